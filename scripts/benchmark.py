@@ -0,0 +1,29 @@
+# Compare calls/second of the native eez module API against the SCPI path
+from utime import ticks_ms, ticks_diff
+from eez import scpi, getSnapshot
+
+NUM_ITERATIONS = 1000
+
+def measure(name, fn):
+    t = ticks_ms()
+    for i in range(NUM_ITERATIONS):
+        fn()
+    dt = ticks_diff(ticks_ms(), t)
+    if dt == 0:
+        dt = 1
+    print(name + ": " + str(NUM_ITERATIONS * 1000 // dt) + " calls/s")
+
+def snapshotScpi():
+    # results are left as returned by SCPI, i.e. without conversion to float
+    u = scpi("MEAS:VOLT? CH1")
+    i = scpi("MEAS:CURR? CH1")
+    p = scpi("MEAS:POW? CH1")
+    mode = scpi("OUTP:MODE? CH1")
+    return (u, i, p, mode)
+
+def snapshotNative():
+    return getSnapshot(1)
+
+measure("SCPI snapshot CH1", snapshotScpi)
+measure("Native snapshot CH1", snapshotNative)
+measure("Native snapshot all channels", getSnapshot)
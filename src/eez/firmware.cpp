@@ -18,6 +18,7 @@
 
 #include <assert.h>
 #include <stdio.h>
+#include <string.h>
 
 #if defined(EEZ_PLATFORM_STM32)
 #include <main.h>
@@ -47,6 +48,7 @@
 #include <eez/modules/psu/io_pins.h>
 #include <eez/modules/psu/profile.h>
 #include <eez/modules/psu/list_program.h>
+#include <eez/modules/psu/waveform.h>
 #include <eez/modules/psu/trigger.h>
 #if OPTION_ETHERNET
 #include <eez/modules/psu/ethernet.h>
@@ -79,10 +81,46 @@ namespace eez {
 
 bool g_isBooted;
 bool g_bootTestSuccess;
+uint32_t g_bootStartTime;
 bool g_shutdownInProgress;
 bool g_shutdown;
 
+#define MAX_BOOT_STEPS 20
+
+static BootStep g_bootSteps[MAX_BOOT_STEPS];
+static int g_numBootSteps;
+
+static void bootStep(const char *name) {
+    if (g_numBootSteps < MAX_BOOT_STEPS) {
+        g_bootSteps[g_numBootSteps].name = name;
+        g_bootSteps[g_numBootSteps].time = millis() - g_bootStartTime;
+        g_numBootSteps++;
+    }
+}
+
+static void pushBootStepsEvent() {
+    char message[512];
+    sprintf(message, "Boot %d ms:", (int)g_bootSteps[g_numBootSteps - 1].time);
+    uint32_t previousTime = 0;
+    for (int i = 0; i < g_numBootSteps; i++) {
+        sprintf(message + strlen(message), " %s %d,", g_bootSteps[i].name, (int)(g_bootSteps[i].time - previousTime));
+        previousTime = g_bootSteps[i].time;
+    }
+    message[strlen(message) - 1] = '\n';
+    psu::event_queue::pushDebugTrace(message, strlen(message));
+}
+
+int getNumBootSteps() {
+    return g_numBootSteps;
+}
+
+const BootStep &getBootStep(int stepIndex) {
+    return g_bootSteps[stepIndex];
+}
+
 void boot() {
+    g_bootStartTime = millis();
+
     assert((uint32_t)(MEMORY_END - MEMORY_BEGIN) <= MEMORY_SIZE);
 
     psu::event_queue::init();
@@ -92,6 +130,8 @@ void boot() {
     //mcu::sdram::test();
 #endif
 
+    bootStep("sdram");
+
 #if OPTION_DISPLAY
     gui::startThread();
 #endif
@@ -111,6 +151,8 @@ void boot() {
 
     psu::startThread();
 
+    bootStep("threads");
+
     // INIT
 
     for (int i = 0; i < CH_MAX; i++) {
@@ -120,14 +162,20 @@ void boot() {
     psu::rtc::init();
     psu::datetime::init();
 
+    bootStep("rtc");
+
     mcu::eeprom::init();
     mcu::eeprom::test();
 
     bp3c::eeprom::init();
     bp3c::eeprom::test();
 
+    bootStep("eeprom");
+
     psu::sd_card::init();
 
+    bootStep("sd");
+
     bp3c::io_exp::init();
 
     // inst:memo 1,0,2,406
@@ -179,6 +227,8 @@ void boot() {
 
     psu::persist_conf::init();
 
+    bootStep("slots");
+
 #if OPTION_DISPLAY
     psu::gui::showWelcomePage();
 #endif
@@ -193,8 +243,14 @@ void boot() {
 
     psu::list::init();
 
+    psu::waveform::init();
+
 #if OPTION_ETHERNET
     psu::ethernet::init();
+
+    // connect (and DHCP) in parallel with the rest of the boot, the result is handled
+    // by the SCPI thread, i.e. TCP servers are started only after the boot
+    mcu::ethernet::startThread();
 #endif
 
 #if OPTION_FAN
@@ -211,12 +267,16 @@ void boot() {
     mcu::encoder::init();
 #endif
 
+    bootStep("init");
+
     // TEST
 
     g_bootTestSuccess = true;
 
     g_bootTestSuccess &= testMaster();
 
+    bootStep("test");
+
 #if defined(EEZ_PLATFORM_STM32)
     if (g_isResetByIWDG) {
         psu::event_queue::pushEvent(psu::event_queue::EVENT_ERROR_WATCHDOG_RESET);
@@ -227,6 +287,8 @@ void boot() {
         psu::psuReset();
     }
 
+    bootStep("power up");
+
     // play beep if there is an error during boot procedure
     if (!g_bootTestSuccess) {
         sound::playBeep();
@@ -234,13 +296,13 @@ void boot() {
 
     g_isBooted = true;
 
-#if OPTION_ETHERNET
-    mcu::ethernet::startThread();
-#endif
     scpi::startThread();
 
     mp::initMessageQueue();
     mp::startThread();
+
+    bootStep("ready");
+    pushBootStepsEvent();
 }
 
 bool testMaster() {
@@ -302,7 +364,7 @@ bool test() {
     if (osThreadGetId() != g_psuTaskHandle) {
         g_testFinished = false;
         
-        osMessagePut(g_psuMessageQueueId, PSU_QUEUE_MESSAGE(PSU_QUEUE_MESSAGE_TYPE_TEST, 0), osWaitForever);
+        sendMessageToPsu(PSU_QUEUE_MESSAGE_TYPE_TEST);
         
         while (!g_testFinished) {
             osDelay(10);
@@ -320,7 +382,7 @@ bool reset() {
     using namespace psu;
 
     if (osThreadGetId() != g_psuTaskHandle) {
-        osMessagePut(g_psuMessageQueueId, PSU_QUEUE_MESSAGE(PSU_QUEUE_MESSAGE_TYPE_RESET, 0), osWaitForever);
+        sendMessageToPsu(PSU_QUEUE_MESSAGE_TYPE_RESET);
         return true;
     }
 
@@ -343,7 +405,7 @@ void shutdown() {
 
     if (osThreadGetId() != g_psuTaskHandle) {
         psu::gui::showSavingPage();
-        osMessagePut(g_psuMessageQueueId, PSU_QUEUE_MESSAGE(PSU_QUEUE_MESSAGE_TYPE_SHUTDOWN, 0), osWaitForever);
+        sendMessageToPsu(PSU_QUEUE_MESSAGE_TYPE_SHUTDOWN);
         return;
     }
 
@@ -18,13 +18,24 @@
 
 #pragma once
 
+#include <stdint.h>
+
 namespace eez {
 
 extern bool g_isBooted;
 extern bool g_bootTestSuccess;
+extern uint32_t g_bootStartTime;
     
 void boot();
 
+struct BootStep {
+    const char *name;
+    uint32_t time; // in ms since boot start, when the step was finished
+};
+
+int getNumBootSteps();
+const BootStep &getBootStep(int stepIndex);
+
 extern bool g_shutdownInProgress;
 extern bool g_shutdown;
 
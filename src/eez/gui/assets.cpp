@@ -27,6 +27,8 @@
 
 #include <eez/libs/lz4/lz4.h>
 
+#include <eez/modules/mcu/display.h>
+
 #include <eez/gui/gui.h>
 #include <eez/gui/widget.h>
 
@@ -40,6 +42,33 @@ namespace gui {
 bool g_assetsLoaded;
 static Assets g_mainAssets;
 
+// Main assets are split by tools/gen_assets_sections.py into independently LZ4
+// compressed sections described by the table of contents below. Section 0 holds
+// the document, styles, fonts and colors and it is decompressed before the first
+// frame. Section i > 0 holds the bitmap with ID i, it is decompressed on first use.
+
+#define ASSETS_SECTIONS_MAGIC 0x53415A45 // "EZAS"
+#define MAX_BITMAPS 64
+
+struct AssetsSection {
+    uint32_t compressedOffset; // from the start of assets
+    uint32_t compressedSize;
+    uint32_t size; // decompressed size
+};
+
+struct AssetsSectionsHeader {
+    uint32_t magic;
+    uint32_t numSections;
+    AssetsSection sections[1];
+};
+
+static const AssetsSectionsHeader &g_assetsSections = *(const AssetsSectionsHeader *)assets;
+
+static uint8_t *g_bitmaps[MAX_BITMAPS]; // in BITMAP_CACHE, nullptr if not decompressed
+static uint32_t g_bitmapCacheUsed;
+
+static uint32_t g_assetsDecompressionTime;
+
 static Assets g_externalAssets;
 
 static Assets *g_fixPointersAssets;
@@ -151,24 +180,37 @@ void initAssets(Assets &assets, bool external, uint8_t *decompressedAssets) {
     }
 }
 
+static void decompressAssetsSection(uint32_t sectionIndex, uint8_t *dst) {
+    const AssetsSection &section = g_assetsSections.sections[sectionIndex];
+
+    int result = LZ4_decompress_safe((const char *)assets + section.compressedOffset, (char *)dst, (int)section.compressedSize, (int)section.size);
+    assert(result == (int)section.size);
+    (void)result;
+}
+
 void decompressAssets() {
-    uint8_t *decompressedAssets;
+    uint32_t startTime = millis();
 
-    int compressedSize = sizeof(assets) - 4;
+    // run tools/gen_assets_sections.py after the document is regenerated
+    assert(g_assetsSections.magic == ASSETS_SECTIONS_MAGIC);
+    assert(g_assetsSections.sections[0].size <= DECOMPRESSED_ASSETS_SIZE);
+    assert(g_assetsSections.numSections - 1 <= MAX_BITMAPS);
 
-    // first 4 bytes (uint32_t) are decompressed size
-    uint32_t decompressedSize = ((uint32_t *)assets)[0];
-    assert(decompressedSize <= DECOMPRESSED_ASSETS_SIZE);
-    decompressedAssets = DECOMPRESSED_ASSETS_START_ADDRESS;
+    uint8_t *decompressedAssets = DECOMPRESSED_ASSETS_START_ADDRESS;
 
-    int result = LZ4_decompress_safe((const char *)assets + 4, (char *)decompressedAssets, compressedSize, (int)decompressedSize);
-    assert(result == (int)decompressedSize);
+    decompressAssetsSection(0, decompressedAssets);
 
     initAssets(g_mainAssets, false, decompressedAssets);
 
     fixPointers(g_mainAssets);
 
     g_assetsLoaded = true;
+
+    g_assetsDecompressionTime = millis() - startTime;
+}
+
+uint32_t getAssetsDecompressionTime() {
+    return g_assetsDecompressionTime;
 }
 
 const Style *getStyle(int styleID) {
@@ -191,9 +233,36 @@ const uint8_t *getFontData(int fontID) {
     return g_mainAssets.fontsData + ((uint32_t *)g_mainAssets.fontsData)[fontID - 1];
 }
 
+// Called only from the GUI thread, the returned bitmap is valid until the next call.
+// When the cache is full all the bitmaps are dropped. Widgets draw a bitmap only
+// when it changes, so this happens only when switching between bitmap heavy pages.
+static const Bitmap *getMainBitmap(int bitmapID) {
+    uint8_t *bitmap = g_bitmaps[bitmapID - 1];
+
+    if (!bitmap) {
+        uint32_t size = (g_assetsSections.sections[bitmapID].size + 3) & ~3;
+        assert(size <= BITMAP_CACHE_SIZE);
+
+        if (g_bitmapCacheUsed + size > BITMAP_CACHE_SIZE) {
+            // display could still be reading pixels of some cached bitmap
+            mcu::display::waitBitBlt();
+            memset(g_bitmaps, 0, sizeof(g_bitmaps));
+            g_bitmapCacheUsed = 0;
+        }
+
+        bitmap = BITMAP_CACHE + g_bitmapCacheUsed;
+        decompressAssetsSection(bitmapID, bitmap);
+        g_bitmapCacheUsed += size;
+
+        g_bitmaps[bitmapID - 1] = bitmap;
+    }
+
+    return (const Bitmap *)bitmap;
+}
+
 const Bitmap *getBitmap(int bitmapID) {
     if (bitmapID > 0) {
-        return (const Bitmap *)(g_mainAssets.bitmapsData + ((uint32_t *)g_mainAssets.bitmapsData)[bitmapID - 1]);
+        return getMainBitmap(bitmapID);
     } else if (bitmapID < 0) {
         return (const Bitmap *)(g_externalAssets.bitmapsData + ((uint32_t *)g_externalAssets.bitmapsData)[-bitmapID - 1]);
     }
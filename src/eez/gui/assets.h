@@ -25,6 +25,8 @@ namespace gui {
 
 void decompressAssets();
 
+uint32_t getAssetsDecompressionTime(); // in ms
+
 extern bool g_assetsLoaded;
 
 const Style *getStyle(int styleID);
@@ -29,6 +29,8 @@
 namespace eez {
 namespace gui {
 
+static_assert(DATA_OPERATION_GET_CANVAS_DRAW_FUNCTION < 64, "g_dataOperationsMasks entry has room for 64 operations");
+
 ////////////////////////////////////////////////////////////////////////////////
 
 bool compare_NONE_value(const Value &a, const Value &b) {
@@ -812,6 +814,22 @@ void ytDataTouchDrag(Cursor cursor, int16_t id, TouchDrag *touchDrag) {
     DATA_OPERATION_FUNCTION(id, DATA_OPERATION_YT_DATA_TOUCH_DRAG, cursor, value);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+
+#if defined(EEZ_PLATFORM_SIMULATOR)
+
+DataOperationStats g_dataOperationStats;
+
+void getDataOperationStats(DataOperationStats &stats) {
+    stats = g_dataOperationStats;
+}
+
+void resetDataOperationStats() {
+    memset(&g_dataOperationStats, 0, sizeof(g_dataOperationStats));
+}
+
+#endif
+
 } // namespace gui
 } // namespace eez
 
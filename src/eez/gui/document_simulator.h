@@ -1888,4 +1888,4 @@ enum PagesEnum {
     PAGE_ID_DEBUG_POWER_CHANNELS = 169
 };
 
-extern const uint8_t assets[444767];
+extern const uint8_t assets[479712];
@@ -1839,4 +1839,4 @@ enum PagesEnum {
     PAGE_ID_DEBUG_POWER_CHANNELS = 163
 };
 
-extern const uint8_t assets[309242];
+extern const uint8_t assets[321152];
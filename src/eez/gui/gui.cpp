@@ -62,9 +62,9 @@ osThreadId g_guiTaskHandle;
 osMessageQDef(g_guiMessageQueue, GUI_QUEUE_SIZE, uint32_t);
 osMessageQId g_guiMessageQueueId;
 
+static uint32_t g_firstFrameTime;
+
 void startThread() {
-    decompressAssets();
-    mcu::display::onThemeChanged();
     touch::init();
     g_guiMessageQueueId = osMessageCreate(osMessageQ(g_guiMessageQueue), NULL);
     g_guiTaskHandle = osThreadCreate(osThread(g_guiTask), nullptr);
@@ -72,16 +72,30 @@ void startThread() {
 
 void oneIter();
 
+static void loadAssets() {
+    // assets are decompressed in GUI thread, i.e. in parallel with the rest of the boot
+    decompressAssets();
+    mcu::display::onThemeChanged();
+}
+
 void mainLoop(const void *) {
 #ifdef __EMSCRIPTEN__
+    if (!g_assetsLoaded) {
+        loadAssets();
+    }
 	oneIter();
 #else
+    loadAssets();
     while (1) {
         oneIter();
     }
 #endif
 }
 
+uint32_t getFirstFrameTime() {
+    return g_firstFrameTime;
+}
+
 void onGuiQueueMessage(uint8_t type, int16_t param) {
     if (type == GUI_QUEUE_MESSAGE_TYPE_SHOW_PAGE) {
         getAppContextFromId(param)->doShowPage();
@@ -156,6 +170,10 @@ void oneIter() {
 
     if (wasOn || mcu::display::isOn()) {
         mcu::display::endBuffersDrawing();
+
+        if (!g_firstFrameTime) {
+            g_firstFrameTime = MAX(millis() - g_bootStartTime, 1);
+        }
     }
 }
 
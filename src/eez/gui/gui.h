@@ -31,7 +31,8 @@ enum {
     FIRST_INTERNAL_PAGE_ID = 32000,
     INTERNAL_PAGE_ID_SELECT_FROM_ENUM,
     INTERNAL_PAGE_ID_TOAST_MESSAGE,
-    INTERNAL_PAGE_ID_MENU_WITH_BUTTONS
+    INTERNAL_PAGE_ID_MENU_WITH_BUTTONS,
+    INTERNAL_PAGE_ID_CHANNEL_STATISTICS
 };
 
 enum InternalActionsEnum {
@@ -40,7 +41,9 @@ enum InternalActionsEnum {
     ACTION_ID_INTERNAL_DIALOG_CLOSE,
     ACTION_ID_INTERNAL_TOAST_ACTION,
     ACTION_ID_INTERNAL_TOAST_ACTION_WITHOUT_PARAM,
-    ACTION_ID_INTERNAL_MENU_WITH_BUTTONS
+    ACTION_ID_INTERNAL_MENU_WITH_BUTTONS,
+    ACTION_ID_INTERNAL_SHOW_CHANNEL_STATISTICS,
+    ACTION_ID_INTERNAL_CHANNEL_STATISTICS_RESET
 };
 
 namespace eez {
@@ -65,6 +68,8 @@ extern osMessageQId g_guiMessageQueueId;
 
 void onGuiQueueMessageHook(uint8_t type, int16_t param);
 
+uint32_t getFirstFrameTime(); // in ms since boot start, 0 if not yet drawn
+
 #endif
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -156,6 +161,46 @@ void executeInternalActionHook(int actionId);
 
 bool activePageHasBackdropHook();
 
+////////////////////////////////////////////////////////////////////////////////
+
+#define DATA_OPERATION_MASK(operation) (1ULL << (operation))
+#define DATA_OPERATIONS_ALL 0xFFFFFFFFFFFFFFFFULL
+
+// For each DATA_ID, mask of the operations implemented by its data function,
+// generated by tools/gen_data_operations.py. Data function is not called for
+// the operation it doesn't implement, value is left as initialized by the caller.
+extern const uint64_t g_dataOperationsMasks[];
+
+#if defined(EEZ_PLATFORM_SIMULATOR)
+struct DataOperationStats {
+    uint32_t numFrames;
+    uint32_t numCalls[64];
+    uint32_t numSkipped[64];
+};
+
+extern DataOperationStats g_dataOperationStats;
+
+void getDataOperationStats(DataOperationStats &stats);
+void resetDataOperationStats();
+#endif
+
+inline void dataOperation(int16_t id, DataOperationEnum operation, Cursor cursor, Value &value) {
+    if (id >= 0) {
+        if (g_dataOperationsMasks[id] & DATA_OPERATION_MASK(operation)) {
+#if defined(EEZ_PLATFORM_SIMULATOR)
+            g_dataOperationStats.numCalls[operation]++;
+#endif
+            g_dataOperationsFunctions[id](operation, cursor, value);
+        } else {
+#if defined(EEZ_PLATFORM_SIMULATOR)
+            g_dataOperationStats.numSkipped[operation]++;
+#endif
+        }
+    } else {
+        externalDataHook(id, operation, cursor, value);
+    }
+}
+
 } // namespace gui
 } // namespace eez
 
@@ -166,4 +211,4 @@ bool activePageHasBackdropHook();
 #include <eez/gui/font.h>
 #include <eez/gui/draw.h>
 
-#define DATA_OPERATION_FUNCTION(id, operation, cursor, value) (id >= 0 ? g_dataOperationsFunctions[id](operation, cursor, value) : externalDataHook(id, operation, cursor, value))
\ No newline at end of file
+#define DATA_OPERATION_FUNCTION(id, operation, cursor, value) dataOperation(id, operation, cursor, value)
\ No newline at end of file
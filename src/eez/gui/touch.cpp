@@ -41,6 +41,12 @@ static int g_filteredX = -1;
 static int g_filteredY = -1;
 static bool g_filteredPressed = false;
 
+static volatile bool g_remoteActive = false;
+static volatile bool g_remotePressed = false;
+static volatile bool g_remoteReleased = false;
+static volatile int g_remoteX = -1;
+static volatile int g_remoteY = -1;
+
 ////////////////////////////////////////////////////////////////////////////////
 
 static EventType g_eventType = EVENT_TYPE_TOUCH_NONE;
@@ -117,6 +123,22 @@ void oneIter() {
     g_pressed = pressed;
 #endif
 
+    if (g_remoteActive) {
+        g_x = g_remoteX;
+        g_y = g_remoteY;
+        g_pressed = g_remotePressed;
+
+        if (g_remoteReleased) {
+            // report the press at least once, even if the release came before this iteration
+            if (g_remotePressed) {
+                g_remotePressed = false;
+            } else {
+                g_remoteReleased = false;
+                g_remoteActive = false;
+            }
+        }
+    }
+
     if (g_pressed) {
         if (g_lastEventType == EVENT_TYPE_TOUCH_NONE || g_lastEventType == EVENT_TYPE_TOUCH_UP) {
             g_lastEventType = EVENT_TYPE_TOUCH_DOWN;
@@ -218,6 +240,18 @@ int getY() {
     return g_eventY;
 }
 
+void writeRemote(bool pressed, int x, int y) {
+    g_remoteX = x;
+    g_remoteY = y;
+    if (pressed) {
+        g_remotePressed = true;
+        g_remoteReleased = false;
+    } else {
+        g_remoteReleased = true;
+    }
+    g_remoteActive = true;
+}
+
 } // namespace touch
 
 void data_touch_calibrated_x(DataOperationEnum operation, Cursor cursor, Value &value) {
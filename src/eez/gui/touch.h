@@ -31,6 +31,9 @@ EventType getEventType();
 int getX();
 int getY();
 
+// touch state received from the remote display client, in display coordinates
+void writeRemote(bool pressed, int x, int y);
+
 } // namespace touch
 } // namespace gui
 } // namespace eez
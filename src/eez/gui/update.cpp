@@ -52,6 +52,10 @@ void updateScreen() {
 	widgetCursor.currentState = g_currentState;
 
     widgetCursor.appContext->updateAppView(widgetCursor);
+
+#if defined(EEZ_PLATFORM_SIMULATOR)
+    g_dataOperationStats.numFrames++;
+#endif
 }
 
 } // namespace gui
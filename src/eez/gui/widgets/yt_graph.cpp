@@ -67,8 +67,10 @@ struct YTGraphDrawHelper {
 
     int x;
 
-    int yPrev[2];
-    int y[2];
+    int yPrevMin[2];
+    int yPrevMax[2];
+    int yMin[2];
+    int yMax[2];
 
     Value::YtDataGetValueFunctionPointer ytDataGetValue;
 
@@ -87,48 +89,80 @@ struct YTGraphDrawHelper {
         ytDataGetValue = ytDataGetGetValueFunc(widgetCursor.cursor, widget->data);
     }
 
-    int getYValue(int valueIndex, uint32_t position) {
+    int getY(int valueIndex, float value) {
+        return widget->h - 1 - (int)round((widget->h - 1) * (value - min[valueIndex]) / (max[valueIndex] - min[valueIndex]));
+    }
+
+    // value at position can be a range (min and max), yTopOut is the top pixel of that range
+    void getYValue(int valueIndex, uint32_t position, int &yTopOut, int &yBottomOut) {
+        yTopOut = INT_MIN;
+        yBottomOut = INT_MIN;
+
         if (position >= numPositions) {
-            return INT_MIN;
+            return;
         }
 
-        float value = ytDataGetValue(position, valueIndex, nullptr);
+        float fMax;
+        float fMin = ytDataGetValue(position, valueIndex, &fMax);
 
-        if (isNaN(value)) {
-            return INT_MIN;
+        if (isNaN(fMin) || isNaN(fMax)) {
+            return;
         }
 
-        int y = (int)round((widget->h - 1) * (value - min[valueIndex]) / (max[valueIndex] - min[valueIndex]));
+        int yTop = getY(valueIndex, fMax);
+        int yBottom = getY(valueIndex, fMin);
 
-        if (y < 0 || y >= widget->h) {
-            return INT_MIN;
+        if (yBottom < 0 || yTop >= widget->h) {
+            return;
         }
 
-        return widget->h - 1 - y;
+        yTopOut = yTop < 0 ? 0 : yTop;
+        yBottomOut = yBottom >= widget->h ? widget->h - 1 : yBottom;
+    }
+
+    void getYValue(int valueIndex, uint32_t position) {
+        getYValue(valueIndex, position, yMin[valueIndex], yMax[valueIndex]);
+    }
+
+    void getPrevYValue(int valueIndex, uint32_t position) {
+        getYValue(valueIndex, position, yPrevMin[valueIndex], yPrevMax[valueIndex]);
     }
 
     void drawValue(int valueIndex) {
-        if (y[valueIndex] == INT_MIN) {
+        if (yMin[valueIndex] == INT_MIN) {
             return;
         }
 
         display::setColor16(dataColor16[valueIndex]);
 
-        if (yPrev[valueIndex] == INT_MIN || abs(yPrev[valueIndex] - y[valueIndex]) <= 1) {
-            display::drawPixel(x, widgetCursor.y + y[valueIndex]);
-        } else {
-            if (yPrev[valueIndex] < y[valueIndex]) {
-                display::drawVLine(x, widgetCursor.y + yPrev[valueIndex] + 1, y[valueIndex] - yPrev[valueIndex] - 1);
-            } else {
-                display::drawVLine(x, widgetCursor.y + y[valueIndex], yPrev[valueIndex] - y[valueIndex] - 1);
+        // connect with the previous value
+        int yFrom = yMin[valueIndex];
+        int yTo = yMax[valueIndex];
+        if (yPrevMin[valueIndex] != INT_MIN) {
+            if (yPrevMax[valueIndex] < yFrom - 1) {
+                yFrom = yPrevMax[valueIndex] + 1;
+            } else if (yPrevMin[valueIndex] > yTo + 1) {
+                yTo = yPrevMin[valueIndex] - 1;
             }
         }
+
+        if (yFrom == yTo) {
+            display::drawPixel(x, widgetCursor.y + yFrom);
+        } else {
+            display::drawVLine(x, widgetCursor.y + yFrom, yTo - yFrom);
+        }
+    }
+
+    bool isSinglePixelStep(int valueIndex) {
+        return yMin[valueIndex] != INT_MIN && yMin[valueIndex] == yMax[valueIndex] &&
+            yPrevMin[valueIndex] != INT_MIN && yPrevMin[valueIndex] == yPrevMax[valueIndex] &&
+            abs(yPrevMin[valueIndex] - yMin[valueIndex]) <= 1;
     }
 
     void drawStep() {
-        if (y[0] != INT_MIN && y[1] != INT_MIN && abs(yPrev[0] - y[0]) <= 1 && abs(yPrev[1] - y[1]) <= 1 && y[0] == y[1]) {
+        if (isSinglePixelStep(0) && isSinglePixelStep(1) && yMin[0] == yMin[1]) {
             display::setColor16(position % 2 ? dataColor16[1] : dataColor16[0]);
-            display::drawPixel(x, widgetCursor.y + y[0]);
+            display::drawPixel(x, widgetCursor.y + yMin[0]);
         } else {
             drawValue(0);
             drawValue(1);
@@ -151,11 +185,11 @@ struct YTGraphDrawHelper {
         for (position = startPosition; position < endPosition; ++position) {
             x = widgetCursor.x + position % graphWidth;
 
-            y[0] = getYValue(0, position);
-            yPrev[0] = getYValue(0, position == 0 ? position : position - 1);
+            getYValue(0, position);
+            getPrevYValue(0, position == 0 ? position : position - 1);
 
-            y[1] = getYValue(1, position);
-            yPrev[1] = getYValue(1, position == 0 ? position : position - 1);
+            getYValue(1, position);
+            getPrevYValue(1, position == 0 ? position : position - 1);
 
             drawStep();
         }
@@ -184,20 +218,22 @@ struct YTGraphDrawHelper {
 
         numPositions = position + numPointsToDraw;
 
-        yPrev[0] = getYValue(0, previousHistoryValuePosition);
-        yPrev[1] = getYValue(1, previousHistoryValuePosition);
+        getPrevYValue(0, previousHistoryValuePosition);
+        getPrevYValue(1, previousHistoryValuePosition);
 
         display::setColor16(color16);
         display::fillRect(startX, widgetCursor.y, endX - 1, widgetCursor.y + widget->h - 1);
 
         for (x = startX; x < endX; x++, position++) {
-            y[0] = getYValue(0, position);
-            y[1] = getYValue(1, position);
+            getYValue(0, position);
+            getYValue(1, position);
 
             drawStep();
 
-            yPrev[0] = y[0];
-            yPrev[1] = y[1];
+            yPrevMin[0] = yMin[0];
+            yPrevMax[0] = yMax[0];
+            yPrevMin[1] = yMin[1];
+            yPrevMax[1] = yMax[1];
         }
     }
 };
@@ -36,10 +36,26 @@ ChannelInterface::ChannelInterface(int slotIndex_)
 {
 }
 
+bool ChannelInterface::testStep(int subchannelIndex) {
+    return false;
+}
+
 unsigned ChannelInterface::getRPol(int subchannelIndex) {
     return 0;
 }
 
+bool ChannelInterface::isWaveformDacSupported(int subchannelIndex) {
+    return false;
+}
+
+bool ChannelInterface::setWaveformDacVoltage(int subchannelIndex, float value) {
+    return false;
+}
+
+bool ChannelInterface::setWaveformDacCurrent(int subchannelIndex, float value) {
+    return false;
+}
+
 void ChannelInterface::setRemoteSense(int subchannelIndex, bool enable) {
 }
 
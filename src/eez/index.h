@@ -148,6 +148,10 @@ struct ChannelInterface {
     virtual void onPowerDown(int subchannelIndex) = 0;
     virtual void reset(int subchannelIndex) = 0;
     virtual void test(int subchannelIndex) = 0;
+    // Continues the test started by test, returns false when the test is finished.
+    // Modules are on separate SPI buses, so testChannels() steps the tests of all
+    // the channels in turns and the modules wait for their ADCs at the same time.
+    virtual bool testStep(int subchannelIndex);
     virtual void tick(int subchannelIndex, uint32_t tickCount) = 0;
 
     virtual TestResult getTestResult(int subchannelIndex) = 0;
@@ -173,6 +177,14 @@ struct ChannelInterface {
 
     virtual bool isDacTesting(int subchannelIndex) = 0;
 
+    // Waveform thread (see psu/waveform.cpp) writes the calibrated setpoint
+    // directly to the DAC, at fixed rate and outside of the PSU thread, so these
+    // must not touch anything but the DAC. Returns false if the value is not
+    // written. Waveform of the modules which don't support it runs in the PSU thread.
+    virtual bool isWaveformDacSupported(int subchannelIndex);
+    virtual bool setWaveformDacVoltage(int subchannelIndex, float value);
+    virtual bool setWaveformDacCurrent(int subchannelIndex, float value);
+
     virtual void setRemoteSense(int subchannelIndex, bool enable);
     virtual void setRemoteProgramming(int subchannelIndex, bool enable);
 
@@ -21,10 +21,18 @@
 #include <eez/libs/image/image.h>
 #include <eez/libs/image/bitmap.h>
 #include <eez/libs/image/jpeg.h>
+#include <eez/libs/image/qoi.h>
 
 bool imageDecode(const char *filePath, Image *image) {
     if (eez::endsWithNoCase(filePath, ".bmp")) {
         return bitmapDecode(filePath, image);
     }
     return jpegDecode(filePath, image);
+}
+
+int imageEncode(ImageFormat format, const uint8_t *screenshotPixels, unsigned char **imageData, size_t *imageDataSize) {
+    if (format == IMAGE_FORMAT_QOI) {
+        return qoiEncode(screenshotPixels, imageData, imageDataSize);
+    }
+    return jpegEncode(screenshotPixels, imageData, imageDataSize);
 }
\ No newline at end of file
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 
 struct Image {
@@ -28,4 +29,12 @@ struct Image {
     uint8_t *pixels;
 };
 
-bool imageDecode(const char *filePath, Image *image);
\ No newline at end of file
+enum ImageFormat {
+    IMAGE_FORMAT_JPEG,
+    IMAGE_FORMAT_QOI // lossless
+};
+
+bool imageDecode(const char *filePath, Image *image);
+
+// encode 480x272 RGB888 screenshot, returns 0 on success
+int imageEncode(ImageFormat format, const uint8_t *screenshotPixels, unsigned char **imageData, size_t *imageDataSize);
\ No newline at end of file
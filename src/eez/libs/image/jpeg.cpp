@@ -40,26 +40,166 @@ extern "C" {
 #include <eez/libs/sd_fat/sd_fat.h>
 #include <eez/libs/image/jpeg.h>
 
+#define SCREENSHOT_WIDTH 480
+#define SCREENSHOT_HEIGHT 272
+#define SCREENSHOT_JPEG_QUALITY 90
+
 static size_t g_imageDataSize;
+static bool g_imageDataOverflow;
 
-void WRITE_ONE_BYTE(unsigned char byte) {
-	VRAM_SCREENSHOOT_JPEG_OUT_BUFFER[g_imageDataSize++] = byte;
+static void writeBytes(const unsigned char *data, unsigned int size) {
+    if (g_imageDataSize + size > VRAM_SCREENSHOOT_JPEG_OUT_BUFFER_SIZE) {
+        g_imageDataOverflow = true;
+        return;
+    }
+    memcpy(VRAM_SCREENSHOOT_JPEG_OUT_BUFFER + g_imageDataSize, data, size);
+    g_imageDataSize += size;
 }
 
-int jpegEncode(const uint8_t *screenshotPixels, unsigned char **imageData, size_t *imageDataSize) {
-	g_imageDataSize = 0;
-	TooJpeg::writeJpeg(WRITE_ONE_BYTE, screenshotPixels, 480, 272);
+static int jpegEncodeSoftware(const uint8_t *screenshotPixels, unsigned char **imageData, size_t *imageDataSize) {
+    g_imageDataSize = 0;
+    g_imageDataOverflow = false;
+    TooJpeg::writeJpeg(writeBytes, screenshotPixels, SCREENSHOT_WIDTH, SCREENSHOT_HEIGHT, true, SCREENSHOT_JPEG_QUALITY);
+    if (g_imageDataOverflow) {
+        return 1;
+    }
     *imageData = VRAM_SCREENSHOOT_JPEG_OUT_BUFFER;
     *imageDataSize = g_imageDataSize;
     return 0;
 }
 
+// RGB to YCbCr (JFIF) conversion in 16.16 fixed point, used by the hardware
+// encoder. Cb and Cr are rounded with 32767, with 32768 a saturated blue
+// (red) would give 256 which doesn't fit into uint8_t and wraps to 0.
+static constexpr int32_t rgbToY(int32_t r, int32_t g, int32_t b) {
+    return (19595 * r + 38470 * g + 7471 * b + 32768) >> 16;
+}
+
+static constexpr int32_t rgbToCb(int32_t r, int32_t g, int32_t b) {
+    return ((-11059 * r - 21709 * g + 32768 * b + 32767) >> 16) + 128;
+}
+
+static constexpr int32_t rgbToCr(int32_t r, int32_t g, int32_t b) {
+    return ((32768 * r - 27439 * g - 5329 * b + 32767) >> 16) + 128;
+}
+
+// extremes are at the saturated colors
+static_assert(rgbToY(0, 0, 0) == 0 && rgbToY(255, 255, 255) == 255, "Y out of range");
+static_assert(rgbToCb(0, 0, 255) == 255 && rgbToCb(255, 255, 0) == 0, "Cb out of range");
+static_assert(rgbToCr(255, 0, 0) == 255 && rgbToCr(0, 255, 255) == 0, "Cr out of range");
+static_assert(rgbToCb(128, 128, 128) == 128 && rgbToCr(128, 128, 128) == 128, "gray must have no chroma");
+
 uint8_t *g_fileData;
 
 #if defined(EEZ_PLATFORM_STM32)
 
 static bool g_jpegInitialized;
 
+static void jpegInit() {
+    if (!g_jpegInitialized) {
+    	JPEG_InitColorTables();
+
+    	hjpeg.Instance = JPEG;
+    	HAL_JPEG_Init(&hjpeg);
+
+    	g_jpegInitialized = true;
+    }
+}
+
+// The hardware encoder input are YCbCr 4:4:4 MCUs (8x8 Y, 8x8 Cb and 8x8 Cr block).
+// They are generated one MCU row at the time, at the end of the output buffer,
+// and given to the JPEG peripheral from HAL_JPEG_GetDataCallback.
+static const uint32_t ENCODE_MCU_ROW_SIZE = (SCREENSHOT_WIDTH / 8) * YCBCR_444_BLOCK_SIZE;
+static uint8_t * const g_encodeMcuRow = VRAM_SCREENSHOOT_JPEG_OUT_BUFFER + VRAM_SCREENSHOOT_JPEG_OUT_BUFFER_SIZE - ENCODE_MCU_ROW_SIZE;
+static const uint32_t ENCODE_OUT_BUFFER_SIZE = VRAM_SCREENSHOOT_JPEG_OUT_BUFFER_SIZE - ENCODE_MCU_ROW_SIZE;
+
+static const uint8_t *g_encodePixels;
+static int g_encodeMcuRowIndex;
+static bool g_encoding;
+static uint32_t g_encodeOutDataLength;
+static bool g_encodeOutBufferFull;
+
+static void encodeConvertMcuRow(int mcuRowIndex) {
+    uint8_t *dst = g_encodeMcuRow;
+
+    for (int mcuX = 0; mcuX < SCREENSHOT_WIDTH; mcuX += 8) {
+        uint8_t *y = dst;
+        uint8_t *cb = dst + 64;
+        uint8_t *cr = dst + 128;
+
+        for (int row = 0; row < 8; row++) {
+            const uint8_t *src = g_encodePixels + ((mcuRowIndex * 8 + row) * SCREENSHOT_WIDTH + mcuX) * 3;
+            for (int column = 0; column < 8; column++) {
+                int32_t r = *src++;
+                int32_t g = *src++;
+                int32_t b = *src++;
+                *y++ = (uint8_t)rgbToY(r, g, b);
+                *cb++ = (uint8_t)rgbToCb(r, g, b);
+                *cr++ = (uint8_t)rgbToCr(r, g, b);
+            }
+        }
+
+        dst += YCBCR_444_BLOCK_SIZE;
+    }
+}
+
+extern "C" void HAL_JPEG_GetDataCallback(JPEG_HandleTypeDef *hjpeg, uint32_t NbEncodedData) {
+    if (!g_encoding) {
+        return;
+    }
+
+    if (++g_encodeMcuRowIndex < SCREENSHOT_HEIGHT / 8) {
+        encodeConvertMcuRow(g_encodeMcuRowIndex);
+        HAL_JPEG_ConfigInputBuffer(hjpeg, g_encodeMcuRow, ENCODE_MCU_ROW_SIZE);
+    } else {
+        HAL_JPEG_ConfigInputBuffer(hjpeg, g_encodeMcuRow, 0);
+    }
+}
+
+extern "C" void HAL_JPEG_DataReadyCallback(JPEG_HandleTypeDef *hjpeg, uint8_t *pDataOut, uint32_t OutDataLength) {
+    if (!g_encoding) {
+        return;
+    }
+
+    // called at the end of encoding, and before that only if the output buffer is full
+    if (OutDataLength == ENCODE_OUT_BUFFER_SIZE) {
+        g_encodeOutBufferFull = true;
+    }
+    g_encodeOutDataLength = OutDataLength;
+}
+
+static int jpegEncodeHardware(const uint8_t *screenshotPixels, unsigned char **imageData, size_t *imageDataSize) {
+    jpegInit();
+
+    JPEG_ConfTypeDef jpegInfo;
+    jpegInfo.ColorSpace = JPEG_YCBCR_COLORSPACE;
+    jpegInfo.ChromaSubsampling = JPEG_444_SUBSAMPLING;
+    jpegInfo.ImageWidth = SCREENSHOT_WIDTH;
+    jpegInfo.ImageHeight = SCREENSHOT_HEIGHT;
+    jpegInfo.ImageQuality = SCREENSHOT_JPEG_QUALITY;
+    if (HAL_JPEG_ConfigEncoding(&hjpeg, &jpegInfo) != HAL_OK) {
+        return 1;
+    }
+
+    g_encodePixels = screenshotPixels;
+    g_encodeMcuRowIndex = 0;
+    encodeConvertMcuRow(0);
+
+    g_encoding = true;
+    g_encodeOutDataLength = 0;
+    g_encodeOutBufferFull = false;
+    HAL_StatusTypeDef status = HAL_JPEG_Encode(&hjpeg, g_encodeMcuRow, ENCODE_MCU_ROW_SIZE, VRAM_SCREENSHOOT_JPEG_OUT_BUFFER, ENCODE_OUT_BUFFER_SIZE, 1000);
+    g_encoding = false;
+
+    if (status != HAL_OK || g_encodeOutBufferFull || g_encodeOutDataLength == 0) {
+        return 1;
+    }
+
+    *imageData = VRAM_SCREENSHOOT_JPEG_OUT_BUFFER;
+    *imageDataSize = g_encodeOutDataLength;
+    return 0;
+}
+
 #else
 
 extern "C" void * const g_jpegDecodeContext = (void *)FILE_VIEW_BUFFER;
@@ -100,6 +240,16 @@ extern "C" void njCopyMem(void* dest, const void* src, int size) {
 
 #endif
 
+int jpegEncode(const uint8_t *screenshotPixels, unsigned char **imageData, size_t *imageDataSize) {
+#if defined(EEZ_PLATFORM_STM32)
+    if (jpegEncodeHardware(screenshotPixels, imageData, imageDataSize) == 0) {
+        return 0;
+    }
+    // fall back to software encoder
+#endif
+    return jpegEncodeSoftware(screenshotPixels, imageData, imageDataSize);
+}
+
 bool jpegDecode(const char *filePath, Image *image) {
     eez::File file;
     if (!file.open(filePath, FILE_OPEN_EXISTING | FILE_READ)) {
@@ -122,14 +272,7 @@ bool jpegDecode(const char *filePath, Image *image) {
     }
 
 #if defined(EEZ_PLATFORM_STM32)
-    if (!g_jpegInitialized) {
-    	JPEG_InitColorTables();
-
-    	hjpeg.Instance = JPEG;
-    	HAL_JPEG_Init(&hjpeg);
-
-    	g_jpegInitialized = true;
-    }
+    jpegInit();
 
     if (HAL_JPEG_Decode(&hjpeg, g_fileData, fileSize, FILE_VIEW_BUFFER, g_fileData - FILE_VIEW_BUFFER, 5000) != HAL_OK) {
         return false;
@@ -0,0 +1,144 @@
+/*
+ * EEZ Modular Firmware
+ * Copyright (C) 2015-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <memory.h>
+
+#include <eez/memory.h>
+#include <eez/libs/image/qoi.h>
+
+#define SCREENSHOT_WIDTH 480
+#define SCREENSHOT_HEIGHT 272
+
+#define QOI_OP_INDEX 0x00 // 00xxxxxx
+#define QOI_OP_DIFF  0x40 // 01xxxxxx
+#define QOI_OP_LUMA  0x80 // 10xxxxxx
+#define QOI_OP_RUN   0xC0 // 11xxxxxx
+#define QOI_OP_RGB   0xFE // 11111110
+
+#define QOI_MAX_RUN 62
+
+// run flush followed by QOI_OP_RGB
+#define QOI_MAX_PIXEL_SIZE 5
+
+static const uint8_t QOI_END_MARKER[] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+
+static uint8_t *writeU32(uint8_t *dst, uint32_t value) {
+    *dst++ = (uint8_t)(value >> 24);
+    *dst++ = (uint8_t)(value >> 16);
+    *dst++ = (uint8_t)(value >> 8);
+    *dst++ = (uint8_t)value;
+    return dst;
+}
+
+int qoiEncode(const uint8_t *screenshotPixels, unsigned char **imageData, size_t *imageDataSize) {
+    uint8_t *dst = VRAM_SCREENSHOOT_JPEG_OUT_BUFFER;
+    uint8_t *dstEnd = VRAM_SCREENSHOOT_JPEG_OUT_BUFFER + VRAM_SCREENSHOOT_JPEG_OUT_BUFFER_SIZE - sizeof(QOI_END_MARKER);
+
+    // header
+    *dst++ = 'q';
+    *dst++ = 'o';
+    *dst++ = 'i';
+    *dst++ = 'f';
+    dst = writeU32(dst, SCREENSHOT_WIDTH);
+    dst = writeU32(dst, SCREENSHOT_HEIGHT);
+    *dst++ = 3; // channels: RGB
+    *dst++ = 0; // colorspace: sRGB with linear alpha
+
+    // Pixels are compared as 0xAARRGGBB with alpha always 255,
+    // so initial (all zero) index entries never match.
+    uint32_t index[64];
+    memset(index, 0, sizeof(index));
+
+    uint32_t previousPixel = 0xFF000000;
+    uint8_t pr = 0;
+    uint8_t pg = 0;
+    uint8_t pb = 0;
+    int run = 0;
+
+    const uint8_t *src = screenshotPixels;
+    const uint8_t *srcEnd = screenshotPixels + SCREENSHOT_WIDTH * SCREENSHOT_HEIGHT * 3;
+
+    for (; src < srcEnd; src += 3) {
+        if (dst + QOI_MAX_PIXEL_SIZE > dstEnd) {
+            return 1;
+        }
+
+        uint8_t r = src[0];
+        uint8_t g = src[1];
+        uint8_t b = src[2];
+        uint32_t pixel = 0xFF000000 | (r << 16) | (g << 8) | b;
+
+        if (pixel == previousPixel) {
+            if (++run == QOI_MAX_RUN) {
+                *dst++ = QOI_OP_RUN | (run - 1);
+                run = 0;
+            }
+            continue;
+        }
+
+        if (run > 0) {
+            *dst++ = QOI_OP_RUN | (run - 1);
+            run = 0;
+        }
+
+        int hash = (r * 3 + g * 5 + b * 7 + 255 * 11) % 64;
+
+        if (index[hash] == pixel) {
+            *dst++ = QOI_OP_INDEX | hash;
+        } else {
+            index[hash] = pixel;
+
+            int8_t dr = (int8_t)(r - pr);
+            int8_t dg = (int8_t)(g - pg);
+            int8_t db = (int8_t)(b - pb);
+
+            int8_t dgr = dr - dg;
+            int8_t dgb = db - dg;
+
+            if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+                *dst++ = QOI_OP_DIFF | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2);
+            } else if (dgr >= -8 && dgr <= 7 && dg >= -32 && dg <= 31 && dgb >= -8 && dgb <= 7) {
+                *dst++ = QOI_OP_LUMA | (dg + 32);
+                *dst++ = ((dgr + 8) << 4) | (dgb + 8);
+            } else {
+                *dst++ = QOI_OP_RGB;
+                *dst++ = r;
+                *dst++ = g;
+                *dst++ = b;
+            }
+        }
+
+        previousPixel = pixel;
+        pr = r;
+        pg = g;
+        pb = b;
+    }
+
+    if (run > 0) {
+        *dst++ = QOI_OP_RUN | (run - 1);
+    }
+
+    memcpy(dst, QOI_END_MARKER, sizeof(QOI_END_MARKER));
+    dst += sizeof(QOI_END_MARKER);
+
+    *imageData = VRAM_SCREENSHOOT_JPEG_OUT_BUFFER;
+    *imageDataSize = dst - VRAM_SCREENSHOOT_JPEG_OUT_BUFFER;
+    return 0;
+}
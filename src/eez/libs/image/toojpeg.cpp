@@ -19,6 +19,7 @@ using uint8_t  = unsigned char;
 using uint16_t = unsigned short;
 using  int16_t =          short;
 using  int32_t =          int; // at least four bytes
+using  int64_t =          long long;
 // ////////////////////////////////////////
 // constants
 // quantization tables from JPEG Standard, Annex K
@@ -82,6 +83,11 @@ const uint8_t AcChrominanceValues        [162] =
       0xB5,0xB6,0xB7,0xB8,0xB9,0xBA,0xC2,0xC3,0xC4,0xC5,0xC6,0xC7,0xC8,0xC9,0xCA,0xD2,0xD3,0xD4,0xD5,0xD6,0xD7,0xD8,0xD9,0xDA,
       0xE2,0xE3,0xE4,0xE5,0xE6,0xE7,0xE8,0xE9,0xEA,0xF2,0xF3,0xF4,0xF5,0xF6,0xF7,0xF8,0xF9,0xFA };
 const int16_t CodeWordLimit = 2048; // +/-2^11, maximum value after DCT
+// fixed point arithmetic
+const int32_t ColorBits   = 16; // RGB to YCbCr constants are scaled by 2^16
+const int32_t SampleBits  = 2;  // Y, Cb and Cr samples keep 2 fractional bits, i.e. they are scaled by 4
+const int32_t DctBits     = 12; // DCT constants are scaled by 2^12
+const int32_t QuantBits   = 20; // quantization reciprocals are scaled by 2^20
 // ////////////////////////////////////////
 // structs
 // represent a single Huffman code
@@ -96,10 +102,30 @@ struct BitCode
 // wrapper for bit output operations
 struct BitWriter
 {
-  // user-supplied callback that writes/stores one byte
-  TooJpeg::WRITE_ONE_BYTE output;
+  // user-supplied callback that writes/stores a block of bytes
+  TooJpeg::WRITE_BYTES output;
   // initialize writer
-  explicit BitWriter(TooJpeg::WRITE_ONE_BYTE output_) : output(output_) {}
+  explicit BitWriter(TooJpeg::WRITE_BYTES output_) : output(output_) {}
+  // collect output bytes and pass them in blocks to the user-supplied callback
+  struct OutputCache
+  {
+    uint8_t  data[256];
+    uint16_t size = 0;
+  } cache;
+  // store a single byte in the output cache
+  void put(uint8_t oneByte)
+  {
+    cache.data[cache.size++] = oneByte;
+    if (cache.size == sizeof(cache.data))
+      flushCache();
+  }
+  // pass all cached bytes to the user-supplied callback
+  void flushCache()
+  {
+    if (cache.size > 0)
+      output(cache.data, cache.size);
+    cache.size = 0;
+  }
   // store the most recently encoded bits that are not written yet
   struct BitBuffer
   {
@@ -119,9 +145,9 @@ struct BitWriter
       // extract highest 8 bits
       buffer.numBits -= 8;
       auto oneByte = uint8_t(buffer.data >> buffer.numBits);
-      output(oneByte);
+      put(oneByte);
       if (oneByte == 0xFF) // 0xFF has a special meaning for JPEGs (it's a block marker)
-        output(0);         // therefore pad a zero to indicate "nope, this one ain't a marker, it's just a coincidence"
+        put(0);            // therefore pad a zero to indicate "nope, this one ain't a marker, it's just a coincidence"
       // note: I don't clear those written bits, therefore buffer.bits may contain garbage in the high bits
       //       if you really want to "clean up" (e.g. for debugging purposes) then uncomment the following line
       //buffer.bits &= (1 << buffer.numBits) - 1;
@@ -134,11 +160,11 @@ struct BitWriter
     // at most seven set bits needed to "fill" the last byte: 0x7F = binary 0111 1111
     *this << BitCode(0x7F, 7); // I should set buffer.numBits = 0 but since there are no single bits written after flush() I can safely ignore it
   }
-  // NOTE: all the following BitWriter functions IGNORE the BitBuffer and write straight to output !
+  // NOTE: all the following BitWriter functions IGNORE the BitBuffer and write straight to the output cache !
   // write a single byte
   BitWriter& operator<<(uint8_t oneByte)
   {
-    output(oneByte);
+    put(oneByte);
     return *this;
   }
   // write an array of bytes
@@ -146,15 +172,15 @@ struct BitWriter
   BitWriter& operator<<(T (&manyBytes)[Size])
   {
     for (auto c : manyBytes)
-      output(c);
+      put(c);
     return *this;
   }
   // start a new JFIF block
   void addMarker(uint8_t id, uint16_t length)
   {
-    output(0xFF); output(id);     // ID, always preceded by 0xFF
-    output(uint8_t(length >> 8)); // length of the block (big-endian, includes the 2 length bytes as well)
-    output(uint8_t(length & 0xFF));
+    put(0xFF); put(id);        // ID, always preceded by 0xFF
+    put(uint8_t(length >> 8)); // length of the block (big-endian, includes the 2 length bytes as well)
+    put(uint8_t(length & 0xFF));
   }
 };
 // ////////////////////////////////////////
@@ -174,16 +200,21 @@ Number clamp(Number value, Limit minValue, Limit maxValue)
   return value;                           // value was inside interval, keep it
 }
 // convert from RGB to YCbCr, constants are similar to ITU-R, see https://en.wikipedia.org/wiki/YCbCr#JPEG_conversion
-float rgb2y (float r, float g, float b) { return +0.299f   * r +0.587f   * g +0.114f   * b; }
-float rgb2cb(float r, float g, float b) { return -0.16874f * r -0.33126f * g +0.5f     * b; }
-float rgb2cr(float r, float g, float b) { return +0.5f     * r -0.41869f * g -0.08131f * b; }
+// the constants are scaled by 2^ColorBits and the result keeps SampleBits fractional bits,
+// an additional right shift divides the result by 2^shift (e.g. if r, g and b are the sums of four pixels)
+int32_t descaleColor(int32_t value, int32_t shift) { return (value + (1 << (ColorBits - SampleBits + shift - 1))) >> (ColorBits - SampleBits + shift); }
+int32_t rgb2y (int32_t r, int32_t g, int32_t b, int32_t shift = 0) { return descaleColor(+19595 * r +38470 * g + 7471 * b, shift); }
+int32_t rgb2cb(int32_t r, int32_t g, int32_t b, int32_t shift = 0) { return descaleColor(-11059 * r -21709 * g +32768 * b, shift); }
+int32_t rgb2cr(int32_t r, int32_t g, int32_t b, int32_t shift = 0) { return descaleColor(+32768 * r -27439 * g - 5329 * b, shift); }
+// fixed point multiplication with a DCT constant (scaled by 2^DctBits)
+int32_t multiply(int32_t value, int32_t constant) { return (value * constant + (1 << (DctBits - 1))) >> DctBits; }
 // forward DCT computation "in one dimension" (fast AAN algorithm by Arai, Agui and Nakajima: "A fast DCT-SQ scheme for images")
-void DCT(float block[8*8], uint8_t stride) // stride must be 1 (=horizontal) or 8 (=vertical)
+void DCT(int32_t block[8*8], uint8_t stride) // stride must be 1 (=horizontal) or 8 (=vertical)
 {
-  const auto SqrtHalfSqrt = 1.306562965f; //    sqrt((2 + sqrt(2)) / 2) = cos(pi * 1 / 8) * sqrt(2)
-  const auto InvSqrt      = 0.707106781f; // 1 / sqrt(2)                = cos(pi * 2 / 8)
-  const auto HalfSqrtSqrt = 0.382683432f; //     sqrt(2 - sqrt(2)) / 2  = cos(pi * 3 / 8)
-  const auto InvSqrtSqrt  = 0.541196100f; // 1 / sqrt(2 - sqrt(2))      = cos(pi * 3 / 8) * sqrt(2)
+  const int32_t SqrtHalfSqrt = 5352; //    sqrt((2 + sqrt(2)) / 2) = cos(pi * 1 / 8) * sqrt(2) = 1.306562965 * 2^12
+  const int32_t InvSqrt      = 2896; // 1 / sqrt(2)                = cos(pi * 2 / 8)           = 0.707106781 * 2^12
+  const int32_t HalfSqrtSqrt = 1567; //     sqrt(2 - sqrt(2)) / 2  = cos(pi * 3 / 8)           = 0.382683432 * 2^12
+  const int32_t InvSqrtSqrt  = 2217; // 1 / sqrt(2 - sqrt(2))      = cos(pi * 3 / 8) * sqrt(2) = 0.541196100 * 2^12
   // modify in-place
   auto& block0 = block[0         ];
   auto& block1 = block[1 * stride];
@@ -193,7 +224,7 @@ void DCT(float block[8*8], uint8_t stride) // stride must be 1 (=horizontal) or
   auto& block5 = block[5 * stride];
   auto& block6 = block[6 * stride];
   auto& block7 = block[7 * stride];
-  // based on https://dev.w3.org/Amaya/libjpeg/jfdctflt.c , the original variable names can be found in my comments
+  // based on https://dev.w3.org/Amaya/libjpeg/jfdctflt.c (and its fixed point sibling jfdctfst.c), the original variable names can be found in my comments
   auto add07 = block0 + block7; auto sub07 = block0 - block7; // tmp0, tmp7
   auto add16 = block1 + block6; auto sub16 = block1 - block6; // tmp1, tmp6
   auto add25 = block2 + block5; auto sub25 = block2 - block5; // tmp2, tmp5
@@ -201,45 +232,47 @@ void DCT(float block[8*8], uint8_t stride) // stride must be 1 (=horizontal) or
   auto add0347 = add07 + add34; auto sub07_34 = add07 - add34; // tmp10, tmp13 ("even part" / "phase 2")
   auto add1256 = add16 + add25; auto sub16_25 = add16 - add25; // tmp11, tmp12
   block0 = add0347 + add1256; block4 = add0347 - add1256; // "phase 3"
-  auto z1 = (sub16_25 + sub07_34) * InvSqrt; // all temporary z-variables kept their original names
+  auto z1 = multiply(sub16_25 + sub07_34, InvSqrt); // all temporary z-variables kept their original names
   block2 = sub07_34 + z1; block6 = sub07_34 - z1; // "phase 5"
   auto sub23_45 = sub25 + sub34; // tmp10 ("odd part" / "phase 2")
   auto sub12_56 = sub16 + sub25; // tmp11
   auto sub01_67 = sub16 + sub07; // tmp12
-  auto z5 = (sub23_45 - sub01_67) * HalfSqrtSqrt;
-  auto z2 = sub23_45 * InvSqrtSqrt  + z5;
-  auto z3 = sub12_56 * InvSqrt;
-  auto z4 = sub01_67 * SqrtHalfSqrt + z5;
+  auto z5 = multiply(sub23_45 - sub01_67, HalfSqrtSqrt);
+  auto z2 = multiply(sub23_45, InvSqrtSqrt ) + z5;
+  auto z3 = multiply(sub12_56, InvSqrt);
+  auto z4 = multiply(sub01_67, SqrtHalfSqrt) + z5;
   auto z6 = sub07 + z3; // z11 ("phase 5")
   auto z7 = sub07 - z3; // z13
   block1 = z6 + z4; block7 = z6 - z4; // "phase 6"
   block5 = z7 + z2; block3 = z7 - z2;
 }
+// multiply by the quantization reciprocal (scaled by 2^QuantBits) and round to the nearest integer
+// note: exact halves are rounded up (towards +infinity) which avoids a branch and doesn't make a visible difference
+int16_t quantize(int32_t value, int32_t reciprocal)
+{
+  return int16_t((int64_t(value) * reciprocal + (int64_t(1) << (QuantBits - 1))) >> QuantBits);
+}
 // run DCT, quantize and write Huffman bit codes
-int16_t encodeBlock(BitWriter& writer, float block[8][8], const float scaled[8*8], int16_t lastDC,
+int16_t encodeBlock(BitWriter& writer, int32_t block[8][8], const int32_t reciprocals[8*8], int16_t lastDC,
                     const BitCode huffmanDC[256], const BitCode huffmanAC[256], const BitCode* codewords)
 {
-  // "linearize" the 8x8 block, treat it as a flat array of 64 floats
-  auto block64 = (float*) block;
+  // "linearize" the 8x8 block, treat it as a flat array of 64 integers
+  auto block64 = (int32_t*) block;
   // DCT: rows
   for (auto offset = 0; offset < 8; offset++)
     DCT(block64 + offset*8, 1);
   // DCT: columns
   for (auto offset = 0; offset < 8; offset++)
     DCT(block64 + offset*1, 8);
-  // scale
-  for (auto i = 0; i < 8*8; i++)
-    block64[i] *= scaled[i];
   // encode DC (the first coefficient is the "average color" of the 8x8 block)
-  auto DC = int(block64[0] + (block64[0] >= 0 ? +0.5f : -0.5f)); // C++11's nearbyint() achieves a similar effect
+  auto DC = quantize(block64[0], reciprocals[0]); // scale and round to nearest integer
   // quantize and zigzag the other 63 coefficients
   auto posNonZero = 0; // find last coefficient which is not zero (because trailing zeros are encoded differently)
   int16_t quantized[8*8];
   for (auto i = 1; i < 8*8; i++) // start at 1 because block64[0]=DC was already processed
   {
-    auto value = block64[ZigZagInv[i]];
-    // round to nearest integer
-    quantized[i] = int(value + (value >= 0 ? +0.5f : -0.5f)); // C++11's nearbyint() achieves a similar effect
+    // scale and round to nearest integer
+    quantized[i] = quantize(block64[ZigZagInv[i]], reciprocals[ZigZagInv[i]]);
     // remember offset of last non-zero coefficient
     if (quantized[i] != 0)
       posNonZero = i;
@@ -299,7 +332,7 @@ void generateHuffmanTable(const uint8_t numCodes[16], const uint8_t* values, Bit
 namespace TooJpeg
 {
 // the only exported function ...
-bool writeJpeg(WRITE_ONE_BYTE output, const void* pixels_, unsigned short width, unsigned short height,
+bool writeJpeg(WRITE_BYTES output, const void* pixels_, unsigned short width, unsigned short height,
                bool isRGB, unsigned char quality_, bool downsample, const char* comment)
 {
   // reject invalid pointers
@@ -432,21 +465,19 @@ bool writeJpeg(WRITE_ONE_BYTE output, const void* pixels_, unsigned short width,
   bitWriter << Spectral;
   // ////////////////////////////////////////
   // adjust quantization tables with AAN scaling factors to simplify DCT
-  float scaledLuminance  [8*8];
-  float scaledChrominance[8*8];
+  // and convert them to fixed point reciprocals, so that quantization becomes a multiplication
+  int32_t reciprocalLuminance  [8*8];
+  int32_t reciprocalChrominance[8*8];
   for (auto i = 0; i < 8*8; i++)
   {
     auto row    = ZigZagInv[i] / 8; // same as ZigZagInv[i] >> 3
     auto column = ZigZagInv[i] % 8; // same as ZigZagInv[i] &  7
     // scaling constants for AAN DCT algorithm: AanScaleFactors[0] = 1, AanScaleFactors[k=1..7] = cos(k*PI/16) * sqrt(2)
     static const float AanScaleFactors[8] = { 1, 1.387039845f, 1.306562965f, 1.175875602f, 1, 0.785694958f, 0.541196100f, 0.275899379f };
-    auto factor = 1 / (AanScaleFactors[row] * AanScaleFactors[column] * 8);
-    scaledLuminance  [ZigZagInv[i]] = factor / quantLuminance  [i];
-    scaledChrominance[ZigZagInv[i]] = factor / quantChrominance[i];
-    // if you really want JPEGs that are bitwise identical to Jon Olick's code then you need slightly different formulas (note: sqrt(8) = 2.828427125f)
-    //static const float aasf[] = { 1.0f * 2.828427125f, 1.387039845f * 2.828427125f, 1.306562965f * 2.828427125f, 1.175875602f * 2.828427125f, 1.0f * 2.828427125f, 0.785694958f * 2.828427125f, 0.541196100f * 2.828427125f, 0.275899379f * 2.828427125f }; // line 240 of jo_jpeg.cpp
-    //scaledLuminance  [ZigZagInv[i]] = 1 / (quantLuminance  [i] * aasf[row] * aasf[column]); // lines 266-267 of jo_jpeg.cpp
-    //scaledChrominance[ZigZagInv[i]] = 1 / (quantChrominance[i] * aasf[row] * aasf[column]);
+    // note: DCT input samples have SampleBits fractional bits, these are removed here as well
+    auto factor = (1 << QuantBits) / (AanScaleFactors[row] * AanScaleFactors[column] * 8 * (1 << SampleBits));
+    reciprocalLuminance  [ZigZagInv[i]] = int32_t(factor / quantLuminance  [i] + 0.5f);
+    reciprocalChrominance[ZigZagInv[i]] = int32_t(factor / quantChrominance[i] + 0.5f);
   }
   // ////////////////////////////////////////
   // precompute JPEG codewords for quantized DCT
@@ -477,7 +508,7 @@ bool writeJpeg(WRITE_ONE_BYTE output, const void* pixels_, unsigned short width,
   // average color of the previous MCU
   int16_t lastYDC = 0, lastCbDC = 0, lastCrDC = 0;
   // convert from RGB to YCbCr
-  float Y[8][8], Cb[8][8], Cr[8][8];
+  int32_t Y[8][8], Cb[8][8], Cr[8][8];
   for (auto mcuY = 0; mcuY < height; mcuY += mcuSize) // each step is either 8 or 16 (=mcuSize)
     for (auto mcuX = 0; mcuX < width; mcuX += mcuSize)
     {
@@ -500,14 +531,14 @@ bool writeJpeg(WRITE_ONE_BYTE output, const void* pixels_, unsigned short width,
               // grayscale images have solely a Y channel which can be easily derived from the input pixel by shifting it by 128
               if (!isRGB)
               {
-                Y[deltaY][deltaX] = pixels[pixelPos] - 128.f;
+                Y[deltaY][deltaX] = (pixels[pixelPos] - 128) << SampleBits;
                 continue;
               }
               // RGB: 3 bytes per pixel (whereas grayscale images have only 1 byte per pixel)
               auto r = pixels[3 * pixelPos    ];
               auto g = pixels[3 * pixelPos + 1];
               auto b = pixels[3 * pixelPos + 2];
-              Y   [deltaY][deltaX] = rgb2y (r, g, b) - 128; // again, the JPEG standard requires Y to be shifted by 128
+              Y   [deltaY][deltaX] = rgb2y (r, g, b) - (128 << SampleBits); // again, the JPEG standard requires Y to be shifted by 128
               // YCbCr444 is easy - the more complex YCbCr420 has to be computed about 20 lines below in a second pass
               if (!downsample)
               {
@@ -517,7 +548,7 @@ bool writeJpeg(WRITE_ONE_BYTE output, const void* pixels_, unsigned short width,
             }
           }
         // encode Y channel
-        lastYDC = encodeBlock(bitWriter, Y, scaledLuminance, lastYDC, huffmanLuminanceDC, huffmanLuminanceAC, codewords);
+        lastYDC = encodeBlock(bitWriter, Y, reciprocalLuminance, lastYDC, huffmanLuminanceDC, huffmanLuminanceAC, codewords);
         // Cb and Cr are encoded about 50 lines below
       }
       // grayscale images don't need any Cb and Cr information
@@ -546,8 +577,8 @@ bool writeJpeg(WRITE_ONE_BYTE output, const void* pixels_, unsigned short width,
             auto g = short(pixels[pixelPos + 1]) + pixels[right + 1] + pixels[down + 1] + pixels[downRight + 1];
             auto b = short(pixels[pixelPos + 2]) + pixels[right + 2] + pixels[down + 2] + pixels[downRight + 2];
             // convert to Cb and Cr
-            Cb[deltaY][deltaX] = rgb2cb(r, g, b) / 4; // I still have to divide r,g,b by 4 to get their average values
-            Cr[deltaY][deltaX] = rgb2cr(r, g, b) / 4; // it's a bit faster if done AFTER CbCr conversion
+            Cb[deltaY][deltaX] = rgb2cb(r, g, b, 2); // I still have to divide r,g,b by 4 to get their average values
+            Cr[deltaY][deltaX] = rgb2cr(r, g, b, 2); // it's a bit faster if done AFTER CbCr conversion (as part of the final shift)
             // step forward to next 2x2 area
             pixelPos += 2*3; // 2 pixels => 6 bytes (2*numComponents)
             column   += 2;
@@ -560,13 +591,14 @@ bool writeJpeg(WRITE_ONE_BYTE output, const void* pixels_, unsigned short width,
           }
         } // end of YCbCr420 code for Cb and Cr
       // encode Cb and Cr
-      lastCbDC = encodeBlock(bitWriter, Cb, scaledChrominance, lastCbDC, huffmanChrominanceDC, huffmanChrominanceAC, codewords);
-      lastCrDC = encodeBlock(bitWriter, Cr, scaledChrominance, lastCrDC, huffmanChrominanceDC, huffmanChrominanceAC, codewords);
+      lastCbDC = encodeBlock(bitWriter, Cb, reciprocalChrominance, lastCbDC, huffmanChrominanceDC, huffmanChrominanceAC, codewords);
+      lastCrDC = encodeBlock(bitWriter, Cr, reciprocalChrominance, lastCrDC, huffmanChrominanceDC, huffmanChrominanceAC, codewords);
     }
   bitWriter.flush(); // now image is completely encoded, write any bits still left in the buffer
   // ///////////////////////////
   // EOI marker
   bitWriter << 0xFF << 0xD9; // this marker has no length, therefore I can't use addMarker()
+  bitWriter.flushCache();    // pass the remaining bytes to the user-supplied callback
   return true;
 } // writeJpeg()
 } // namespace TooJpeg
\ No newline at end of file
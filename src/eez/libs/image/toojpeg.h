@@ -9,26 +9,26 @@
 // basic example:
 // => create an image with any content you like, e.g. 1024x768, RGB = 3 bytes per pixel
 // auto pixels = new unsigned char[1024*768*3];
-// => you need to define a callback that receives the compressed data byte-by-byte from my JPEG writer
-// void myOutput(unsigned char oneByte) { fputc(oneByte, myFileHandle); } // save byte to file
+// => you need to define a callback that receives the compressed data block-by-block from my JPEG writer
+// void myOutput(const unsigned char* data, unsigned int size) { fwrite(data, 1, size, myFileHandle); } // save block to file
 // => let's go !
 // TooJpeg::writeJpeg(myOutput, mypixels, 1024, 768);
 #pragma once
 namespace TooJpeg
 {
-  // write one byte (to disk, memory, ...)
-  typedef void (*WRITE_ONE_BYTE)(unsigned char);
-  // this callback is called for every byte generated by the encoder and behaves similar to fputc
+  // write a block of bytes (to disk, memory, ...)
+  typedef void (*WRITE_BYTES)(const unsigned char* data, unsigned int size);
+  // this callback is called whenever the encoder's internal output buffer is full (and once more at the end) and behaves similar to fwrite
   // if you prefer stylish C++11 syntax then it can be a lambda, too:
-  // auto myOutput = [](unsigned char oneByte) { fputc(oneByte, output); };
-  // output       - callback that stores a single byte (writes to disk, memory, ...)
+  // auto myOutput = [](const unsigned char* data, unsigned int size) { fwrite(data, 1, size, output); };
+  // output       - callback that stores a block of bytes (writes to disk, memory, ...)
   // pixels       - stored in RGB format or grayscale, stored from upper-left to lower-right
   // width,height - image size
   // isRGB        - true if RGB format (3 bytes per pixel); false if grayscale (1 byte per pixel)
   // quality      - between 1 (worst) and 100 (best)
   // downsample   - if true then YCbCr 4:2:0 format is used (smaller size, minor quality loss) instead of 4:4:4, not relevant for grayscale
   // comment      - optional JPEG comment (0/NULL if no comment), must not contain ASCII code 0xFF
-  bool writeJpeg(WRITE_ONE_BYTE output, const void* pixels, unsigned short width, unsigned short height,
+  bool writeJpeg(WRITE_BYTES output, const void* pixels, unsigned short width, unsigned short height,
                  bool isRGB = true, unsigned char quality = 90, bool downsample = false, const char* comment = nullptr);
 } // namespace TooJpeg
 // My main inspiration was Jon Olick's Minimalistic JPEG writer
@@ -39,9 +39,12 @@ namespace TooJpeg
 // Therefore I wrote the whole lib from scratch and tried hard to add tons of comments to my code, especially describing where all those magic numbers come from.
 // And I managed to remove the need for any external includes ...
 // yes, that's right: my library has no (!) includes at all, not even #include <stdlib.h>
-// Depending on your callback WRITE_ONE_BYTE, the library writes either to disk, or in-memory, or wherever you wish.
+// Depending on your callback WRITE_BYTES, the library writes either to disk, or in-memory, or wherever you wish.
 // Moreover, no dynamic memory allocations are performed, just a few bytes on the stack.
 //
+// Modified for the EEZ firmware: the DCT, color conversion and quantization use fixed point integer arithmetic
+// and the output is handed over in blocks of 256 bytes instead of calling the callback for every single byte.
+//
 // In contrast to Jon's code, compression can be significantly improved in many use cases:
 // a) grayscale JPEG images need just a single Y channel, no need to save the superfluous Cb + Cr channels
 // b) YCbCr 4:2:0 downsampling is often about 20% more efficient (=smaller) than the default YCbCr 4:4:4 with only little visual loss
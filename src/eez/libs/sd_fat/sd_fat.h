@@ -96,6 +96,7 @@ struct FileInfo {
 #else
     std::string m_parentPath;
     struct dirent *m_dirent;
+    struct dirent m_fstatDirent; // used by fstat, which has no open directory
 #endif
 };
 
@@ -55,9 +55,30 @@ FileInfo::FileInfo() {
 #endif
 }
 
+std::string getRealPath(const char *path);
+
 SdFatResult FileInfo::fstat(const char *filePath) {
+#if defined(EEZ_PLATFORM_SIMULATOR_WIN32)
     Directory dir;
     return dir.findFirst(filePath, *this);
+#else
+    // findFirst does opendir, which fails for files, so stat the path directly
+    std::string path = getRealPath(filePath);
+    struct stat stbuf;
+    if (stat(path.c_str(), &stbuf) != 0) {
+        return SD_FAT_RESULT_NO_FILE;
+    }
+
+    size_t i = path.find_last_of('/');
+    m_parentPath = i == std::string::npos ? "." : path.substr(0, i);
+
+    memset(&m_fstatDirent, 0, sizeof(m_fstatDirent));
+    strncpy(m_fstatDirent.d_name, i == std::string::npos ? path.c_str() : path.c_str() + i + 1,
+            sizeof(m_fstatDirent.d_name) - 1);
+    m_dirent = &m_fstatDirent;
+
+    return SD_FAT_RESULT_OK;
+#endif
 }
 
 std::string getRealPath(const char *path) {
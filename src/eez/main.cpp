@@ -18,6 +18,8 @@
 
 #include <assert.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #if defined(EEZ_PLATFORM_STM32)
 #include <main.h>
@@ -51,6 +53,7 @@
 #include <eez/modules/psu/psu.h>
 #include <eez/modules/psu/serial_psu.h>
 #include <eez/modules/psu/sd_card.h>
+#include <eez/modules/psu/io_pins.h>
 
  ////////////////////////////////////////////////////////////////////////////////
 
@@ -94,6 +97,18 @@ int main(int argc, char **argv) {
     startEmscripten();
 #else
 
+#if defined(EEZ_PLATFORM_SIMULATOR)
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--virtual-time") == 0) {
+            osKernelSetVirtualTime(true);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            eez::psu::simulator::setSeed((uint32_t)strtoul(argv[++i], nullptr, 10));
+        } else if (strcmp(argv[i], "--start-time") == 0 && i + 1 < argc) {
+            osKernelSetStartTime((uint64_t)(strtod(argv[++i], nullptr) * 1000000));
+        }
+    }
+#endif
+
 #if defined(EEZ_PLATFORM_STM32)
 	if (RCC->CSR & RCC_CSR_IWDGRSTF) {	
 		/* Reset by IWDG */
@@ -147,6 +162,14 @@ int main(int argc, char **argv) {
         osDelay(100);
     }
 
+#if defined(EEZ_PLATFORM_SIMULATOR)
+    if (osKernelIsVirtualTime()) {
+        float virtualTime = osKernelVirtualTime() / 1000000.0f;
+        float realTime = osKernelRealTime() / 1000000.0f;
+        printf("Virtual time: %.3f s, real time: %.3f s, speed-up: %.1fx\n", virtualTime, realTime, realTime > 0 ? virtualTime / realTime : 0.0f);
+    }
+#endif
+
 #endif
 
     return 0;
@@ -201,6 +224,9 @@ extern "C" void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin) {
         return;
     } else if (GPIO_Pin == ENC_A_Pin || GPIO_Pin == ENC_B_Pin) {
         eez::mcu::encoder::onPinInterrupt();
+    } else if (GPIO_Pin == DIN2_Pin) {
+        eez::psu::io_pins::onInputPinInterrupt(EXT_TRIG2);
+        return;
     }
 
     if (slotIndex != -1) {
@@ -216,6 +242,8 @@ void consoleInputTask(const void *) {
     osMessagePut(eez::scpi::g_scpiMessageQueueId, SCPI_QUEUE_SERIAL_MESSAGE(SERIAL_LINE_STATE_CHANGED, 1), osWaitForever);
 
     while (1) {
+        // osMessagePut can wait in osDelay when SCPI queue is full
+        osThreadLeaveVirtualTime();
         int ch = getchar();
         if (ch == EOF) {
             break;
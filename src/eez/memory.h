@@ -31,15 +31,20 @@ static uint8_t * const MEMORY_BEGIN = g_memory;
 static const uint32_t MEMORY_SIZE = 64 * 1024 * 1024;
 #endif
 
+// all assets except bitmaps, i.e. section 0 of the assets, see gui/assets.cpp
 static uint8_t * const DECOMPRESSED_ASSETS_START_ADDRESS = MEMORY_BEGIN;
+static const uint32_t DECOMPRESSED_ASSETS_SIZE = 576 * 1024;
+
+// bitmaps decompressed on first use, see getBitmap() in gui/assets.cpp
+static uint8_t * const BITMAP_CACHE = DECOMPRESSED_ASSETS_START_ADDRESS + DECOMPRESSED_ASSETS_SIZE;
 #if defined(EEZ_PLATFORM_STM32)
-static const uint32_t DECOMPRESSED_ASSETS_SIZE = 3 * 512 * 1024;
+static const uint32_t BITMAP_CACHE_SIZE = 640 * 1024;
 #endif
 #if defined(EEZ_PLATFORM_SIMULATOR)
-static const uint32_t DECOMPRESSED_ASSETS_SIZE = 6 * 1024 * 1024;
+static const uint32_t BITMAP_CACHE_SIZE = 5 * 1024 * 1024;
 #endif
 
-static uint8_t * const DLOG_RECORD_BUFFER = DECOMPRESSED_ASSETS_START_ADDRESS + DECOMPRESSED_ASSETS_SIZE;
+static uint8_t * const DLOG_RECORD_BUFFER = BITMAP_CACHE + BITMAP_CACHE_SIZE;
 static const uint32_t DLOG_RECORD_BUFFER_SIZE = 128 * 1024;
 
 static uint8_t * const FILE_VIEW_BUFFER = DLOG_RECORD_BUFFER + DLOG_RECORD_BUFFER_SIZE;
@@ -53,10 +58,15 @@ static const uint32_t FILE_VIEW_BUFFER_SIZE = 3 * 512 * 1024;
 static uint8_t * const MP_BUFFER = FILE_VIEW_BUFFER + FILE_VIEW_BUFFER_SIZE;
 static const uint32_t MP_BUFFER_SIZE = 512 * 1024;
 
-static uint8_t * const SOUND_TUNES_MEMORY = MP_BUFFER + MP_BUFFER_SIZE;
-static const uint32_t SOUND_TUNES_MEMORY_SIZE = 32 * 1024;
+// bytecode of the last compiled MicroPython script, see mp.cpp
+static uint8_t * const MP_SCRIPT_CACHE = MP_BUFFER + MP_BUFFER_SIZE;
+static const uint32_t MP_SCRIPT_CACHE_SIZE = 32 * 1024;
+
+// sound: DAC DMA ping-pong buffer, mixer fills one half while the other half is played
+static uint8_t * const SOUND_BUFFER = MP_SCRIPT_CACHE + MP_SCRIPT_CACHE_SIZE;
+static const uint32_t SOUND_BUFFER_SIZE = 2 * 256;
 
-static uint8_t * const FILE_MANAGER_MEMORY = SOUND_TUNES_MEMORY + SOUND_TUNES_MEMORY_SIZE;
+static uint8_t * const FILE_MANAGER_MEMORY = SOUND_BUFFER + SOUND_BUFFER_SIZE;
 static const uint32_t FILE_MANAGER_MEMORY_SIZE = 512 * 1024;
 
 static uint8_t * const VRAM_SCREENSHOOT_JPEG_OUT_BUFFER = FILE_MANAGER_MEMORY + FILE_MANAGER_MEMORY_SIZE;
@@ -65,6 +75,23 @@ static const uint32_t VRAM_SCREENSHOOT_JPEG_OUT_BUFFER_SIZE = 256 * 1024;
 static uint8_t * const SCREENSHOOT_BUFFER_START_ADDRESS = VRAM_SCREENSHOOT_JPEG_OUT_BUFFER + VRAM_SCREENSHOOT_JPEG_OUT_BUFFER_SIZE;
 static const uint32_t SCREENSHOOT_BUFFER_SIZE = 480 * 272 * 3;
 
+// remote display: RGB565 copy of the visible frame followed by the tile encoder state
+static uint8_t * const REMOTE_DISPLAY_MEMORY = SCREENSHOOT_BUFFER_START_ADDRESS + SCREENSHOOT_BUFFER_SIZE;
+static const uint32_t REMOTE_DISPLAY_FRAME_BUFFER_SIZE = 480 * 272 * 2;
+static const uint32_t REMOTE_DISPLAY_MEMORY_SIZE = REMOTE_DISPLAY_FRAME_BUFFER_SIZE + 64 * 1024;
+
+// channel min/max history: CH_MAX channels * CHANNEL_HISTORY_NUM_LEVELS * CHANNEL_HISTORY_SIZE buckets
+static uint8_t * const CHANNEL_HISTORY_MEMORY = REMOTE_DISPLAY_MEMORY + REMOTE_DISPLAY_MEMORY_SIZE;
+static const uint32_t CHANNEL_HISTORY_MEMORY_SIZE = 6 * 6 * 512 * 16;
+
+// measurement stream: samples queue filled by the PSU thread followed by the send buffer
+static uint8_t * const STREAM_MEMORY = CHANNEL_HISTORY_MEMORY + CHANNEL_HISTORY_MEMORY_SIZE;
+static const uint32_t STREAM_MEMORY_SIZE = 4096 * 16 + 4096;
+
+// dlog export: read and write buffers used while converting dlog file to CSV or binary
+static uint8_t * const DLOG_EXPORT_MEMORY = STREAM_MEMORY + STREAM_MEMORY_SIZE;
+static const uint32_t DLOG_EXPORT_MEMORY_SIZE = 64 * 1024;
+
 #if defined(EEZ_PLATFORM_STM32)
 static const uint32_t DISPLAY_WIDTH = 480;
 static const uint32_t DISPLAY_HEIGHT = 272;
@@ -77,7 +104,7 @@ static const uint32_t DISPLAY_HEIGHT = 563;
 static const uint32_t VRAM_BUFFER_SIZE = DISPLAY_WIDTH * DISPLAY_HEIGHT * 4; // RGBA8888
 #endif
 
-static uint8_t * const VRAM_BUFFER1_START_ADDRESS = SCREENSHOOT_BUFFER_START_ADDRESS + SCREENSHOOT_BUFFER_SIZE;
+static uint8_t * const VRAM_BUFFER1_START_ADDRESS = DLOG_EXPORT_MEMORY + DLOG_EXPORT_MEMORY_SIZE;
 static uint8_t * const VRAM_BUFFER2_START_ADDRESS = VRAM_BUFFER1_START_ADDRESS + VRAM_BUFFER_SIZE;
 
 // used for animation
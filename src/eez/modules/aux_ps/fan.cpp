@@ -28,9 +28,7 @@
 
 #include <eez/system.h>
 
-#if defined(EEZ_PLATFORM_STM32)
-#include <i2c.h>
-#endif
+#include <eez/platform/stm32/i2c.h>
 
 #include <eez/modules/psu/psu.h>
 #include <eez/modules/psu/gui/psu.h>
@@ -60,8 +58,6 @@ int g_rpm = 0;
 
 ////////////////////////////////////////////////////////////////////////////////
 
-#if defined(EEZ_PLATFORM_STM32)
-
 // MAX31760
 // Precision Fan-Speed Controller with Nonvolatile Lookup Table
 // https://datasheets.maximintegrated.com/en/ds/MAX31760.pdf
@@ -170,82 +166,69 @@ PWMMeasurement g_pwmMeasurement;
 
 ////////////////////////////////////////////////////////////////////////////////
 
-HAL_StatusTypeDef readReg(uint8_t reg, uint8_t *value) {
-	taskENTER_CRITICAL();
-    HAL_StatusTypeDef returnValue = HAL_I2C_Master_Transmit(&hi2c1, MAX31760_DEVICE_ADDRESS, &reg, 1, 5);
-	taskEXIT_CRITICAL();
-    if (returnValue != HAL_OK) {
-    	return returnValue;
+bool readReg(uint8_t reg, uint8_t *value) {
+    if (!psu::i2c::transmit(MAX31760_DEVICE_ADDRESS, &reg, 1, 5)) {
+    	return false;
     }
 
-	taskENTER_CRITICAL();
-    returnValue = HAL_I2C_Master_Receive(&hi2c1, MAX31760_DEVICE_ADDRESS, value, 1, 5);
-	taskEXIT_CRITICAL();
-    if (returnValue != HAL_OK) {
-    	return returnValue;
-    }
-
-    return HAL_OK;
+    return psu::i2c::receive(MAX31760_DEVICE_ADDRESS, value, 1, 5);
 }
 
-HAL_StatusTypeDef writeReg(uint8_t reg, uint8_t value) {
+bool writeReg(uint8_t reg, uint8_t value) {
 	uint8_t data[2];
 	data[0] = reg;
 	data[1] = value;
-	taskENTER_CRITICAL();
-    HAL_StatusTypeDef returnValue = HAL_I2C_Master_Transmit(&hi2c1, MAX31760_DEVICE_ADDRESS, data, 2, 5);
-	taskEXIT_CRITICAL();
-	return returnValue;
+	return psu::i2c::transmit(MAX31760_DEVICE_ADDRESS, data, 2, 5);
 }
 
-HAL_StatusTypeDef readTemp(uint8_t reg, float *temp) {
+bool readTemp(uint8_t reg, float *temp) {
 	static const float RESOLUTION = 0.125f;
-	HAL_StatusTypeDef returnValue;
+	bool returnValue;
 
 	int16_t regVal;
 
 	returnValue = readReg(reg + 0, ((uint8_t *)&regVal) + 1); // read MSB
-    if (returnValue != HAL_OK) {
+    if (!returnValue) {
     	return returnValue;
     }
 
 	returnValue = readReg(reg + 1, ((uint8_t *)&regVal) + 0); // read LSB
-    if (returnValue != HAL_OK) {
+    if (!returnValue) {
     	return returnValue;
     }
 
 	*temp = (regVal >> 5) * RESOLUTION;
-	return HAL_OK;
+	return true;
 }
 
-HAL_StatusTypeDef readLocalTemp(float *temp) {
+bool readLocalTemp(float *temp) {
 	return readTemp(REG_LTH, temp);
 }
 
-HAL_StatusTypeDef readRemoteTemp(float *temp) {
+bool readRemoteTemp(float *temp) {
 	return readTemp(REG_RTH, temp);
 }
 
-HAL_StatusTypeDef readRpm(uint8_t reg, int n, float *rpm) {
-	HAL_StatusTypeDef returnValue;
+bool readRpm(uint8_t reg, int n, float *rpm) {
+	bool returnValue;
 
 	uint8_t tch;
 	returnValue = readReg(reg + 0, &tch); // read MSB
-    if (returnValue != HAL_OK) {
+    if (!returnValue) {
     	return returnValue;
     }
 
     uint8_t tcl;
 	returnValue = readReg(reg + 1, &tcl); // read LSB
-    if (returnValue != HAL_OK) {
+    if (!returnValue) {
     	return returnValue;
     }
 
 	*rpm = 60 * 100000 / (tch * 256 + tcl) / n;
-	return HAL_OK;
+	return true;
 }
 
-HAL_StatusTypeDef setPwmFrequency(uint8_t freq) {
+bool setPwmFrequency(uint8_t freq) {
 	g_cr1 = (g_cr1 & 0b11100111) | freq;
 	return writeReg(REG_CR1, (uint8_t)g_cr1);
 }
@@ -255,7 +238,7 @@ enum PwmPolarity {
 	PWM_POLARITY_NEGATIVE
 };
 
-HAL_StatusTypeDef setPwmPolarity(PwmPolarity pwmPolarity) {
+bool setPwmPolarity(PwmPolarity pwmPolarity) {
 	if (pwmPolarity) {
 		g_cr1 |= 0b00000100;
 	} else {
@@ -265,7 +248,7 @@ HAL_StatusTypeDef setPwmPolarity(PwmPolarity pwmPolarity) {
 	return writeReg(REG_CR1, g_cr1);
 }
 
-HAL_StatusTypeDef setStandbyMode(bool enable) {
+bool setStandbyMode(bool enable) {
 	if (enable) {
 		g_cr2 |= 0x80;
 	} else {
@@ -274,7 +257,7 @@ HAL_StatusTypeDef setStandbyMode(bool enable) {
 	return writeReg(REG_CR2, g_cr2);
 }
 
-HAL_StatusTypeDef setFanSpinUp(bool enable) {
+bool setFanSpinUp(bool enable) {
 	if (enable) {
 		g_cr2 |= 0x20;
 	} else {
@@ -283,7 +266,7 @@ HAL_StatusTypeDef setFanSpinUp(bool enable) {
 	return writeReg(REG_CR2, g_cr2);
 }
 
-HAL_StatusTypeDef setDirectFanControl(bool enable) {
+bool setDirectFanControl(bool enable) {
 	if (enable) {
 		g_cr2 |= 0x01;
 	} else {
@@ -292,16 +275,16 @@ HAL_StatusTypeDef setDirectFanControl(bool enable) {
 	return writeReg(REG_CR2, g_cr2);
 }
 
-HAL_StatusTypeDef clearFanFail() {
+bool clearFanFail() {
 	return writeReg(REG_CR3, g_cr3 | 0x80);
 }
 
-HAL_StatusTypeDef setPwmDutyCycleRampRate(uint8_t rampRate) {
+bool setPwmDutyCycleRampRate(uint8_t rampRate) {
 	g_cr3 = (g_cr3 & 0b11001111) | rampRate;
 	return writeReg(REG_CR3, g_cr3);
 }
 
-HAL_StatusTypeDef setTachFull(bool enable) {
+bool setTachFull(bool enable) {
 	if (enable) {
 		g_cr3 |= 0x08;
 	} else {
@@ -310,7 +293,7 @@ HAL_StatusTypeDef setTachFull(bool enable) {
 	return writeReg(REG_CR3, g_cr3);
 }
 
-HAL_StatusTypeDef setPulseStretchEnable(bool enable) {
+bool setPulseStretchEnable(bool enable) {
 	if (enable) {
 		g_cr3 |= 0x04;
 	} else {
@@ -319,7 +302,7 @@ HAL_StatusTypeDef setPulseStretchEnable(bool enable) {
 	return writeReg(REG_CR3, g_cr3);
 }
 
-HAL_StatusTypeDef setTach2Enable(bool enable) {
+bool setTach2Enable(bool enable) {
 	if (enable) {
 		g_cr3 |= 0x02;
 	} else {
@@ -328,7 +311,7 @@ HAL_StatusTypeDef setTach2Enable(bool enable) {
 	return writeReg(REG_CR3, g_cr3);
 }
 
-HAL_StatusTypeDef setTach1Enable(bool enable) {
+bool setTach1Enable(bool enable) {
 	if (enable) {
 		g_cr3 |= 0x01;
 	} else {
@@ -337,12 +320,10 @@ HAL_StatusTypeDef setTach1Enable(bool enable) {
 	return writeReg(REG_CR3, g_cr3);
 }
 
-HAL_StatusTypeDef setPwmDutyCycle(uint8_t dutyCycle) {
+bool setPwmDutyCycle(uint8_t dutyCycle) {
 	return writeReg(REG_PWMR, dutyCycle);
 }
 
-#endif
-
 ////////////////////////////////////////////////////////////////////////////////
 
 void init() {
@@ -350,7 +331,6 @@ void init() {
 	g_fanPID.SetOutputLimits(0, 255);
 	g_fanPID.SetMode(AUTOMATIC);
 
-#if defined(EEZ_PLATFORM_STM32)
 	setStandbyMode(false);
 	clearFanFail();
 	setFanSpinUp(false);
@@ -363,20 +343,13 @@ void init() {
 	setPulseStretchEnable(false);
 	setTach2Enable(false);
 	setTach1Enable(true);
-#endif
 }
 
 bool test() {
-#if defined(EEZ_PLATFORM_STM32)
 	// start testing
 	g_testResult = TEST_NONE;
 	setPwmDutyCycle(CONF_FAN_TEST_PWM);
 	g_fanSpeedLastMeasuredTick = micros();
-#endif
-
-#if defined(EEZ_PLATFORM_SIMULATOR)
-	g_testResult = TEST_OK;
-#endif
 
     return g_testResult == TEST_OK || g_testResult == TEST_NONE;
 }
@@ -398,7 +371,6 @@ void getIMonMax(float &iMonMax, float &iMax) {
 	}
 }
 
-#if defined(EEZ_PLATFORM_STM32)
 void genFanError() {
 	g_testResult = TEST_FAILED;
 	generateError(SCPI_ERROR_FAN_TEST_FAILED);
@@ -435,8 +407,6 @@ void checkTest() {
 	}
 }
 
-#endif
-
 int updateFanSpeed() {
     int newFanSpeedPWM = g_fanSpeedPWM;
 
@@ -456,7 +426,6 @@ int updateFanSpeed() {
             newFanSpeedPWM = 0;
         } else {
         	if (page && page->fanPWMMeasuringInProgress) {
-#if defined(EEZ_PLATFORM_STM32)
         		int rpm;
 				newFanSpeedPWM = g_pwmMeasurement.measurePWM((uint8_t)page->fanSpeedPercentage.getFloat(), rpm);
 				if (rpm != 0) {
@@ -464,11 +433,6 @@ int updateFanSpeed() {
 					page->fanPWMMeasuringInProgress = false;
 					g_rpm = rpm;
 				}
-#else
-                newFanSpeedPWM = FAN_MAX_PWM;
-				page->fanSpeedPWM = newFanSpeedPWM;
-				page->fanPWMMeasuringInProgress = false;
-#endif
         		page->fanSpeedPWM = newFanSpeedPWM;
         	} else {
         		newFanSpeedPWM = fanSpeed;
@@ -478,6 +442,12 @@ int updateFanSpeed() {
         // adjust fan speed depending on max. channel temperature
         float maxChannelTemperature = psu::temperature::getMaxChannelTemperature();
 
+        // heatsink temperature estimated from the output power is ahead of the sensor
+        float maxPredictedChannelTemperature = psu::temperature::getMaxPredictedChannelTemperature();
+        if (maxPredictedChannelTemperature > maxChannelTemperature) {
+            maxChannelTemperature = maxPredictedChannelTemperature;
+        }
+
         float iMonMax, iMax;
         getIMonMax(iMonMax, iMax);
         float Ki = roundPrec(remap(iMonMax * iMonMax, 0, FAN_PID_KI_MIN, iMax * iMax, FAN_PID_KI_MAX), 0.05f);
@@ -507,18 +477,15 @@ int updateFanSpeed() {
 }
 
 void tick(uint32_t tickCount) {
-#if defined(EEZ_PLATFORM_STM32)
     if (g_testResult == TEST_NONE) {
     	// still testing
     	checkTest();
     }
-#endif
 
     if (g_testResult != TEST_OK) {
         return;
     }
 
-#if defined(EEZ_PLATFORM_STM32)
 	int32_t diff = tickCount - g_fanSpeedLastMeasuredTick;
 	if (diff >= FAN_SPEED_MEASURMENT_INTERVAL * 1000L) {
 	    g_fanSpeedLastMeasuredTick = tickCount;
@@ -526,7 +493,7 @@ void tick(uint32_t tickCount) {
 	    if (g_fanSpeedPWM != 0) {
 			if (checkStatus()) {
 				float rpm;
-				if (readRpm(REG_TC1H, CONF_NUM_TACH_PULSES_PER_REVOLUTION, &rpm) == HAL_OK) {
+				if (readRpm(REG_TC1H, CONF_NUM_TACH_PULSES_PER_REVOLUTION, &rpm)) {
 					g_rpm = (int)roundf(rpm);
 					g_pwmMeasurement.addMeasurement(g_fanSpeedPWM, g_rpm);
 				}
@@ -542,16 +509,6 @@ void tick(uint32_t tickCount) {
 	    	}
 	    }
 	}
-#endif
-
-#if defined(EEZ_PLATFORM_SIMULATOR)
-	g_fanSpeedPWM = updateFanSpeed();
-    if (g_fanSpeedPWM != 0) {
-        g_rpm = (int)roundf(remap(1.0f * g_fanSpeedPWM, FAN_MIN_PWM, 500, FAN_MAX_PWM, 3200));
-    } else {
-        g_rpm = 0;
-    }
-#endif
 }
 
 void setPidTunings(double Kp, double Ki, double Kd, int POn) {
@@ -564,12 +521,10 @@ void setPidTunings(double Kp, double Ki, double Kd, int POn) {
 }
 
 float readTemperature() {
-#if defined(EEZ_PLATFORM_STM32)
 	float temperature;
-	if (readLocalTemp(&temperature) == HAL_OK) {
+	if (readLocalTemp(&temperature)) {
 		return roundPrec(temperature, 1.0f);
 	}
-#endif
 	return NAN;
 }
 
@@ -17,6 +17,7 @@
  */
 
 #include <assert.h>
+#include <string.h>
 
 #include "eez/firmware.h"
 #include "eez/system.h"
@@ -57,7 +58,12 @@ bool g_bootloaderMode = false;
 static int g_slotIndex;
 static char g_hexFilePath[MAX_PATH_LENGTH + 1];
 
-#ifdef EEZ_PLATFORM_STM32
+// Slave MCU flash is erased in pages of FLASH_PAGE_SIZE bytes and bootloader
+// Write/Read Memory commands transfer up to FLASH_BLOCK_SIZE bytes at once.
+static const uint32_t FLASH_START_ADDRESS = 0x08000000;
+static const uint32_t FLASH_PAGE_SIZE = 2048;
+static const uint32_t FLASH_BLOCK_SIZE = 256;
+static const uint32_t MAX_FLASH_PAGES = 256;
 
 static const uint8_t CMD_GET = 0x00;
 static const uint8_t CMD_GET_VERSION = 0x01;
@@ -80,8 +86,325 @@ static const uint8_t NACK = 0x1F;
 static const uint32_t SYNC_TIMEOUT = 3000;
 static const uint32_t CMD_TIMEOUT = 100;
 
+#if defined(EEZ_PLATFORM_STM32)
+
 static UART_HandleTypeDef *phuart = &huart7;
 
+static bool uartTransmit(const uint8_t *data, uint16_t size) {
+	return HAL_UART_Transmit(phuart, (uint8_t *)data, size, 20) == HAL_OK;
+}
+
+static bool uartReceive(uint8_t *data, uint16_t size, uint32_t timeout) {
+	return HAL_UART_Receive(phuart, data, size, timeout) == HAL_OK;
+}
+
+#endif
+
+#if defined(EEZ_PLATFORM_SIMULATOR)
+
+// bootloader emulator runs in the calling thread, nothing to protect
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+
+// Emulated STM32 system memory bootloader (USART protocol, AN3155) of the
+// slave MCU, so the same protocol code as on the real hardware is used in the
+// simulator. Slave flash memory is kept between downloads. As on the real MCU,
+// writing to the flash which is not erased fails (NACK) and the time spent on
+// UART transfer and flash erase/programming is emulated.
+struct BootloaderEmulator {
+	static const uint32_t FLASH_SIZE = 64 * 1024;
+	static const uint32_t NUM_PAGES = FLASH_SIZE / FLASH_PAGE_SIZE;
+
+	// 115200 baud, 8 data bits, even parity, 1 start and 1 stop bit
+	static const uint32_t BYTE_TIME_US = 11 * 1000000 / 115200;
+	// STM32F0 datasheet, typical values
+	static const uint32_t PAGE_ERASE_TIME_US = 20000;
+	static const uint32_t HALF_WORD_PROGRAMMING_TIME_US = 50;
+
+	enum State {
+		STATE_SYNC,
+		STATE_COMMAND,
+		STATE_COMMAND_COMPLEMENT,
+		STATE_ADDRESS,
+		STATE_READ_SIZE,
+		STATE_WRITE_DATA,
+		STATE_ERASE
+	};
+
+	uint8_t flash[NUM_SLOTS][FLASH_SIZE];
+	bool flashInitialized[NUM_SLOTS];
+	int slotIndex;
+
+	State state;
+	uint8_t command;
+	uint32_t address;
+	// Write Memory: N, N + 1 data bytes and checksum
+	uint8_t input[1 + FLASH_BLOCK_SIZE + 1];
+	uint32_t inputSize;
+
+	uint8_t output[FLASH_BLOCK_SIZE + 16];
+	uint32_t outputHead;
+	uint32_t outputTail;
+
+	// emulated time not yet spent
+	uint32_t timeUs;
+
+	// BOOT0 is set and slave MCU is reset
+	void reset(int slotIndex_) {
+		slotIndex = slotIndex_;
+		if (!flashInitialized[slotIndex]) {
+			memset(flash[slotIndex], 0xFF, FLASH_SIZE);
+			flashInitialized[slotIndex] = true;
+		}
+		state = STATE_SYNC;
+		outputHead = 0;
+		outputTail = 0;
+		timeUs = 0;
+	}
+
+	void reply(uint8_t data) {
+		assert(outputTail < sizeof(output));
+		output[outputTail++] = data;
+	}
+
+	void nack() {
+		reply(NACK);
+		state = STATE_COMMAND;
+	}
+
+	uint8_t *getFlash(uint32_t address, uint32_t size) {
+		if (address < FLASH_START_ADDRESS || address - FLASH_START_ADDRESS + size > FLASH_SIZE) {
+			return nullptr;
+		}
+		return flash[slotIndex] + address - FLASH_START_ADDRESS;
+	}
+
+	static uint8_t xorAll(const uint8_t *data, uint32_t size) {
+		uint8_t result = 0;
+		for (uint32_t i = 0; i < size; i++) {
+			result ^= data[i];
+		}
+		return result;
+	}
+
+	void receiveByte(uint8_t data) {
+		timeUs += BYTE_TIME_US;
+
+		if (state == STATE_SYNC) {
+			if (data == ENTER_BOOTLOADER) {
+				reply(ACK);
+				state = STATE_COMMAND;
+			}
+		} else if (state == STATE_COMMAND) {
+			command = data;
+			state = STATE_COMMAND_COMPLEMENT;
+		} else if (state == STATE_COMMAND_COMPLEMENT) {
+			if (data != (command ^ CRC_MASK)) {
+				nack();
+			} else {
+				executeCommand();
+			}
+		} else {
+			input[inputSize++] = data;
+			if (state == STATE_ADDRESS) {
+				if (inputSize == 5) {
+					onAddress();
+				}
+			} else if (state == STATE_READ_SIZE) {
+				if (inputSize == 2) {
+					onReadSize();
+				}
+			} else if (state == STATE_WRITE_DATA) {
+				if (inputSize == 1u + input[0] + 2) {
+					onWriteData();
+				}
+			} else if (state == STATE_ERASE) {
+				if (inputSize >= 2) {
+					uint16_t n = (input[0] << 8) | input[1];
+					if (n == 0xFFFF) {
+						if (inputSize == 3) {
+							onMassErase();
+						}
+					} else if (n >= NUM_PAGES) {
+						// bank erase or too many pages
+						nack();
+					} else if (inputSize == 2 + 2 * (n + 1u) + 1) {
+						onPageErase(n + 1);
+					}
+				}
+			}
+		}
+	}
+
+	void executeCommand() {
+		inputSize = 0;
+
+		if (command == CMD_GET) {
+			static const uint8_t commands[] = {
+				CMD_GET, CMD_GET_VERSION, CMD_ID, CMD_READ_MEMORY, CMD_GO, CMD_WRITE_MEMORY,
+				CMD_EXTENDED_ERASE, CMD_WRITE_PROTECT, CMD_WRITE_UNPROTECT, CMD_READOUT_PROTECT, CMD_READOUT_UNPROTECT
+			};
+			reply(ACK);
+			reply(sizeof(commands));
+			reply(0x31); // bootloader version 3.1
+			for (uint32_t i = 0; i < sizeof(commands); i++) {
+				reply(commands[i]);
+			}
+			reply(ACK);
+			state = STATE_COMMAND;
+		} else if (command == CMD_READ_MEMORY || command == CMD_WRITE_MEMORY) {
+			reply(ACK);
+			state = STATE_ADDRESS;
+		} else if (command == CMD_EXTENDED_ERASE) {
+			reply(ACK);
+			state = STATE_ERASE;
+		} else {
+			// not emulated
+			nack();
+		}
+	}
+
+	void onAddress() {
+		if (xorAll(input, 5) != 0) {
+			nack();
+			return;
+		}
+
+		address = (input[0] << 24) | (input[1] << 16) | (input[2] << 8) | input[3];
+		if (!getFlash(address, 1)) {
+			nack();
+			return;
+		}
+
+		reply(ACK);
+		inputSize = 0;
+		state = command == CMD_READ_MEMORY ? STATE_READ_SIZE : STATE_WRITE_DATA;
+	}
+
+	void onReadSize() {
+		uint32_t size = input[0] + 1;
+		uint8_t *memory = getFlash(address, size);
+		if (input[1] != (input[0] ^ CRC_MASK) || !memory) {
+			nack();
+			return;
+		}
+
+		reply(ACK);
+		for (uint32_t i = 0; i < size; i++) {
+			reply(memory[i]);
+		}
+		state = STATE_COMMAND;
+	}
+
+	void onWriteData() {
+		uint32_t size = input[0] + 1;
+		uint8_t *memory = getFlash(address, size);
+		if (xorAll(input, inputSize) != 0 || !memory || (address % 4) != 0) {
+			nack();
+			return;
+		}
+
+		// flash is programmed in half-words, each must be erased before
+		for (uint32_t i = 0; i < size; i += 2) {
+			if (memory[i] != 0xFF || (i + 1 < size && memory[i + 1] != 0xFF)) {
+				DebugTrace("Bootloader emulator: write to not erased flash at %08x\n", address + i);
+				nack();
+				return;
+			}
+		}
+
+		memcpy(memory, input + 1, size);
+		timeUs += (size + 1) / 2 * HALF_WORD_PROGRAMMING_TIME_US;
+
+		reply(ACK);
+		state = STATE_COMMAND;
+	}
+
+	void onMassErase() {
+		if (xorAll(input, 3) != 0) {
+			nack();
+			return;
+		}
+
+		memset(flash[slotIndex], 0xFF, FLASH_SIZE);
+		timeUs += NUM_PAGES * PAGE_ERASE_TIME_US;
+
+		reply(ACK);
+		state = STATE_COMMAND;
+	}
+
+	void onPageErase(uint32_t numPages) {
+		if (xorAll(input, inputSize) != 0) {
+			nack();
+			return;
+		}
+
+		for (uint32_t i = 0; i < numPages; i++) {
+			uint16_t pageNumber = (input[2 + 2 * i] << 8) | input[2 + 2 * i + 1];
+			if (pageNumber >= NUM_PAGES) {
+				nack();
+				return;
+			}
+		}
+
+		for (uint32_t i = 0; i < numPages; i++) {
+			uint16_t pageNumber = (input[2 + 2 * i] << 8) | input[2 + 2 * i + 1];
+			memset(flash[slotIndex] + pageNumber * FLASH_PAGE_SIZE, 0xFF, FLASH_PAGE_SIZE);
+			timeUs += PAGE_ERASE_TIME_US;
+		}
+
+		reply(ACK);
+		state = STATE_COMMAND;
+	}
+
+	// sleep for the emulated time spent so far
+	void wait() {
+		if (timeUs >= 1000) {
+			osDelay(timeUs / 1000);
+			timeUs %= 1000;
+		}
+	}
+
+	bool transmit(const uint8_t *data, uint16_t size) {
+		for (uint16_t i = 0; i < size; i++) {
+			receiveByte(data[i]);
+		}
+		return true;
+	}
+
+	bool receive(uint8_t *data, uint16_t size, uint32_t timeout) {
+		if (outputTail - outputHead < size) {
+			// not enough data, the rest would never come
+			outputHead = outputTail = 0;
+			osDelay(timeout);
+			return false;
+		}
+
+		memcpy(data, output + outputHead, size);
+		outputHead += size;
+		if (outputHead == outputTail) {
+			outputHead = outputTail = 0;
+		}
+
+		timeUs += size * BYTE_TIME_US;
+		wait();
+
+		return true;
+	}
+};
+
+static BootloaderEmulator g_bootloaderEmulator;
+
+static bool uartTransmit(const uint8_t *data, uint16_t size) {
+	return g_bootloaderEmulator.transmit(data, size);
+}
+
+static bool uartReceive(uint8_t *data, uint16_t size, uint32_t timeout) {
+	return g_bootloaderEmulator.receive(data, size, timeout);
+}
+
+#endif
+
 static uint8_t rxData[128];
 
 struct BootloaderInfo {
@@ -104,29 +427,29 @@ struct BootloaderInfo {
 void sendDataAndCRC(uint8_t data) {
 	uint8_t sendData[1];
 	sendData[0] = data;
-	HAL_UART_Transmit(phuart, sendData, 1, 20);
+	uartTransmit(sendData, 1);
 	sendData[0] = CRC_MASK ^ data;
-	HAL_UART_Transmit(phuart, sendData, 1, 20);
+	uartTransmit(sendData, 1);
 }
 
 void sendDataNoCRC(uint8_t data) {
 	uint8_t sendData[1];
 	sendData[0] = data;
-	HAL_UART_Transmit(phuart, sendData, 1, 20);
+	uartTransmit(sendData, 1);
 }
 
 bool execGetCmd(BootloaderInfo &bootloaderInfo) {
 	taskENTER_CRITICAL();
 	sendDataAndCRC(CMD_GET);
-	HAL_StatusTypeDef result = HAL_UART_Receive(phuart, rxData, 2, CMD_TIMEOUT);
-	if (result != HAL_OK || rxData[0] != ACK) {
+	bool result = uartReceive(rxData, 2, CMD_TIMEOUT);
+	if (!result || rxData[0] != ACK) {
 		taskEXIT_CRITICAL();
 		return false;
 	}
-	result = HAL_UART_Receive(phuart, rxData + 2, rxData[1] + 2, CMD_TIMEOUT);
+	result = uartReceive(rxData + 2, rxData[1] + 2, CMD_TIMEOUT);
 	taskEXIT_CRITICAL();
 
-	if (result != HAL_OK || rxData[0] != ACK || rxData[14] != ACK) {
+	if (!result || rxData[0] != ACK || rxData[14] != ACK) {
 		return false;
 	}
 
@@ -164,10 +487,24 @@ bool execGetCmd(BootloaderInfo &bootloaderInfo) {
 	return true;
 }
 
+bool syncWithSlave() {
+    uint32_t startTime = millis();
+    do {
+        taskENTER_CRITICAL();
+        sendDataNoCRC(ENTER_BOOTLOADER);
+        bool result = uartReceive(rxData, 1, 100);
+        taskEXIT_CRITICAL();
+        if (result && rxData[0] == ACK) {
+            return true;
+        }
+    } while (millis() - startTime < SYNC_TIMEOUT);
+    return false;
+}
+
 bool readMemory(uint32_t address, uint8_t *buffer, uint32_t bufferSize) {
 	assert(bufferSize <= 256);
-	
-	uint8_t addressAndCrc[5] = { 
+
+	uint8_t addressAndCrc[5] = {
 		(uint8_t)(address >> 24),
 		(uint8_t)((address >> 16) & 0xFF),
 		(uint8_t)((address >> 8) & 0xFF),
@@ -182,30 +519,30 @@ bool readMemory(uint32_t address, uint8_t *buffer, uint32_t bufferSize) {
 
 	sendDataAndCRC(CMD_READ_MEMORY);
 
-	HAL_StatusTypeDef result = HAL_UART_Receive(phuart, rxData, 1, CMD_TIMEOUT);
-	if (result != HAL_OK || rxData[0] != ACK) {
+	bool result = uartReceive(rxData, 1, CMD_TIMEOUT);
+	if (!result || rxData[0] != ACK) {
 		taskEXIT_CRITICAL();
 		return false;
 	}
 
-	HAL_UART_Transmit(phuart, addressAndCrc, 5, 20);
+	uartTransmit(addressAndCrc, 5);
 
-	result = HAL_UART_Receive(phuart, rxData, 1, CMD_TIMEOUT);
-	if (result != HAL_OK || rxData[0] != ACK) {
+	result = uartReceive(rxData, 1, CMD_TIMEOUT);
+	if (!result || rxData[0] != ACK) {
 		taskEXIT_CRITICAL();
 		return false;
 	}
 
-	HAL_UART_Transmit(phuart, numBytesAndCrc, 2, 20);
+	uartTransmit(numBytesAndCrc, 2);
 
-	result = HAL_UART_Receive(phuart, rxData, 1, CMD_TIMEOUT);
-	if (result != HAL_OK || rxData[0] != ACK) {
+	result = uartReceive(rxData, 1, CMD_TIMEOUT);
+	if (!result || rxData[0] != ACK) {
 		taskEXIT_CRITICAL();
 		return false;
 	}
 
-	result = HAL_UART_Receive(phuart, buffer, bufferSize, CMD_TIMEOUT);
-	if (result != HAL_OK) {
+	result = uartReceive(buffer, bufferSize, CMD_TIMEOUT);
+	if (!result) {
 		taskEXIT_CRITICAL();
 		return false;
 	}
@@ -214,63 +551,41 @@ bool readMemory(uint32_t address, uint8_t *buffer, uint32_t bufferSize) {
 	return true;
 }
 
-#endif
-
-bool syncWithSlave() {
-#if defined(EEZ_PLATFORM_STM32)
-    uint32_t startTime = HAL_GetTick();
-    do {
-        taskENTER_CRITICAL();
-        sendDataNoCRC(ENTER_BOOTLOADER);
-        HAL_StatusTypeDef result = HAL_UART_Receive(phuart, rxData, 1, 100);
-        taskEXIT_CRITICAL();
-        if (result == HAL_OK && rxData[0] == ACK) {
-            return true;
-        }
-    } while (HAL_GetTick() - startTime < SYNC_TIMEOUT);
-    return false;
-#endif
-
-#if defined(EEZ_PLATFORM_SIMULATOR)
-    return true;
-#endif
-}
-
+bool erasePage(uint16_t pageNumber) {
+	// Extended Erase of a single page: number of pages - 1 and page number, both 16-bit MSB first, and checksum
+	uint8_t buffer[5] = {
+		0x00,
+		0x00,
+		(uint8_t)(pageNumber >> 8),
+		(uint8_t)(pageNumber & 0xFF)
+	};
+	buffer[4] = buffer[0] ^ buffer[1] ^ buffer[2] ^ buffer[3];
 
-bool eraseAll() {
-#if defined(EEZ_PLATFORM_STM32)
-    taskENTER_CRITICAL();
+	taskENTER_CRITICAL();
 
 	sendDataAndCRC(CMD_EXTENDED_ERASE);
 
-	HAL_StatusTypeDef result = HAL_UART_Receive(phuart, rxData, 1, CMD_TIMEOUT);
-	if (result != HAL_OK || rxData[0] != ACK) {
+	bool result = uartReceive(rxData, 1, CMD_TIMEOUT);
+	if (!result || rxData[0] != ACK) {
 		taskEXIT_CRITICAL();
 		return false;
 	}
 
-	static uint8_t buffer[3] = { 0xFF, 0xFF, 0x00 };
-	HAL_UART_Transmit(phuart, buffer, 3, 20);
+	uartTransmit(buffer, 5);
 
-	result = HAL_UART_Receive(phuart, rxData, 1, CMD_TIMEOUT);
-	if (result != HAL_OK || rxData[0] != ACK) {
+	result = uartReceive(rxData, 1, CMD_TIMEOUT);
+	if (!result || rxData[0] != ACK) {
 		taskEXIT_CRITICAL();
 		return false;
 	}
 
 	taskEXIT_CRITICAL();
 	return true;
-#endif
-
-#if defined(EEZ_PLATFORM_SIMULATOR)
-    return true;
-#endif
 }
 
 bool writeMemory(uint32_t address, const uint8_t *buffer, uint32_t bufferSize) {
 	assert(bufferSize <= 256);
 
-#if defined(EEZ_PLATFORM_STM32)
     uint8_t addressAndCrc[5] = {
 		(uint8_t)(address >> 24),
 		(uint8_t)((address >> 16) & 0xFF),
@@ -290,38 +605,32 @@ bool writeMemory(uint32_t address, const uint8_t *buffer, uint32_t bufferSize) {
 
 	sendDataAndCRC(CMD_WRITE_MEMORY);
 
-	HAL_StatusTypeDef result = HAL_UART_Receive(phuart, rxData, 1, CMD_TIMEOUT);
-	if (result != HAL_OK || rxData[0] != ACK) {
+	bool result = uartReceive(rxData, 1, CMD_TIMEOUT);
+	if (!result || rxData[0] != ACK) {
 		taskEXIT_CRITICAL();
 		return false;
 	}
 
-	HAL_UART_Transmit(phuart, addressAndCrc, 5, 20);
+	uartTransmit(addressAndCrc, 5);
 
-	result = HAL_UART_Receive(phuart, rxData, 1, CMD_TIMEOUT);
-	if (result != HAL_OK || rxData[0] != ACK) {
+	result = uartReceive(rxData, 1, CMD_TIMEOUT);
+	if (!result || rxData[0] != ACK) {
 		taskEXIT_CRITICAL();
 		return false;
 	}
 
-	HAL_UART_Transmit(phuart, &numBytes, 1, 20);
-	HAL_UART_Transmit(phuart, (uint8_t *)buffer, bufferSize, 20);
-	HAL_UART_Transmit(phuart, &crc, 1, 20);
+	uartTransmit(&numBytes, 1);
+	uartTransmit(buffer, bufferSize);
+	uartTransmit(&crc, 1);
 
-	result = HAL_UART_Receive(phuart, rxData, 1, CMD_TIMEOUT);
-	if (result != HAL_OK || rxData[0] != ACK) {
+	result = uartReceive(rxData, 1, CMD_TIMEOUT);
+	if (!result || rxData[0] != ACK) {
 		taskEXIT_CRITICAL();
 		return false;
 	}
 
 	taskEXIT_CRITICAL();
 	return true;
-#endif
-
-#if defined(EEZ_PLATFORM_SIMULATOR)
-    osDelay(1);
-    return true;
-#endif
 }
 
 void enterBootloaderMode(int slotIndex) {
@@ -372,6 +681,10 @@ void enterBootloaderMode(int slotIndex) {
 
     MX_UART7_Init();
 #endif
+
+#if defined(EEZ_PLATFORM_SIMULATOR)
+    g_bootloaderEmulator.reset(slotIndex);
+#endif
 }
 
 void leaveBootloaderMode() {
@@ -475,71 +788,270 @@ bool start(int slotIndex, const char *hexFilePath, int *err) {
 	return true;
 }
 
-void uploadHexFile() {
-	// uint8_t buffer[256];
-	// if (readMemory(0x08000000, buffer, sizeof(buffer))) {
-	// 	for (size_t i = 0; i < sizeof(buffer) / 16; i++) {
-	// 		for (size_t j = 0; j < 16; j++) {
-	// 			DebugTrace("%02x", (int)buffer[i * 16 + j]);
-	// 		}
-	// 		DebugTrace("\n");
-	// 	}
-	// }
-
-    // uint8_t hour, minute, second;
-    // psu::datetime::getTime(hour, minute, second);
-    // DebugTrace("[%02d:%02d:%02d] Flash started\n", hour, minute, second);
-
-	bool eofReached = false;
-    File file;
-    psu::sd_card::BufferedFileRead bufferedFile(file);
-    size_t totalSize = 0;
-	HexRecord hexRecord;
-	uint32_t addressUpperBits = 0;
+// Hex file is processed in one pass. Hex records are collected into a page
+// buffer and when page is complete it is compared with the slave flash read
+// back. Only if it is different, the page is erased and written in
+// FLASH_BLOCK_SIZE blocks, skipping blocks that are erased, so downloading the
+// same firmware again erases and writes nothing. At the end, pages of the
+// previous firmware not covered by the new image are erased.
+struct FlashPage {
+	bool used;
+	uint32_t address;
+	uint8_t data[FLASH_PAGE_SIZE];
+};
 
-#if OPTION_DISPLAY
-    psu::gui::showProgressPageWithoutAbort("Downloading firmware...");
-#endif
+static FlashPage g_flashPage;
 
-    if (!eraseAll()) {
-		DebugTrace("Failed to erase all!\n");
-		goto Exit;
+// slave flash page read back for comparison
+static uint8_t g_slavePage[FLASH_PAGE_SIZE];
+
+// pages of the image already flushed in this download, if hex records come
+// back to such page it is read back and merged with the new records
+static uint8_t g_pagesInImage[MAX_FLASH_PAGES / 8];
+
+struct FlashStats {
+	uint32_t numPages;
+	uint32_t numPagesWritten;
+	uint32_t numPagesErased;
+	uint32_t numBytesWritten;
+};
+
+static FlashStats g_flashStats;
+
+static bool getPageNumber(uint32_t address, uint32_t &pageNumber) {
+	if (address < FLASH_START_ADDRESS || address - FLASH_START_ADDRESS >= MAX_FLASH_PAGES * FLASH_PAGE_SIZE) {
+		DebugTrace("Invalid address %08x\n", address);
+		return false;
 	}
+	pageNumber = (address - FLASH_START_ADDRESS) / FLASH_PAGE_SIZE;
+	return true;
+}
 
-    if (!file.open(g_hexFilePath, FILE_OPEN_EXISTING | FILE_READ)) {
-		DebugTrace("Can't open firmware hex file!\n");
-		goto Exit;
-    }
+static bool isPageInImage(uint32_t pageNumber) {
+	return (g_pagesInImage[pageNumber / 8] & (1 << (pageNumber % 8))) != 0;
+}
 
-#if OPTION_DISPLAY
-    totalSize = file.size();
-#endif
+static bool readPage(uint32_t address, uint8_t *data) {
+	for (uint32_t offset = 0; offset < FLASH_PAGE_SIZE; offset += FLASH_BLOCK_SIZE) {
+		if (!readMemory(address + offset, data + offset, FLASH_BLOCK_SIZE)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool isErased(const uint8_t *data, uint32_t size) {
+	for (uint32_t i = 0; i < size; i++) {
+		if (data[i] != 0xFF) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool flushPage() {
+	if (!g_flashPage.used) {
+		return true;
+	}
+
+	g_flashPage.used = false;
+
+	uint32_t pageNumber = (g_flashPage.address - FLASH_START_ADDRESS) / FLASH_PAGE_SIZE;
+
+	if (!isPageInImage(pageNumber)) {
+		g_pagesInImage[pageNumber / 8] |= 1 << (pageNumber % 8);
+		g_flashStats.numPages++;
+	}
+
+	// if page can't be read back (e.g. readout protection), write it anyway
+	bool erased = false;
+	if (readPage(g_flashPage.address, g_slavePage)) {
+		if (memcmp(g_slavePage, g_flashPage.data, FLASH_PAGE_SIZE) == 0) {
+			// unchanged
+			return true;
+		}
+		erased = isErased(g_slavePage, FLASH_PAGE_SIZE);
+	}
+
+	if (!erased) {
+		if (!erasePage((uint16_t)pageNumber)) {
+			DebugTrace("Failed to erase page at address %08x\n", g_flashPage.address);
+			return false;
+		}
+		g_flashStats.numPagesErased++;
+	}
+
+	g_flashStats.numPagesWritten++;
+
+	for (uint32_t offset = 0; offset < FLASH_PAGE_SIZE; offset += FLASH_BLOCK_SIZE) {
+		// block is already erased
+		if (isErased(g_flashPage.data + offset, FLASH_BLOCK_SIZE)) {
+			continue;
+		}
+
+		if (!writeMemory(g_flashPage.address + offset, g_flashPage.data + offset, FLASH_BLOCK_SIZE)) {
+			DebugTrace("Failed to write memory at address %08x\n", g_flashPage.address + offset);
+			return false;
+		}
 
-	while (!eofReached && readHexRecord(bufferedFile, hexRecord)) {
+		g_flashStats.numBytesWritten += FLASH_BLOCK_SIZE;
+	}
+
+	return true;
+}
+
+static bool addToPage(uint32_t address, const uint8_t *data, uint32_t size) {
+	while (size > 0) {
+		uint32_t pageNumber;
+		if (!getPageNumber(address, pageNumber)) {
+			return false;
+		}
+
+		uint32_t pageAddress = FLASH_START_ADDRESS + pageNumber * FLASH_PAGE_SIZE;
+
+		if (!g_flashPage.used || g_flashPage.address != pageAddress) {
+			if (!flushPage()) {
+				return false;
+			}
+
+			g_flashPage.used = true;
+			g_flashPage.address = pageAddress;
+
+			if (isPageInImage(pageNumber)) {
+				if (!readPage(pageAddress, g_flashPage.data)) {
+					DebugTrace("Failed to read memory at address %08x\n", pageAddress);
+					return false;
+				}
+			} else {
+				memset(g_flashPage.data, 0xFF, FLASH_PAGE_SIZE);
+			}
+		}
+
+		uint32_t offset = address - pageAddress;
+		uint32_t n = FLASH_PAGE_SIZE - offset;
+		if (n > size) {
+			n = size;
+		}
+
+		memcpy(g_flashPage.data + offset, data, n);
+
+		address += n;
+		data += n;
+		size -= n;
+	}
+
+	return true;
+}
+
+// Erases pages of the previous firmware: gaps in the image and pages after it
+// up to the first erased page (or end of the slave flash).
+static bool eraseStalePages() {
+	uint32_t lastPageNumber = 0;
+	for (uint32_t pageNumber = 0; pageNumber < MAX_FLASH_PAGES; pageNumber++) {
+		if (isPageInImage(pageNumber)) {
+			lastPageNumber = pageNumber;
+		}
+	}
+
+	for (uint32_t pageNumber = 0; pageNumber < MAX_FLASH_PAGES; pageNumber++) {
+		if (isPageInImage(pageNumber)) {
+			continue;
+		}
+
+		uint32_t pageAddress = FLASH_START_ADDRESS + pageNumber * FLASH_PAGE_SIZE;
+		if (!readPage(pageAddress, g_slavePage)) {
+			// end of the slave flash
+			break;
+		}
+
+		if (isErased(g_slavePage, FLASH_PAGE_SIZE)) {
+			if (pageNumber > lastPageNumber) {
+				break;
+			}
+			continue;
+		}
+
+		if (!erasePage((uint16_t)pageNumber)) {
+			DebugTrace("Failed to erase page at address %08x\n", pageAddress);
+			return false;
+		}
+		g_flashStats.numPagesErased++;
+	}
+
+	return true;
+}
+
+// returns false on error
+static bool processHexFile() {
+	bool result = false;
+	File file;
+	psu::sd_card::BufferedFileRead bufferedFile(file);
+	size_t totalSize = 0;
+	HexRecord hexRecord;
+	uint32_t addressUpperBits = 0;
+
+	g_flashPage.used = false;
+
+	if (!file.open(g_hexFilePath, FILE_OPEN_EXISTING | FILE_READ)) {
+		DebugTrace("Can't open firmware hex file!\n");
+		return false;
+	}
 
 #if OPTION_DISPLAY
-        psu::gui::updateProgressPage(file.tell(), totalSize);
+	totalSize = file.size();
 #endif
 
+	while (readHexRecord(bufferedFile, hexRecord)) {
 		if (hexRecord.recordType == 0x04) {
 			addressUpperBits = ((hexRecord.data[0] << 8) + hexRecord.data[1]) << 16;
 		} else if (hexRecord.recordType == 0x00) {
 			uint32_t address = addressUpperBits | hexRecord.address;
-			if (!writeMemory(address, hexRecord.data, hexRecord.recordLength)) {
-				DebugTrace("Failed to write memory at address %08x\n", address);
+			uint32_t pageAddress = g_flashPage.address;
+			if (!addToPage(address, hexRecord.data, hexRecord.recordLength)) {
 				break;
 			}
+
+#if OPTION_DISPLAY
+			if (g_flashPage.address != pageAddress) {
+				psu::gui::updateProgressPage(file.tell(), totalSize);
+			}
+#endif
 		} else if (hexRecord.recordType == 0x01) {
-			eofReached = true;
+			result = flushPage() && eraseStalePages();
+			break;
 		}
 	}
 
-	// uint8_t hour, minute, second;
-	// psu::datetime::getTime(hour, minute, second);
-	// DebugTrace("[%02d:%02d:%02d] Flash finished\n", hour, minute, second);
-
 	file.close();
 
+	return result;
+}
+
+void uploadHexFile() {
+	bool flashed = false;
+	uint32_t startTime = millis();
+	uint32_t time;
+
+	memset(&g_flashStats, 0, sizeof(g_flashStats));
+	memset(g_pagesInImage, 0, sizeof(g_pagesInImage));
+
+#if OPTION_DISPLAY
+    psu::gui::showProgressPageWithoutAbort("Downloading firmware...");
+#endif
+
+	if (!processHexFile()) {
+		goto Exit;
+	}
+
+	flashed = true;
+
+	time = millis() - startTime;
+	DebugTrace("Slot %d flashed in %d ms: %d pages, %d written, %d erased, %d bytes written (%d B/s)\n",
+		g_slotIndex + 1, (int)time,
+		(int)g_flashStats.numPages, (int)g_flashStats.numPagesWritten, (int)g_flashStats.numPagesErased,
+		(int)g_flashStats.numBytesWritten,
+		(int)(time > 0 ? (uint64_t)g_flashStats.numBytesWritten * 1000 / time : 0));
+
 Exit:
 
 #if OPTION_DISPLAY
@@ -548,7 +1060,7 @@ Exit:
 
 	leaveBootloaderMode();
 
-	if (!eofReached) {
+	if (!flashed) {
 		psu::gui::errorMessage("Downloading failed!");
 	}
 }
@@ -19,14 +19,16 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <math.h>
+
 #if defined(EEZ_PLATFORM_STM32)
 #include <main.h>
-#include <crc.h>
-#include <eez/platform/stm32/spi.h>
 #include <memory.h>
 #include <stdlib.h>
 #endif
 
+#include <eez/platform/stm32/spi.h>
+
 #include <eez/modules/dcpX05/channel.h>
 
 #include <eez/modules/psu/psu.h>
@@ -34,6 +36,7 @@
 #include <eez/modules/psu/event_queue.h>
 #include <eez/scpi/regs.h>
 #include <eez/system.h>
+#include <eez/util.h>
 
 #define CONF_MASTER_SYNC_TIMEOUT_MS 500
 #define CONF_MASTER_SYNC_IRQ_TIMEOUT_MS 50
@@ -57,8 +60,6 @@ static const uint16_t ADC_MAX = 65535;
 
 static const float PTOT = 155.0f;
 
-#if defined(EEZ_PLATFORM_STM32)
-
 #define REG0_CC1_MASK     (1 << 1)
 #define REG0_CC2_MASK     (1 << 3)
 #define REG0_PWRGOOD_MASK (1 << 4)
@@ -66,9 +67,6 @@ static const float PTOT = 155.0f;
 #define SPI_SLAVE_SYNBYTE         0x53
 #define SPI_MASTER_SYNBYTE        0xAC
 
-static GPIO_TypeDef *SPI_IRQ_GPIO_Port[] = { SPI2_IRQ_GPIO_Port, SPI4_IRQ_GPIO_Port, SPI5_IRQ_GPIO_Port };
-static const uint16_t SPI_IRQ_Pin[] = { SPI2_IRQ_Pin, SPI4_IRQ_Pin, SPI5_IRQ_Pin };
-
 bool masterSynchro(int slotIndex, uint8_t &firmwareMajorVersion, uint8_t &firmwareMinorVersion, uint32_t &idw0, uint32_t &idw1, uint32_t &idw2) {
 	uint32_t start = millis();
 
@@ -85,7 +83,7 @@ bool masterSynchro(int slotIndex, uint8_t &firmwareMajorVersion, uint8_t &firmwa
 	    if (rxBuffer[0] == SPI_SLAVE_SYNBYTE) {
 			uint32_t startIrq = millis();
 			while (true) {
-				if (HAL_GPIO_ReadPin(SPI_IRQ_GPIO_Port[slotIndex], SPI_IRQ_Pin[slotIndex]) == GPIO_PIN_SET) {
+				if (spi::isIrqSet(slotIndex)) {
 					firmwareMajorVersion = rxBuffer[1];
 					firmwareMinorVersion = rxBuffer[2];
 					idw0 = (rxBuffer[3] << 24) | (rxBuffer[4] << 16) | (rxBuffer[5] << 8) | rxBuffer[6];
@@ -133,14 +131,11 @@ float calcTemperature(uint16_t adcValue) {
 	return roundPrec(Tcelsius, 1.0f);
 }
 
-#endif
-
 struct Channel : ChannelInterface {
     bool outputEnable[2];
 
     uint8_t output[BUFFER_SIZE];
 
-#if defined(EEZ_PLATFORM_STM32)
 	bool synchronized;
 
 	uint8_t input[BUFFER_SIZE];
@@ -149,14 +144,6 @@ struct Channel : ChannelInterface {
 	uint16_t iSet[2];
 
 	float temperature[2];
-#endif
-
-#if defined(EEZ_PLATFORM_SIMULATOR)
-    float uMon[2];
-    float iMon[2];
-    float uSet[2];
-    float iSet[2];
-#endif
 
     TestResult testResult;
 
@@ -170,15 +157,11 @@ struct Channel : ChannelInterface {
 
     Channel(int slotIndex_)
 		: ChannelInterface(slotIndex_)
-#if defined(EEZ_PLATFORM_STM32)
 		, synchronized(false)
-#endif
     	, testResult(TEST_NONE)
 	{
-#if defined(EEZ_PLATFORM_STM32)
     	memset(output, 0, sizeof(output));
     	memset(input, 0, sizeof(input));
-#endif
     }
 
 	void getParams(int subchannelIndex, ChannelParams &params) {
@@ -253,7 +236,6 @@ struct Channel : ChannelInterface {
 		I_MAX_FOR_REMAP = slot.moduleInfo->moduleType == MODULE_TYPE_DCM224 ? 5.0f : 4.1667f;
 	}
 
-#if defined(EEZ_PLATFORM_STM32)
     int numCrcErrors;
 
 	void transfer() {
@@ -261,7 +243,7 @@ struct Channel : ChannelInterface {
 		spi::transfer(slotIndex, output, input, BUFFER_SIZE);
 		spi::deselect(slotIndex);
 
-		uint32_t crc = HAL_CRC_Calculate(&hcrc, (uint32_t *)input, BUFFER_SIZE - 4);
+		uint32_t crc = crc32(input, BUFFER_SIZE - 4);
 		if (crc == *((uint32_t *)(input + BUFFER_SIZE - 4))) {
 			numCrcErrors = 0;
 		} else {
@@ -274,10 +256,8 @@ struct Channel : ChannelInterface {
 			}
 		}
 	}
-#endif
 
 	void init(int subchannelIndex) {
-#if defined(EEZ_PLATFORM_STM32)
 		if (!synchronized && subchannelIndex == 0) {
 			if (masterSynchro(slotIndex, firmwareMajorVersion, firmwareMinorVersion, idw0, idw1, idw2)) {
 	    		//DebugTrace("DCM220 slot #%d firmware version %d.%d\n", slotIndex + 1, (int)firmwareMajorVersion, (int)firmwareMinorVersion);
@@ -292,37 +272,23 @@ struct Channel : ChannelInterface {
 				idw2 = 0;
 			}
 		}
-#endif
-
-#if defined(EEZ_PLATFORM_SIMULATOR)
-        firmwareMajorVersion = 1;
-		firmwareMinorVersion = 0;
-		idw0 = 0;
-		idw1 = 0;
-		idw2 = 0;
-#endif
     }
 
 	void onPowerDown(int subchannelIndex) {
-#if defined(EEZ_PLATFORM_STM32)
 		synchronized = false;
-#endif
 	}
 
 	void reset(int subchannelIndex) {
 	}
 
 	void test(int subchannelIndex) {
-#if defined(EEZ_PLATFORM_STM32)
 		if (!synchronized) {
 			testResult = TEST_FAILED;
 			return;
 		}
-#endif
 
 		psu::Channel &channel = psu::Channel::getBySlotIndex(slotIndex, subchannelIndex);
 
-#if defined(EEZ_PLATFORM_STM32)
 		if (subchannelIndex == 0) {
 			output[0] = 0;
 
@@ -335,11 +301,6 @@ struct Channel : ChannelInterface {
 		} else{
 			pwrGood = true;
 		}
-#endif
-
-#if defined(EEZ_PLATFORM_SIMULATOR)
-        bool pwrGood = simulator::getPwrgood(channel.channelIndex);
-#endif
 
 		channel.flags.powerOk = pwrGood ? 1 : 0;
 
@@ -357,7 +318,6 @@ struct Channel : ChannelInterface {
 
             output[0] = output0;
 
-#if defined(EEZ_PLATFORM_STM32)
         	output[1] = 0;
 
         	uint16_t *outputSetValues = (uint16_t *)(output + 2);
@@ -375,54 +335,15 @@ struct Channel : ChannelInterface {
 #endif
 
 			transfer();
-#endif
 
-#if defined(EEZ_PLATFORM_STM32)
             if (numCrcErrors == 0) {
 		    	temperature[0] = calcTemperature(*((uint16_t *)(input + 10)));
 		    	temperature[1] = calcTemperature(*((uint16_t *)(input + 12)));
 		    }
-#endif
-        }
-
-#if defined(EEZ_PLATFORM_SIMULATOR)
-        if (channel.isOutputEnabled()) {
-            if (channel.simulator.getLoadEnabled()) {
-                float u_set_v = uSet[channel.subchannelIndex];
-                float i_set_a = iSet[channel.subchannelIndex];
-
-                float u_mon_v = i_set_a * channel.simulator.load;
-                float i_mon_a = i_set_a;
-                if (u_mon_v > u_set_v) {
-                    u_mon_v = u_set_v;
-                    i_mon_a = u_set_v / channel.simulator.load;
-
-                    simulator::setCC(channel.channelIndex, false);
-                } else {
-                    simulator::setCC(channel.channelIndex, true);
-                }
-
-                uMon[channel.subchannelIndex] = u_mon_v;
-                iMon[channel.subchannelIndex] = i_mon_a;
-            } else {
-                uMon[channel.subchannelIndex] = uSet[channel.subchannelIndex];
-                iMon[channel.subchannelIndex] = 0;
-                if (uSet[channel.subchannelIndex] > 0 && iSet[channel.subchannelIndex] > 0) {
-                    simulator::setCC(channel.channelIndex, false);
-                } else {
-                    simulator::setCC(channel.channelIndex, true);
-                }
-            }
-        } else {
-            uMon[channel.subchannelIndex] = 0;
-            iMon[channel.subchannelIndex] = 0;
-            simulator::setCC(channel.channelIndex, false);
         }
-#endif
 
         //
 
-#if defined(EEZ_PLATFORM_STM32)
         if (numCrcErrors == 0) {
         	uint16_t *inputSetValues = (uint16_t *)(input + 2);
 
@@ -444,27 +365,15 @@ struct Channel : ChannelInterface {
 			psu::debug::g_iMon[channel.channelIndex].set(iMonAdc);
 #endif
         }
-#endif
-
-#if defined(EEZ_PLATFORM_SIMULATOR)
-        channel.onAdcData(ADC_DATA_TYPE_U_MON, uMon[channel.subchannelIndex]);
-        channel.onAdcData(ADC_DATA_TYPE_I_MON, iMon[channel.subchannelIndex]);
-#endif
 
         // PWRGOOD
 
-#if defined(EEZ_PLATFORM_STM32)
 		bool pwrGood;
 		if (numCrcErrors == 0) {
 			pwrGood = input[0] & REG0_PWRGOOD_MASK ? true : false;
 		} else{
 			pwrGood = true;
 		}
-#endif
-
-#if defined(EEZ_PLATFORM_SIMULATOR)
-        bool pwrGood = simulator::getPwrgood(channel.channelIndex);
-#endif
 
 #if !CONF_SKIP_PWRGOOD_TEST
 		if (!pwrGood) {
@@ -477,14 +386,7 @@ struct Channel : ChannelInterface {
 	}
 	
 	bool isCcMode(int subchannelIndex) {
-#if defined(EEZ_PLATFORM_STM32)
         return (input[0] & (subchannelIndex == 0 ? REG0_CC1_MASK : REG0_CC2_MASK)) != 0;
-#endif
-
-#if defined(EEZ_PLATFORM_SIMULATOR)
-        psu::Channel &channel = psu::Channel::getBySlotIndex(slotIndex, subchannelIndex);
-        return simulator::getCC(channel.channelIndex);
-#endif
 	}
 
 	bool isCvMode(int subchannelIndex) {
@@ -511,51 +413,24 @@ struct Channel : ChannelInterface {
     }
     
     void setDacVoltage(int subchannelIndex, uint16_t value) {
-
-#if defined(EEZ_PLATFORM_STM32)
         value = (uint16_t)clamp((float)value, (float)DAC_MIN, (float)DAC_MAX);
         uSet[subchannelIndex] = clamp(value, DAC_MIN, DAC_MAX);
-#endif
-
-#if defined(EEZ_PLATFORM_SIMULATOR)
-        psu::Channel &channel = psu::Channel::getBySlotIndex(slotIndex, subchannelIndex);
-        uSet[subchannelIndex] = remap(clamp((float)value, (float)DAC_MIN, (float)DAC_MAX), (float)DAC_MIN, 0, (float)DAC_MAX, channel.params.U_MAX);
-#endif
 	}
 
 	void setDacVoltageFloat(int subchannelIndex, float value) {
-#if defined(EEZ_PLATFORM_STM32)
         psu::Channel &channel = psu::Channel::getBySlotIndex(slotIndex, subchannelIndex);
         value = remap(value, 0, (float)DAC_MIN, channel.params.U_MAX, (float)DAC_MAX);
         uSet[subchannelIndex] = (uint16_t)clamp(round(value), DAC_MIN, DAC_MAX);
-#endif
-
-#if defined(EEZ_PLATFORM_SIMULATOR)
-        uSet[subchannelIndex] = value;
-#endif
 	}
 
 	void setDacCurrent(int subchannelIndex, uint16_t value) {
-#if defined(EEZ_PLATFORM_STM32)
         value = (uint16_t)clamp((float)value, (float)DAC_MIN, (float)DAC_MAX);
         iSet[subchannelIndex] = value;
-#endif
-
-#if defined(EEZ_PLATFORM_SIMULATOR)
-        psu::Channel &channel = psu::Channel::getBySlotIndex(slotIndex, subchannelIndex);
-        uSet[subchannelIndex] = remap(clamp((float)value, (float)DAC_MIN, (float)DAC_MAX), (float)DAC_MIN, channel.params.I_MIN, (float)DAC_MAX, channel.params.I_MAX);
-#endif
     }
 
 	void setDacCurrentFloat(int subchannelIndex, float value) {
-#if defined(EEZ_PLATFORM_STM32)
         value = remap(value, /*channel.params.I_MIN*/ 0, (float)DAC_MIN, /*channel.params.I_MAX*/ I_MAX_FOR_REMAP, (float)DAC_MAX);
         iSet[subchannelIndex] = (uint16_t)clamp(round(value), DAC_MIN, DAC_MAX);
-#endif
-
-#if defined(EEZ_PLATFORM_SIMULATOR)
-        iSet[subchannelIndex] = value;
-#endif
 	}
 
 	bool isDacTesting(int subchannelIndex) {
@@ -572,13 +447,9 @@ struct Channel : ChannelInterface {
 	}
     
 	void getSerial(char *text) {
-#if defined(EEZ_PLATFORM_STM32)		
 		sprintf(text, "%08X", (unsigned int)idw0);
 		sprintf(text + 8, "%08X", (unsigned int)idw1);
 		sprintf(text + 16, "%08X", (unsigned int)idw2);
-#else
-		strcpy(text, "N/A");
-#endif
 	}
 
     void getVoltageStepValues(StepValues *stepValues) {
@@ -624,8 +495,6 @@ static Channel g_channel1(1);
 static Channel g_channel2(2);
 ChannelInterface *g_channelInterfaces[NUM_SLOTS] = { &g_channel0, &g_channel1, &g_channel2 };
 
-#if defined(EEZ_PLATFORM_STM32)
-
 float readTemperature(int channelIndex) {
 	psu::Channel& channel = psu::Channel::get(channelIndex);
 	int slotIndex = channel.slotIndex;
@@ -639,7 +508,5 @@ float readTemperature(int channelIndex) {
 	}
 }
 
-#endif
-
 } // namespace dcm220
 } // namespace eez
@@ -25,9 +25,7 @@ namespace dcm220 {
 
 extern ChannelInterface *g_channelInterfaces[NUM_SLOTS];
 
-#if defined(EEZ_PLATFORM_STM32)
 float readTemperature(int channelIndex);
-#endif
 
 } // namespace dcpX05
 } // namespace eez
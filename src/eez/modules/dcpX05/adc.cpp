@@ -21,12 +21,10 @@
 #include <eez/modules/psu/channel_dispatcher.h>
 #include <eez/modules/dcpX05/adc.h>
 
-#if defined(EEZ_PLATFORM_STM32)
 #include <eez/platform/stm32/spi.h>
 #include <eez/system.h>
 #include <eez/index.h>
 #include <scpi/scpi.h>
-#endif
 
 /// How many times per second will ADC take snapshot value?
 /// Normal: 0: 20 SPS, 1: 45 SPS, 2:  90 SPS, 3: 175 SPS, 4: 330 SPS, 5:  600 SPS, 6: 1000 SPS
@@ -40,8 +38,6 @@
 namespace eez {
 namespace psu {
 
-#if defined(EEZ_PLATFORM_STM32)
-
 float remapAdcDataToVoltage(Channel& channel, AdcDataType adcDataType, int16_t adcData) {
     float value = remap((float)adcData, (float)AnalogDigitalConverter::ADC_MIN, channel.params.U_MIN, (float)AnalogDigitalConverter::ADC_MAX, channel.params.U_MAX);
 #if !defined(EEZ_PLATFORM_SIMULATOR)    
@@ -89,123 +85,53 @@ static const uint8_t ADC_REG3_VAL = 0B00000000;
 
 ////////////////////////////////////////////////////////////////////////////////
 
-uint8_t AnalogDigitalConverter::getReg1Val() {
-    return (CONF_ADC_SPS << 5) | (CONF_ADC_MODE << 3) | 0B00000000;
+static uint8_t getReg0Val(AdcDataType adcDataType) {
+	if (adcDataType == ADC_DATA_TYPE_U_MON) {
+		return ADC_REG0_READ_U_MON;
+	} else if (adcDataType == ADC_DATA_TYPE_I_MON) {
+		return ADC_REG0_READ_I_MON;
+	} else if (adcDataType == ADC_DATA_TYPE_U_MON_DAC) {
+		return ADC_REG0_READ_U_SET;
+	} else {
+		return ADC_REG0_READ_I_SET;
+	}
 }
 
-#endif
-
-#if defined(EEZ_PLATFORM_SIMULATOR)
-static float g_uMon[CH_MAX];
-static float g_iMon[CH_MAX];
-
-float g_uSet[CH_MAX];
-float g_iSet[CH_MAX];
-
-void updateValues(Channel &channel) {
-    int channelIndex = channel.channelIndex;
-
-    bool series = false;
-    bool parallel = false;
-    Channel &channel0 = Channel::get(0);
-    Channel &channel1 = Channel::get(1);
-    if (channelIndex == 0 || channelIndex == 1) {
-        if (channel_dispatcher::getCouplingType() == channel_dispatcher::COUPLING_TYPE_SERIES) {
-            series = true;
-        } else if (channel_dispatcher::getCouplingType() == channel_dispatcher::COUPLING_TYPE_PARALLEL) {
-            parallel = true;
-        }
-    }
-
-    if (series || parallel) {
-        if (channelIndex == 1) {
-            return;
-        }
-    }
+static float getValue(Channel& channel, AdcDataType adcDataType, int16_t adcValue) {
+    float value;
 
-    if (channel.simulator.getLoadEnabled()) {
-        float u_set_v;
-        if (series) {
-            u_set_v = channel.isRemoteProgrammingEnabled()
-                ? remap(channel0.simulator.voltProgExt + channel1.simulator.voltProgExt, 0, 0, 2.5, channel.u.max)
-                : g_uSet[0] + g_uSet[1];
-        } else {
-            u_set_v = channel.isRemoteProgrammingEnabled()
-                ? remap(channel.simulator.voltProgExt, 0, 0, 2.5, channel.u.max)
-                : g_uSet[channelIndex];
-        }
-
-        float i_set_a;
-        if (parallel) {
-            i_set_a = g_iSet[0] + g_iSet[1];
-        } else {
-            i_set_a = g_iSet[channelIndex];
-        }
-
-        float u_mon_v = i_set_a * channel.simulator.load;
-        float i_mon_a = i_set_a;
-        if (u_mon_v > u_set_v) {
-            u_mon_v = u_set_v;
-            i_mon_a = u_set_v / channel.simulator.load;
-
-            simulator::setCV(channel.channelIndex, true);
-            simulator::setCC(channel.channelIndex, false);
-        } else {
-            simulator::setCV(channel.channelIndex, false);
-            simulator::setCC(channel.channelIndex, true);
-        }
-
-        if (series) {
-            g_uMon[0] = u_mon_v / 2;
-            g_uMon[1] = u_mon_v / 2;
-        } else {
-            g_uMon[channelIndex] = u_mon_v;
-        }
-
-        if (parallel) {
-            g_iMon[0] = i_mon_a / 2;
-            g_iMon[1] = i_mon_a / 2;
-        } else {
-            g_iMon[channelIndex] = i_mon_a;
-        }
-
-        return;
+    if (adcDataType == ADC_DATA_TYPE_U_MON) {
+        value = remapAdcDataToVoltage(channel, adcDataType, adcValue);
+        channel.u.mon_adc = value;
+#ifdef DEBUG
+        debug::g_uMon[channel.channelIndex].set(adcValue);
+#endif
+    } else if (adcDataType == ADC_DATA_TYPE_I_MON) {
+        value = remapAdcDataToCurrent(channel, adcDataType, adcValue);
+        channel.i.mon_adc = value;
+#ifdef DEBUG
+        debug::g_iMon[channel.channelIndex].set(adcValue);
+#endif
+    } else if (adcDataType == ADC_DATA_TYPE_U_MON_DAC) {
+        value = remapAdcDataToVoltage(channel, adcDataType, adcValue);
+#ifdef DEBUG
+        debug::g_uMonDac[channel.channelIndex].set(adcValue);
+#endif
     } else {
-        if (channel.isOutputEnabled()) {
-            if (series) {
-                g_uMon[0] = g_uSet[0];
-                g_uMon[1] = g_uSet[1];
-            } else {
-                g_uMon[channelIndex] = g_uSet[channelIndex];
-            }
-
-            if (series) {
-                g_iMon[0] = 0;
-                g_iMon[1] = 0;
-            } else {
-                g_iMon[channelIndex] = 0;
-            }
-
-            if (g_uSet[channelIndex] > 0 && g_iSet[channelIndex] > 0) {
-                simulator::setCV(channel.channelIndex, true);
-                simulator::setCC(channel.channelIndex, false);
-            } else {
-                simulator::setCV(channel.channelIndex, false);
-                simulator::setCC(channel.channelIndex, true);
-            }
-            return;
-        }
+        value = remapAdcDataToCurrent(channel, adcDataType, adcValue);
+#ifdef DEBUG
+        debug::g_iMonDac[channel.channelIndex].set(adcValue);
+#endif
     }
 
-    g_uMon[channelIndex] = 0;
-    g_iMon[channelIndex] = 0;
-    simulator::setCV(channel.channelIndex, true);
-    simulator::setCC(channel.channelIndex, false);
+    return value;
+}
+
+uint8_t AnalogDigitalConverter::getReg1Val() {
+    return (CONF_ADC_SPS << 5) | (CONF_ADC_MODE << 3) | 0B00000000;
 }
-#endif
 
 void AnalogDigitalConverter::init() {
-#if defined(EEZ_PLATFORM_STM32)
     uint8_t data[4];
     uint8_t result[4];
 
@@ -224,15 +150,9 @@ void AnalogDigitalConverter::init() {
     spi::transfer(slotIndex, data, result, 4);
 
     spi::deselect(slotIndex);
-#endif
-
-#if defined(EEZ_PLATFORM_SIMULATOR)
-    g_testResult = TEST_OK;
-#endif
 }
 
 bool AnalogDigitalConverter::test() {
-#if defined(EEZ_PLATFORM_STM32)    
     uint8_t data[4];
     uint8_t result[4];
 
@@ -271,7 +191,6 @@ bool AnalogDigitalConverter::test() {
     } else {
     	g_testResult = TEST_OK;
     }
-#endif
 
     return g_testResult != TEST_FAILED;
 }
@@ -279,32 +198,19 @@ bool AnalogDigitalConverter::test() {
 void AnalogDigitalConverter::start(AdcDataType adcDataType_) {
     adcDataType = adcDataType_;
 
-#if defined(EEZ_PLATFORM_STM32)
 	uint8_t data[3];
 	uint8_t result[3];
 
 	data[0] = ADC_WR1S0;
-
-	if (adcDataType == ADC_DATA_TYPE_U_MON) {
-		data[1] = ADC_REG0_READ_U_MON;
-	} else if (adcDataType == ADC_DATA_TYPE_I_MON) {
-		data[1] = ADC_REG0_READ_I_MON;
-	} else if (adcDataType == ADC_DATA_TYPE_U_MON_DAC) {
-		data[1] = ADC_REG0_READ_U_SET;
-	} else {
-		data[1] = ADC_REG0_READ_I_SET;
-	}
-
+	data[1] = getReg0Val(adcDataType);
 	data[2] = ADC_START;
 
 	spi::select(slotIndex, spi::CHIP_ADC);
 	spi::transfer(slotIndex, data, result, 3);
 	spi::deselect(slotIndex);
-#endif
 }
 
 float AnalogDigitalConverter::read(Channel& channel) {
-#if defined(EEZ_PLATFORM_STM32)
     uint8_t data[3];
     uint8_t result[3];
 
@@ -319,58 +225,36 @@ float AnalogDigitalConverter::read(Channel& channel) {
     uint16_t dmsb = result[1];
     uint16_t dlsb = result[2];
 
-    int16_t adcValue = (int16_t)((dmsb << 8) | dlsb);
-
-    float value;
+    return getValue(channel, adcDataType, (int16_t)((dmsb << 8) | dlsb));
+}
 
-    if (adcDataType == ADC_DATA_TYPE_U_MON) {
-        value = remapAdcDataToVoltage(channel, adcDataType, adcValue);
-        channel.u.mon_adc = value;
-#ifdef DEBUG
-        debug::g_uMon[channel.channelIndex].set(adcValue);
-#endif
-    } else if (adcDataType == ADC_DATA_TYPE_I_MON) {
-        value = remapAdcDataToCurrent(channel, adcDataType, adcValue);
-        channel.i.mon_adc = value;
-#ifdef DEBUG
-        debug::g_iMon[channel.channelIndex].set(adcValue);
-#endif
-    } else if (adcDataType == ADC_DATA_TYPE_U_MON_DAC) {
-        value = remapAdcDataToVoltage(channel, adcDataType, adcValue);
-#ifdef DEBUG
-        debug::g_uMonDac[channel.channelIndex].set(adcValue);
-#endif
-    } else {
-        value = remapAdcDataToCurrent(channel, adcDataType, adcValue);
-#ifdef DEBUG
-        debug::g_iMonDac[channel.channelIndex].set(adcValue);
-#endif
-    }
+float AnalogDigitalConverter::readAndStart(Channel& channel, AdcDataType nextAdcDataType) {
+    // ADS1120 accepts more commands while CS is low: RDATA is followed by WREG and START
+    uint8_t data[6];
+    uint8_t result[6];
 
-    return value;
-#endif
+    data[0] = ADC_RDATA;
+    data[1] = 0;
+    data[2] = 0;
+    data[3] = ADC_WR1S0;
+    data[4] = getReg0Val(nextAdcDataType);
+    data[5] = ADC_START;
 
-#if defined(EEZ_PLATFORM_SIMULATOR)
-    updateValues(channel);
+    spi::select(slotIndex, spi::CHIP_ADC);
+    spi::transfer(slotIndex, data, result, 6);
+    spi::deselect(slotIndex);
 
-    if (adcDataType == ADC_DATA_TYPE_U_MON) {
-        return g_uMon[channel.channelIndex];
-    }
+    uint16_t dmsb = result[1];
+    uint16_t dlsb = result[2];
 
-    if (adcDataType == ADC_DATA_TYPE_I_MON) {
-        return g_iMon[channel.channelIndex];
-    }
+    float value = getValue(channel, adcDataType, (int16_t)((dmsb << 8) | dlsb));
 
-    if (adcDataType == ADC_DATA_TYPE_U_MON_DAC) {
-        return g_uSet[channel.channelIndex];
-    }
+    adcDataType = nextAdcDataType;
 
-    return g_iSet[channel.channelIndex];
-#endif
+    return value;
 }
 
 void AnalogDigitalConverter::readAllRegisters(uint8_t registers[]) {
-#if defined(EEZ_PLATFORM_STM32)    
     uint8_t data[5];
     uint8_t result[5];
 
@@ -392,7 +276,6 @@ void AnalogDigitalConverter::readAllRegisters(uint8_t registers[]) {
     if (adcDataType) {
     	start(adcDataType);
     }
-#endif
 }
 
 } // namespace psu
@@ -42,14 +42,15 @@ public:
     void start(AdcDataType adcDataType);
     float read(Channel& channel);
 
+    // read the last conversion and start the next one in a single SPI transaction
+    float readAndStart(Channel& channel, AdcDataType nextAdcDataType);
+
     void readAllRegisters(uint8_t registers[]);
 
 private:
     uint32_t start_time;
 
-#if defined(EEZ_PLATFORM_STM32)
     uint8_t getReg1Val();
-#endif
 };
 
 } // namespace psu
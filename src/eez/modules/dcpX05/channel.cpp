@@ -25,6 +25,7 @@
 #include <eez/modules/psu/debug.h>
 #include <eez/modules/psu/profile.h>
 #include <eez/modules/psu/channel_dispatcher.h>
+#include <eez/modules/psu/waveform.h>
 
 #include <eez/scpi/regs.h>
 
@@ -205,7 +206,28 @@ struct Channel : ChannelInterface {
 	void test(int subchannelIndex) {
 		ioexp.test();
 		adc.test();
-		dac.test(ioexp, adc);
+		if (dac.testStart(ioexp, adc)) {
+			adc.start(ADC_DATA_TYPE_U_MON_DAC);
+		}
+	}
+
+	bool testStep(int subchannelIndex) {
+		if (!isDacTesting(subchannelIndex)) {
+			return false;
+		}
+
+		psu::Channel &channel = psu::Channel::getBySlotIndex(slotIndex);
+
+		waitConversionEnd();
+
+		if (adc.adcDataType == ADC_DATA_TYPE_U_MON_DAC) {
+			channel.onAdcData(ADC_DATA_TYPE_U_MON_DAC, adc.readAndStart(channel, ADC_DATA_TYPE_I_MON_DAC));
+			return true;
+		}
+
+		channel.onAdcData(ADC_DATA_TYPE_I_MON_DAC, adc.read(channel));
+		dac.testFinish();
+		return false;
 	}
 
 	TestResult getTestResult(int subchannelIndex) {
@@ -254,8 +276,7 @@ struct Channel : ChannelInterface {
 
 		if (channel.isOutputEnabled() && ioexp.isAdcReady()) {
 			auto adcDataType = adc.adcDataType;
-			float value = adc.read(channel);
-			adc.start(getNextAdcDataType(adcDataType));
+			float value = adc.readAndStart(channel, getNextAdcDataType(adcDataType));
 			channel.onAdcData(adcDataType, value);
 #ifdef DEBUG
 			psu::debug::g_adcCounter.inc();
@@ -333,9 +354,13 @@ struct Channel : ChannelInterface {
 				}
 			}
 
+			// voltage waveform written by the waveform thread has falling edges all the time,
+			// so HW OVP stays deactivated while it is executed (SW OVP is still active)
+			bool hwOvpSuspended = fallingEdge || waveform::isWritingDac(channel, waveform::TYPE_VOLTAGE);
+
 			// HW OVP handling
 			if (ioexp.testBit(IOExpander::IO_BIT_OUT_OUTPUT_ENABLE)) {
-				if (!fallingEdge && isHwOvpEnabled(channel) && !ioexp.testBit(IOExpander::DCP405_IO_BIT_OUT_OVP_ENABLE)) {
+				if (!hwOvpSuspended && isHwOvpEnabled(channel) && !ioexp.testBit(IOExpander::DCP405_IO_BIT_OUT_OVP_ENABLE)) {
 					if (channel.u.set > CONF_OVP_HW_VOLTAGE_THRESHOLD) {
 						// activate HW OVP
 						channel.prot_conf.flags.u_hwOvpDeactivated = 0;
@@ -343,9 +368,9 @@ struct Channel : ChannelInterface {
 					} else {
 						channel.prot_conf.flags.u_hwOvpDeactivated = 1;
 					}
-				} else if ((fallingEdge || !isHwOvpEnabled(channel)) && ioexp.testBit(IOExpander::DCP405_IO_BIT_OUT_OVP_ENABLE)) {
+				} else if ((hwOvpSuspended || !isHwOvpEnabled(channel)) && ioexp.testBit(IOExpander::DCP405_IO_BIT_OUT_OVP_ENABLE)) {
 					// deactivate HW OVP
-					channel.prot_conf.flags.u_hwOvpDeactivated = fallingEdge ? 0 : 1;
+					channel.prot_conf.flags.u_hwOvpDeactivated = hwOvpSuspended ? 0 : 1;
 					ioexp.changeBit(IOExpander::DCP405_IO_BIT_OUT_OVP_ENABLE, false);
 				}
 			}
@@ -365,7 +390,6 @@ struct Channel : ChannelInterface {
 	}
 
 	void waitConversionEnd() {
-#if defined(EEZ_PLATFORM_STM32)
         for (int i = 0; i < CONF_ADC_CONVERSION_MAX_TIME_MS; i++) {
             ioexp.tick(micros());
             if (ioexp.isAdcReady()) {
@@ -375,7 +399,6 @@ struct Channel : ChannelInterface {
 		}
 
         WATCHDOG_RESET();
-#endif
     }
 
 	void adcMeasureUMon(int subchannelIndex) {
@@ -664,6 +687,34 @@ struct Channel : ChannelInterface {
 		return dac.isTesting();
 	}
 
+	bool isWaveformDacSupported(int subchannelIndex) {
+		return true;
+	}
+
+	// called from the waveform thread, uSet is the only state shared with the PSU thread
+	bool setWaveformDacVoltage(int subchannelIndex, float value) {
+		psu::Channel &channel = psu::Channel::getBySlotIndex(slotIndex);
+
+		if ((channel.params.features & CH_FEATURE_HW_OVP) && value < uSet && ioexp.testBit(IOExpander::DCP405_IO_BIT_OUT_OVP_ENABLE)) {
+			// HW OVP is deactivated in the next tick, until then falling edge would trip it
+			return false;
+		}
+
+		uSet = value;
+
+		if (ioexp.testBit(IOExpander::IO_BIT_OUT_OUTPUT_ENABLE)) {
+			dac.setVoltage(value);
+		}
+
+		return true;
+	}
+
+	// called from the waveform thread
+	bool setWaveformDacCurrent(int subchannelIndex, float value) {
+		dac.setCurrent(value);
+		return true;
+	}
+
 	void setCurrentRange(int subchannelIndex) {
         auto &channel = psu::Channel::getBySlotIndex(slotIndex);
 		auto &slot = g_slots[slotIndex];
@@ -22,9 +22,7 @@
 
 #include <eez/system.h>
 
-#if defined(EEZ_PLATFORM_STM32)
 #include <eez/platform/stm32/spi.h>
-#endif
 
 #include <eez/modules/psu/psu.h>
 
@@ -37,49 +35,45 @@ namespace psu {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-#if defined(EEZ_PLATFORM_STM32)
 static const uint8_t DATA_BUFFER_A = 0B00010000;
 static const uint8_t DATA_BUFFER_B = 0B00100100;
-#endif
-
-#if defined(EEZ_PLATFORM_SIMULATOR)
-extern float g_uSet[CH_MAX];
-extern float g_iSet[CH_MAX];
-#endif
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void DigitalAnalogConverter::init() {
 }
 
-bool DigitalAnalogConverter::test(IOExpander &ioexp, AnalogDigitalConverter &adc) {
-#if defined(EEZ_PLATFORM_STM32)
+bool DigitalAnalogConverter::testStart(IOExpander &ioexp, AnalogDigitalConverter &adc) {
     Channel &channel = Channel::getBySlotIndex(slotIndex);
 
     if (ioexp.g_testResult != TEST_OK) {
         // DebugTrace("Ch%d DAC test skipped because of IO expander", channel.channelIndex + 1);
         g_testResult = TEST_SKIPPED;
-        return true;
+        return false;
     }
 
     if (adc.g_testResult != TEST_OK) {
         // DebugTrace("Ch%d DAC test skipped because of ADC", channel.channelIndex + 1);
         g_testResult = TEST_SKIPPED;
-        return true;
+        return false;
     }
 
     m_testing = true;
 
     channel.calibrationEnableNoEvent(false);
 
-    // set U on DAC and check it on ADC
-    float uSet = channel.u.max / 2;
-    float iSet = channel.i.max / 2;
+    // set U and I on DAC and check them on ADC
+    channel.setVoltage(channel.u.max / 2);
+    channel.setCurrent(channel.i.max / 2);
 
-    channel.setVoltage(uSet);
-    channel.setCurrent(iSet);
+    return true;
+}
 
-    channel.adcMeasureMonDac();
+bool DigitalAnalogConverter::testFinish() {
+    Channel &channel = Channel::getBySlotIndex(slotIndex);
+
+    float uSet = channel.u.max / 2;
+    float iSet = channel.i.max / 2;
 
     setDacVoltage(0);
     setDacCurrent(0);
@@ -105,11 +99,6 @@ bool DigitalAnalogConverter::test(IOExpander &ioexp, AnalogDigitalConverter &adc
     }
 
     m_testing = false;
-#endif
-
-#if defined(EEZ_PLATFORM_SIMULATOR)
-    g_testResult = TEST_OK;
-#endif
 
     return g_testResult != TEST_FAILED;
 }
@@ -118,54 +107,24 @@ bool DigitalAnalogConverter::test(IOExpander &ioexp, AnalogDigitalConverter &adc
 
 void DigitalAnalogConverter::setVoltage(float value) {
     Channel &channel = Channel::getBySlotIndex(slotIndex);
-
-#if defined(EEZ_PLATFORM_STM32)
     set(DATA_BUFFER_B, remap(value, channel.params.U_MIN, (float)DAC_MIN, channel.params.U_MAX, (float)DAC_MAX));
-#endif
-
-#if defined(EEZ_PLATFORM_SIMULATOR)
-    g_uSet[channel.channelIndex] = value;
-#endif
 }
 
 void DigitalAnalogConverter::setDacVoltage(uint16_t value) {
-#if defined(EEZ_PLATFORM_STM32)
     set(DATA_BUFFER_B, value);
-#endif
-
-#if defined(EEZ_PLATFORM_SIMULATOR)
-    Channel &channel = Channel::getBySlotIndex(slotIndex);
-    g_uSet[channel.channelIndex] = remap(value, (float)DAC_MIN, channel.params.U_MIN, (float)DAC_MAX, channel.params.U_MAX);
-#endif
 }
 
 void DigitalAnalogConverter::setCurrent(float value) {
     Channel &channel = Channel::getBySlotIndex(slotIndex);
-
-#if defined(EEZ_PLATFORM_STM32)
     set(DATA_BUFFER_A, remap(value, channel.params.I_MIN, (float)DAC_MIN, channel.getDualRangeMax(), (float)DAC_MAX));
-#endif
-
-#if defined(EEZ_PLATFORM_SIMULATOR)
-    g_iSet[channel.channelIndex] = value;
-#endif
 }
 
 void DigitalAnalogConverter::setDacCurrent(uint16_t value) {
-#if defined(EEZ_PLATFORM_STM32)
     set(DATA_BUFFER_A, value);
-#endif
-
-#if defined(EEZ_PLATFORM_SIMULATOR)
-    Channel &channel = Channel::getBySlotIndex(slotIndex);
-    g_iSet[channel.channelIndex] = remap(value, (float)DAC_MIN, channel.params.I_MIN, (float)DAC_MAX, channel.getDualRangeMax());
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-#if defined(EEZ_PLATFORM_STM32)
-
 void DigitalAnalogConverter::set(uint8_t buffer, uint16_t value) {
     Channel &channel = Channel::getBySlotIndex(slotIndex);
 
@@ -193,7 +152,5 @@ void DigitalAnalogConverter::set(uint8_t buffer, float value) {
     set(buffer, (uint16_t)clamp(round(value), DAC_MIN, DAC_MAX));
 }
 
-#endif
-
 } // namespace psu
 } // namespace eez
@@ -34,7 +34,9 @@ public:
     TestResult g_testResult;
 
     void init();
-    bool test(IOExpander &ioexp, AnalogDigitalConverter &adc);
+    // test sets the DAC outputs in testStart and checks the values measured by ADC in testFinish
+    bool testStart(IOExpander &ioexp, AnalogDigitalConverter &adc);
+    bool testFinish();
 
     void setVoltage(float voltage);
     void setDacVoltage(uint16_t voltage);
@@ -48,10 +50,8 @@ public:
   private:
     bool m_testing;
 
-#if defined(EEZ_PLATFORM_STM32)
     void set(uint8_t buffer, uint16_t value);
     void set(uint8_t buffer, float value);
-#endif
 };
 
 } // namespace psu
@@ -21,18 +21,18 @@
 #include <eez/modules/dcpX05/ioexp.h>
 
 #if defined(EEZ_PLATFORM_STM32)
-#include <scpi/scpi.h>
 #include <main.h>
+#endif
+
+#include <scpi/scpi.h>
 #include <eez/platform/stm32/spi.h>
 #include <eez/system.h>
 #include <eez/index.h>
 #include <eez/modules/psu/event_queue.h>
-#endif
 
 namespace eez {
 namespace psu {
 
-#if defined(EEZ_PLATFORM_STM32)
 // I/O expander MCP23S17-E/SS
 // http://ww1.microchip.com/downloads/en/devicedoc/20001952c.pdf
 static const uint8_t IOEXP_WRITE = 0B01000000;
@@ -116,11 +116,13 @@ static const uint8_t REG_VALUES[] = {
 
 static const int REG_IODIRA_INDEX = 0;
 static const int REG_IODIRB_INDEX = 1;
-#endif
+
+// IODIRA is checked for I/O expander reset at this rate, not on every tick,
+// fault match (GPIO vs. written value) is still checked on every tick
+static const uint32_t RESET_CHECK_PERIOD_US = 20000;
 
 ////////////////////////////////////////////////////////////////////////////////
 
-#if defined(EEZ_PLATFORM_STM32)
 uint8_t IOExpander::getRegValue(int i) {
     uint8_t reg = REG_VALUES[3 * i];
     uint8_t value = REG_VALUES[3 * i + 1];
@@ -165,10 +167,8 @@ uint8_t IOExpander::getRegValue(int i) {
 
     return value;
 }
-#endif
 
 void IOExpander::init() {
-#if defined(EEZ_PLATFORM_STM32)
     auto &slot = g_slots[slotIndex];
 
     gpioOutputPinsMask = 0;
@@ -224,12 +224,9 @@ void IOExpander::init() {
     delay(1);
     HAL_GPIO_WritePin(OE_SYNC_GPIO_Port, OE_SYNC_Pin, GPIO_PIN_RESET);
 #endif
-
-#endif
 }
 
 bool IOExpander::test() {
-#if defined(EEZ_PLATFORM_STM32)    
     Channel &channel = Channel::getBySlotIndex(slotIndex);
     auto &slot = g_slots[slotIndex];
 
@@ -266,18 +263,10 @@ bool IOExpander::test() {
         }
 #endif
 	}
-#endif
-
-#if defined(EEZ_PLATFORM_SIMULATOR)
-    Channel &channel = Channel::getBySlotIndex(slotIndex);
-    g_testResult = TEST_OK;
-    channel.flags.powerOk = 1;
-#endif
 
 	return g_testResult != TEST_FAILED;
 }
 
-#if defined(EEZ_PLATFORM_STM32)
 void IOExpander::reinit() {
     const uint8_t N_REGS = sizeof(REG_VALUES) / 3;
     for (int i = 0; i < N_REGS; i++) {
@@ -293,15 +282,18 @@ void IOExpander::reinit() {
     	write(reg, value);
     }
 }
-#endif
 
 void IOExpander::tick(uint32_t tick_usec) {
-#if defined(EEZ_PLATFORM_STM32)    
     auto &slot = g_slots[slotIndex];
 
 	readGpio();
 
-    uint8_t iodira = read(REG_IODIRA);
+    uint8_t iodira = 0;
+    if (tick_usec - lastResetCheckTime >= RESET_CHECK_PERIOD_US) {
+        lastResetCheckTime = tick_usec;
+        iodira = read(REG_IODIRA);
+    }
+
     if (iodira == 0xFF || (gpio & gpioOutputPinsMask) != gpioWritten) {
         if (iodira == 0xFF) {
             event_queue::pushEvent(event_queue::EVENT_ERROR_CH1_IOEXP_RESET_DETECTED + slot.channelIndex);
@@ -313,40 +305,8 @@ void IOExpander::tick(uint32_t tick_usec) {
 
         readGpio();
     }
-#endif
-
-#if defined(EEZ_PLATFORM_SIMULATOR)
-    Channel &channel = Channel::getBySlotIndex(slotIndex);
-
-    if (simulator::getPwrgood(channel.channelIndex)) {
-        gpio |= 1 << IOExpander::IO_BIT_IN_PWRGOOD;
-    } else {
-        gpio &= ~(1 << IOExpander::IO_BIT_IN_PWRGOOD);
-    }
-
-    if (channel.params.features & CH_FEATURE_RPOL) {
-        if (!simulator::getRPol(channel.channelIndex)) {
-            gpio |= 1 << IOExpander::IO_BIT_IN_RPOL;
-        } else {
-            gpio &= ~(1 << IOExpander::IO_BIT_IN_RPOL);
-        }
-    }
-
-    if (simulator::getCV(channel.channelIndex)) {
-        gpio |= 1 << IOExpander::IO_BIT_IN_CV_ACTIVE;
-    } else {
-        gpio &= ~(1 << IOExpander::IO_BIT_IN_CV_ACTIVE);
-    }
-
-    if (simulator::getCC(channel.channelIndex)) {
-        gpio |= 1 << IOExpander::IO_BIT_IN_CC_ACTIVE;
-    } else {
-        gpio &= ~(1 << IOExpander::IO_BIT_IN_CC_ACTIVE);
-    }
-#endif
 }
 
-#if defined(EEZ_PLATFORM_STM32)
 int IOExpander::getBitDirection(int bit) {
     uint8_t dir;
     if (bit < 8) {
@@ -357,7 +317,6 @@ int IOExpander::getBitDirection(int bit) {
     }
     return dir & (1 << bit) ? 1 : 0;
 }
-#endif
 
 bool IOExpander::testBit(int io_bit) {
     auto result = (gpio & (1 << io_bit)) ? true : false;
@@ -373,13 +332,9 @@ bool IOExpander::testBit(int io_bit) {
 }
 
 bool IOExpander::isAdcReady() {
-#if defined(EEZ_PLATFORM_STM32)
     // ready = !HAL_GPIO_ReadPin(SPI2_IRQ_GPIO_Port, SPI2_IRQ_Pin);
 	auto &slot = g_slots[slotIndex];
     return !testBit(slot.moduleInfo->moduleType == MODULE_TYPE_DCP405 || slot.moduleInfo->moduleType == MODULE_TYPE_DCP405B ? DCP405_IO_BIT_IN_ADC_DRDY : DCP505_IO_BIT_IN_ADC_DRDY);
-#else
-    return true;
-#endif
 }
 
 void IOExpander::changeBit(int io_bit, bool set) {
@@ -390,7 +345,6 @@ void IOExpander::changeBit(int io_bit, bool set) {
         }
     }
 
-#if defined(EEZ_PLATFORM_STM32)
     if (io_bit < 8) {
         uint8_t oldValue = (uint8_t)gpioWritten;
         uint8_t newValue = set ? (oldValue | (1 << io_bit)) : (oldValue & ~(1 << io_bit));
@@ -404,16 +358,25 @@ void IOExpander::changeBit(int io_bit, bool set) {
             write(REG_GPIOB, newValue);
 	    }
     }
-#endif
 
     gpio = set ? (gpio | (1 << io_bit)) : (gpio & ~(1 << io_bit));
 }
 
-#if defined(EEZ_PLATFORM_STM32)
 void IOExpander::readGpio() {
-    uint8_t gpioa = read(REG_GPIOA);
-    uint8_t gpiob = read(REG_GPIOB);
-    gpio = (gpiob << 8) | gpioa;
+    // IOCON.BANK is 0, so address pointer toggles between GPIOA and GPIOB
+    // and both ports are read in a single transaction
+    uint8_t data[4];
+    data[0] = IOEXP_READ;
+    data[1] = REG_GPIOA;
+    data[2] = 0;
+    data[3] = 0;
+    uint8_t result[4];
+
+    spi::select(slotIndex, spi::CHIP_IOEXP);
+    spi::transfer(slotIndex, data, result, 4);
+    spi::deselect(slotIndex);
+
+    gpio = (result[3] << 8) | result[2];
 }
 
 uint8_t IOExpander::read(uint8_t reg) {
@@ -449,26 +412,15 @@ void IOExpander::write(uint8_t reg, uint8_t val) {
 
     spi::deselect(slotIndex);
 }
-#endif
 
-#if defined(EEZ_PLATFORM_STM32)
 uint8_t IOExpander::readIntcapRegister() {
     return read(REG_INTCAPA);
 }
-#endif
 
 void IOExpander::readAllRegisters(uint8_t registers[]) {
-#if defined(EEZ_PLATFORM_STM32)
     for (int i = 0; i < 22; i++) {
         registers[i] = read(i);
     }
-#endif
-
-#if defined(EEZ_PLATFORM_SIMULATOR)
-    for (int i = 0; i < 22; i++) {
-        registers[i] = 0;
-    }
-#endif
 }
 
 }
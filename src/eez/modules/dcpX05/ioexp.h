@@ -73,10 +73,8 @@ public:
     bool testBit(int io_bit);
     void changeBit(int io_bit, bool set);
 
-#if defined(EEZ_PLATFORM_STM32)
     int getBitDirection(int io_bit); // 0: output, 1: input
     uint8_t readIntcapRegister();
-#endif
 
     bool isAdcReady();
 
@@ -85,9 +83,9 @@ public:
     uint16_t gpio;
 
 private:
-#if defined(EEZ_PLATFORM_STM32)
     uint16_t gpioWritten;
     uint16_t gpioOutputPinsMask;
+    uint32_t lastResetCheckTime;
 
     uint8_t getRegValue(int i);
 
@@ -95,7 +93,6 @@ private:
     void readGpio();
     uint8_t read(uint8_t reg);
     void write(uint8_t reg, uint8_t val);
-#endif
 };
 
 } // namespace psu
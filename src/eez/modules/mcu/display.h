@@ -84,6 +84,12 @@ uint8_t getOpacity();
 
 const uint8_t * takeScreenshot();
 
+// Asks the GUI thread to copy the visible 480x272 frame, as RGB565, to REMOTE_DISPLAY_MEMORY
+// during the next sync. If onlyIfChanged is true, copy is postponed until the frame changes.
+void requestFrame(bool onlyIfChanged);
+// Returns the copied frame once the request is served, nullptr while it is pending.
+const uint16_t *getRequestedFrame();
+
 void clearDirty();
 // void markDirty(int x1, int y1, int x2, int y2);
 extern bool g_dirty;
@@ -102,6 +108,8 @@ void bitBlt(void *src, int x1, int y1, int x2, int y2);
 void bitBlt(void *src, void *dst, int x1, int y1, int x2, int y2);
 void bitBlt(void *src, void *dst, int sx, int sy, int sw, int sh, int dx, int dy, uint8_t opacity);
 void drawBitmap(Image *image, int x, int y);
+// wait until the last bitBlt or drawBitmap is done reading its source pixels
+void waitBitBlt();
 void drawStr(const char *text, int textLength, int x, int y, int clip_x1, int clip_y1, int clip_x2,
              int clip_y2, gui::font::Font &font);
 int8_t measureGlyph(uint8_t encoding, gui::font::Font &font);
@@ -53,6 +53,8 @@ static int16_t g_diffCounter;
 #if defined(EEZ_PLATFORM_SIMULATOR)
 bool g_simulatorClicked;
 #endif	
+static volatile int16_t g_remoteDiffCounter;
+static volatile bool g_remoteClicked;
 static float g_accumulatedCounter;
 EncoderMode g_encoderMode = ENCODER_MODE_AUTO;
 
@@ -159,6 +161,10 @@ int getCounter() {
     int16_t diffCounter = g_diffCounter;
     g_diffCounter -= diffCounter;
 
+    int16_t remoteDiffCounter = g_remoteDiffCounter;
+    g_remoteDiffCounter -= remoteDiffCounter;
+    diffCounter += remoteDiffCounter;
+
     g_totalCounter += diffCounter;
     psu::debug::g_encoderCounter.set(g_totalCounter);
 
@@ -179,6 +185,11 @@ void resetEncoder() {
 }
 
 bool isButtonClicked() {
+    if (g_remoteClicked) {
+        g_remoteClicked = false;
+        return true;
+    }
+
 #if defined(EEZ_PLATFORM_SIMULATOR)
     return g_simulatorClicked;
 #endif
@@ -203,6 +214,13 @@ void write(int counter, bool clicked) {
 }
 #endif
 
+void writeRemote(int counter, bool clicked) {
+    g_remoteDiffCounter += counter;
+    if (clicked) {
+        g_remoteClicked = true;
+    }
+}
+
 void switchEncoderMode() {
     if (g_encoderMode == ENCODER_MODE_STEP4) {
         g_encoderMode = ENCODER_MODE_AUTO;
@@ -45,6 +45,9 @@ int getAutoModeStepLevel();
 void write(int counter, bool clicked);
 #endif
 
+// encoder rotation and click received from the remote display client
+void writeRemote(int counter, bool clicked);
+
 void switchEncoderMode();
 
 #if defined(EEZ_PLATFORM_STM32)
@@ -420,6 +420,10 @@ bool bind(int port) {
         return false;
     }
 
+    // simulator restarted right after it was closed can bind again to the same port
+    int reuseAddress = 1;
+    setsockopt(listen_socket, SOL_SOCKET, SO_REUSEADDR, &reuseAddress, sizeof(reuseAddress));
+
     bzero((char *)&serv_addr, sizeof(serv_addr));
     serv_addr.sin_family = AF_INET;
     serv_addr.sin_addr.s_addr = INADDR_ANY;
@@ -685,8 +689,12 @@ void mainLoop(const void *) {
             }
         } else {
             onIdle();
-            mqtt::tick();
-            ntp::tick();
+            // thread is started early in the boot to connect in parallel with it,
+            // but MQTT reads the channels and NTP sets the clock, so they wait for the boot to finish
+            if (g_isBooted) {
+                mqtt::tick();
+                ntp::tick();
+            }
         }
     }
 }
@@ -0,0 +1,428 @@
+/*
+ * EEZ Modular Firmware
+ * Copyright (C) 2015-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if OPTION_ETHERNET
+
+#include <stdint.h>
+#include <string.h>
+
+#include <eez/system.h>
+#include <eez/debug.h>
+#include <eez/memory.h>
+#include <eez/gui/gui.h>
+#include <eez/modules/mcu/display.h>
+#include <eez/modules/mcu/encoder.h>
+#include <eez/modules/mcu/remote_display.h>
+#include <eez/modules/mcu/tcp_server.h>
+
+#if defined(EEZ_PLATFORM_SIMULATOR)
+#include <eez/modules/psu/gui/psu.h>
+#endif
+
+#define LZ4_STATIC_LINKING_ONLY
+#include <eez/libs/lz4/lz4.h>
+
+#define CONF_FRAME_PERIOD_MS 5
+#define CONF_ACCEPT_PERIOD_MS 100
+#define CONF_SEND_BUFFER_SIZE 4096
+
+namespace eez {
+namespace mcu {
+namespace remote_display {
+
+static const int WIDTH = 480;
+static const int HEIGHT = 272;
+static const int NUM_TILES_X = WIDTH / TILE_SIZE;
+static const int NUM_TILES_Y = HEIGHT / TILE_SIZE;
+static const int NUM_TILES = NUM_TILES_X * NUM_TILES_Y;
+static const int TILE_DATA_SIZE = TILE_SIZE * TILE_SIZE * 2;
+static const int TILE_HEADER_SIZE = 8;
+
+struct CacheEntry {
+    uint64_t hash;
+    bool valid;
+};
+
+// lives in SDRAM, after the RGB565 frame buffer (see REMOTE_DISPLAY_MEMORY)
+struct Encoder {
+    // hashes of the tiles client is currently showing
+    uint64_t tileHashes[NUM_TILES];
+    uint16_t changedTiles[NUM_TILES];
+    // mirror of the client side tile cache
+    CacheEntry cache[CACHE_SIZE];
+    LZ4_stream_t lz4State;
+    uint8_t tile[TILE_DATA_SIZE];
+    uint8_t sendBuffer[CONF_SEND_BUFFER_SIZE];
+};
+
+static_assert(sizeof(Encoder) <= REMOTE_DISPLAY_MEMORY_SIZE - REMOTE_DISPLAY_FRAME_BUFFER_SIZE, "REMOTE_DISPLAY_MEMORY_SIZE is too small");
+
+static Encoder &g_encoder = *(Encoder *)(REMOTE_DISPLAY_MEMORY + REMOTE_DISPLAY_FRAME_BUFFER_SIZE);
+
+static void mainLoop(const void *);
+
+#if defined(EEZ_PLATFORM_STM32)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#endif
+
+osThreadDef(g_remoteDisplayTask, mainLoop, osPriorityBelowNormal, 0, 1024);
+
+#if defined(EEZ_PLATFORM_STM32)
+#pragma GCC diagnostic pop
+#endif
+
+static bool g_threadStarted;
+static volatile bool g_enabled;
+static volatile uint16_t g_port;
+
+static bool g_listening;
+static bool g_clientConnected;
+
+static bool g_frameRequested;
+static bool g_fullRefresh;
+
+static uint8_t g_inputBuffer[64];
+static int g_inputLength;
+
+static int g_sendLength;
+
+static TcpServer g_server;
+
+static struct {
+    uint32_t connectTime;
+    uint32_t frames;
+    uint32_t tiles;
+    uint32_t cachedTiles;
+    uint32_t bytes;
+} g_stats;
+
+////////////////////////////////////////////////////////////////////////////////
+
+static void put8(uint8_t value) {
+    g_encoder.sendBuffer[g_sendLength++] = value;
+}
+
+static void put16(uint16_t value) {
+    put8(value & 0xFF);
+    put8(value >> 8);
+}
+
+static void put32(uint32_t value) {
+    put16(value & 0xFFFF);
+    put16(value >> 16);
+}
+
+static bool flush() {
+    if (g_sendLength == 0) {
+        return true;
+    }
+
+    bool result = g_server.send(g_encoder.sendBuffer, g_sendLength);
+    g_stats.bytes += g_sendLength;
+    g_sendLength = 0;
+    return result;
+}
+
+// makes sure there is room for size bytes in the send buffer
+static bool reserve(int size) {
+    if (g_sendLength + size > CONF_SEND_BUFFER_SIZE) {
+        return flush();
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static void resetCache() {
+    for (int i = 0; i < CACHE_SIZE; i++) {
+        g_encoder.cache[i].valid = false;
+    }
+    g_fullRefresh = true;
+}
+
+// 64-bit FNV-1a over 32-bit words, two pixels at a time. Tiles are compared
+// and looked up in the cache by hash only, so it is wide enough to make
+// a collision (and wrong pixels on the client) practically impossible.
+static uint64_t hashTile(const uint16_t *src) {
+    uint64_t hash = 14695981039346656037ull;
+    for (int y = 0; y < TILE_SIZE; y++) {
+        const uint32_t *p = (const uint32_t *)src;
+        for (int x = 0; x < TILE_SIZE / 2; x++) {
+            hash = (hash ^ p[x]) * 1099511628211ull;
+        }
+        src += WIDTH;
+    }
+    return hash;
+}
+
+static void copyTile(const uint16_t *src, uint8_t *dst) {
+    for (int y = 0; y < TILE_SIZE; y++) {
+        memcpy(dst, src, TILE_SIZE * 2);
+        dst += TILE_SIZE * 2;
+        src += WIDTH;
+    }
+}
+
+static const uint16_t *getTile(const uint16_t *frame, int tileIndex) {
+    return frame + (tileIndex / NUM_TILES_X) * TILE_SIZE * WIDTH + (tileIndex % NUM_TILES_X) * TILE_SIZE;
+}
+
+static bool sendTile(const uint16_t *frame, int tileIndex) {
+    if (!reserve(TILE_HEADER_SIZE + TILE_DATA_SIZE)) {
+        return false;
+    }
+
+    uint64_t hash = g_encoder.tileHashes[tileIndex];
+
+    put16(tileIndex);
+    put32((uint32_t)hash);
+
+    CacheEntry &cacheEntry = g_encoder.cache[hash % CACHE_SIZE];
+    if (cacheEntry.valid && cacheEntry.hash == hash) {
+        put16(0);
+        g_stats.cachedTiles++;
+        return true;
+    }
+
+    cacheEntry.hash = hash;
+    cacheEntry.valid = true;
+
+    copyTile(getTile(frame, tileIndex), g_encoder.tile);
+
+    uint8_t *dst = g_encoder.sendBuffer + g_sendLength + 2;
+    int length = LZ4_compress_fast_extState_fastReset(&g_encoder.lz4State, (const char *)g_encoder.tile, (char *)dst, TILE_DATA_SIZE, TILE_DATA_SIZE - 1, 1);
+    if (length == 0) {
+        // incompressible, send it raw
+        memcpy(dst, g_encoder.tile, TILE_DATA_SIZE);
+        length = TILE_DATA_SIZE;
+    }
+
+    put16(length);
+    g_sendLength += length;
+
+    g_stats.tiles++;
+
+    return true;
+}
+
+static bool sendFrame() {
+    if (!g_frameRequested) {
+        display::requestFrame(!g_fullRefresh);
+        g_frameRequested = true;
+    }
+
+    const uint16_t *frame = display::getRequestedFrame();
+    if (!frame) {
+        return true;
+    }
+
+    g_frameRequested = false;
+
+    int numChangedTiles = 0;
+    for (int tileIndex = 0; tileIndex < NUM_TILES; tileIndex++) {
+        uint64_t hash = hashTile(getTile(frame, tileIndex));
+        if (g_fullRefresh || hash != g_encoder.tileHashes[tileIndex]) {
+            g_encoder.tileHashes[tileIndex] = hash;
+            g_encoder.changedTiles[numChangedTiles++] = tileIndex;
+        }
+    }
+
+    g_fullRefresh = false;
+
+    if (numChangedTiles == 0) {
+        return true;
+    }
+
+    // send buffer is empty here, it is flushed at the end of every frame
+    put8('F');
+    put8(0);
+    put16(numChangedTiles);
+    put32(g_stats.frames);
+
+    for (int i = 0; i < numChangedTiles; i++) {
+        if (!sendTile(frame, g_encoder.changedTiles[i])) {
+            return false;
+        }
+    }
+
+    g_stats.frames++;
+
+    return flush();
+}
+
+static bool processInput() {
+    int n = g_server.receive(g_inputBuffer + g_inputLength, sizeof(g_inputBuffer) - g_inputLength);
+    if (n < 0) {
+        return false;
+    }
+    g_inputLength += n;
+
+    int i = 0;
+    while (i < g_inputLength) {
+        uint8_t command = g_inputBuffer[i];
+
+        int size;
+        if (command == 'T') {
+            size = 6;
+        } else if (command == 'E') {
+            size = 3;
+        } else if (command == 'R') {
+            size = 1;
+        } else {
+            DebugTrace("REMOTE DISPLAY: unknown command %d\n", (int)command);
+            return false;
+        }
+
+        if (i + size > g_inputLength) {
+            break;
+        }
+
+        const uint8_t *params = g_inputBuffer + i + 1;
+
+        if (command == 'T') {
+            int x = params[0] | (params[1] << 8);
+            int y = params[2] | (params[3] << 8);
+#if defined(EEZ_PLATFORM_SIMULATOR)
+            // simulator touch is in the front panel window coordinates
+            x += psu::gui::g_psuAppContext.rect.x;
+            y += psu::gui::g_psuAppContext.rect.y;
+#endif
+            gui::touch::writeRemote(params[4] != 0, x, y);
+        } else if (command == 'E') {
+            encoder::writeRemote((int8_t)params[0], params[1] != 0);
+        } else {
+            resetCache();
+            g_frameRequested = false;
+        }
+
+        i += size;
+    }
+
+    g_inputLength -= i;
+    memmove(g_inputBuffer, g_inputBuffer + i, g_inputLength);
+
+    return true;
+}
+
+static bool onClientConnected() {
+    g_clientConnected = true;
+
+    memset(&g_stats, 0, sizeof(g_stats));
+    g_stats.connectTime = millis();
+
+    g_inputLength = 0;
+    g_sendLength = 0;
+
+    LZ4_resetStream(&g_encoder.lz4State);
+    resetCache();
+
+    // current frame is sent even if nothing is drawn
+    g_frameRequested = false;
+
+    put8('H');
+    put8(PROTOCOL_VERSION);
+    put8(TILE_SIZE);
+    put8(0);
+    put16(WIDTH);
+    put16(HEIGHT);
+    put16(CACHE_SIZE);
+
+    return flush();
+}
+
+static void disconnectClient() {
+    g_server.closeClient();
+    g_clientConnected = false;
+
+    DebugTrace("REMOTE DISPLAY: client disconnected after %d s, %d frames, %d tiles, %d from cache, %d KB sent\n",
+        (int)((millis() - g_stats.connectTime) / 1000), (int)g_stats.frames, (int)g_stats.tiles, (int)g_stats.cachedTiles, (int)(g_stats.bytes / 1024));
+}
+
+static void mainLoop(const void *) {
+    while (1) {
+        if (!g_enabled) {
+            if (g_clientConnected) {
+                disconnectClient();
+            }
+            if (g_listening) {
+                g_server.closeListen();
+                g_listening = false;
+            }
+            osDelay(CONF_ACCEPT_PERIOD_MS);
+            continue;
+        }
+
+        if (!g_listening) {
+            g_listening = g_server.listen(g_port);
+            if (!g_listening) {
+                DebugTrace("REMOTE DISPLAY: can't listen on port %d\n", (int)g_port);
+                g_enabled = false;
+                continue;
+            }
+        }
+
+        if (!g_clientConnected) {
+            if (!g_server.accept()) {
+                osDelay(CONF_ACCEPT_PERIOD_MS);
+                continue;
+            }
+
+            if (!onClientConnected()) {
+                disconnectClient();
+                continue;
+            }
+        } else {
+            // only one client at a time
+            g_server.rejectPendingClient();
+        }
+
+        if (!processInput() || !sendFrame()) {
+            disconnectClient();
+            continue;
+        }
+
+        osDelay(CONF_FRAME_PERIOD_MS);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void beginServer(uint16_t port) {
+    g_port = port;
+    g_enabled = true;
+
+    if (!g_threadStarted) {
+        g_threadStarted = true;
+        osThreadCreate(osThread(g_remoteDisplayTask), nullptr);
+    }
+}
+
+void endServer() {
+    g_enabled = false;
+}
+
+bool isClientConnected() {
+    return g_clientConnected;
+}
+
+} // namespace remote_display
+} // namespace mcu
+} // namespace eez
+
+#endif
@@ -0,0 +1,63 @@
+/*
+ * EEZ Modular Firmware
+ * Copyright (C) 2015-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Remote display streams the front panel display to a single TCP client and
+// accepts touch and encoder input from it. It is not authenticated, so it runs
+// only if enabled with SYSTem:COMMunicate:ENABle ON,RDISplay (off by default). Only the tiles that changed since
+// the last frame are sent, as LZ4 compressed RGB565 or as a reference into the
+// tile cache that the client keeps.
+//
+// All values are little endian.
+//
+// Server to client:
+//   hello:      'H', version (1), tile size (1), 0 (1), width (2), height (2), cache size (2)
+//   frame:      'F', 0 (1), number of tiles (2), frame number (4),
+//               followed by the tiles, top to bottom, left to right:
+//                 tile index (2), low 32 bits of the tile hash (4), data length (2), data
+//               Data length 0 means that tile is in the cache slot (hash % cache size,
+//               cache size is a power of two),
+//               tile size * tile size * 2 means raw RGB565 and anything else means
+//               LZ4 block which decompresses to raw RGB565. Tiles with data are stored
+//               by the client into their cache slot.
+//
+// Client to server:
+//   touch:      'T', x (2), y (2), pressed (1)
+//   encoder:    'E', counter (1, signed), clicked (1)
+//   refresh:    'R', client lost its state, send full frame and reset the cache
+
+namespace eez {
+namespace mcu {
+namespace remote_display {
+
+static const uint8_t PROTOCOL_VERSION = 1;
+static const int TILE_SIZE = 16;
+static const int CACHE_SIZE = 1024;
+static_assert((CACHE_SIZE & (CACHE_SIZE - 1)) == 0, "CACHE_SIZE must be a power of two");
+
+void beginServer(uint16_t port);
+void endServer();
+
+bool isClientConnected();
+
+} // namespace remote_display
+} // namespace mcu
+} // namespace eez
@@ -63,6 +63,12 @@ static uint32_t *g_lastBuffer;
 static bool g_takeScreenshot;
 static int g_screenshotY;
 
+static volatile bool g_frameRequested;
+static volatile bool g_onlyChangedFrameRequested;
+static volatile bool g_frameReady;
+static volatile uint32_t g_frameIndex;
+static volatile uint32_t g_takenFrameIndex;
+
 ////////////////////////////////////////////////////////////////////////////////
 
 // heuristics to find resource file
@@ -195,6 +201,7 @@ void updateBrightness() {
 
 void updateScreen(uint32_t *buffer) {
     g_lastBuffer = buffer;
+    g_frameIndex++;
 
     if (!isOn()) {
         return;
@@ -243,9 +250,31 @@ void animate() {
 }
 
 void doTakeScreenshot() {
-    uint8_t *src = (uint8_t *)(g_lastBuffer + g_psuAppContext.rect.y * DISPLAY_WIDTH + g_psuAppContext.rect.x);
+    const uint32_t *src = g_lastBuffer + g_psuAppContext.rect.y * DISPLAY_WIDTH + g_psuAppContext.rect.x;
     uint8_t *dst = SCREENSHOOT_BUFFER_START_ADDRESS;
 
+    int srcAdvance = DISPLAY_WIDTH - 480;
+
+    for (int y = 0; y < 272; y++) {
+        // read whole ARGB pixels instead of one byte at the time
+        for (int x = 0; x < 480; x++) {
+            uint32_t pixel = *src++;
+            dst[0] = (uint8_t)(pixel >> 16);
+            dst[1] = (uint8_t)(pixel >> 8);
+            dst[2] = (uint8_t)pixel;
+            dst += 3;
+        }
+        src += srcAdvance;
+    }
+
+    g_takeScreenshot = false;
+
+}
+
+void doTakeFrame() {
+    uint8_t *src = (uint8_t *)(g_lastBuffer + g_psuAppContext.rect.y * DISPLAY_WIDTH + g_psuAppContext.rect.x);
+    uint16_t *dst = (uint16_t *)REMOTE_DISPLAY_MEMORY;
+
     int srcAdvance = (DISPLAY_WIDTH - 480) * 4;
 
     for (int y = 0; y < 272; y++) {
@@ -255,15 +284,14 @@ void doTakeScreenshot() {
             uint8_t r = *src++;
             src++;
 
-            *dst++ = r;
-            *dst++ = g;
-            *dst++ = b;
+            *dst++ = RGB_TO_COLOR(r, g, b);
         }
         src += srcAdvance;
     }
 
-    g_takeScreenshot = false;
-
+    g_takenFrameIndex = g_frameIndex;
+    g_frameRequested = false;
+    g_frameReady = true;
 }
 
 void sync() {
@@ -272,7 +300,7 @@ void sync() {
     int32_t diff = 1000 / 60 - (tickCount - g_lastTickCount);
     g_lastTickCount = tickCount;
     if (diff > 0 && diff < 1000 / 60) {
-        SDL_Delay(diff);
+        osDelay(diff);
     }
 
     if (!isOn()) {
@@ -309,6 +337,9 @@ void sync() {
         clearDirty();
     }
 
+    if (g_frameRequested && g_lastBuffer && (!g_onlyChangedFrameRequested || g_frameIndex != g_takenFrameIndex)) {
+        doTakeFrame();
+    }
 }
 
 void finishAnimation() {
@@ -351,6 +382,20 @@ const uint8_t *takeScreenshot() {
     return SCREENSHOOT_BUFFER_START_ADDRESS;
 }
 
+void requestFrame(bool onlyIfChanged) {
+    g_frameReady = false;
+    g_onlyChangedFrameRequested = onlyIfChanged;
+    g_frameRequested = true;
+}
+
+const uint16_t *getRequestedFrame() {
+    if (!g_frameReady) {
+        return nullptr;
+    }
+    g_frameReady = false;
+    return (const uint16_t *)REMOTE_DISPLAY_MEMORY;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 static void doDrawGlyph(const gui::font::Glyph &glyph, int x_glyph, int y_glyph, int width, int height, int offset, int iStartByte) {
@@ -639,6 +684,9 @@ void drawBitmap(Image *image, int x, int y) {
     markDirty(x, y, x + image->width - 1, y + image->height - 1);
 }
 
+void waitBitBlt() {
+}
+
 void drawStr(const char *text, int textLength, int x, int y, int clip_x1, int clip_y1, int clip_x2, int clip_y2, gui::font::Font &font) {
     g_font = font;
 
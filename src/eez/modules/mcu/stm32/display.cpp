@@ -65,6 +65,12 @@ static uint16_t *g_animationBuffer;
 
 static bool g_takeScreenshot;
 
+static volatile bool g_frameRequested;
+static volatile bool g_onlyChangedFrameRequested;
+static volatile bool g_frameReady;
+static volatile uint32_t g_frameIndex;
+static volatile uint32_t g_takenFrameIndex;
+
 ////////////////////////////////////////////////////////////////////////////////
 
 #define DMA2D_WAIT while (HAL_DMA2D_PollForTransfer(&hdma2d, 1000) != HAL_OK)
@@ -451,6 +457,8 @@ void swapBuffers() {
     g_bufferOld = temp;
 
     g_buffer = g_bufferNew;
+
+    g_frameIndex++;
 }
 
 void sync() {
@@ -510,6 +518,14 @@ void sync() {
         DMA2D_WAIT;
     	g_takeScreenshot = false;
     }
+
+    if (g_frameRequested && (!g_onlyChangedFrameRequested || g_frameIndex != g_takenFrameIndex)) {
+        bitBlt(g_bufferOld, (uint16_t *)REMOTE_DISPLAY_MEMORY, 0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT);
+        DMA2D_WAIT;
+        g_takenFrameIndex = g_frameIndex;
+        g_frameRequested = false;
+        g_frameReady = true;
+    }
 }
 
 void finishAnimation() {
@@ -539,6 +555,20 @@ const uint8_t *takeScreenshot() {
 	return SCREENSHOOT_BUFFER_START_ADDRESS;
 }
 
+void requestFrame(bool onlyIfChanged) {
+    g_frameReady = false;
+    g_onlyChangedFrameRequested = onlyIfChanged;
+    g_frameRequested = true;
+}
+
+const uint16_t *getRequestedFrame() {
+    if (!g_frameReady) {
+        return nullptr;
+    }
+    g_frameReady = false;
+    return (const uint16_t *)REMOTE_DISPLAY_MEMORY;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 static int8_t drawGlyph(int x1, int y1, int clip_x1, int clip_y1, int clip_x2, int clip_y2,
@@ -672,6 +702,10 @@ void drawBitmap(Image *image, int x, int y) {
     markDirty(x, y, x + image->width - 1, y + image->height - 1);
 }
 
+void waitBitBlt() {
+    DMA2D_WAIT;
+}
+
 void drawStr(const char *text, int textLength, int x, int y, int clip_x1, int clip_y1, int clip_x2, int clip_y2, gui::font::Font &font) {
     g_font = font;
 
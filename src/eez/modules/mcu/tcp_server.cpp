@@ -0,0 +1,311 @@
+/*
+ * EEZ Modular Firmware
+ * Copyright (C) 2015-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if OPTION_ETHERNET
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(EEZ_PLATFORM_STM32)
+#include <api.h>
+#include <tcp.h>
+#include <tcpip.h>
+#endif
+
+#if defined(EEZ_PLATFORM_SIMULATOR)
+#ifdef EEZ_PLATFORM_SIMULATOR_WIN32
+#undef INPUT
+#undef OUTPUT
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <winsock2.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+#endif
+
+#include <eez/system.h>
+#include <eez/modules/mcu/tcp_server.h>
+
+#define CONF_SEND_TIMEOUT_MS 5000
+
+namespace eez {
+namespace mcu {
+
+#if defined(EEZ_PLATFORM_STM32)
+
+TcpServer::TcpServer()
+    : listenConnection(nullptr), clientConnection(nullptr), inputPbuf(nullptr), inputPbufOffset(0)
+{
+}
+
+bool TcpServer::listen(uint16_t port) {
+    listenConnection = netconn_new(NETCONN_TCP);
+    if (listenConnection == nullptr) {
+        return false;
+    }
+
+    if (netconn_bind(listenConnection, nullptr, port) != ERR_OK || netconn_listen(listenConnection) != ERR_OK) {
+        netconn_delete(listenConnection);
+        listenConnection = nullptr;
+        return false;
+    }
+
+    // netconn_accept returns ERR_WOULDBLOCK if there is no client waiting
+    netconn_set_nonblocking(listenConnection, 1);
+
+    return true;
+}
+
+void TcpServer::closeListen() {
+    netconn_close(listenConnection);
+    netconn_delete(listenConnection);
+    listenConnection = nullptr;
+}
+
+static struct netconn *acceptConnection(struct netconn *listenConnection) {
+    struct netconn *connection;
+    if (netconn_accept(listenConnection, &connection) != ERR_OK) {
+        return nullptr;
+    }
+    return connection;
+}
+
+bool TcpServer::accept() {
+    clientConnection = acceptConnection(listenConnection);
+    if (clientConnection == nullptr) {
+        return false;
+    }
+
+    // messages are small, don't wait for the ACK of the previous one
+    LOCK_TCPIP_CORE();
+    tcp_nagle_disable(clientConnection->pcb.tcp);
+    UNLOCK_TCPIP_CORE();
+
+    // don't block the caller forever if client stops reading
+    netconn_set_sendtimeout(clientConnection, CONF_SEND_TIMEOUT_MS);
+
+    return true;
+}
+
+void TcpServer::rejectPendingClient() {
+    struct netconn *connection = acceptConnection(listenConnection);
+    if (connection) {
+        netconn_close(connection);
+        netconn_delete(connection);
+    }
+}
+
+void TcpServer::closeClient() {
+    if (inputPbuf) {
+        pbuf_free(inputPbuf);
+        inputPbuf = nullptr;
+    }
+
+    netconn_close(clientConnection);
+    netconn_delete(clientConnection);
+    clientConnection = nullptr;
+}
+
+int TcpServer::receive(uint8_t *buffer, int size) {
+    if (inputPbuf == nullptr) {
+        err_t err = netconn_recv_tcp_pbuf_flags(clientConnection, &inputPbuf, NETCONN_DONTBLOCK);
+        if (err == ERR_WOULDBLOCK) {
+            return 0;
+        }
+        if (err != ERR_OK) {
+            inputPbuf = nullptr;
+            return -1;
+        }
+        inputPbufOffset = 0;
+    }
+
+    int n = pbuf_copy_partial(inputPbuf, buffer, size, inputPbufOffset);
+    inputPbufOffset += n;
+
+    if (inputPbufOffset >= inputPbuf->tot_len) {
+        pbuf_free(inputPbuf);
+        inputPbuf = nullptr;
+    }
+
+    return n;
+}
+
+bool TcpServer::send(const uint8_t *data, int length) {
+    return netconn_write(clientConnection, data, length, NETCONN_COPY) == ERR_OK;
+}
+
+#endif
+
+#if defined(EEZ_PLATFORM_SIMULATOR)
+
+#ifdef EEZ_PLATFORM_SIMULATOR_WIN32
+typedef SOCKET Socket;
+#define INVALID_SOCKET_HANDLE INVALID_SOCKET
+#define closeSocket closesocket
+#else
+typedef int Socket;
+#define INVALID_SOCKET_HANDLE -1
+#define closeSocket close
+#endif
+
+#ifdef MSG_NOSIGNAL
+#define SEND_FLAGS MSG_NOSIGNAL
+#else
+#define SEND_FLAGS 0
+#endif
+
+static bool wouldBlock() {
+#ifdef EEZ_PLATFORM_SIMULATOR_WIN32
+    return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+    return errno == EAGAIN || errno == EWOULDBLOCK;
+#endif
+}
+
+static bool setNonBlocking(Socket socket) {
+#ifdef EEZ_PLATFORM_SIMULATOR_WIN32
+    u_long mode = 1;
+    return ioctlsocket(socket, FIONBIO, &mode) == 0;
+#else
+    int flags = fcntl(socket, F_GETFL, 0);
+    return flags != -1 && fcntl(socket, F_SETFL, flags | O_NONBLOCK) != -1;
+#endif
+}
+
+TcpServer::TcpServer()
+    : listenSocket((intptr_t)INVALID_SOCKET_HANDLE), clientSocket((intptr_t)INVALID_SOCKET_HANDLE)
+{
+}
+
+bool TcpServer::listen(uint16_t port) {
+#ifdef EEZ_PLATFORM_SIMULATOR_WIN32
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+        return false;
+    }
+#endif
+
+    Socket socket = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (socket == INVALID_SOCKET_HANDLE) {
+        return false;
+    }
+
+    int reuseAddress = 1;
+    setsockopt(socket, SOL_SOCKET, SO_REUSEADDR, (const char *)&reuseAddress, sizeof(reuseAddress));
+
+    sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(port);
+
+    if (!setNonBlocking(socket) ||
+        ::bind(socket, (sockaddr *)&address, sizeof(address)) < 0 ||
+        ::listen(socket, 1) < 0
+    ) {
+        closeSocket(socket);
+        return false;
+    }
+
+    listenSocket = (intptr_t)socket;
+
+    return true;
+}
+
+void TcpServer::closeListen() {
+    closeSocket((Socket)listenSocket);
+    listenSocket = (intptr_t)INVALID_SOCKET_HANDLE;
+}
+
+bool TcpServer::accept() {
+    Socket socket = ::accept((Socket)listenSocket, nullptr, nullptr);
+    if (socket == INVALID_SOCKET_HANDLE) {
+        return false;
+    }
+
+    if (!setNonBlocking(socket)) {
+        closeSocket(socket);
+        return false;
+    }
+
+    // messages are small, don't wait for the ACK of the previous one
+    int noDelay = 1;
+    setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, (const char *)&noDelay, sizeof(noDelay));
+
+    clientSocket = (intptr_t)socket;
+
+    return true;
+}
+
+void TcpServer::rejectPendingClient() {
+    Socket socket = ::accept((Socket)listenSocket, nullptr, nullptr);
+    if (socket != INVALID_SOCKET_HANDLE) {
+        closeSocket(socket);
+    }
+}
+
+void TcpServer::closeClient() {
+    closeSocket((Socket)clientSocket);
+    clientSocket = (intptr_t)INVALID_SOCKET_HANDLE;
+}
+
+int TcpServer::receive(uint8_t *buffer, int size) {
+    int n = ::recv((Socket)clientSocket, (char *)buffer, size, 0);
+    if (n > 0) {
+        return n;
+    }
+    if (n < 0 && wouldBlock()) {
+        return 0;
+    }
+    return -1;
+}
+
+bool TcpServer::send(const uint8_t *data, int length) {
+    uint32_t lastProgressTime = millis();
+
+    while (length > 0) {
+        int n = ::send((Socket)clientSocket, (const char *)data, length, SEND_FLAGS);
+        if (n < 0) {
+            if (!wouldBlock() || millis() - lastProgressTime > CONF_SEND_TIMEOUT_MS) {
+                return false;
+            }
+            osDelay(1);
+            continue;
+        }
+
+        data += n;
+        length -= n;
+        lastProgressTime = millis();
+    }
+
+    return true;
+}
+
+#endif
+
+} // namespace mcu
+} // namespace eez
+
+#endif
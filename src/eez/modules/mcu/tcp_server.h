@@ -0,0 +1,68 @@
+/*
+ * EEZ Modular Firmware
+ * Copyright (C) 2015-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#if defined(EEZ_PLATFORM_STM32)
+struct netconn;
+struct pbuf;
+#endif
+
+namespace eez {
+namespace mcu {
+
+// Non-blocking TCP server with a single client, used by the servers that are
+// running in their own thread next to the SCPI server (remote display,
+// measurement stream). None of the functions is waiting for the client,
+// except send which waits until all the data is accepted by the TCP stack.
+class TcpServer {
+public:
+    TcpServer();
+
+    bool listen(uint16_t port);
+    void closeListen();
+
+    // accepts waiting client, returns false if there is none
+    bool accept();
+    // closes waiting client, used while the other client is connected
+    void rejectPendingClient();
+    void closeClient();
+
+    // returns number of received bytes, 0 if nothing is received or -1 if client is disconnected
+    int receive(uint8_t *buffer, int size);
+    bool send(const uint8_t *data, int length);
+
+private:
+#if defined(EEZ_PLATFORM_STM32)
+    struct netconn *listenConnection;
+    struct netconn *clientConnection;
+    struct pbuf *inputPbuf;
+    uint16_t inputPbufOffset;
+#endif
+
+#if defined(EEZ_PLATFORM_SIMULATOR)
+    // SOCKET on Windows, file descriptor everywhere else
+    intptr_t listenSocket;
+    intptr_t clientSocket;
+#endif
+};
+
+} // namespace mcu
+} // namespace eez
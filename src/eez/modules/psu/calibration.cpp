@@ -61,6 +61,8 @@ void Value::reset() {
 
     numPoints = 2;
 
+    model = MODEL_LINEAR;
+
     points[0].set = true;
     points[1].set = true;
 
@@ -214,7 +216,7 @@ Channel &getCalibrationChannel() {
 
 void start(Channel &channel) {
     if (osThreadGetId() != g_psuTaskHandle) {
-        osMessagePut(g_psuMessageQueueId, PSU_QUEUE_MESSAGE(PSU_QUEUE_MESSAGE_TYPE_CALIBRATION_START, channel.channelIndex), osWaitForever);
+        sendMessageToPsu(PSU_QUEUE_MESSAGE_TYPE_CALIBRATION_START, channel.channelIndex);
         return;
     }
 
@@ -248,7 +250,7 @@ void start(Channel &channel) {
 
 void stop() {
     if (osThreadGetId() != g_psuTaskHandle) {
-        osMessagePut(g_psuMessageQueueId, PSU_QUEUE_MESSAGE(PSU_QUEUE_MESSAGE_TYPE_CALIBRATION_STOP, 0), osWaitForever);
+        sendMessageToPsu(PSU_QUEUE_MESSAGE_TYPE_CALIBRATION_STOP);
         return;
     }
 
@@ -269,6 +271,7 @@ void stop() {
 
 void copyValueFromChannel(Channel::CalibrationValueConfiguration &channelValue, Value &value) {
     value.numPoints = channelValue.numPoints;
+    value.model = (Model)channelValue.model;
     for (unsigned int i = 0; i < channelValue.numPoints; i++) {
         value.points[i].set = true;
         value.points[i].dac = channelValue.points[i].dac;
@@ -413,6 +416,7 @@ bool save() {
 
     if (isVoltageCalibrated()) {
         g_channel->cal_conf.u.numPoints = g_voltage.numPoints;
+        g_channel->cal_conf.u.model = g_voltage.model;
         for (int i = 0; i < g_voltage.numPoints; i++) {
             g_channel->cal_conf.u.points[i].dac = g_voltage.points[i].dac;
             g_channel->cal_conf.u.points[i].value = g_voltage.points[i].value;
@@ -422,6 +426,7 @@ bool save() {
 
     if (isCurrentCalibrated(g_currents[0])) {
         g_channel->cal_conf.i[0].numPoints = g_currents[0].numPoints;
+        g_channel->cal_conf.i[0].model = g_currents[0].model;
         for (int i = 0; i < g_currents[0].numPoints; i++) {
             g_channel->cal_conf.i[0].points[i].dac = g_currents[0].points[i].dac;
             g_channel->cal_conf.i[0].points[i].value = g_currents[0].points[i].value;
@@ -431,6 +436,7 @@ bool save() {
 
     if (hasSupportForCurrentDualRange() && isCurrentCalibrated(g_currents[1])) {
         g_channel->cal_conf.i[1].numPoints = g_currents[1].numPoints;
+        g_channel->cal_conf.i[1].model = g_currents[1].model;
         for (int i = 0; i < g_currents[1].numPoints; i++) {
             g_channel->cal_conf.i[1].points[i].dac = g_currents[1].points[i].dac;
             g_channel->cal_conf.i[1].points[i].value = g_currents[1].points[i].value;
@@ -438,6 +444,8 @@ bool save() {
         }
     }
 
+    g_channel->compileCalibrationCurves();
+
     // TODO move this to scpi thread
     return persist_conf::saveChannelCalibration(*g_channel);
 }
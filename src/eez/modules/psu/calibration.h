@@ -46,6 +46,7 @@ struct Value {
     int8_t numPoints;
     int8_t currentPointIndex;
     ValuePoint points[MAX_CALIBRATION_POINTS];
+    Model model;
 
     Value(CalibrationValueType type);
 
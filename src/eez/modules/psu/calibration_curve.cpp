@@ -0,0 +1,90 @@
+/*
+ * EEZ Modular Firmware
+ * Copyright (C) 2020-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <eez/modules/psu/psu.h>
+
+#include <eez/modules/psu/calibration_curve.h>
+
+namespace eez {
+namespace psu {
+namespace calibration {
+
+static void setLine(Curve::Segment &segment, float x0, float y0, float slope) {
+    segment.x0 = x0;
+    segment.y0 = y0;
+    segment.b = slope;
+    segment.c = 0;
+    segment.d = 0;
+}
+
+void Curve::compile(Model model, const float *x_, const float *y, int numPoints_) {
+    if (numPoints_ < 2) {
+        numPoints = 0;
+        setLine(segments[0], 0, 0, 1.0f);
+        return;
+    }
+
+    numPoints = numPoints_;
+
+    // secant slopes, all divisions are done here
+    float h[MAX_CALIBRATION_POINTS - 1];
+    float delta[MAX_CALIBRATION_POINTS - 1];
+    for (int i = 0; i < numPoints - 1; i++) {
+        h[i] = x_[i + 1] - x_[i];
+        delta[i] = h[i] != 0 ? (y[i + 1] - y[i]) / h[i] : 0;
+    }
+
+    // tangents at the points
+    float m[MAX_CALIBRATION_POINTS];
+    if (model == MODEL_CUBIC) {
+        m[0] = delta[0];
+        m[numPoints - 1] = delta[numPoints - 2];
+        for (int i = 1; i < numPoints - 1; i++) {
+            if (delta[i - 1] * delta[i] <= 0) {
+                // local extreme
+                m[i] = 0;
+            } else {
+                // weighted harmonic mean keeps the curve monotone
+                m[i] = 3 * (h[i - 1] + h[i]) / ((2 * h[i] + h[i - 1]) / delta[i - 1] + (h[i] + 2 * h[i - 1]) / delta[i]);
+            }
+        }
+    }
+
+    for (int i = 0; i < numPoints; i++) {
+        x[i] = x_[i];
+    }
+
+    setLine(segments[0], x_[0], y[0], delta[0]);
+
+    for (int i = 0; i < numPoints - 1; i++) {
+        Segment &segment = segments[i + 1];
+        setLine(segment, x_[i], y[i], delta[i]);
+
+        if (model == MODEL_CUBIC && h[i] != 0) {
+            segment.b = m[i];
+            segment.c = (3 * delta[i] - 2 * m[i] - m[i + 1]) / h[i];
+            segment.d = (m[i] + m[i + 1] - 2 * delta[i]) / (h[i] * h[i]);
+        }
+    }
+
+    setLine(segments[numPoints], x_[numPoints - 1], y[numPoints - 1], delta[numPoints - 2]);
+}
+
+} // namespace calibration
+} // namespace psu
+} // namespace eez
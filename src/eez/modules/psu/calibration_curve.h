@@ -0,0 +1,74 @@
+/*
+ * EEZ Modular Firmware
+ * Copyright (C) 2020-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+namespace eez {
+namespace psu {
+namespace calibration {
+
+/// How calibration points are connected.
+enum Model {
+    /// Straight line between neighbouring points.
+    MODEL_LINEAR,
+    /// Monotone piecewise cubic (Fritsch-Carlson) through all the points,
+    /// smooth at the points and never overshoots between them.
+    MODEL_CUBIC
+};
+
+/// Calibration curve compiled from the calibration points when calibration
+/// configuration changes, so that the conversion of every ADC sample and every
+/// DAC setpoint is a short segment search and a polynomial without divisions.
+///
+/// Segment k (1 .. numPoints - 1) is between points k - 1 and k. Segments 0
+/// and numPoints are straight line extensions of the first and the last
+/// segment, below the first and above the last point.
+struct Curve {
+    struct Segment {
+        // y = y0 + dx * (b + dx * (c + dx * d)), dx = x - x0
+        float x0;
+        float y0;
+        float b;
+        float c;
+        float d;
+    };
+
+    uint8_t numPoints;
+    float x[MAX_CALIBRATION_POINTS];
+    Segment segments[MAX_CALIBRATION_POINTS + 1];
+
+    /// Points must be sorted by x. With less then 2 points curve is identity.
+    void compile(Model model, const float *x, const float *y, int numPoints);
+
+    float evaluate(float value) const {
+        int i = 0;
+        while (i < numPoints && value > x[i]) {
+            i++;
+        }
+
+        const Segment &segment = segments[i];
+        float dx = value - segment.x0;
+        return segment.y0 + dx * (segment.b + dx * (segment.c + dx * segment.d));
+    }
+};
+
+} // namespace calibration
+} // namespace psu
+} // namespace eez
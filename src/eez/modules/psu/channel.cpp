@@ -24,6 +24,7 @@
 
 #include <eez/firmware.h>
 #include <eez/system.h>
+#include <eez/memory.h>
 #include <eez/modules/psu/board.h>
 #include <eez/modules/psu/calibration.h>
 #include <eez/modules/psu/channel_dispatcher.h>
@@ -33,7 +34,9 @@
 #include <eez/modules/psu/persist_conf.h>
 #include <eez/modules/psu/profile.h>
 #include <eez/modules/psu/ramp.h>
+#include <eez/modules/psu/stream.h>
 #include <eez/modules/psu/trigger.h>
+#include <eez/modules/psu/waveform.h>
 #include <eez/scpi/regs.h>
 #include <eez/sound.h>
 #include <eez/index.h>
@@ -75,6 +78,39 @@ void Channel::Value::resetMonValues() {
     mon_measured = false;
 }
 
+void Channel::Statistics::reset() {
+    count = 0;
+    min = 0;
+    max = 0;
+    sum = 0;
+    sumOfSquares = 0;
+}
+
+void Channel::Statistics::add(float value) {
+    if (count == 0) {
+        min = value;
+        max = value;
+    } else if (value < min) {
+        min = value;
+    } else if (value > max) {
+        max = value;
+    }
+
+    count++;
+    sum += value;
+    sumOfSquares += (double)value * value;
+}
+
+float Channel::Statistics::getMean() {
+    return count > 0 ? (float)(sum / count) : 0;
+}
+
+float Channel::Statistics::getRms() {
+    return count > 0 ? (float)sqrt(sumOfSquares / count) : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void Channel::Value::addMonValue(float value, float prec) {
     if (io_pins::isInhibited()) {
         value = 0;
@@ -158,7 +194,7 @@ static uint16_t g_oeSavedState;
 
 void Channel::saveAndDisableOE() {
     if (osThreadGetId() != g_psuTaskHandle) {
-        osMessagePut(g_psuMessageQueueId, PSU_QUEUE_MESSAGE(PSU_QUEUE_TRIGGER_CHANNEL_SAVE_AND_DISABLE_OE, 0), 0);
+        sendMessageToPsu(PSU_QUEUE_TRIGGER_CHANNEL_SAVE_AND_DISABLE_OE, 0, 0);
     } else {
         if (!g_oeSavedState) {
             for (int i = 0; i < CH_NUM; i++)  {
@@ -176,7 +212,7 @@ void Channel::saveAndDisableOE() {
 
 void Channel::restoreOE() {
     if (osThreadGetId() != g_psuTaskHandle) {
-        osMessagePut(g_psuMessageQueueId, PSU_QUEUE_MESSAGE(PSU_QUEUE_TRIGGER_CHANNEL_RESTORE_OE, 0), 0);
+        sendMessageToPsu(PSU_QUEUE_TRIGGER_CHANNEL_RESTORE_OE, 0, 0);
     } else {
         if (g_oeSavedState) {
             for (int i = 0; i < CH_NUM; i++)  {
@@ -193,147 +229,27 @@ void Channel::restoreOE() {
 ////////////////////////////////////////////////////////////////////////////////
 
 float Channel::getChannel0HistoryValue(uint32_t rowIndex, uint8_t columnIndex, float *max) {
-    Channel &channel = g_channels[0];
-
-    uint32_t position = rowIndex % CHANNEL_HISTORY_SIZE;
-    
-    if (columnIndex == 0) {
-        if (channel.flags.displayValue1 == DISPLAY_VALUE_VOLTAGE) {
-            return channel.uHistory[position];
-        }
-        if (channel.flags.displayValue1 == DISPLAY_VALUE_CURRENT) {
-            return channel.iHistory[position];
-        }
-    } else {
-        if (channel.flags.displayValue2 == DISPLAY_VALUE_VOLTAGE) {
-            return channel.uHistory[position];
-        }
-        if (channel.flags.displayValue2 == DISPLAY_VALUE_CURRENT) {
-            return channel.iHistory[position];
-        }
-    }
-
-    return channel.uHistory[position] * channel.iHistory[position];
+    return g_channels[0].getHistoryValue(rowIndex, columnIndex, max);
 }
 
 float Channel::getChannel1HistoryValue(uint32_t rowIndex, uint8_t columnIndex, float *max) {
-    Channel &channel = g_channels[1];
-
-    uint32_t position = rowIndex % CHANNEL_HISTORY_SIZE;
-
-    if (columnIndex == 0) {
-        if (channel.flags.displayValue1 == DISPLAY_VALUE_VOLTAGE) {
-            return channel.uHistory[position];
-        }
-        if (channel.flags.displayValue1 == DISPLAY_VALUE_CURRENT) {
-            return channel.iHistory[position];
-        }
-    } else {
-        if (channel.flags.displayValue2 == DISPLAY_VALUE_VOLTAGE) {
-            return channel.uHistory[position];
-        }
-        if (channel.flags.displayValue2 == DISPLAY_VALUE_CURRENT) {
-            return channel.iHistory[position];
-        }
-    }
-
-    return channel.uHistory[position] * channel.iHistory[position];
+    return g_channels[1].getHistoryValue(rowIndex, columnIndex, max);
 }
 
 float Channel::getChannel2HistoryValue(uint32_t rowIndex, uint8_t columnIndex, float *max) {
-    Channel &channel = g_channels[2];
-
-    uint32_t position = rowIndex % CHANNEL_HISTORY_SIZE;
-
-    if (columnIndex == 0) {
-        if (channel.flags.displayValue1 == DISPLAY_VALUE_VOLTAGE) {
-            return channel.uHistory[position];
-        }
-        if (channel.flags.displayValue1 == DISPLAY_VALUE_CURRENT) {
-            return channel.iHistory[position];
-        }
-    } else {
-        if (channel.flags.displayValue2 == DISPLAY_VALUE_VOLTAGE) {
-            return channel.uHistory[position];
-        }
-        if (channel.flags.displayValue2 == DISPLAY_VALUE_CURRENT) {
-            return channel.iHistory[position];
-        }
-    }
-
-    return channel.uHistory[position] * channel.iHistory[position];
+    return g_channels[2].getHistoryValue(rowIndex, columnIndex, max);
 }
 
 float Channel::getChannel3HistoryValue(uint32_t rowIndex, uint8_t columnIndex, float *max) {
-    Channel &channel = g_channels[3];
-
-    uint32_t position = rowIndex % CHANNEL_HISTORY_SIZE;
-
-    if (columnIndex == 0) {
-        if (channel.flags.displayValue1 == DISPLAY_VALUE_VOLTAGE) {
-            return channel.uHistory[position];
-        }
-        if (channel.flags.displayValue1 == DISPLAY_VALUE_CURRENT) {
-            return channel.iHistory[position];
-        }
-    } else {
-        if (channel.flags.displayValue2 == DISPLAY_VALUE_VOLTAGE) {
-            return channel.uHistory[position];
-        }
-        if (channel.flags.displayValue2 == DISPLAY_VALUE_CURRENT) {
-            return channel.iHistory[position];
-        }
-    }
-
-    return channel.uHistory[position] * channel.iHistory[position];
+    return g_channels[3].getHistoryValue(rowIndex, columnIndex, max);
 }
 
 float Channel::getChannel4HistoryValue(uint32_t rowIndex, uint8_t columnIndex, float *max) {
-    Channel &channel = g_channels[4];
-
-    uint32_t position = rowIndex % CHANNEL_HISTORY_SIZE;
-
-    if (columnIndex == 0) {
-        if (channel.flags.displayValue1 == DISPLAY_VALUE_VOLTAGE) {
-            return channel.uHistory[position];
-        }
-        if (channel.flags.displayValue1 == DISPLAY_VALUE_CURRENT) {
-            return channel.iHistory[position];
-        }
-    } else {
-        if (channel.flags.displayValue2 == DISPLAY_VALUE_VOLTAGE) {
-            return channel.uHistory[position];
-        }
-        if (channel.flags.displayValue2 == DISPLAY_VALUE_CURRENT) {
-            return channel.iHistory[position];
-        }
-    }
-
-    return channel.uHistory[position] * channel.iHistory[position];
+    return g_channels[4].getHistoryValue(rowIndex, columnIndex, max);
 }
 
 float Channel::getChannel5HistoryValue(uint32_t rowIndex, uint8_t columnIndex, float *max) {
-    Channel &channel = g_channels[5];
-
-    uint32_t position = rowIndex % CHANNEL_HISTORY_SIZE;
-
-    if (columnIndex == 0) {
-        if (channel.flags.displayValue1 == DISPLAY_VALUE_VOLTAGE) {
-            return channel.uHistory[position];
-        }
-        if (channel.flags.displayValue1 == DISPLAY_VALUE_CURRENT) {
-            return channel.iHistory[position];
-        }
-    } else {
-        if (channel.flags.displayValue2 == DISPLAY_VALUE_CURRENT) {
-            return channel.iHistory[position];
-        }
-        if (channel.flags.displayValue2 == DISPLAY_VALUE_VOLTAGE) {
-            return channel.uHistory[position];
-        }
-    }
-
-    return channel.uHistory[position] * channel.iHistory[position];
+    return g_channels[5].getHistoryValue(rowIndex, columnIndex, max);
 }
 
 Channel::YtDataGetValueFunctionPointer Channel::getChannelHistoryValueFuncs(int channelIndex) {
@@ -521,13 +437,13 @@ void Channel::protectionCheck(ProtectionValue &cpv) {
     if (state && isOutputEnabled() && condition) {
         if (delay > 0) {
             if (cpv.flags.alarmed) {
-                if (micros() - cpv.alarm_started >= delay * 1000000UL) {
+                if (micros64() - cpv.alarm_started >= (uint64_t)(delay * 1000000L)) {
                     cpv.flags.alarmed = 0;
                     protectionEnter(cpv);
                 }
             } else {
                 cpv.flags.alarmed = 1;
-                cpv.alarm_started = micros();
+                cpv.alarm_started = micros64();
             }
         } else {
             protectionEnter(cpv);
@@ -625,6 +541,7 @@ void Channel::reset() {
     p_limit = roundChannelValue(UNIT_WATT, params.PTOT);
 
     resetHistory();
+    resetStatistics();
 
     flags.displayValue1 = DISPLAY_VALUE_VOLTAGE;
     flags.displayValue2 = DISPLAY_VALUE_CURRENT;
@@ -637,6 +554,7 @@ void Channel::reset() {
     u.triggerLevel = params.U_MIN;
     i.triggerLevel = params.I_MIN;
     list::resetChannelList(*this);
+    waveform::resetChannelWaveform(*this);
 
     outputDelayDuration = 0;
 
@@ -648,8 +566,18 @@ void Channel::reset() {
     channelInterface->reset(subchannelIndex);
 }
 
+static uint32_t getYtViewRateUsec(float ytViewRate) {
+    uint32_t ytViewRateUsec = (uint32_t)round(ytViewRate * 1000000L);
+    return ytViewRateUsec < CHANNEL_HISTORY_LEVEL0_PERIOD_US ? CHANNEL_HISTORY_LEVEL0_PERIOD_US : ytViewRateUsec;
+}
+
 uint32_t Channel::getCurrentHistoryValuePosition() {
-	return historyPosition;
+    // positions start at CHANNEL_HISTORY_SIZE, so YT graph never has to go below 0
+    return CHANNEL_HISTORY_SIZE + (uint32_t)((uint64_t)historyIndex * CHANNEL_HISTORY_LEVEL0_PERIOD_US / getYtViewRateUsec(ytViewRate));
+}
+
+uint32_t Channel::getHistoryRefreshCounter() {
+    return historyResetCounter + getYtViewRateUsec(ytViewRate);
 }
 
 void Channel::resetHistoryForAllChannels() {
@@ -659,21 +587,274 @@ void Channel::resetHistoryForAllChannels() {
 }
 
 void Channel::resetHistory() {
-    for (int i = 0; i < CHANNEL_HISTORY_SIZE; ++i) {
-        uHistory[i] = 0;
-        iHistory[i] = 0;
-    }
+    // history is started again from the PSU thread
     flags.historyStarted = 0;
-    historyPosition = 1;
+    historyResetCounter++;
+}
+
+Channel::HistoryBucket *Channel::getHistoryBucket(int level, uint32_t bucketIndex) {
+    static_assert(CH_MAX * CHANNEL_HISTORY_NUM_LEVELS * CHANNEL_HISTORY_SIZE * sizeof(HistoryBucket) <= CHANNEL_HISTORY_MEMORY_SIZE, "CHANNEL_HISTORY_MEMORY_SIZE is too small");
+    HistoryBucket *buckets = (HistoryBucket *)CHANNEL_HISTORY_MEMORY + (channelIndex * CHANNEL_HISTORY_NUM_LEVELS + level) * CHANNEL_HISTORY_SIZE;
+    return buckets + bucketIndex % CHANNEL_HISTORY_SIZE;
+}
+
+/// Moves history to the bucket of the given time. Every new bucket (at each level)
+/// starts with the last monitored values, i.e. value is held between two ADC samples.
+/// Must be called before new ADC value is stored.
+void Channel::advanceHistory(uint32_t tickUsec) {
+    float uMon = channel_dispatcher::getUMonLast(*this);
+    float iMon = channel_dispatcher::getIMonLast(*this);
+
+    if (!flags.historyStarted) {
+        historyIndex = 0;
+        historyLastTick = tickUsec;
+
+        for (int level = 0; level < CHANNEL_HISTORY_NUM_LEVELS; level++) {
+            HistoryBucket *bucket = getHistoryBucket(level, 0);
+            bucket->uMin = bucket->uMax = uMon;
+            bucket->iMin = bucket->iMax = iMon;
+        }
+
+        flags.historyStarted = 1;
+        return;
+    }
+
+    int32_t diff = (int32_t)(tickUsec - historyLastTick);
+    if (diff < CHANNEL_HISTORY_LEVEL0_PERIOD_US) {
+        return;
+    }
+
+    uint32_t numPeriods = diff / CHANNEL_HISTORY_LEVEL0_PERIOD_US;
+    historyLastTick += numPeriods * CHANNEL_HISTORY_LEVEL0_PERIOD_US;
+
+    uint32_t newHistoryIndex = historyIndex + numPeriods;
+    if (newHistoryIndex < historyIndex) {
+        // history index overflow (after ~248 days), start again
+        resetHistory();
+        return;
+    }
+
+    uint32_t factor = 1;
+    for (int level = 0; level < CHANNEL_HISTORY_NUM_LEVELS; level++) {
+        uint32_t fromBucketIndex = historyIndex / factor + 1;
+        uint32_t toBucketIndex = newHistoryIndex / factor;
+        if (toBucketIndex >= fromBucketIndex) {
+            uint32_t numBuckets = toBucketIndex - fromBucketIndex + 1;
+            if (numBuckets > CHANNEL_HISTORY_SIZE) {
+                numBuckets = CHANNEL_HISTORY_SIZE;
+            }
+
+            for (uint32_t bucketIndex = toBucketIndex - numBuckets + 1; numBuckets > 0; bucketIndex++, numBuckets--) {
+                HistoryBucket *bucket = getHistoryBucket(level, bucketIndex);
+                bucket->uMin = bucket->uMax = uMon;
+                bucket->iMin = bucket->iMax = iMon;
+            }
+        }
+
+        factor *= CHANNEL_HISTORY_LEVEL_FACTOR;
+    }
+
+    historyIndex = newHistoryIndex;
+}
+
+/// Adds last monitored values to the current bucket of every history level.
+void Channel::addHistoryValue() {
+    if (!flags.historyStarted) {
+        return;
+    }
+
+    float uMon = channel_dispatcher::getUMonLast(*this);
+    float iMon = channel_dispatcher::getIMonLast(*this);
+
+    uint32_t factor = 1;
+    for (int level = 0; level < CHANNEL_HISTORY_NUM_LEVELS; level++) {
+        HistoryBucket *bucket = getHistoryBucket(level, historyIndex / factor);
+
+        if (uMon < bucket->uMin) {
+            bucket->uMin = uMon;
+        } else if (uMon > bucket->uMax) {
+            bucket->uMax = uMon;
+        }
+
+        if (iMon < bucket->iMin) {
+            bucket->iMin = iMon;
+        } else if (iMon > bucket->iMax) {
+            bucket->iMax = iMon;
+        }
+
+        factor *= CHANNEL_HISTORY_LEVEL_FACTOR;
+    }
+}
+
+/// Returns min (and max) of the displayed value during the YT graph pixel at rowIndex.
+/// Pixel is folded from the finest history level that still holds it, so changing
+/// ytViewRate doesn't require new collection period and short spikes are not lost.
+float Channel::getHistoryValue(uint32_t rowIndex, uint8_t columnIndex, float *max) {
+    if (!flags.historyStarted || rowIndex < CHANNEL_HISTORY_SIZE) {
+        if (max) {
+            *max = NAN;
+        }
+        return NAN;
+    }
+
+    uint32_t ytViewRateUsec = getYtViewRateUsec(ytViewRate);
+    uint32_t position = rowIndex - CHANNEL_HISTORY_SIZE;
+    uint32_t currentHistoryIndex = historyIndex;
+
+    // range of level 0 buckets covered by this pixel
+    uint32_t fromIndex = (uint32_t)((uint64_t)position * ytViewRateUsec / CHANNEL_HISTORY_LEVEL0_PERIOD_US);
+    uint32_t toIndex = (uint32_t)((uint64_t)(position + 1) * ytViewRateUsec / CHANNEL_HISTORY_LEVEL0_PERIOD_US);
+    if (fromIndex > currentHistoryIndex) {
+        if (max) {
+            *max = NAN;
+        }
+        return NAN;
+    }
+    if (toIndex > currentHistoryIndex + 1) {
+        toIndex = currentHistoryIndex + 1;
+    }
+    if (toIndex <= fromIndex) {
+        toIndex = fromIndex + 1;
+    }
+
+    // finest level with bucket period not longer then view rate ...
+    int level = 0;
+    uint32_t factor = 1;
+    while (level < CHANNEL_HISTORY_NUM_LEVELS - 1 && (uint64_t)factor * CHANNEL_HISTORY_LEVEL_FACTOR * CHANNEL_HISTORY_LEVEL0_PERIOD_US <= ytViewRateUsec) {
+        level++;
+        factor *= CHANNEL_HISTORY_LEVEL_FACTOR;
+    }
+
+    // ... that still holds this pixel
+    while (currentHistoryIndex / factor - fromIndex / factor >= CHANNEL_HISTORY_SIZE) {
+        if (level == CHANNEL_HISTORY_NUM_LEVELS - 1) {
+            if (max) {
+                *max = NAN;
+            }
+            return NAN;
+        }
+        level++;
+        factor *= CHANNEL_HISTORY_LEVEL_FACTOR;
+    }
+
+    unsigned displayValue = columnIndex == 0 ? flags.displayValue1 : flags.displayValue2;
+
+    float minValue = INFINITY;
+    float maxValue = -INFINITY;
+
+    for (uint32_t bucketIndex = fromIndex / factor; bucketIndex <= (toIndex - 1) / factor; bucketIndex++) {
+        HistoryBucket *bucket = getHistoryBucket(level, bucketIndex);
+
+        float bucketMin;
+        float bucketMax;
+        if (displayValue == DISPLAY_VALUE_VOLTAGE) {
+            bucketMin = bucket->uMin;
+            bucketMax = bucket->uMax;
+        } else if (displayValue == DISPLAY_VALUE_CURRENT) {
+            bucketMin = bucket->iMin;
+            bucketMax = bucket->iMax;
+        } else {
+            // power is not collected, this is the envelope of it
+            bucketMin = bucket->uMin * bucket->iMin;
+            bucketMax = bucket->uMax * bucket->iMax;
+        }
+
+        if (bucketMin < minValue) {
+            minValue = bucketMin;
+        }
+        if (bucketMax > maxValue) {
+            maxValue = bucketMax;
+        }
+    }
+
+    if (max) {
+        *max = maxValue;
+    }
+    return minValue;
+}
+
+void Channel::resetStatistics() {
+    // statistics are updated in PSU thread
+    if (osThreadGetId() != g_psuTaskHandle) {
+        sendMessageToPsu(PSU_QUEUE_MESSAGE_TYPE_RESET_CHANNEL_STATISTICS, channelIndex);
+        return;
+    }
+
+    beginStatisticsUpdate();
+
+    uStatistics.reset();
+    iStatistics.reset();
+
+    charge = 0;
+    energy = 0;
+    energyTime = 0;
+
+    endStatisticsUpdate();
+
+    energyStarted = false;
+}
+
+void Channel::beginStatisticsUpdate() {
+    statisticsSequence.store(statisticsSequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+void Channel::endStatisticsUpdate() {
+    statisticsSequence.store(statisticsSequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void Channel::getStatisticsSnapshot(StatisticsSnapshot &snapshot) {
+    // Readers have lower priority than PSU thread, so on the STM32 update is
+    // never in progress here, copy is repeated only if PSU thread preempted it
+    while (true) {
+        uint32_t sequence = statisticsSequence.load(std::memory_order_acquire);
+        if (sequence & 1) {
+            continue;
+        }
+
+        snapshot.u = uStatistics;
+        snapshot.i = iStatistics;
+        snapshot.charge = charge;
+        snapshot.energy = energy;
+        snapshot.energyTime = energyTime;
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (statisticsSequence.load(std::memory_order_relaxed) == sequence) {
+            return;
+        }
+    }
 }
 
 void Channel::clearCalibrationConf() {
-    cal_conf.u.numPoints = 0;
-    cal_conf.i[0].numPoints = 0;
-    cal_conf.i[1].numPoints = 0;
+    memset(&cal_conf.u, 0, sizeof(cal_conf.u));
+    memset(&cal_conf.i, 0, sizeof(cal_conf.i));
     
     cal_conf.calibrationDate = 0;
     strcpy(cal_conf.calibrationRemark, CALIBRATION_REMARK_INIT);
+
+    compileCalibrationCurves();
+}
+
+static void compileCalibrationCurves(Channel::CalibrationValueConfiguration &cal, calibration::Curve &adcCurve, calibration::Curve &dacCurve) {
+    float adc[MAX_CALIBRATION_POINTS];
+    float value[MAX_CALIBRATION_POINTS];
+    float dac[MAX_CALIBRATION_POINTS];
+
+    int numPoints = MIN(cal.numPoints, MAX_CALIBRATION_POINTS);
+    for (int i = 0; i < numPoints; i++) {
+        adc[i] = cal.points[i].adc;
+        value[i] = cal.points[i].value;
+        dac[i] = cal.points[i].dac;
+    }
+
+    adcCurve.compile((calibration::Model)cal.model, adc, value, numPoints);
+    dacCurve.compile((calibration::Model)cal.model, value, dac, numPoints);
+}
+
+void Channel::compileCalibrationCurves() {
+    psu::compileCalibrationCurves(cal_conf.u, uAdcCurve, uDacCurve);
+    psu::compileCalibrationCurves(cal_conf.i[0], iAdcCurve[0], iDacCurve[0]);
+    psu::compileCalibrationCurves(cal_conf.i[1], iAdcCurve[1], iDacCurve[1]);
 }
 
 void Channel::clearProtectionConf() {
@@ -697,9 +878,9 @@ void Channel::clearProtectionConf() {
     temperature::sensors[temp_sensor::CH1 + channelIndex].prot_conf.delay = OTP_CH_DEFAULT_DELAY;
 }
 
-bool Channel::test() {
+void Channel::testStart() {
     if (!isInstalled()) {
-        return true;
+        return;
     }
 
     flags.powerOk = 0;
@@ -708,8 +889,14 @@ bool Channel::test() {
     doRemoteProgrammingEnable(false);
 
     channelInterface->test(subchannelIndex);
+}
+
+bool Channel::testStep() {
+    if (!isInstalled()) {
+        return false;
+    }
 
-    return isOk();
+    return channelInterface->testStep(subchannelIndex);
 }
 
 bool Channel::isInstalled() {
@@ -744,6 +931,11 @@ void Channel::tick(uint32_t tick_usec) {
         return;
     }
 
+    if (isOutputEnabled()) {
+        // ADC is polled and protection is checked (including protection delay) on every tick
+        scheduleTick(CONF_PSU_TICK_POLL_PERIOD_US);
+    }
+
     channelInterface->tick(subchannelIndex, tick_usec);
 
     if (params.features & CH_FEATURE_RPOL) {
@@ -768,21 +960,9 @@ void Channel::tick(uint32_t tick_usec) {
         setCcMode(channelInterface->isCcMode(subchannelIndex));
     }
 
-    // update history values
-    if (!flags.historyStarted) {
-        flags.historyStarted = 1;
-        historyLastTick = tick_usec;
-        historyPosition = 1;
-    } else {
-        uint32_t ytViewRateMicroseconds = (int)round(ytViewRate * 1000000L);
-        while (tick_usec - historyLastTick >= ytViewRateMicroseconds) {
-            uint32_t historyIndex = historyPosition % CHANNEL_HISTORY_SIZE;
-            uHistory[historyIndex] = channel_dispatcher::getUMonLast(*this);
-            iHistory[historyIndex] = channel_dispatcher::getIMonLast(*this);
-            historyPosition++;
-            historyLastTick += ytViewRateMicroseconds;
-        }
-    }
+    // history is also advanced here, in case there are no ADC samples
+    advanceHistory(tick_usec);
+    addHistoryValue();
 
     doAutoSelectCurrentRange(tick_usec);
 }
@@ -844,32 +1024,57 @@ float Channel::roundChannelValue(Unit unit, float value) const {
     return roundPrec(value, getValuePrecision(unit, value));
 }
 
-float remapAdcValue(float value, Channel::CalibrationValueConfiguration &cal) {
-    unsigned int i;
-    
-    for (i = 1; i < cal.numPoints - 1 && value > cal.points[i].adc; i++) {
-    }
-
-    return remap(value,
-        cal.points[i - 1].adc,
-        cal.points[i - 1].value,
-        cal.points[i].adc,
-        cal.points[i].value);
-}
-
 void Channel::addUMonAdcValue(float value) {
+    advanceHistory(micros());
+
     if (isVoltageCalibrationEnabled()) {
-        value = remapAdcValue(value, cal_conf.u);
+        value = uAdcCurve.evaluate(value);
     }
     u.addMonValue(value, getVoltageResolution());
+
+    beginStatisticsUpdate();
+    uStatistics.add(u.mon_last);
+    endStatisticsUpdate();
+
+    addHistoryValue();
+
+#if OPTION_ETHERNET
+    stream::addSample(channelIndex, stream::QUANTITY_VOLTAGE, u.mon_last);
+#endif
 }
 
 void Channel::addIMonAdcValue(float value) {
+    advanceHistory(micros());
+
     if (isCurrentCalibrationEnabled()) {
-        value = remapAdcValue(value, cal_conf.i[flags.currentCurrentRange]);
+        value = iAdcCurve[flags.currentCurrentRange].evaluate(value);
     }
 
     i.addMonValue(value, getCurrentResolution());
+
+    beginStatisticsUpdate();
+
+    iStatistics.add(i.mon_last);
+
+    if (isOutputEnabled()) {
+        uint64_t time = micros64();
+        if (energyStarted) {
+            double dt = (time - energyLastTime) * 1E-6;
+            charge += i.mon_last * dt;
+            energy += u.mon_last * i.mon_last * dt;
+            energyTime += dt;
+        }
+        energyLastTime = time;
+        energyStarted = true;
+    }
+
+    endStatisticsUpdate();
+
+    addHistoryValue();
+
+#if OPTION_ETHERNET
+    stream::addSample(channelIndex, stream::QUANTITY_CURRENT, i.mon_last);
+#endif
 }
 
 void Channel::addUMonDacAdcValue(float value) {
@@ -970,6 +1175,9 @@ void Channel::executeOutputEnable(bool enable, uint16_t tasks) {
     if (tasks & OUTPUT_ENABLE_TASK_FINALIZE) {
         setOperBits(OPER_ISUM_OE_OFF, !enable);
 
+        // don't integrate charge and energy over the time output was disabled
+        energyStarted = false;
+
         if (!enable) {
             setCvMode(false);
             setCcMode(false);
@@ -1217,22 +1425,9 @@ bool Channel::isRemoteProgrammingEnabled() {
     return flags.rprogEnabled;
 }
 
-float remapValue(float value, Channel::CalibrationValueConfiguration &cal) {
-    unsigned int i;
-
-    for (i = 1; i < cal.numPoints - 1 && value > cal.points[i].value; i++) {
-    }
-
-    return remap(value,
-        cal.points[i - 1].value,
-        cal.points[i - 1].dac,
-        cal.points[i].value,
-        cal.points[i].dac);
-}
-
 float Channel::getCalibratedVoltage(float value) {
     if (isVoltageCalibrationEnabled()) {
-        value = remapValue(value, cal_conf.u);
+        value = uDacCurve.evaluate(value);
     }
 
 #if !defined(EEZ_PLATFORM_SIMULATOR)
@@ -1243,16 +1438,20 @@ float Channel::getCalibratedVoltage(float value) {
 }
 
 void Channel::doSetVoltage(float value) {
+    setVoltageSetpoint(value);
+
+	value = getCalibratedVoltage(value);
+
+    channelInterface->setDacVoltageFloat(subchannelIndex, value);
+}
+
+void Channel::setVoltageSetpoint(float value) {
     u.set = value;
     u.mon_dac = 0;
 
     if (prot_conf.u_level < u.set) {
         prot_conf.u_level = u.set;
     }
-
-	value = getCalibratedVoltage(value);
-
-    channelInterface->setDacVoltageFloat(subchannelIndex, value);
 }
 
 void Channel::setVoltage(float value) {
@@ -1274,16 +1473,26 @@ void Channel::doSetCurrent(float value) {
         }
     }
 
+    setCurrentSetpoint(value);
+
+    value = getCalibratedCurrent(value);
+
+    channelInterface->setDacCurrentFloat(subchannelIndex, value);
+}
+
+void Channel::setCurrentSetpoint(float value) {
     i.set = value;
     i.mon_dac = 0;
+}
 
+float Channel::getCalibratedCurrent(float value) {
     if (isCurrentCalibrationEnabled()) {
-        value = remapValue(value, cal_conf.i[flags.currentCurrentRange]);
+        value = iDacCurve[flags.currentCurrentRange].evaluate(value);
     }
 
     value += getDualRangeGndOffset();
 
-    channelInterface->setDacCurrentFloat(subchannelIndex, value);
+    return value;
 }
 
 void Channel::setCurrent(float value) {
@@ -1448,6 +1657,12 @@ void Channel::unlimitMaxCurrent() {
     limitMaxCurrent(MAX_CURRENT_LIMIT_CAUSE_NONE);
 }
 
+void Channel::unlimitMaxCurrent(MaxCurrentLimitCause cause) {
+    if (maxCurrentLimitCause == cause) {
+        unlimitMaxCurrent();
+    }
+}
+
 float Channel::getPowerLimit() const {
     return p_limit;
 }
@@ -1467,13 +1682,13 @@ void Channel::setPowerLimit(float limit) {
 }
 
 bool Channel::isVoltageLimitExceeded(float u) {
-    return channel_dispatcher::getValuePrecision(*this, UNIT_VOLT, u) >
-        channel_dispatcher::getValuePrecision(*this, UNIT_VOLT, channel_dispatcher::getULimit(*this));
+    return channel_dispatcher::roundChannelValue(*this, UNIT_VOLT, u) >
+        channel_dispatcher::roundChannelValue(*this, UNIT_VOLT, channel_dispatcher::getULimit(*this));
 }
 
 bool Channel::isCurrentLimitExceeded(float i) {
-    return channel_dispatcher::getValuePrecision(*this, UNIT_AMPER, i) >
-        channel_dispatcher::getValuePrecision(*this, UNIT_AMPER, channel_dispatcher::getILimit(*this));
+    return channel_dispatcher::roundChannelValue(*this, UNIT_AMPER, i) >
+        channel_dispatcher::roundChannelValue(*this, UNIT_AMPER, channel_dispatcher::getILimit(*this));
 }
 
 
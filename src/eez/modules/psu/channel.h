@@ -20,8 +20,11 @@
 
 #include <math.h>
 
+#include <atomic>
+
 #include <eez/modules/psu/persist_conf.h>
 #include <eez/modules/psu/temp_sensor.h>
+#include <eez/modules/psu/calibration_curve.h>
 
 #define IS_OVP_VALUE(channel, cpv) (&cpv == &channel->ovp)
 #define IS_OCP_VALUE(channel, cpv) (&cpv == &channel->ocp)
@@ -33,7 +36,8 @@ namespace psu {
 enum MaxCurrentLimitCause {
     MAX_CURRENT_LIMIT_CAUSE_NONE,
     MAX_CURRENT_LIMIT_CAUSE_FAN,
-    MAX_CURRENT_LIMIT_CAUSE_TEMPERATURE
+    MAX_CURRENT_LIMIT_CAUSE_TEMPERATURE,
+    MAX_CURRENT_LIMIT_CAUSE_THERMAL
 };
 
 extern int CH_NUM;
@@ -44,7 +48,7 @@ struct Value;
 
 enum DisplayValue { DISPLAY_VALUE_VOLTAGE, DISPLAY_VALUE_CURRENT, DISPLAY_VALUE_POWER };
 
-enum TriggerMode { TRIGGER_MODE_FIXED, TRIGGER_MODE_LIST, TRIGGER_MODE_STEP };
+enum TriggerMode { TRIGGER_MODE_FIXED, TRIGGER_MODE_LIST, TRIGGER_MODE_STEP, TRIGGER_MODE_FUNCTION };
 
 enum TriggerOnListStop {
     TRIGGER_ON_LIST_STOP_OUTPUT_OFF,
@@ -75,7 +79,7 @@ struct ProtectionFlags {
 /// Runtime protection values
 struct ProtectionValue {
     ProtectionFlags flags;
-    uint32_t alarm_started;
+    uint64_t alarm_started; // in microseconds
 };
 
 enum ChannelMode {
@@ -112,15 +116,17 @@ class Channel {
     };
 
     /// Calibration parameters for the voltage and current.
-    /// There are three points defined: `min`, `mid` and `max`.
-    /// Only `min` and `max` are used in actual calculations -
-    /// `mid` is only used for the validity checking.
-    /// Here is how `DAC` value is calculated from the `real_value` set by user:
-    /// `DAC = min.dac + (real_value - min.val) * (max.dac - min.dac) / (max.val - min.val);`
-    /// And here is how `real_value` is calculated from the `ADC` value:
-    /// `real_value = min.val + (ADC - min.adc) * (max.val - min.val) / (max.adc - min.adc);`
+    /// Points are connected with the curve selected by the `model`
+    /// (see calibration::Model). `DAC` value is calculated from the `real_value`
+    /// set by user by going through the (value, dac) points and `real_value` is
+    /// calculated from the `ADC` value by going through the (adc, value) points.
+    /// Both curves are compiled in advance, see Channel::compileCalibrationCurves.
     struct CalibrationValueConfiguration {
-        unsigned int numPoints;
+        // numPoints and model share what used to be 32-bit numPoints,
+        // so calibration stored by the older firmware is still valid
+        uint8_t numPoints;
+        uint8_t model;
+        uint8_t reserved[2];
         CalibrationValuePointConfiguration points[MAX_CALIBRATION_POINTS];
     };
 
@@ -236,6 +242,30 @@ class Channel {
         void addMonValue(float value, float precision);
     };
 
+    /// Running statistics of the measured values, updated on every ADC sample.
+    struct Statistics {
+        uint32_t count;
+        float min;
+        float max;
+        double sum;
+        double sumOfSquares;
+
+        void reset();
+        void add(float value);
+        float getMean();
+        float getRms();
+    };
+
+    /// Consistent copy of the statistics and of the charge and energy
+    /// accumulators, see getStatisticsSnapshot().
+    struct StatisticsSnapshot {
+        Statistics u;
+        Statistics i;
+        double charge;
+        double energy;
+        double energyTime;
+    };
+
 #ifdef EEZ_PLATFORM_SIMULATOR
     /// Per channel simulator data
     struct Simulator {
@@ -306,6 +336,13 @@ class Channel {
     CalibrationConfiguration cal_conf;
     ChannelProtectionConfiguration prot_conf;
 
+    /// Compiled from cal_conf: ADC to value and value to DAC curves
+    /// for the voltage and for the currents in both ranges.
+    calibration::Curve uAdcCurve;
+    calibration::Curve uDacCurve;
+    calibration::Curve iAdcCurve[2];
+    calibration::Curve iDacCurve[2];
+
     ProtectionValue ovp;
     ProtectionValue ocp;
     ProtectionValue opp;
@@ -332,8 +369,14 @@ class Channel {
     /// Clear channel calibration configuration.
     void clearCalibrationConf();
 
-    /// Test the channel.
-    bool test();
+    /// Must be called every time cal_conf is changed.
+    void compileCalibrationCurves();
+
+    /// Start the test of the channel, testStep() must be called until it returns false.
+    void testStart();
+
+    /// Continue the test of the channel, returns false when the test is finished.
+    bool testStep();
 
     /// Is channel installed?
     bool isInstalled();
@@ -398,6 +441,7 @@ class Channel {
     bool isRemoteProgrammingEnabled();
 
     float getCalibratedVoltage(float value);
+    float getCalibratedCurrent(float value);
 
     /// Set channel voltage level.
     void setVoltage(float voltage);
@@ -470,6 +514,9 @@ class Channel {
     /// Unset current max. limit
     void unlimitMaxCurrent();
 
+    /// Unset current max. limit only if it was set because of the given cause
+    void unlimitMaxCurrent(MaxCurrentLimitCause cause);
+
     /// Returns currently set power limit
     float getPowerLimit() const;
 
@@ -492,11 +539,21 @@ class Channel {
     float getUSetUnbalanced();
     float getISetUnbalanced();
 
+    /// Position (in ytViewRate units) of the YT graph pixel that is currently collected.
     uint32_t getCurrentHistoryValuePosition();
+    /// Changes whenever history is reset or ytViewRate is changed,
+    /// i.e. when YT graph should be redrawn from scratch.
+    uint32_t getHistoryRefreshCounter();
 
     static void resetHistoryForAllChannels();
     void resetHistory();
 
+    void resetStatistics();
+
+    /// Statistics are updated in PSU thread on every ADC sample. Use this to
+    /// read them from any other thread.
+    void getStatisticsSnapshot(StatisticsSnapshot &snapshot);
+
     TriggerMode getVoltageTriggerMode();
     void setVoltageTriggerMode(TriggerMode mode);
 
@@ -535,6 +592,11 @@ class Channel {
     void doSetVoltage(float value);
     void doSetCurrent(float value);
 
+    /// Set u.set (i.set) without writing it to the DAC,
+    /// used while the waveform thread writes the DAC (see waveform.cpp).
+    void setVoltageSetpoint(float value);
+    void setCurrentSetpoint(float value);
+
     float getDualRangeGndOffset();
 
     void enterOvpProtection();
@@ -555,10 +617,42 @@ private:
     
     MaxCurrentLimitCause maxCurrentLimitCause;
 
-    float uHistory[CHANNEL_HISTORY_SIZE];
-    float iHistory[CHANNEL_HISTORY_SIZE];
-    uint32_t historyPosition;
+    /// Min/max of the monitored values during one history bucket period.
+    struct HistoryBucket {
+        float uMin;
+        float uMax;
+        float iMin;
+        float iMax;
+    };
+
+    /// Number of CHANNEL_HISTORY_LEVEL0_PERIOD_US periods since history is started.
+    uint32_t historyIndex;
     uint32_t historyLastTick;
+    uint32_t historyResetCounter;
+
+    HistoryBucket *getHistoryBucket(int level, uint32_t bucketIndex);
+    void advanceHistory(uint32_t tickUsec);
+    void addHistoryValue();
+    float getHistoryValue(uint32_t rowIndex, uint8_t columnIndex, float *max);
+
+    Statistics uStatistics;
+    Statistics iStatistics;
+
+    /// Charge (in As), energy (in Ws) and time (in s) accumulated while
+    /// output is enabled, since the last statistics reset.
+    double charge;
+    double energy;
+    double energyTime;
+
+    bool energyStarted;
+    uint64_t energyLastTime;
+
+    /// Odd while PSU thread is updating the statistics. Readers retry if it is
+    /// odd or if it was changed while they were copying.
+    std::atomic<uint32_t> statisticsSequence;
+
+    void beginStatisticsUpdate();
+    void endStatisticsUpdate();
 
     int reg_get_ques_isum_bit_mask_for_channel_protection_value(ProtectionValue &cpv);
 
@@ -18,6 +18,9 @@
 
 #include <float.h>
 #include <assert.h>
+#include <string.h>
+
+#include <atomic>
 
 #include <eez/modules/psu/psu.h>
 #include <eez/modules/psu/calibration.h>
@@ -28,6 +31,7 @@
 #include <eez/scpi/regs.h>
 #include <eez/modules/psu/temperature.h>
 #include <eez/modules/psu/trigger.h>
+#include <eez/modules/psu/waveform.h>
 #include <eez/index.h>
 #include <eez/system.h>
 #include <eez/modules/bp3c/io_exp.h>
@@ -119,7 +123,7 @@ bool setCouplingType(CouplingType couplingType, int *err) {
         }
 
         if (osThreadGetId() != g_psuTaskHandle) {
-            osMessagePut(g_psuMessageQueueId, PSU_QUEUE_MESSAGE(PSU_QUEUE_SET_COUPLING_TYPE, couplingType), osWaitForever);
+            sendMessageToPsu(PSU_QUEUE_SET_COUPLING_TYPE, couplingType);
         } else {
             setCouplingTypeInPsuThread(couplingType);
         }
@@ -146,6 +150,7 @@ void setCouplingTypeInPsuThread(CouplingType couplingType) {
             channel.setTriggerOnListStop(TRIGGER_ON_LIST_STOP_OUTPUT_OFF);
 
             list::resetChannelList(channel);
+            waveform::resetChannelWaveform(channel);
 
             channel.setVoltage(getUMin(channel));
             channel.setVoltageLimit(MIN(Channel::get(0).getVoltageLimit(), Channel::get(1).getVoltageLimit()));
@@ -246,7 +251,7 @@ void setCouplingTypeInPsuThread(CouplingType couplingType) {
 
 void setTrackingChannels(uint16_t trackingEnabled) {
     if (osThreadGetId() != g_psuTaskHandle) {
-        osMessagePut(g_psuMessageQueueId, PSU_QUEUE_MESSAGE(PSU_QUEUE_SET_TRACKING_CHANNELS, trackingEnabled), osWaitForever);
+        sendMessageToPsu(PSU_QUEUE_SET_TRACKING_CHANNELS, trackingEnabled);
     } else {
         bool resetTrackingChannels = false;
         for (int i = 0; i < CH_NUM; i++) {
@@ -342,6 +347,7 @@ void setTrackingChannels(uint16_t trackingEnabled) {
                     trackingChannel.setTriggerOnListStop(TRIGGER_ON_LIST_STOP_OUTPUT_OFF);
 
                     list::resetChannelList(trackingChannel);
+                    waveform::resetChannelWaveform(trackingChannel);
 
                     trackingChannel.setVoltage(MAX(uMin, getUMin(trackingChannel)));
                     trackingChannel.setVoltageLimit(MAX(voltageLimit, getUMin(trackingChannel)));
@@ -547,16 +553,336 @@ float getUProtectionLevel(const Channel &channel) {
     return channel.prot_conf.u_level;
 }
 
-static float g_setVoltageValues[CH_MAX];
+////////////////////////////////////////////////////////////////////////////////
+// Setpoint mailbox
+//
+// setVoltage/setCurrent called outside of the PSU thread only store the value into
+// the channel mailbox slot and set the dirty bit. The PSU thread applies all dirty
+// slots at once when it gets PSU_QUEUE_MESSAGE_TYPE_APPLY_SETPOINTS, which is posted
+// only by the write that found the mailbox empty, so a burst of setpoint commands
+// doesn't fill the PSU queue and repeated writes to the same slot are coalesced
+// (latest value wins).
+//
+// Mailbox state is a single word: voltage dirty bits, current dirty bits and
+// the number of open setpoint groups. While a group is open nothing is applied,
+// so all the setpoints set inside the group are applied in the same PSU tick.
+
+static const uint32_t SETPOINT_VOLTAGE_DIRTY = 1;
+static const uint32_t SETPOINT_CURRENT_DIRTY = 1 << 8;
+static const uint32_t SETPOINT_DIRTY_MASK = 0xFFFF;
+static const uint32_t SETPOINT_GROUP_ONE = 1 << 16;
+
+static std::atomic<float> g_setVoltageValues[CH_MAX];
+static std::atomic<float> g_setCurrentValues[CH_MAX];
+static std::atomic<uint32_t> g_setpointMailbox(0);
+
+// PSU message sequence number at the time APPLY_SETPOINTS was posted
+static std::atomic<uint32_t> g_setpointSequence(0);
+
+static std::atomic<uint32_t> g_numSetpointWrites(0);
+static std::atomic<uint32_t> g_numSetpointsCoalesced(0);
+static std::atomic<uint32_t> g_numSetpointApplies(0);
+
+static void postApplySetpoints() {
+    g_setpointSequence = getPsuMessageSequence();
+    osMessagePut(g_psuMessageQueueId, PSU_QUEUE_MESSAGE(PSU_QUEUE_MESSAGE_TYPE_APPLY_SETPOINTS, 0), osWaitForever);
+}
+
+static void writeSetpoint(std::atomic<float> *values, int channelIndex, float value, uint32_t dirtyBit) {
+    // If some other message was posted to the PSU thread after the pending setpoints,
+    // wait for them to be applied so that new value can't overtake that message,
+    // e.g. OUTP OFF followed by the higher voltage.
+    while (true) {
+        uint32_t mailbox = g_setpointMailbox;
+        if ((mailbox & SETPOINT_DIRTY_MASK) == 0 || mailbox >= SETPOINT_GROUP_ONE || g_setpointSequence == getPsuMessageSequence()) {
+            break;
+        }
+        osDelay(1);
+    }
+
+    values[channelIndex] = value;
+
+    uint32_t bit = dirtyBit << channelIndex;
+    uint32_t mailbox = g_setpointMailbox.fetch_or(bit);
+
+    g_numSetpointWrites++;
+    if (mailbox & bit) {
+        g_numSetpointsCoalesced++;
+    }
+
+    if (mailbox == 0) {
+        postApplySetpoints();
+    }
+}
+
+void beginSetpointGroup() {
+    if (osThreadGetId() == g_psuTaskHandle) {
+        return;
+    }
+
+    g_setpointMailbox += SETPOINT_GROUP_ONE;
+}
+
+void endSetpointGroup() {
+    if (osThreadGetId() == g_psuTaskHandle) {
+        return;
+    }
+
+    uint32_t mailbox = g_setpointMailbox -= SETPOINT_GROUP_ONE;
+    if (mailbox < SETPOINT_GROUP_ONE && (mailbox & SETPOINT_DIRTY_MASK)) {
+        postApplySetpoints();
+    }
+}
+
+void applySetpointsInPsuThread() {
+    uint32_t mailbox = g_setpointMailbox;
+    do {
+        if (mailbox >= SETPOINT_GROUP_ONE || mailbox == 0) {
+            // endSetpointGroup will post another APPLY_SETPOINTS
+            return;
+        }
+    } while (!g_setpointMailbox.compare_exchange_weak(mailbox, 0));
+
+    g_numSetpointApplies++;
+
+    for (int i = 0; i < CH_NUM; ++i) {
+        if (mailbox & (SETPOINT_VOLTAGE_DIRTY << i)) {
+            setVoltage(Channel::get(i), g_setVoltageValues[i]);
+        }
+        if (mailbox & (SETPOINT_CURRENT_DIRTY << i)) {
+            setCurrent(Channel::get(i), g_setCurrentValues[i]);
+        }
+    }
+}
+
+void getSetpointStats(uint32_t &numWrites, uint32_t &numCoalesced, uint32_t &numApplies) {
+    numWrites = g_numSetpointWrites;
+    numCoalesced = g_numSetpointsCoalesced;
+    numApplies = g_numSetpointApplies;
+}
+
+void resetSetpointStats() {
+    g_numSetpointWrites = 0;
+    g_numSetpointsCoalesced = 0;
+    g_numSetpointApplies = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Transaction
+//
+// Staged setpoints are committed in the PSU thread in one pass: outputs which
+// should be disabled are disabled first, so new setpoints never appear at them,
+// then all the DAC values are written back to back and at the end outputs which
+// should be enabled are enabled with a single syncOutputEnable.
+
+static const uint8_t STAGED_VOLTAGE = 1;
+static const uint8_t STAGED_CURRENT = 2;
+static const uint8_t STAGED_OUTPUT_ENABLE = 4;
+
+static struct {
+    uint8_t flags;
+    bool outputEnable;
+    float voltage;
+    float current;
+} g_staged[CH_MAX];
+
+static bool g_transactionActive;
+static const void *g_transactionOwner;
+static volatile bool g_transactionCommitted;
+static TransactionStats g_transactionStats;
+
+bool beginTransaction(const void *owner, int *err) {
+    if (g_transactionActive) {
+        if (g_transactionOwner != owner) {
+            // staged by some other interface
+            if (err) {
+                *err = SCPI_ERROR_EXECUTION_ERROR;
+            }
+            return false;
+        }
+        return true;
+    }
+
+    memset(g_staged, 0, sizeof(g_staged));
+    g_transactionOwner = owner;
+    g_transactionActive = true;
+    return true;
+}
+
+bool isTransactionActive() {
+    return g_transactionActive;
+}
+
+void stageVoltage(Channel &channel, float voltage) {
+    g_staged[channel.channelIndex].flags |= STAGED_VOLTAGE;
+    g_staged[channel.channelIndex].voltage = voltage;
+}
+
+void stageCurrent(Channel &channel, float current) {
+    g_staged[channel.channelIndex].flags |= STAGED_CURRENT;
+    g_staged[channel.channelIndex].current = current;
+}
 
-void setVoltageInPsuThread(int channelIndex) {
-    setVoltage(Channel::get(channelIndex), g_setVoltageValues[channelIndex]);
+void stageOutputEnable(Channel &channel, bool enable) {
+    g_staged[channel.channelIndex].flags |= STAGED_OUTPUT_ENABLE;
+    g_staged[channel.channelIndex].outputEnable = enable;
 }
 
+// Staged values are checked when they are staged, but limits and trigger
+// state could be changed, by this or some other interface, before the commit.
+static bool testStagedSetpoints(Channel &channel, int *err) {
+    uint8_t flags = g_staged[channel.channelIndex].flags;
+    if (!(flags & (STAGED_VOLTAGE | STAGED_CURRENT))) {
+        return true;
+    }
+
+    float voltage = (flags & STAGED_VOLTAGE) ? g_staged[channel.channelIndex].voltage : getUSetUnbalanced(channel);
+    float current = (flags & STAGED_CURRENT) ? g_staged[channel.channelIndex].current : getISetUnbalanced(channel);
+
+    int error = 0;
+    if (getVoltageTriggerMode(channel) != TRIGGER_MODE_FIXED && !trigger::isIdle()) {
+        error = SCPI_ERROR_CANNOT_CHANGE_TRANSIENT_TRIGGER;
+    } else if ((flags & STAGED_VOLTAGE) && channel.isRemoteProgrammingEnabled()) {
+        error = SCPI_ERROR_EXECUTION_ERROR;
+    } else if (channel.isVoltageLimitExceeded(voltage)) {
+        error = SCPI_ERROR_VOLTAGE_LIMIT_EXCEEDED;
+    } else if (channel.isCurrentLimitExceeded(current)) {
+        error = SCPI_ERROR_CURRENT_LIMIT_EXCEEDED;
+    } else if (channel.isPowerLimitExceeded(voltage, current)) {
+        error = SCPI_ERROR_POWER_LIMIT_EXCEEDED;
+    }
+
+    if (error) {
+        if (err) {
+            *err = error;
+        }
+        return false;
+    }
+
+    return true;
+}
+
+bool commitTransaction(const void *owner, int *err) {
+    if (!g_transactionActive) {
+        return true;
+    }
+
+    if (g_transactionOwner != owner) {
+        if (err) {
+            *err = SCPI_ERROR_EXECUTION_ERROR;
+        }
+        return false;
+    }
+
+    bool callTriggerAbort = false;
+    for (int i = 0; i < CH_NUM; ++i) {
+        if (!testStagedSetpoints(Channel::get(i), err)) {
+            g_transactionActive = false;
+            return false;
+        }
+
+        if (g_staged[i].flags & STAGED_OUTPUT_ENABLE) {
+            if (!testOutputEnable(Channel::get(i), g_staged[i].outputEnable, callTriggerAbort, err)) {
+                g_transactionActive = false;
+                return false;
+            }
+        }
+    }
+
+    if (callTriggerAbort) {
+        if (err) {
+            *err = SCPI_ERROR_CANNOT_CHANGE_TRANSIENT_TRIGGER;
+        }
+        g_transactionActive = false;
+        return false;
+    }
+
+    if (osThreadGetId() == g_psuTaskHandle) {
+        commitTransactionInPsuThread();
+    } else {
+        g_transactionCommitted = false;
+        sendMessageToPsu(PSU_QUEUE_MESSAGE_TYPE_COMMIT_TRANSACTION);
+        while (!g_transactionCommitted) {
+            osDelay(1);
+        }
+    }
+
+    g_transactionActive = false;
+
+    return true;
+}
+
+void abortTransaction(const void *owner) {
+    if (g_transactionOwner == owner) {
+        g_transactionActive = false;
+    }
+}
+
+void commitTransactionInPsuThread() {
+    uint32_t startTime = micros();
+
+    TransactionStats stats;
+    memset(&stats, 0, sizeof(stats));
+
+    bool sync = false;
+    for (int i = 0; i < CH_NUM; ++i) {
+        if (g_staged[i].flags) {
+            stats.numChannels++;
+        }
+        if ((g_staged[i].flags & STAGED_OUTPUT_ENABLE) && !g_staged[i].outputEnable) {
+            outputEnableOnNextSync(Channel::get(i), false);
+            sync = true;
+        }
+    }
+    if (sync) {
+        Channel::syncOutputEnable();
+    }
+
+    uint32_t dacStartTime = micros();
+
+    for (int i = 0; i < CH_NUM; ++i) {
+        if (g_staged[i].flags & STAGED_VOLTAGE) {
+            setVoltage(Channel::get(i), g_staged[i].voltage);
+            stats.numDacWrites++;
+        }
+        if (g_staged[i].flags & STAGED_CURRENT) {
+            setCurrent(Channel::get(i), g_staged[i].current);
+            stats.numDacWrites++;
+        }
+    }
+
+    uint32_t dacEndTime = micros();
+
+    sync = false;
+    for (int i = 0; i < CH_NUM; ++i) {
+        if ((g_staged[i].flags & STAGED_OUTPUT_ENABLE) && g_staged[i].outputEnable) {
+            outputEnableOnNextSync(Channel::get(i), true);
+            sync = true;
+        }
+    }
+    if (sync) {
+        Channel::syncOutputEnable();
+    }
+
+    uint32_t endTime = micros();
+
+    stats.dacTime = dacEndTime - dacStartTime;
+    stats.outputEnableTime = (endTime - startTime) - stats.dacTime;
+    stats.totalTime = endTime - startTime;
+    g_transactionStats = stats;
+
+    g_transactionCommitted = true;
+}
+
+void getLastTransactionStats(TransactionStats &stats) {
+    stats = g_transactionStats;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void setVoltage(Channel &channel, float voltage) {
     if (osThreadGetId() != g_psuTaskHandle) {
-        g_setVoltageValues[channel.channelIndex] = voltage;
-        osMessagePut(g_psuMessageQueueId, PSU_QUEUE_MESSAGE(PSU_QUEUE_MESSAGE_TYPE_SET_VOLTAGE, channel.channelIndex), osWaitForever);
+        writeSetpoint(g_setVoltageValues, channel.channelIndex, voltage, SETPOINT_VOLTAGE_DIRTY);
         return;
     }
 
@@ -848,16 +1174,9 @@ float getIMax(const Channel &channel) {
     return channel.i.max;
 }
 
-static float g_setCurrentValues[CH_MAX];
-
-void setCurrentInPsuThread(int channelIndex) {
-    setCurrent(Channel::get(channelIndex), g_setCurrentValues[channelIndex]);
-}
-
 void setCurrent(Channel &channel, float current) {
     if (osThreadGetId() != g_psuTaskHandle) {
-        g_setCurrentValues[channel.channelIndex] = current;
-        osMessagePut(g_psuMessageQueueId, PSU_QUEUE_MESSAGE(PSU_QUEUE_MESSAGE_TYPE_SET_CURRENT, channel.channelIndex), osWaitForever);
+        writeSetpoint(g_setCurrentValues, channel.channelIndex, current, SETPOINT_CURRENT_DIRTY);
         return;
     }
 
@@ -1218,7 +1537,7 @@ void outputEnableOnNextSync(Channel &channel, bool enable) {
 
 void syncOutputEnable() {
     if (osThreadGetId() != g_psuTaskHandle) {
-        osMessagePut(g_psuMessageQueueId, PSU_QUEUE_MESSAGE(PSU_QUEUE_SYNC_OUTPUT_ENABLE, 0), osWaitForever);
+        sendMessageToPsu(PSU_QUEUE_SYNC_OUTPUT_ENABLE);
     } else {
         Channel::syncOutputEnable();
     }
@@ -1535,49 +1854,28 @@ void setOtpDelay(int sensor, float delay) {
 }
 
 void setDisplayViewSettings(Channel &channel, int displayValue1, int displayValue2, float ytViewRate) {
-    bool resetHistory = false;
-
+    // history is kept at several timescales, so it doesn't have to be reset on ytViewRate change
     if (channel.channelIndex < 2 && (g_couplingType == COUPLING_TYPE_SERIES || g_couplingType == COUPLING_TYPE_PARALLEL)) {
         Channel::get(0).flags.displayValue1 = displayValue1;
         Channel::get(0).flags.displayValue2 = displayValue2;
-        if (Channel::get(0).ytViewRate != ytViewRate) {
-            Channel::get(0).ytViewRate = ytViewRate;
-            resetHistory = true;
-        }
+        Channel::get(0).ytViewRate = ytViewRate;
 
         Channel::get(1).flags.displayValue1 = displayValue1;
         Channel::get(1).flags.displayValue2 = displayValue2;
-        if (Channel::get(1).ytViewRate != ytViewRate) {
-            Channel::get(1).ytViewRate = ytViewRate;
-            resetHistory = true;
-        }
+        Channel::get(1).ytViewRate = ytViewRate;
     } else if (channel.flags.trackingEnabled) {
         for (int i = 0; i < CH_NUM; ++i) {
             Channel &trackingChannel = Channel::get(i);
             if (trackingChannel.flags.trackingEnabled) {
                 trackingChannel.flags.displayValue1 = displayValue1;
                 trackingChannel.flags.displayValue2 = displayValue2;
-                if (trackingChannel.ytViewRate != ytViewRate) {
-                    trackingChannel.ytViewRate = ytViewRate;
-                    resetHistory = true;
-                }
+                trackingChannel.ytViewRate = ytViewRate;
             }
         }
     } else {
         channel.flags.displayValue1 = displayValue1;
         channel.flags.displayValue2 = displayValue2;
-        if (channel.ytViewRate != ytViewRate) {
-            channel.ytViewRate = ytViewRate;
-            resetHistory = true;
-        }
-    }
-    
-    if (resetHistory) {
-        if (osThreadGetId() != g_psuTaskHandle) {
-            osMessagePut(g_psuMessageQueueId, PSU_QUEUE_MESSAGE(PSU_QUEUE_RESET_CHANNELS_HISTORY, 0), osWaitForever);
-        } else {
-            Channel::resetHistoryForAllChannels();
-        }
+        channel.ytViewRate = ytViewRate;
     }
 }
 
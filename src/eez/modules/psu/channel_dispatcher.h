@@ -111,6 +111,7 @@ void setOutputDelayDuration(Channel &channel, float duration);
 void outputEnable(Channel &channel, bool enable);
 void outputEnableOnNextSync(Channel &channel, bool enable);
 void syncOutputEnable();
+bool testOutputEnable(Channel &channel, bool enable, bool &callTriggerAbort, int *err);
 bool outputEnable(uint32_t channels, bool enable, int *err);
 void disableOutputForAllChannels();
 void disableOutputForAllTrackingChannels();
@@ -165,8 +166,42 @@ void setLoadEnabled(Channel &channel, bool state);
 void setLoad(Channel &channel, float load);
 #endif
 
-void setVoltageInPsuThread(int channelIndex);
-void setCurrentInPsuThread(int channelIndex);
+/// Setpoints set with setVoltage/setCurrent between begin and end of the group
+/// from some other thread than PSU thread are applied in the same PSU tick.
+/// Groups can be nested and it is a no-op when called from the PSU thread.
+void beginSetpointGroup();
+void endSetpointGroup();
+
+void applySetpointsInPsuThread();
+
+void getSetpointStats(uint32_t &numWrites, uint32_t &numCoalesced, uint32_t &numApplies);
+void resetSetpointStats();
+
+/// Voltage, current and output state of many channels can be staged and then committed
+/// in a single PSU tick. There is only one transaction at a time and it belongs to
+/// the owner (e.g. SCPI context) that began it, until it is committed or aborted.
+/// beginTransaction fails if the transaction of some other owner is active, otherwise
+/// it begins a new one or continues the active one. Staged values are validated
+/// again at commit.
+bool beginTransaction(const void *owner, int *err);
+bool isTransactionActive();
+void stageVoltage(Channel &channel, float voltage);
+void stageCurrent(Channel &channel, float current);
+void stageOutputEnable(Channel &channel, bool enable);
+bool commitTransaction(const void *owner, int *err);
+void abortTransaction(const void *owner);
+
+void commitTransactionInPsuThread();
+
+struct TransactionStats {
+    uint8_t numChannels;
+    uint8_t numDacWrites;
+    uint32_t dacTime; // from the start of the first to the end of the last DAC write in microseconds
+    uint32_t outputEnableTime; // output enable/disable time in microseconds
+    uint32_t totalTime; // commit time in PSU thread in microseconds
+};
+
+void getLastTransactionStats(TransactionStats &stats);
 
 const char *copyChannelToChannel(int srcChannelIndex, int dstChannelIndex);
 
@@ -41,6 +41,12 @@
 /// SCPI TCP server port.
 #define TCP_PORT 5025
 
+/// Remote display (front panel streaming) TCP server port.
+#define REMOTE_DISPLAY_TCP_PORT 5026
+
+/// Measurement stream (SYSTem:COMMunicate:STReam) TCP server port.
+#define STREAM_TCP_PORT 5027
+
 /// Name of the DAC chip.
 #define DAC_NAME "DAC8552"
 
@@ -165,6 +171,39 @@
 /// Number of seconds after which main power will be turned off.
 #define FAN_MAX_TEMP_DELAY 30
 
+/// Channel thermal model: heatsink temperature rise (in oC) per watt of output power
+/// with fan stopped.
+#define THERMAL_MODEL_RTH 1.0f
+
+/// Channel thermal model: heatsink thermal resistance at FAN_NOMINAL_RPM is
+/// THERMAL_MODEL_RTH / (1 + THERMAL_MODEL_FAN_COOLING).
+#define THERMAL_MODEL_FAN_COOLING 3.0f
+
+/// Channel thermal model: heatsink time constant (in seconds).
+#define THERMAL_MODEL_HEATSINK_TAU 120.0f
+
+/// Channel thermal model: time constant (in seconds) of the channel temperature sensor
+/// following the heatsink.
+#define THERMAL_MODEL_SENSOR_TAU 15.0f
+
+/// Channel thermal model: how much of the difference between the measured and the estimated
+/// sensor temperature is corrected on every temperature reading.
+#define THERMAL_MODEL_SENSOR_GAIN 0.3f
+
+/// Channel thermal model: how much of the difference between the measured and the estimated
+/// sensor temperature is attributed to the ambient temperature on every temperature reading.
+#define THERMAL_MODEL_AMBIENT_GAIN 0.02f
+
+/// Set to 0 to disable limiting of max. channel current to ERR_MAX_CURRENT when the
+/// estimated heatsink temperature is too high. Model is corrected by the channel temperature
+/// sensor, so the constants above don't have to be exact.
+#define CONF_THERMAL_DERATING 1
+
+/// Max. channel current is limited when the estimated heatsink temperature goes above
+/// (OTP level - THERMAL_DERATING_BAND), or (FAN_MAX_TEMP - THERMAL_DERATING_BAND) if lower,
+/// and unlimited when it falls THERMAL_DERATING_BAND below that.
+#define THERMAL_DERATING_BAND 5.0f
+
 /// Interval (in minutes) at which "on time" will be written to EEPROM
 #define WRITE_ONTIME_INTERVAL 10
 
@@ -195,10 +234,18 @@
 /// See DP_NEG_LEV in seconds.
 #define DP_NEG_DELAY 1
 
-/// Number of history values shown in YT diagram. This value must be power of 2 and
+/// Number of min/max buckets kept at each channel history level. This value must be
 /// greater then width of YT widget.
 #define CHANNEL_HISTORY_SIZE 512
 
+/// Channel history is kept at CHANNEL_HISTORY_NUM_LEVELS timescales. Bucket period
+/// of the first level is CHANNEL_HISTORY_LEVEL0_PERIOD_US and every next level has
+/// CHANNEL_HISTORY_LEVEL_FACTOR times longer bucket period (5 ms, 50 ms, 500 ms,
+/// 5 s, 50 s and 500 s). Last level must cover YT widget at GUI_YT_VIEW_RATE_MAX.
+#define CHANNEL_HISTORY_NUM_LEVELS 6
+#define CHANNEL_HISTORY_LEVEL0_PERIOD_US 5000
+#define CHANNEL_HISTORY_LEVEL_FACTOR 10
+
 #define GUI_YT_VIEW_RATE_DEFAULT 0.1f
 #define GUI_YT_VIEW_RATE_MIN 0.005f
 #define GUI_YT_VIEW_RATE_MAX 300.0f
@@ -211,6 +258,27 @@
 
 #define MAX_LIST_COUNT 65535
 
+/// Number of points in the precomputed waveform table (TRIGGER_MODE_FUNCTION).
+#define WAVEFORM_TABLE_SIZE 256
+
+/// Waveform DAC update period. Waveform thread is woken up by every TIM7 tick
+/// on STM32 and by the 1 ms kernel timer on the simulator.
+#if defined(EEZ_PLATFORM_STM32)
+#define CONF_WAVEFORM_UPDATE_PERIOD_US 200
+#else
+#define CONF_WAVEFORM_UPDATE_PERIOD_US 1000
+#endif
+
+/// Max. frequency leaves at least 50 DAC updates per period on STM32.
+#define WAVEFORM_FREQUENCY_MIN 0.001f
+#define WAVEFORM_FREQUENCY_MAX 100.0f
+#define WAVEFORM_FREQUENCY_DEF 1.0f
+
+#define WAVEFORM_PHASE_MIN 0.0f
+#define WAVEFORM_PHASE_MAX 360.0f
+
+#define MAX_WAVEFORM_COUNT 65535
+
 #define LISTS_DIR (PATH_SEPARATOR "Lists")
 #define PROFILES_DIR (PATH_SEPARATOR "Profiles")
 #define RECORDINGS_DIR (PATH_SEPARATOR "Recordings")
@@ -264,4 +332,16 @@
 #define CONF_LIST_COUNDOWN_DISPLAY_THRESHOLD 5 // 5 seconds
 #define CONF_RAMP_COUNDOWN_DISPLAY_THRESHOLD 5 // 5 seconds
 
-#define MAX_CALIBRATION_POINTS 10
\ No newline at end of file
+#define MAX_CALIBRATION_POINTS 10
+
+/// PSU thread sleeps until the earliest deadline requested with psu::scheduleTick
+/// or until message arrives, but never longer than this (temperature, fan and datetime).
+#define CONF_PSU_TICK_MAX_PERIOD_US 10000
+
+/// Tick period while channel output is enabled (ADC and protection),
+/// ramp or waveform is executing or IO pin input function is used.
+#define CONF_PSU_TICK_POLL_PERIOD_US 1000
+
+/// Set to 0 to execute full PSU tick on every wake up, i.e. poll every 1 ms
+/// (useful to compare DIAG:INFO:CPU? results).
+#define CONF_PSU_TICK_SCHEDULER 1
\ No newline at end of file
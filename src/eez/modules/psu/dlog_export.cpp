@@ -0,0 +1,441 @@
+/*
+ * EEZ Modular Firmware
+ * Copyright (C) 2020-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+
+#include <eez/util.h>
+#include <eez/memory.h>
+
+#include <eez/modules/psu/psu.h>
+#include <eez/modules/psu/sd_card.h>
+#include <eez/modules/psu/dlog_view.h>
+#include <eez/modules/psu/dlog_record.h>
+#include <eez/modules/psu/dlog_export.h>
+#include <eez/modules/psu/scpi/psu.h>
+#if OPTION_DISPLAY
+#include <eez/modules/psu/gui/psu.h>
+#endif
+
+#include <eez/libs/sd_fat/sd_fat.h>
+
+namespace eez {
+namespace psu {
+namespace dlog_export {
+
+static const uint32_t READ_BUFFER_SIZE = 32 * 1024;
+static const uint32_t WRITE_BUFFER_SIZE = 28 * 1024;
+
+// enough for any X or float value
+static const uint32_t MAX_CSV_VALUE_LENGTH = 32;
+
+static const int MAX_X_DECIMAL_PLACES = 6;
+
+// lives in SDRAM (see DLOG_EXPORT_MEMORY)
+struct ExportMemory {
+    dlog_view::Recording recording;
+    uint8_t readBuffer[READ_BUFFER_SIZE];
+    uint8_t writeBuffer[WRITE_BUFFER_SIZE];
+};
+
+static_assert(sizeof(ExportMemory) <= DLOG_EXPORT_MEMORY_SIZE, "DLOG_EXPORT_MEMORY_SIZE is too small");
+
+static ExportMemory &g_memory = *(ExportMemory *)DLOG_EXPORT_MEMORY;
+
+static File *g_destinationFile;
+static uint32_t g_writePosition;
+
+static double g_xStart;
+static double g_xStep;
+static int g_xNumDecimalPlaces;
+static uint64_t g_xScale;
+
+////////////////////////////////////////////////////////////////////////////////
+
+static bool flush() {
+    if (g_writePosition == 0) {
+        return true;
+    }
+
+    bool result = g_destinationFile->write(g_memory.writeBuffer, g_writePosition) == g_writePosition;
+    g_writePosition = 0;
+    return result;
+}
+
+static bool write(const void *data, uint32_t size) {
+    if (g_writePosition + size > WRITE_BUFFER_SIZE && !flush()) {
+        return false;
+    }
+
+    memcpy(g_memory.writeBuffer + g_writePosition, data, size);
+    g_writePosition += size;
+    return true;
+}
+
+static bool write16(uint16_t value) {
+    uint8_t data[2] = { (uint8_t)value, (uint8_t)(value >> 8) };
+    return write(data, sizeof(data));
+}
+
+static bool write32(uint32_t value) {
+    return write16(value & 0xFFFF) && write16(value >> 16);
+}
+
+static bool writeDouble(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return write32((uint32_t)bits) && write32((uint32_t)(bits >> 32));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static void appendUnit(char *name, int count, Unit unit) {
+    const char *unitName = getUnitName(unit);
+    if (!*unitName) {
+        return;
+    }
+
+    // skip units that are using GUI font symbols (Ohm, degree, ...)
+    for (const char *p = unitName; *p; p++) {
+        if (*p < ' ' || *p > '~') {
+            return;
+        }
+    }
+
+    size_t length = strlen(name);
+    snprintf(name + length, count - length, " [%s]", unitName);
+}
+
+static void getXName(char *name, int count) {
+    dlog_view::XAxis &xAxis = g_memory.recording.parameters.xAxis;
+
+    if (xAxis.label[0]) {
+        snprintf(name, count, "%s", xAxis.label);
+    } else {
+        snprintf(name, count, "%s", xAxis.unit == UNIT_SECOND ? "Time" : "X");
+    }
+
+    appendUnit(name, count, xAxis.unit);
+}
+
+static void getColumnName(int yAxisIndex, char *name, int count) {
+    dlog_view::YAxis &yAxis = g_memory.recording.parameters.yAxes[yAxisIndex];
+
+    if (yAxis.label[0]) {
+        snprintf(name, count, "%s", yAxis.label);
+    } else if (yAxis.channelIndex >= 0 && yAxis.unit == UNIT_VOLT) {
+        snprintf(name, count, "U%d", yAxis.channelIndex + 1);
+    } else if (yAxis.channelIndex >= 0 && yAxis.unit == UNIT_AMPER) {
+        snprintf(name, count, "I%d", yAxis.channelIndex + 1);
+    } else if (yAxis.channelIndex >= 0 && yAxis.unit == UNIT_WATT) {
+        snprintf(name, count, "P%d", yAxis.channelIndex + 1);
+    } else {
+        snprintf(name, count, "Y%d", yAxisIndex + 1);
+    }
+
+    appendUnit(name, count, yAxis.unit);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+// X values are printed with the fixed number of decimal places derived from the step,
+// in double precision, so that the time doesn't lose resolution in long recordings
+static void initX() {
+    dlog_view::XAxis &xAxis = g_memory.recording.parameters.xAxis;
+
+    g_xStart = xAxis.range.min;
+    g_xStep = xAxis.step;
+
+    g_xNumDecimalPlaces = MAX_X_DECIMAL_PLACES;
+    g_xScale = 1;
+    for (int i = 0; i < MAX_X_DECIMAL_PLACES; i++) {
+        double scaledStep = g_xStep * g_xScale;
+        if (fabs(scaledStep - round(scaledStep)) < 1E-3 * scaledStep) {
+            g_xNumDecimalPlaces = i;
+            break;
+        }
+        g_xScale *= 10;
+    }
+}
+
+static char *uint64ToStr(char *str, uint64_t value) {
+    char digits[20];
+    int n = 0;
+    do {
+        digits[n++] = '0' + value % 10;
+        value /= 10;
+    } while (value);
+
+    while (n > 0) {
+        *str++ = digits[--n];
+    }
+
+    return str;
+}
+
+static char *xToStr(char *str, uint32_t rowIndex) {
+    double x = g_xStart + rowIndex * g_xStep;
+
+    double scaled = round(x * g_xScale);
+    if (!(fabs(scaled) < 1E15)) {
+        return floatToStr(str, (float)x);
+    }
+
+    if (scaled < 0) {
+        *str++ = '-';
+        scaled = -scaled;
+    }
+
+    uint64_t value = (uint64_t)scaled;
+
+    str = uint64ToStr(str, value / g_xScale);
+
+    if (g_xNumDecimalPlaces > 0) {
+        *str++ = '.';
+        uint64_t fraction = value % g_xScale;
+        for (int i = g_xNumDecimalPlaces - 1; i >= 0; i--) {
+            str[i] = '0' + fraction % 10;
+            fraction /= 10;
+        }
+        str += g_xNumDecimalPlaces;
+    }
+
+    return str;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static bool writeCsvField(const char *text) {
+    if (!strpbrk(text, ",\"")) {
+        return write(text, strlen(text));
+    }
+
+    if (!write("\"", 1)) {
+        return false;
+    }
+
+    for (const char *p = text; *p; p++) {
+        if (!write(p, 1) || (*p == '"' && !write(p, 1))) {
+            return false;
+        }
+    }
+
+    return write("\"", 1);
+}
+
+static bool writeCsvHeader() {
+    char name[BINARY_COLUMN_NAME_SIZE];
+
+    getXName(name, sizeof(name));
+    if (!writeCsvField(name)) {
+        return false;
+    }
+
+    for (int yAxisIndex = 0; yAxisIndex < g_memory.recording.parameters.numYAxes; yAxisIndex++) {
+        getColumnName(yAxisIndex, name, sizeof(name));
+        if (!write(",", 1) || !writeCsvField(name)) {
+            return false;
+        }
+    }
+
+    return write("\n", 1);
+}
+
+static bool writeCsvRows(const float *values, uint32_t rowIndex, uint32_t numRows) {
+    int numColumns = g_memory.recording.parameters.numYAxes;
+    uint32_t maxRowLength = (numColumns + 1) * MAX_CSV_VALUE_LENGTH;
+
+    for (uint32_t i = 0; i < numRows; i++) {
+        if (g_writePosition + maxRowLength > WRITE_BUFFER_SIZE && !flush()) {
+            return false;
+        }
+
+        // format directly into the write buffer
+        char *str = (char *)g_memory.writeBuffer + g_writePosition;
+
+        str = xToStr(str, rowIndex + i);
+        for (int columnIndex = 0; columnIndex < numColumns; columnIndex++) {
+            *str++ = ',';
+            str = floatToStr(str, *values++);
+        }
+        *str++ = '\n';
+
+        g_writePosition = (uint8_t *)str - g_memory.writeBuffer;
+    }
+
+    return true;
+}
+
+static bool writeBinaryHeader(uint32_t numRows) {
+    int numColumns = g_memory.recording.parameters.numYAxes;
+
+    if (!write32(BINARY_MAGIC1) || !write32(BINARY_MAGIC2) || !write16(BINARY_VERSION) ||
+        !write16(numColumns) || !write32(numRows) || !writeDouble(g_xStart) || !writeDouble(g_xStep)
+    ) {
+        return false;
+    }
+
+    char name[BINARY_COLUMN_NAME_SIZE];
+
+    memset(name, 0, sizeof(name));
+    getXName(name, sizeof(name));
+    if (!write(name, sizeof(name))) {
+        return false;
+    }
+
+    for (int yAxisIndex = 0; yAxisIndex < numColumns; yAxisIndex++) {
+        memset(name, 0, sizeof(name));
+        getColumnName(yAxisIndex, name, sizeof(name));
+        if (!write(name, sizeof(name))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static bool isRecordingFile(const char *filePath) {
+    return !dlog_record::isIdle() && strcicmp(filePath, dlog_record::g_parameters.filePath) == 0;
+}
+
+bool exportFile(const char *sourcePath, const char *destinationPath, Format format, bool showProgress, int *err) {
+    // destination is created with FILE_CREATE_ALWAYS, which would truncate the source
+    if (strcicmp(sourcePath, destinationPath) == 0) {
+        if (err) {
+            *err = SCPI_ERROR_FILE_NAME_ERROR;
+        }
+        return false;
+    }
+
+    // file that is still being recorded is incomplete and is written by the dlog task
+    if (isRecordingFile(sourcePath) || isRecordingFile(destinationPath)) {
+        if (err) {
+            *err = SCPI_ERROR_EXECUTION_ERROR;
+        }
+        return false;
+    }
+
+    if (!sd_card::isMounted(err)) {
+        return false;
+    }
+
+    File sourceFile;
+    if (!sourceFile.open(sourcePath, FILE_OPEN_EXISTING | FILE_READ)) {
+        if (err) {
+            *err = SCPI_ERROR_FILE_NAME_NOT_FOUND;
+        }
+        return false;
+    }
+
+    dlog_view::Recording &recording = g_memory.recording;
+    memset(&recording, 0, sizeof(recording));
+
+    // file without Y axes has no samples, its row size would be 0
+    if (
+        !dlog_view::readHeader(sourceFile, g_memory.readBuffer, READ_BUFFER_SIZE, recording) ||
+        recording.parameters.numYAxes == 0 ||
+        !sourceFile.seek(recording.dataOffset)
+    ) {
+        sourceFile.close();
+        if (err) {
+            *err = SCPI_ERROR_MASS_STORAGE_ERROR;
+        }
+        return false;
+    }
+
+    uint32_t rowSize = recording.parameters.numYAxes * sizeof(float);
+    uint32_t numRows = (sourceFile.size() - recording.dataOffset) / rowSize;
+
+    // only whole rows are read
+    uint32_t maxRowsPerRead = READ_BUFFER_SIZE / rowSize;
+
+    File destinationFile;
+    if (!destinationFile.open(destinationPath, FILE_CREATE_ALWAYS | FILE_WRITE)) {
+        sourceFile.close();
+        if (err) {
+            *err = SCPI_ERROR_FILE_NAME_NOT_FOUND;
+        }
+        return false;
+    }
+
+    g_destinationFile = &destinationFile;
+    g_writePosition = 0;
+
+    initX();
+
+    bool result = format == FORMAT_CSV ? writeCsvHeader() : writeBinaryHeader(numRows);
+    bool aborted = false;
+
+    uint32_t rowIndex = 0;
+    while (result && rowIndex < numRows) {
+        uint32_t numRowsToRead = MIN(maxRowsPerRead, numRows - rowIndex);
+        uint32_t bytesToRead = numRowsToRead * rowSize;
+
+        if (sourceFile.read(g_memory.readBuffer, bytesToRead) != bytesToRead) {
+            result = false;
+            break;
+        }
+
+        if (format == FORMAT_CSV) {
+            result = writeCsvRows((const float *)g_memory.readBuffer, rowIndex, numRowsToRead);
+        } else {
+            // values are already stored as little endian floats
+            result = flush() && destinationFile.write(g_memory.readBuffer, bytesToRead) == bytesToRead;
+        }
+
+        rowIndex += numRowsToRead;
+
+        // dlog record is written to the SD card from this thread, don't let its buffer overflow
+        dlog_record::fileWrite();
+
+#if OPTION_DISPLAY
+        if (showProgress && !psu::gui::updateProgressPage(rowIndex, numRows)) {
+            aborted = true;
+            break;
+        }
+#endif
+    }
+
+    if (result && !aborted) {
+        result = flush();
+    }
+
+    sourceFile.close();
+    if (!destinationFile.close()) {
+        result = false;
+    }
+
+    if (!result || aborted) {
+        sd_card::deleteFile(destinationPath, nullptr);
+        if (err) {
+            *err = aborted ? SCPI_ERROR_FILE_TRANSFER_ABORTED : SCPI_ERROR_MASS_STORAGE_ERROR;
+        }
+        return false;
+    }
+
+    onSdCardFileChangeHook(destinationPath);
+
+    return true;
+}
+
+} // namespace dlog_export
+} // namespace psu
+} // namespace eez
@@ -0,0 +1,79 @@
+/*
+ * EEZ Modular Firmware
+ * Copyright (C) 2020-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/* Converts dlog file (see dlog_view.h) to CSV or binary file.
+
+CSV: one header line with the column names, followed by one line per row.
+First column is X value (usually time in seconds), e.g.:
+
+    Time [s],U1 [V],I1 [A]
+    0.000,5.00012,0.100021
+    0.020,5.00009,0.100017
+
+Binary, all values are little endian:
+
+OFFSET              TYPE    WIDTH    DESCRIPTION
+----------------------------------------------------------------------
+0                   U32     4        MAGIC1 = 0x2D5A4545L
+
+4                   U32     4        MAGIC2 = 0x4E494244L
+
+8                   U16     2        VERSION = 0x0001L
+
+10                  U16     2        N - number of columns
+
+12                  U32     4        Number of rows
+
+16                  Double  8        X value of the first row
+
+24                  Double  8        X step
+
+32                  Char    40       X name, zero terminated
+
+72+n*40             Char    40       n-th column name, zero terminated
+
+72+N*40+(m*N+n)*4   Float   4        m-th row and n-th column value
+*/
+
+namespace eez {
+namespace psu {
+namespace dlog_export {
+
+static const uint32_t BINARY_MAGIC1 = 0x2D5A4545;
+static const uint32_t BINARY_MAGIC2 = 0x4E494244;
+static const uint16_t BINARY_VERSION = 1;
+static const int BINARY_COLUMN_NAME_SIZE = 40;
+
+enum Format {
+    FORMAT_CSV,
+    FORMAT_BINARY
+};
+
+/// Whole file is converted in one pass, reading and writing large blocks.
+/// Source and destination must be different files and neither can be the file
+/// that is currently being recorded.
+/// Must be called from the thread that owns SD card.
+bool exportFile(const char *sourcePath, const char *destinationPath, Format format, bool showProgress, int *err);
+
+} // namespace dlog_export
+} // namespace psu
+} // namespace eez
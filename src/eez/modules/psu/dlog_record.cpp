@@ -722,6 +722,9 @@ void stateTransition(int event, int* perr) {
 
     g_stateTransitionError = err;
 
+    // recording starts in PSU thread tick
+    wakeUpPsuThread();
+
     if (perr) {
         *perr = err;
     } else {
@@ -784,6 +787,12 @@ void reset() {
 void tick(uint32_t tickCount) {
     if (g_state == STATE_EXECUTING && g_nextTime <= g_recording.parameters.time && !g_inStateTransition) {
         log(tickCount);
+
+        if (!g_traceInitiated) {
+            // next sample
+            double remaining = g_nextTime - g_currentTime;
+            scheduleTick(remaining > 0 ? (uint64_t)(remaining * 1E6) : 0);
+        }
     }
 }
 
@@ -561,193 +561,204 @@ void scaleToFit(Recording &recording) {
     }
 }
 
-bool openFile(const char *filePath, int *err) {
-    if (osThreadGetId() != g_scpiTaskHandle) {
-        g_state = STATE_LOADING;
-        g_loadingStartTickCount = millis();
+bool readHeader(File &file, uint8_t *buffer, uint32_t bufferSize, Recording &recording) {
+    uint32_t read = file.read(buffer, DLOG_VERSION1_HEADER_SIZE);
+    if (read != DLOG_VERSION1_HEADER_SIZE) {
+        return false;
+    }
 
-        strcpy(g_filePath, filePath);
-        memset(&g_recording, 0, sizeof(Recording));
+    uint32_t offset = 0;
 
-        osMessagePut(g_scpiMessageQueueId, SCPI_QUEUE_MESSAGE(SCPI_QUEUE_MESSAGE_TARGET_NONE, SCPI_QUEUE_MESSAGE_DLOG_SHOW_FILE, 0), osWaitForever);
-        return true;
+    uint32_t magic1 = readUint32(buffer, offset);
+    uint32_t magic2 = readUint32(buffer, offset);
+    uint16_t version = readUint16(buffer, offset);
+
+    if (magic1 != MAGIC1 || magic2 != MAGIC2 || (version != VERSION1 && version != VERSION2)) {
+        return false;
     }
 
-    g_state = STATE_LOADING;
+    bool invalidHeader = false;
 
-    File file;
-    if (file.open(filePath != nullptr ? filePath : g_filePath, FILE_OPEN_EXISTING | FILE_READ)) {
-        uint8_t * buffer = FILE_VIEW_BUFFER;
-        uint32_t read = file.read(buffer, DLOG_VERSION1_HEADER_SIZE);
-        if (read == DLOG_VERSION1_HEADER_SIZE) {
-            uint32_t offset = 0;
-
-            uint32_t magic1 = readUint32(buffer, offset);
-            uint32_t magic2 = readUint32(buffer, offset);
-            uint16_t version = readUint16(buffer, offset);
-
-            if (magic1 == MAGIC1 && magic2 == MAGIC2 && (version == VERSION1 || version == VERSION2)) {
-                bool invalidHeader = false;
-
-                if (version == VERSION1) {
-                    g_recording.dataOffset = DLOG_VERSION1_HEADER_SIZE;
-
-                    readUint16(buffer, offset); // flags
-                    uint32_t columns = readUint32(buffer, offset);
-                    float period = readFloat(buffer, offset);
-                    float duration = readFloat(buffer, offset);
-                    readUint32(buffer, offset); // startTime
-
-                    g_recording.parameters.period = period;
-                    g_recording.parameters.time = duration;
-
-                    for (int channelIndex = 0; channelIndex < CH_MAX; ++channelIndex) {
-                        g_recording.parameters.logVoltage[channelIndex] = columns & (1 << (4 * channelIndex)) ? 1 : 0;
-                        g_recording.parameters.logCurrent[channelIndex] = columns & (2 << (4 * channelIndex)) ? 1 : 0;
-                        g_recording.parameters.logPower[channelIndex] = columns & (4 << (4 * channelIndex)) ? 1 : 0;
-                    }
+    if (version == VERSION1) {
+        recording.dataOffset = DLOG_VERSION1_HEADER_SIZE;
 
-                    initAxis(g_recording);
-                } else {
-                    readUint16(buffer, offset); // No. of columns
-                    g_recording.dataOffset = readUint32(buffer, offset);
-
-                    // read the rest of the header
-                    if (DLOG_VERSION1_HEADER_SIZE < g_recording.dataOffset) {
-                        uint32_t headerRemaining = g_recording.dataOffset - DLOG_VERSION1_HEADER_SIZE;
-                        uint32_t read = file.read(buffer + DLOG_VERSION1_HEADER_SIZE, headerRemaining);
-                        if (read != headerRemaining) {
-                            invalidHeader = true;
-                        }
-                    }
+        readUint16(buffer, offset); // flags
+        uint32_t columns = readUint32(buffer, offset);
+        float period = readFloat(buffer, offset);
+        float duration = readFloat(buffer, offset);
+        readUint32(buffer, offset); // startTime
 
-                    while (!invalidHeader && offset < g_recording.dataOffset) {
-                        uint16_t fieldLength = readUint16(buffer, offset);
-                        if (fieldLength == 0) {
-                        	break;
-                        }
+        recording.parameters.period = period;
+        recording.parameters.time = duration;
 
-                        if (offset - sizeof(uint16_t) + fieldLength > g_recording.dataOffset) {
-                            invalidHeader = true;
-                            break;
-                        }
+        for (int channelIndex = 0; channelIndex < CH_MAX; ++channelIndex) {
+            recording.parameters.logVoltage[channelIndex] = columns & (1 << (4 * channelIndex)) ? 1 : 0;
+            recording.parameters.logCurrent[channelIndex] = columns & (2 << (4 * channelIndex)) ? 1 : 0;
+            recording.parameters.logPower[channelIndex] = columns & (4 << (4 * channelIndex)) ? 1 : 0;
+        }
 
-                        uint8_t fieldId = readUint8(buffer, offset);
+        initAxis(recording);
+    } else {
+        readUint16(buffer, offset); // No. of columns
+        recording.dataOffset = readUint32(buffer, offset);
 
-                        uint16_t fieldDataLength = fieldLength - sizeof(uint16_t) - sizeof(uint8_t);
+        if (recording.dataOffset > bufferSize) {
+            return false;
+        }
 
-                        if (fieldId == FIELD_ID_COMMENT) {
-                            if (fieldDataLength > MAX_COMMENT_LENGTH) {
-                                invalidHeader = true;
-                                break;
-                            }
-                            for (int i = 0; i < fieldDataLength; i++) {
-                                g_recording.parameters.comment[i] = readUint8(buffer, offset);
-                            }
-                            g_recording.parameters.comment[MAX_COMMENT_LENGTH] = 0;
-                        } else if (fieldId == FIELD_ID_X_UNIT) {
-                            g_recording.parameters.xAxis.unit = (Unit)readUint8(buffer, offset);
-                        } else if (fieldId == FIELD_ID_X_STEP) {
-                            g_recording.parameters.xAxis.step = readFloat(buffer, offset);
-                        } else if (fieldId == FIELD_ID_X_SCALE) {
-                            g_recording.parameters.xAxis.scale = (Scale)readUint8(buffer, offset);
-                        } else if (fieldId == FIELD_ID_X_RANGE_MIN) {
-                            g_recording.parameters.xAxis.range.min = readFloat(buffer, offset);
-                        } else if (fieldId == FIELD_ID_X_RANGE_MAX) {
-                            g_recording.parameters.xAxis.range.max = readFloat(buffer, offset);
-                        } else if (fieldId == FIELD_ID_X_LABEL) {
-                            if (fieldDataLength > MAX_LABEL_LENGTH) {
-                                invalidHeader = true;
-                                break;
-                            }
-                            for (int i = 0; i < fieldDataLength; i++) {
-                                g_recording.parameters.xAxis.label[i] = readUint8(buffer, offset);
-                            }
-                            g_recording.parameters.xAxis.label[MAX_LABEL_LENGTH] = 0;
-                        } else if (fieldId >= FIELD_ID_Y_UNIT && fieldId <= FIELD_ID_Y_CHANNEL_INDEX) {
-                            int8_t yAxisIndex = (int8_t)readUint8(buffer, offset);
-                            if (yAxisIndex > MAX_NUM_OF_Y_AXES) {
-                                invalidHeader = true;
-                                break;
-                            }
+        // read the rest of the header
+        if (DLOG_VERSION1_HEADER_SIZE < recording.dataOffset) {
+            uint32_t headerRemaining = recording.dataOffset - DLOG_VERSION1_HEADER_SIZE;
+            uint32_t read = file.read(buffer + DLOG_VERSION1_HEADER_SIZE, headerRemaining);
+            if (read != headerRemaining) {
+                invalidHeader = true;
+            }
+        }
 
-                            fieldDataLength -= sizeof(uint8_t);
+        while (!invalidHeader && offset < recording.dataOffset) {
+            uint16_t fieldLength = readUint16(buffer, offset);
+            if (fieldLength == 0) {
+            	break;
+            }
 
-                            yAxisIndex--;
-                            if (yAxisIndex >= g_recording.parameters.numYAxes) {
-                                g_recording.parameters.numYAxes = yAxisIndex + 1;
-                                initYAxis(g_recording.parameters, yAxisIndex);
-                            }
+            if (offset - sizeof(uint16_t) + fieldLength > recording.dataOffset) {
+                invalidHeader = true;
+                break;
+            }
 
-                            YAxis &destYAxis = yAxisIndex >= 0 ? g_recording.parameters.yAxes[yAxisIndex] : g_recording.parameters.yAxis;
-
-                            if (fieldId == FIELD_ID_Y_UNIT) {
-                                destYAxis.unit = (Unit)readUint8(buffer, offset);
-                            } else if (fieldId == FIELD_ID_Y_RANGE_MIN) {
-                                destYAxis.range.min = readFloat(buffer, offset);
-                            } else if (fieldId == FIELD_ID_Y_RANGE_MAX) {
-                                destYAxis.range.max = readFloat(buffer, offset);
-                            } else if (fieldId == FIELD_ID_Y_LABEL) {
-                                if (fieldDataLength > MAX_LABEL_LENGTH) {
-                                    invalidHeader = true;
-                                    break;
-                                }
-                                for (int i = 0; i < fieldDataLength; i++) {
-                                    destYAxis.label[i] = readUint8(buffer, offset);
-                                }
-                                destYAxis.label[MAX_LABEL_LENGTH] = 0;
-                            } else if (fieldId == FIELD_ID_Y_CHANNEL_INDEX) {
-                                destYAxis.channelIndex = (int16_t)(readUint8(buffer, offset)) - 1;
-                            } else {
-                                // unknown field, skip
-                                offset += fieldDataLength;
-                            }
-                        } else if (fieldId == FIELD_ID_Y_SCALE) {
-                            g_recording.parameters.yAxisScale = (Scale)readUint8(buffer, offset);
-                        } else if (fieldId == FIELD_ID_CHANNEL_MODULE_TYPE) {
-                            readUint8(buffer, offset); // channel index
-                            readUint16(buffer, offset); // module type
-                        } else if (fieldId == FIELD_ID_CHANNEL_MODULE_REVISION) {
-                            readUint8(buffer, offset); // channel index
-                            readUint16(buffer, offset); // module revision
-                        } else {
-                            // unknown field, skip
-                            offset += fieldDataLength;
-                        }
-                    }
+            uint8_t fieldId = readUint8(buffer, offset);
+
+            uint16_t fieldDataLength = fieldLength - sizeof(uint16_t) - sizeof(uint8_t);
 
-					g_recording.parameters.period = g_recording.parameters.xAxis.step;
-					g_recording.parameters.time = g_recording.parameters.xAxis.range.max - g_recording.parameters.xAxis.range.min;
+            if (fieldId == FIELD_ID_COMMENT) {
+                if (fieldDataLength > MAX_COMMENT_LENGTH) {
+                    invalidHeader = true;
+                    break;
+                }
+                for (int i = 0; i < fieldDataLength; i++) {
+                    recording.parameters.comment[i] = readUint8(buffer, offset);
+                }
+                recording.parameters.comment[MAX_COMMENT_LENGTH] = 0;
+            } else if (fieldId == FIELD_ID_X_UNIT) {
+                recording.parameters.xAxis.unit = (Unit)readUint8(buffer, offset);
+            } else if (fieldId == FIELD_ID_X_STEP) {
+                recording.parameters.xAxis.step = readFloat(buffer, offset);
+            } else if (fieldId == FIELD_ID_X_SCALE) {
+                recording.parameters.xAxis.scale = (Scale)readUint8(buffer, offset);
+            } else if (fieldId == FIELD_ID_X_RANGE_MIN) {
+                recording.parameters.xAxis.range.min = readFloat(buffer, offset);
+            } else if (fieldId == FIELD_ID_X_RANGE_MAX) {
+                recording.parameters.xAxis.range.max = readFloat(buffer, offset);
+            } else if (fieldId == FIELD_ID_X_LABEL) {
+                if (fieldDataLength > MAX_LABEL_LENGTH) {
+                    invalidHeader = true;
+                    break;
+                }
+                for (int i = 0; i < fieldDataLength; i++) {
+                    recording.parameters.xAxis.label[i] = readUint8(buffer, offset);
+                }
+                recording.parameters.xAxis.label[MAX_LABEL_LENGTH] = 0;
+            } else if (fieldId >= FIELD_ID_Y_UNIT && fieldId <= FIELD_ID_Y_CHANNEL_INDEX) {
+                int8_t yAxisIndex = (int8_t)readUint8(buffer, offset);
+                if (yAxisIndex > MAX_NUM_OF_Y_AXES) {
+                    invalidHeader = true;
+                    break;
                 }
 
-                if (!invalidHeader) {
-                    initDlogValues(g_recording);
+                fieldDataLength -= sizeof(uint8_t);
 
-                    g_recording.pageSize = VIEW_WIDTH;
+                yAxisIndex--;
+                if (yAxisIndex >= recording.parameters.numYAxes) {
+                    recording.parameters.numYAxes = yAxisIndex + 1;
+                    initYAxis(recording.parameters, yAxisIndex);
+                }
 
-                    g_recording.numSamples = (file.size() - g_recording.dataOffset) / (g_recording.parameters.numYAxes * sizeof(float));
-                    g_recording.xAxisDivMin = g_recording.pageSize * g_recording.parameters.period / dlog_view::NUM_HORZ_DIVISIONS;
-                    g_recording.xAxisDivMax = MAX(g_recording.numSamples, g_recording.pageSize) * g_recording.parameters.period / dlog_view::NUM_HORZ_DIVISIONS;
+                YAxis &destYAxis = yAxisIndex >= 0 ? recording.parameters.yAxes[yAxisIndex] : recording.parameters.yAxis;
+
+                if (fieldId == FIELD_ID_Y_UNIT) {
+                    destYAxis.unit = (Unit)readUint8(buffer, offset);
+                } else if (fieldId == FIELD_ID_Y_RANGE_MIN) {
+                    destYAxis.range.min = readFloat(buffer, offset);
+                } else if (fieldId == FIELD_ID_Y_RANGE_MAX) {
+                    destYAxis.range.max = readFloat(buffer, offset);
+                } else if (fieldId == FIELD_ID_Y_LABEL) {
+                    if (fieldDataLength > MAX_LABEL_LENGTH) {
+                        invalidHeader = true;
+                        break;
+                    }
+                    for (int i = 0; i < fieldDataLength; i++) {
+                        destYAxis.label[i] = readUint8(buffer, offset);
+                    }
+                    destYAxis.label[MAX_LABEL_LENGTH] = 0;
+                } else if (fieldId == FIELD_ID_Y_CHANNEL_INDEX) {
+                    destYAxis.channelIndex = (int16_t)(readUint8(buffer, offset)) - 1;
+                } else {
+                    // unknown field, skip
+                    offset += fieldDataLength;
+                }
+            } else if (fieldId == FIELD_ID_Y_SCALE) {
+                recording.parameters.yAxisScale = (Scale)readUint8(buffer, offset);
+            } else if (fieldId == FIELD_ID_CHANNEL_MODULE_TYPE) {
+                readUint8(buffer, offset); // channel index
+                readUint16(buffer, offset); // module type
+            } else if (fieldId == FIELD_ID_CHANNEL_MODULE_REVISION) {
+                readUint8(buffer, offset); // channel index
+                readUint16(buffer, offset); // module revision
+            } else {
+                // unknown field, skip
+                offset += fieldDataLength;
+            }
+        }
 
-                    g_recording.size = g_recording.numSamples;
+        recording.parameters.period = recording.parameters.xAxis.step;
+        recording.parameters.time = recording.parameters.xAxis.range.max - recording.parameters.xAxis.range.min;
+    }
 
-                    g_recording.xAxisOffset = 0.0f;
-                    g_recording.xAxisDiv = g_recording.xAxisDivMin;
+    return !invalidHeader && recording.parameters.numYAxes > 0;
+}
 
-                    g_recording.cursorOffset = VIEW_WIDTH / 2;
+bool openFile(const char *filePath, int *err) {
+    if (osThreadGetId() != g_scpiTaskHandle) {
+        g_state = STATE_LOADING;
+        g_loadingStartTickCount = millis();
 
-                    g_recording.getValue = getValue;
-                    g_isLoading = false;
+        strcpy(g_filePath, filePath);
+        memset(&g_recording, 0, sizeof(Recording));
 
-                    if (isMulipleValuesOverlayHeuristic(g_recording)) {
-                        autoScale(g_recording);
-                    }
+        osMessagePut(g_scpiMessageQueueId, SCPI_QUEUE_MESSAGE(SCPI_QUEUE_MESSAGE_TARGET_NONE, SCPI_QUEUE_MESSAGE_DLOG_SHOW_FILE, 0), osWaitForever);
+        return true;
+    }
 
-                    g_state = STATE_READY;
+    g_state = STATE_LOADING;
 
-                    invalidateAllBlocks();
-                }
+    File file;
+    if (file.open(filePath != nullptr ? filePath : g_filePath, FILE_OPEN_EXISTING | FILE_READ)) {
+        if (readHeader(file, FILE_VIEW_BUFFER, FILE_VIEW_BUFFER_SIZE, g_recording)) {
+            initDlogValues(g_recording);
+
+            g_recording.pageSize = VIEW_WIDTH;
+
+            g_recording.numSamples = (file.size() - g_recording.dataOffset) / (g_recording.parameters.numYAxes * sizeof(float));
+            g_recording.xAxisDivMin = g_recording.pageSize * g_recording.parameters.period / dlog_view::NUM_HORZ_DIVISIONS;
+            g_recording.xAxisDivMax = MAX(g_recording.numSamples, g_recording.pageSize) * g_recording.parameters.period / dlog_view::NUM_HORZ_DIVISIONS;
+
+            g_recording.size = g_recording.numSamples;
+
+            g_recording.xAxisOffset = 0.0f;
+            g_recording.xAxisDiv = g_recording.xAxisDivMin;
+
+            g_recording.cursorOffset = VIEW_WIDTH / 2;
+
+            g_recording.getValue = getValue;
+            g_isLoading = false;
+
+            if (isMulipleValuesOverlayHeuristic(g_recording)) {
+                autoScale(g_recording);
             }
+
+            g_state = STATE_READY;
+
+            invalidateAllBlocks();
         }
 
         if (g_state != STATE_READY) {
@@ -54,6 +54,9 @@ OFFSET    TYPE    WIDTH    DESCRIPTION
 */
 
 namespace eez {
+
+class File;
+
 namespace psu {
 namespace dlog_view {
 
@@ -208,6 +211,10 @@ extern bool g_showLatest;
 // open dlog file for viewing
 bool openFile(const char *filePath, int *err = nullptr);
 
+// reads VERSION1 or VERSION2 header into recording parameters and dataOffset,
+// file must be positioned at the start and buffer must fit the whole header
+bool readHeader(File &file, uint8_t *buffer, uint32_t bufferSize, Recording &recording);
+
 extern State getState();
 
 // this is called from the thread that owns SD card
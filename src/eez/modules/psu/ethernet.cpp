@@ -23,12 +23,15 @@
 #include <eez/firmware.h>
 
 #include <eez/modules/psu/psu.h>
+#include <eez/modules/psu/channel_dispatcher.h>
 #include <eez/modules/psu/event_queue.h>
 #include <eez/modules/psu/persist_conf.h>
 #include <eez/modules/psu/serial_psu.h>
 #include <eez/modules/psu/ethernet.h>
 
 #include <eez/modules/mcu/ethernet.h>
+#include <eez/modules/mcu/remote_display.h>
+#include <eez/modules/psu/stream.h>
 
 #define CONF_CHECK_DHCP_LEASE_SEC 60
 
@@ -156,12 +159,15 @@ void onQueueMessage(uint32_t type, uint32_t param) {
         g_testResult = TEST_OK;
 
         eez::mcu::ethernet::beginServer(persist_conf::devConf.ethernetScpiPort);
+        updateRemoteDisplay();
+        stream::beginServer(STREAM_TCP_PORT);
         //DebugTrace("Listening on port %d", (int)persist_conf::devConf.ethernetScpiPort);
     } else if (type == ETHERNET_CLIENT_CONNECTED) {
         g_isConnected = true;
         scpi::emptyBuffer(g_scpiContext);
     } else if (type == ETHERNET_CLIENT_DISCONNECTED) {
         g_isConnected = false;
+        channel_dispatcher::abortTransaction(&g_scpiContext);
     } else if (type == ETHERNET_INPUT_AVAILABLE) {
         char *buffer;
         uint32_t length;
@@ -181,6 +187,14 @@ bool isConnected() {
     return g_isConnected;
 }
 
+void updateRemoteDisplay() {
+    if (persist_conf::isEthernetEnabled() && persist_conf::isRemoteDisplayEnabled() && g_testResult == TEST_OK) {
+        eez::mcu::remote_display::beginServer(REMOTE_DISPLAY_TCP_PORT);
+    } else {
+        eez::mcu::remote_display::endServer();
+    }
+}
+
 void update() {
     static TestResult g_testResultAtBoot;
 
@@ -191,6 +205,8 @@ void update() {
 
         if (callBeginServer) {
             eez::mcu::ethernet::beginServer(persist_conf::devConf.ethernetScpiPort);
+            updateRemoteDisplay();
+            stream::beginServer(STREAM_TCP_PORT);
         }
     } else {
         if (g_isConnected) {
@@ -199,6 +215,8 @@ void update() {
         }
 
         eez::mcu::ethernet::endServer();
+        eez::mcu::remote_display::endServer();
+        stream::endServer();
 
         if (g_testResult != TEST_SKIPPED) {
             g_testResultAtBoot = g_testResult;
@@ -47,6 +47,10 @@ bool isConnected();
 // and it should reconnect to the ethernet with these settings
 void update();
 
+// starts or stops remote display server, it runs only if it is enabled
+// in the device configuration and ethernet is connected
+void updateRemoteDisplay();
+
 } // namespace ethernet
 } // namespace psu
 } // namespace eez
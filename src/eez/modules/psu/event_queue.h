@@ -163,6 +163,12 @@ static const int EVENT_TYPE_ERROR = 4;
     EVENT_WARNING(FILE_UPLOAD_ABORTED, 23, "File upload aborted")                                  \
     EVENT_WARNING(FILE_DOWNLOAD_ABORTED, 24, "File download aborted")                              \
     EVENT_WARNING(AUTO_RECALL_MODULE_MISMATCH, 25, "Auto-recall module mismatch")                  \
+    EVENT_WARNING(CH1_CURRENT_DERATED, 30, "Ch1 current derated")                                  \
+    EVENT_WARNING(CH2_CURRENT_DERATED, 31, "Ch2 current derated")                                  \
+    EVENT_WARNING(CH3_CURRENT_DERATED, 32, "Ch3 current derated")                                  \
+    EVENT_WARNING(CH4_CURRENT_DERATED, 33, "Ch4 current derated")                                  \
+    EVENT_WARNING(CH5_CURRENT_DERATED, 34, "Ch5 current derated")                                  \
+    EVENT_WARNING(CH6_CURRENT_DERATED, 35, "Ch6 current derated")                                  \
     EVENT_INFO(WELCOME, 0, "Welcome!")                                                             \
     EVENT_INFO(POWER_UP, 1, "Power up")                                                            \
     EVENT_INFO(POWER_DOWN, 2, "Power down")                                                        \
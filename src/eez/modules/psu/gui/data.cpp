@@ -95,6 +95,7 @@ EnumItem g_enumDefinition_CHANNEL_TRIGGER_MODE[] = {
     { TRIGGER_MODE_FIXED, "Fixed" },
     { TRIGGER_MODE_LIST, "List" },
     { TRIGGER_MODE_STEP, "Step" },
+    { TRIGGER_MODE_FUNCTION, "Function" },
     { 0, 0 } 
 };
 
@@ -355,7 +356,9 @@ void printTime(double time, char *text, int count) {
     } else if (m > 0) {
         snprintf(text, count - 1, "%um %us", m, (unsigned int)floor(s));
     } else {
-        snprintf(text, count - 1, "%gs", s);
+        char str[32];
+        floatToStr(str, s);
+        snprintf(text, count - 1, "%ss", str);
     }
 
     text[count - 1] = 0;
@@ -2696,7 +2699,12 @@ void data_channel_protection_ocp_limit(DataOperationEnum operation, Cursor curso
 
 void data_channel_protection_ocp_max_current_limit_cause(DataOperationEnum operation, Cursor cursor, Value &value) {
     if (operation == DATA_OPERATION_GET) {
-        value = Value(g_channel->getMaxCurrentLimitCause());
+        MaxCurrentLimitCause cause = g_channel->getMaxCurrentLimitCause();
+        // thermal derating is shown with the temperature icon
+        if (cause == MAX_CURRENT_LIMIT_CAUSE_THERMAL) {
+            cause = MAX_CURRENT_LIMIT_CAUSE_TEMPERATURE;
+        }
+        value = Value(cause);
     }
 }
 
@@ -3067,7 +3075,7 @@ void data_channel_tracking_is_enabled(DataOperationEnum operation, Cursor cursor
 
 void data_channel_tracking_is_allowed(DataOperationEnum operation, Cursor cursor, Value &value) {
     if (operation == DATA_OPERATION_GET) {
-        auto channel = Channel::get(cursor);
+        auto &channel = Channel::get(cursor);
         value = channel_dispatcher::isTrackingAllowed(channel, nullptr) ? 1 : 0;
     }
 }
@@ -5045,7 +5053,8 @@ void data_channel_history_values(DataOperationEnum operation, Cursor cursor, Val
     if (operation == DATA_OPERATION_YT_DATA_GET_GET_VALUE_FUNC) {
         value = Channel::getChannelHistoryValueFuncs(cursor);
     } else if (operation == DATA_OPERATION_YT_DATA_GET_REFRESH_COUNTER) {
-        value = Value(0, VALUE_TYPE_UINT32);
+        int iChannel = cursor >= 0 ? cursor : (g_channel ? g_channel->channelIndex : 0);
+        value = Value(Channel::get(iChannel).getHistoryRefreshCounter(), VALUE_TYPE_UINT32);
     } else if (operation == DATA_OPERATION_YT_DATA_GET_SIZE) {
         value = Value(CHANNEL_HISTORY_SIZE, VALUE_TYPE_UINT32);
     } else if (operation == DATA_OPERATION_YT_DATA_GET_POSITION) {
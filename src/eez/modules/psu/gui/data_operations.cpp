@@ -0,0 +1,889 @@
+/*
+ * EEZ Modular Firmware
+ * Copyright (C) 2020-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Generated by tools/gen_data_operations.py, do not edit.
+
+#if OPTION_DISPLAY
+
+#include <eez/gui/gui.h>
+
+namespace eez {
+namespace gui {
+
+#if defined(EEZ_PLATFORM_STM32)
+
+const uint64_t g_dataOperationsMasks[] = {
+    DATA_OPERATIONS_ALL, // data_none
+    DATA_OPERATION_MASK(DATA_OPERATION_COUNT) | DATA_OPERATION_MASK(DATA_OPERATION_DESELECT) | DATA_OPERATION_MASK(DATA_OPERATION_SELECT), // data_channels
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_status
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_output_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_is_cc
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_is_cv
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_EDIT_VALUE) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_LIMIT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_u_set
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_EDIT_VALUE) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_LIMIT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_display_value1_set
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ACTIVE_BACKGROUND_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ACTIVE_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_BACKGROUND_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_LIMIT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_TEXT_REFRESH_RATE) | DATA_OPERATION_MASK(DATA_OPERATION_IS_BLINKING), // data_channel_u_mon
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_BACKGROUND_COLOR), // data_channel_u_mon_dac
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_u_limit
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_display_value1_limit
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_EDIT_VALUE) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_LIMIT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_u_edit
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_EDIT_VALUE) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_LIMIT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_i_set
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_EDIT_VALUE) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_LIMIT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_display_value2_set
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ACTIVE_BACKGROUND_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ACTIVE_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_BACKGROUND_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_LIMIT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_TEXT_REFRESH_RATE) | DATA_OPERATION_MASK(DATA_OPERATION_IS_BLINKING), // data_channel_i_mon
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_BACKGROUND_COLOR), // data_channel_i_mon_dac
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_i_limit
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_display_value2_limit
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_EDIT_VALUE) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_LIMIT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_i_edit
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ACTIVE_BACKGROUND_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ACTIVE_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_BACKGROUND_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_LIMIT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_TEXT_REFRESH_RATE) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_IS_BLINKING), // data_channel_p_mon
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ACTIVE_BACKGROUND_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ACTIVE_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_BACKGROUND_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_LIMIT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_TEXT_REFRESH_RATE) | DATA_OPERATION_MASK(DATA_OPERATION_IS_BLINKING), // data_channel_other_value_mon
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channels_is_max_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channels_view_mode
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channels_view_mode_in_default
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channels_view_mode_in_max
+    DATA_OPERATION_MASK(DATA_OPERATION_GET_CONTEXT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_CONTEXT_CURSOR) | DATA_OPERATION_MASK(DATA_OPERATION_RESTORE_CONTEXT) | DATA_OPERATION_MASK(DATA_OPERATION_SET_CONTEXT), // data_slot_max_channel_index
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot_max_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET_CONTEXT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_CONTEXT_CURSOR) | DATA_OPERATION_MASK(DATA_OPERATION_RESTORE_CONTEXT) | DATA_OPERATION_MASK(DATA_OPERATION_SET_CONTEXT), // data_slot_min1_channel_index
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot_min1_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET_CONTEXT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_CONTEXT_CURSOR) | DATA_OPERATION_MASK(DATA_OPERATION_RESTORE_CONTEXT) | DATA_OPERATION_MASK(DATA_OPERATION_SET_CONTEXT), // data_slot_min2_channel_index
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot_min2_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot_micro1_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot_micro2_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot_micro3_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ACTIVE_BACKGROUND_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ACTIVE_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_BACKGROUND_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_LIMIT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_TEXT_REFRESH_RATE) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_IS_BLINKING), // data_channel_display_value1
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ACTIVE_BACKGROUND_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ACTIVE_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_BACKGROUND_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_LIMIT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_TEXT_REFRESH_RATE) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_IS_BLINKING), // data_channel_display_value2
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_ovp
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_ocp
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_opp
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_otp_ch
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_otp_aux
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_alert_message
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_alert_message_2
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_alert_message_3
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_IS_BLINKING), // data_edit_value
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_edit_unit
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_edit_info
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_edit_mode_interactive_mode_selector
+    DATA_OPERATIONS_ALL, // data_edit_steps
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_master_info
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_master_test_result
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_firmware_info
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_keypad_text
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_keypad_mode
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_keypad_option1_text
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_keypad_option1_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_keypad_option2_text
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_keypad_option2_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_keypad_sign_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_keypad_dot_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_keypad_unit_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_label
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_short_label
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_temp_status
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_temp
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_on_time_total
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_on_time_last
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_calibration_status
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_calibration_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_calibration_date
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_calibration_remark
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_cal_ch_u_min
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_cal_ch_u_mid
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_cal_ch_u_max
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_cal_ch_i0_min
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_cal_ch_i0_mid
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_cal_ch_i0_max
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_cal_ch_i1_min
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_cal_ch_i1_mid
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_cal_ch_i1_max
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_protection_status
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_protection_ovp_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_protection_ovp_type
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_protection_ovp_level
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_protection_ovp_delay
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_protection_ovp_limit
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_protection_ocp_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_protection_ocp_delay
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_protection_ocp_limit
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_protection_ocp_max_current_limit_cause
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_protection_opp_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_protection_opp_level
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_protection_opp_delay
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_protection_opp_limit
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_protection_otp_installed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_protection_otp_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_protection_otp_level
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_protection_otp_delay
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_event_queue_last_event_type
+    DATA_OPERATION_MASK(DATA_OPERATION_COUNT) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_PAGE_SIZE) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_POSITION) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_SIZE) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_SET_POSITION), // data_event_queue_events
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_event_queue_event_type
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_event_queue_event_message
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_event_queue_selected_event_message
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_rsense_status
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_rprog_installed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_rprog_status
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_tracking_is_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_tracking_is_allowed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_is_par_ser_coupled_or_tracked
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_coupling_type
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_coupling_is_series
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_on_time_total
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_on_time_last
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_temp_aux_status
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_temp_aux_otp_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_temp_aux_otp_level
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_temp_aux_otp_delay
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_temp_aux_otp_is_tripped
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_temp_aux
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_info_firmware_ver
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_info_serial_no
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_info_scpi_ver
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_info_cpu
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_info_fan_status
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_info_fan_speed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_board_info_label
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_board_info_revision
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_date_time_date
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_date_time_year
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_date_time_month
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_date_time_day
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_date_time_time
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_date_time_hour
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_date_time_minute
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_date_time_second
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_date_time_time_zone
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_date_time_dst
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_set_page_dirty
+    DATA_OPERATION_MASK(DATA_OPERATION_COUNT), // data_profiles_list
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_profiles_auto_recall_status
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_profiles_auto_recall_location
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_profile_status
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_profile_label
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_profile_remark
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_profile_is_auto_recall_location
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_profile_channel_u_set
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_profile_channel_i_set
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_profile_channel_output_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_ethernet_installed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_ethernet_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_mqtt_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_ethernet_status
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_ethernet_and_mqtt_status
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_mqtt_connection_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_ethernet_ip_address
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_ethernet_dns
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_ethernet_gateway
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_ethernet_subnet_mask
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_ethernet_scpi_port
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_ethernet_is_connected
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_ethernet_dhcp
+    DATA_OPERATIONS_ALL, // data_ethernet_mac
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_is_voltage_balanced
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_is_current_balanced
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_output_protection_coupled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_shutdown_when_protection_tripped
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_force_disabling_all_outputs_on_power_up
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_password_is_set
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_rl_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_sound_is_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_sound_is_click_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_sound_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_display_view_settings_display_value1
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_display_view_settings_display_value2
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_display_view_settings_yt_view_rate
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_encoder_confirmation_mode
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_sys_encoder_moving_up_speed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_sys_encoder_moving_down_speed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_encoder_installed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_display_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_sys_display_brightness
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_trigger_mode
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_trigger_on_list_stop
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_EDIT_VALUE) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_LIMIT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_u_trigger_value
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_EDIT_VALUE) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_LIMIT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_i_trigger_value
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_list_count
+    DATA_OPERATION_MASK(DATA_OPERATION_COUNT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_FLOAT_LIST_LENGTH), // data_channel_lists
+    DATA_OPERATIONS_ALL, // data_ramp_and_delay_list
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_list_index
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_DEF) | DATA_OPERATION_MASK(DATA_OPERATION_GET_FLOAT_LIST) | DATA_OPERATION_MASK(DATA_OPERATION_GET_FLOAT_LIST_LENGTH) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN), // data_channel_list_dwell
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_list_dwell_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_DEF) | DATA_OPERATION_MASK(DATA_OPERATION_GET_FLOAT_LIST) | DATA_OPERATION_MASK(DATA_OPERATION_GET_FLOAT_LIST_LENGTH) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN), // data_channel_list_voltage
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_list_voltage_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_DEF) | DATA_OPERATION_MASK(DATA_OPERATION_GET_FLOAT_LIST) | DATA_OPERATION_MASK(DATA_OPERATION_GET_FLOAT_LIST_LENGTH) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN), // data_channel_list_current
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_list_current_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_lists_previous_page_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_lists_next_page_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_lists_cursor
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_lists_insert_menu_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_lists_delete_menu_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_lists_delete_row_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_lists_clear_column_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_lists_delete_rows_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_coupling_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_trigger_source
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_trigger_delay
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_trigger_initiate_continuously
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_IS_BLINKING), // data_trigger_is_initiated
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_trigger_is_manual
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_has_support_for_current_dual_range
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_ranges_supported
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_ranges_mode
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_ranges_auto_ranging
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_ranges_currently_selected
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_text_message
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_serial_status
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_serial_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_serial_is_connected
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_list_countdown
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_ramp_countdown
+    DATA_OPERATION_MASK(DATA_OPERATION_COUNT), // data_io_pins
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_IS_BLINKING), // data_io_pins_inhibit_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_io_pin_number
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_io_pin_polarity
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_io_pin_function_name
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_ntp_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_ntp_server
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_sys_display_background_luminosity_step
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_progress
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_touch_calibration_point
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_selected_theme
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_title
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_short_title
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_short_title_with_colon
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_short_title_without_tracking_icon
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_long_title
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_animations_duration
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot1_info
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot2_info
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot3_info
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot1_test_result
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot2_test_result
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot3_test_result
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot_default1_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot_default2_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot_default3_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET_CONTEXT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_CONTEXT_CURSOR) | DATA_OPERATION_MASK(DATA_OPERATION_RESTORE_CONTEXT) | DATA_OPERATION_MASK(DATA_OPERATION_SET_CONTEXT), // data_slot1_channel_index
+    DATA_OPERATION_MASK(DATA_OPERATION_GET_CONTEXT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_CONTEXT_CURSOR) | DATA_OPERATION_MASK(DATA_OPERATION_RESTORE_CONTEXT) | DATA_OPERATION_MASK(DATA_OPERATION_SET_CONTEXT), // data_slot2_channel_index
+    DATA_OPERATION_MASK(DATA_OPERATION_GET_CONTEXT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_CONTEXT_CURSOR) | DATA_OPERATION_MASK(DATA_OPERATION_RESTORE_CONTEXT) | DATA_OPERATION_MASK(DATA_OPERATION_SET_CONTEXT), // data_slot3_channel_index
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot_def_2ch_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot_max_2ch_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot_min_2ch_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot_micro_2ch_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET_CONTEXT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_CONTEXT_CURSOR) | DATA_OPERATION_MASK(DATA_OPERATION_RESTORE_CONTEXT) | DATA_OPERATION_MASK(DATA_OPERATION_SET_CONTEXT), // data_slot_2ch_ch1_index
+    DATA_OPERATION_MASK(DATA_OPERATION_GET_CONTEXT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_CONTEXT_CURSOR) | DATA_OPERATION_MASK(DATA_OPERATION_RESTORE_CONTEXT) | DATA_OPERATION_MASK(DATA_OPERATION_SET_CONTEXT), // data_slot_2ch_ch2_index
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_battery
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_io_pin_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_dprog
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_dprog_installed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_info_sdcard_status
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_info_has_error
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_settings_has_error
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_info_battery_status
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_fan_mode
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_fan_speed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_is_coupling_type_uncoupled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_is_coupling_type_parallel
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_is_coupling_type_common_gnd
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_is_coupling_type_split_rails
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_is_tracking_allowed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_is_coupling_parallel_allowed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_is_coupling_series_allowed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_coupling_enable_tracking_mode
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_active_coupled_led
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_is_coupling_type_series
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_is_coupled_or_tracked
+    DATA_OPERATIONS_ALL, // data_overlay
+    DATA_OPERATION_MASK(DATA_OPERATION_COUNT), // data_channels_with_list_counter_visible
+    DATA_OPERATION_MASK(DATA_OPERATION_COUNT), // data_channels_with_ramp_counter_visible
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_dlog_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_dlog_toggle_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_DEF) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_SET) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_CURSOR_OFFSET) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_CURSOR_X_VALUE) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_DIV) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_GET_VALUE_FUNC) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_GRAPH_UPDATE_METHOD) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_HORZ_DIVISIONS) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_LABEL) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_OFFSET) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_PAGE_SIZE) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_PERIOD) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_POSITION) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_REFRESH_COUNTER) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_SELECTED_VALUE_INDEX) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_SHOW_LABELS) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_SIZE) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_STYLE) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_VERT_DIVISIONS) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_IS_CURSOR_VISIBLE) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_SET_POSITION) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_TOUCH_DRAG) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_VALUE_IS_VISIBLE), // data_recording
+    DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_GET_VALUE_FUNC) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_GRAPH_UPDATE_METHOD) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_POSITION) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_REFRESH_COUNTER) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_SIZE) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_STYLE), // data_channel_history_values
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_recording_ready
+    DATA_OPERATIONS_ALL, // data_nondrag_overlay
+    DATA_OPERATIONS_ALL, // data_dlog_single_value_overlay
+    DATA_OPERATIONS_ALL, // data_dlog_multiple_values_overlay
+    DATA_OPERATION_MASK(DATA_OPERATION_COUNT), // data_dlog_visible_values
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_dlog_visible_value_label
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_EDIT_VALUE) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_dlog_visible_value_div
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_EDIT_VALUE) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_dlog_visible_value_offset
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_dlog_visible_value_cursor
+    DATA_OPERATION_MASK(DATA_OPERATION_COUNT), // data_dlog_all_values
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_dlog_current_time
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_dlog_file_length
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_dlog_x_axis_offset
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_DEF) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_dlog_x_axis_div
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_dlog_x_axis_max_value
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_dlog_x_axis_max_value_label
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_is_single_page_on_stack
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_is_show_live_recording
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_dlog_view_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_dlog_period
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_dlog_duration
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_dlog_voltage_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_dlog_current_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_dlog_power_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_dlog_start_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_dlog_file_name
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_dlog_value_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot_max_2ch_min_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_off_label
+    DATA_OPERATION_MASK(DATA_OPERATION_COUNT) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_PAGE_SIZE) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_POSITION) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_POSITION_INCREMENT) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_SIZE) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_SET_POSITION), // data_file_manager_files
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_file_name
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_file_date_time
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_file_size
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_file_selected
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_is_root_directory
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_current_directory
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_is_directory
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_file_type
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_open_file_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_upload_file_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_rename_file_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_delete_file_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET_BITMAP_IMAGE), // data_file_manager_opened_image
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_script_info
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_script_is_started
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_keypad_ok_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_IS_VALID_VALUE) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_ethernet_host_name
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_mqtt_host
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_DEF) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_mqtt_port
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_mqtt_username
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_mqtt_password
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_mqtt_period
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_dlog_view_show_labels
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_is_any_coupling_allowed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_is_coupling_split_rails_allowed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_list_counter_label
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_ramp_counter_label
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_module_specific_ch_settings
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_firmware_version
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_browser_title
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_has_error_settings
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_settings_page
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_is_reset_by_iwdg
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_dlog_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_browser_is_save_dialog
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_storage_info
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_storage_alarm
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_event_queue_is_long_message_text
+    DATA_OPERATIONS_ALL, // data_event_queue_event_long_message_overlay
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_event_queue_event_is_selected
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_date_time_format
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_date_time_format_is_dmy
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_date_time_format_is_24h
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_date_time_am_pm
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_is_multi_tracking
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_copy_available
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_rsense_installed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_sort_files_option
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_info_brand
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_info_serial
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_list_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_is_list_view_option_available
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_file_icon
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_layout
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_file_description
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_touch_raw_x
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_touch_raw_y
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_touch_raw_z1
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_touch_raw_pressed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_touch_calibrated_x
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_touch_calibrated_y
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_touch_calibrated_pressed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_touch_filtered_x
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_touch_filtered_y
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_touch_filtered_pressed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_can_show_previous_page
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_file_has_description
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_image_open_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_image_open_progress
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_alert_message_is_set
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_async_progress
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_io_pin_function
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ALLOW_ZERO) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_io_pin_pwm_frequency
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_io_pin_pwm_duty
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ALLOW_ZERO) | DATA_OPERATION_MASK(DATA_OPERATION_GET_EDIT_VALUE) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_LIMIT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_voltage_ramp_duration
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ALLOW_ZERO) | DATA_OPERATION_MASK(DATA_OPERATION_GET_EDIT_VALUE) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_LIMIT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_current_ramp_duration
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ALLOW_ZERO) | DATA_OPERATION_MASK(DATA_OPERATION_GET_EDIT_VALUE) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_LIMIT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_output_delay
+    DATA_OPERATIONS_ALL, // data_debug_variables
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_debug_variable_name
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_TEXT_REFRESH_RATE), // data_debug_variable_value
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_ramp_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_ramp_and_delay_list_scrollbar_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_mqtt_in_error
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_PRECISION) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_debug_i_dac
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_PRECISION) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_debug_u_dac
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_debug_i_dac_amper
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_debug_u_dac_voltage
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_TEXT_REFRESH_RATE), // data_debug_i_adc
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_TEXT_REFRESH_RATE), // data_debug_u_adc
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_TEXT_REFRESH_RATE), // data_debug_i_adc_amper
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_TEXT_REFRESH_RATE), // data_debug_u_adc_voltage
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_dlog_view_legend_view_option
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_PRECISION) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_calibration_point_measured_value
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_calibration_value_type
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_calibration_value_is_voltage
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_calibration_point_can_move_to_previous
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_calibration_point_can_move_to_next
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_calibration_point_can_delete
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_calibration_point_info
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_CANVAS_DRAW_FUNCTION), // data_channel_calibration_chart
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_calibration_point_can_save
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_calibration_chart_zoom
+};
+
+static_assert(sizeof(g_dataOperationsMasks) / sizeof(uint64_t) == DATA_ID_CHANNEL_CALIBRATION_CHART_ZOOM + 1, "Run tools/gen_data_operations.py");
+
+#elif defined(EEZ_PLATFORM_SIMULATOR)
+
+const uint64_t g_dataOperationsMasks[] = {
+    DATA_OPERATIONS_ALL, // data_none
+    DATA_OPERATION_MASK(DATA_OPERATION_COUNT) | DATA_OPERATION_MASK(DATA_OPERATION_DESELECT) | DATA_OPERATION_MASK(DATA_OPERATION_SELECT), // data_channels
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_status
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_output_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_is_cc
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_is_cv
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_EDIT_VALUE) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_LIMIT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_u_set
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_EDIT_VALUE) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_LIMIT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_display_value1_set
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ACTIVE_BACKGROUND_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ACTIVE_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_BACKGROUND_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_LIMIT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_TEXT_REFRESH_RATE) | DATA_OPERATION_MASK(DATA_OPERATION_IS_BLINKING), // data_channel_u_mon
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_BACKGROUND_COLOR), // data_channel_u_mon_dac
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_u_limit
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_display_value1_limit
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_EDIT_VALUE) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_LIMIT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_u_edit
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_EDIT_VALUE) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_LIMIT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_i_set
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_EDIT_VALUE) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_LIMIT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_display_value2_set
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ACTIVE_BACKGROUND_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ACTIVE_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_BACKGROUND_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_LIMIT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_TEXT_REFRESH_RATE) | DATA_OPERATION_MASK(DATA_OPERATION_IS_BLINKING), // data_channel_i_mon
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_BACKGROUND_COLOR), // data_channel_i_mon_dac
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_i_limit
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_display_value2_limit
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_EDIT_VALUE) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_LIMIT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_i_edit
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ACTIVE_BACKGROUND_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ACTIVE_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_BACKGROUND_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_LIMIT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_TEXT_REFRESH_RATE) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_IS_BLINKING), // data_channel_p_mon
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ACTIVE_BACKGROUND_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ACTIVE_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_BACKGROUND_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_LIMIT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_TEXT_REFRESH_RATE) | DATA_OPERATION_MASK(DATA_OPERATION_IS_BLINKING), // data_channel_other_value_mon
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channels_is_max_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channels_view_mode
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channels_view_mode_in_default
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channels_view_mode_in_max
+    DATA_OPERATION_MASK(DATA_OPERATION_GET_CONTEXT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_CONTEXT_CURSOR) | DATA_OPERATION_MASK(DATA_OPERATION_RESTORE_CONTEXT) | DATA_OPERATION_MASK(DATA_OPERATION_SET_CONTEXT), // data_slot_max_channel_index
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot_max_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET_CONTEXT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_CONTEXT_CURSOR) | DATA_OPERATION_MASK(DATA_OPERATION_RESTORE_CONTEXT) | DATA_OPERATION_MASK(DATA_OPERATION_SET_CONTEXT), // data_slot_min1_channel_index
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot_min1_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET_CONTEXT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_CONTEXT_CURSOR) | DATA_OPERATION_MASK(DATA_OPERATION_RESTORE_CONTEXT) | DATA_OPERATION_MASK(DATA_OPERATION_SET_CONTEXT), // data_slot_min2_channel_index
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot_min2_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot_micro1_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot_micro2_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot_micro3_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ACTIVE_BACKGROUND_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ACTIVE_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_BACKGROUND_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_LIMIT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_TEXT_REFRESH_RATE) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_IS_BLINKING), // data_channel_display_value1
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ACTIVE_BACKGROUND_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ACTIVE_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_BACKGROUND_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_COLOR) | DATA_OPERATION_MASK(DATA_OPERATION_GET_LIMIT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_TEXT_REFRESH_RATE) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_IS_BLINKING), // data_channel_display_value2
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_ovp
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_ocp
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_opp
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_otp_ch
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_otp_aux
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_alert_message
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_alert_message_2
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_alert_message_3
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_IS_BLINKING), // data_edit_value
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_edit_unit
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_edit_info
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_edit_mode_interactive_mode_selector
+    DATA_OPERATIONS_ALL, // data_edit_steps
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_master_info
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_master_test_result
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_firmware_info
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_keypad_text
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_keypad_mode
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_keypad_option1_text
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_keypad_option1_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_keypad_option2_text
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_keypad_option2_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_keypad_sign_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_keypad_dot_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_keypad_unit_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_label
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_short_label
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_temp_status
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_temp
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_on_time_total
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_on_time_last
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_calibration_status
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_calibration_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_calibration_date
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_calibration_remark
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_cal_ch_u_min
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_cal_ch_u_mid
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_cal_ch_u_max
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_cal_ch_i0_min
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_cal_ch_i0_mid
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_cal_ch_i0_max
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_cal_ch_i1_min
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_cal_ch_i1_mid
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_cal_ch_i1_max
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_protection_status
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_protection_ovp_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_protection_ovp_type
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_protection_ovp_level
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_protection_ovp_delay
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_protection_ovp_limit
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_protection_ocp_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_protection_ocp_delay
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_protection_ocp_limit
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_protection_ocp_max_current_limit_cause
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_protection_opp_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_protection_opp_level
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_protection_opp_delay
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_protection_opp_limit
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_protection_otp_installed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_protection_otp_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_protection_otp_level
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_protection_otp_delay
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_event_queue_last_event_type
+    DATA_OPERATION_MASK(DATA_OPERATION_COUNT) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_PAGE_SIZE) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_POSITION) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_SIZE) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_SET_POSITION), // data_event_queue_events
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_event_queue_event_type
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_event_queue_event_message
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_event_queue_selected_event_message
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_rsense_status
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_rprog_installed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_rprog_status
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_tracking_is_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_tracking_is_allowed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_is_par_ser_coupled_or_tracked
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_coupling_type
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_coupling_is_series
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_on_time_total
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_on_time_last
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_temp_aux_status
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_temp_aux_otp_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_temp_aux_otp_level
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_temp_aux_otp_delay
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_temp_aux_otp_is_tripped
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_temp_aux
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_info_firmware_ver
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_info_serial_no
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_info_scpi_ver
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_info_cpu
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_info_fan_status
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_info_fan_speed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_board_info_label
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_board_info_revision
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_date_time_date
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_date_time_year
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_date_time_month
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_date_time_day
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_date_time_time
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_date_time_hour
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_date_time_minute
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_date_time_second
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_date_time_time_zone
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_date_time_dst
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_set_page_dirty
+    DATA_OPERATION_MASK(DATA_OPERATION_COUNT), // data_profiles_list
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_profiles_auto_recall_status
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_profiles_auto_recall_location
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_profile_status
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_profile_label
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_profile_remark
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_profile_is_auto_recall_location
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_profile_channel_u_set
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_profile_channel_i_set
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_profile_channel_output_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_ethernet_installed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_ethernet_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_mqtt_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_ethernet_status
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_ethernet_and_mqtt_status
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_mqtt_connection_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_ethernet_ip_address
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_ethernet_dns
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_ethernet_gateway
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_ethernet_subnet_mask
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_ethernet_scpi_port
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_ethernet_is_connected
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_ethernet_dhcp
+    DATA_OPERATIONS_ALL, // data_ethernet_mac
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_is_voltage_balanced
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_is_current_balanced
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_output_protection_coupled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_shutdown_when_protection_tripped
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_force_disabling_all_outputs_on_power_up
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_password_is_set
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_rl_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_sound_is_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_sound_is_click_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_sound_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_display_view_settings_display_value1
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_display_view_settings_display_value2
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_display_view_settings_yt_view_rate
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_encoder_confirmation_mode
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_sys_encoder_moving_up_speed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_sys_encoder_moving_down_speed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_encoder_installed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_display_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_sys_display_brightness
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_trigger_mode
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_trigger_on_list_stop
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_EDIT_VALUE) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_LIMIT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_u_trigger_value
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_EDIT_VALUE) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_LIMIT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_i_trigger_value
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_list_count
+    DATA_OPERATION_MASK(DATA_OPERATION_COUNT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_FLOAT_LIST_LENGTH), // data_channel_lists
+    DATA_OPERATIONS_ALL, // data_ramp_and_delay_list
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_list_index
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_DEF) | DATA_OPERATION_MASK(DATA_OPERATION_GET_FLOAT_LIST) | DATA_OPERATION_MASK(DATA_OPERATION_GET_FLOAT_LIST_LENGTH) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN), // data_channel_list_dwell
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_list_dwell_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_DEF) | DATA_OPERATION_MASK(DATA_OPERATION_GET_FLOAT_LIST) | DATA_OPERATION_MASK(DATA_OPERATION_GET_FLOAT_LIST_LENGTH) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN), // data_channel_list_voltage
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_list_voltage_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_DEF) | DATA_OPERATION_MASK(DATA_OPERATION_GET_FLOAT_LIST) | DATA_OPERATION_MASK(DATA_OPERATION_GET_FLOAT_LIST_LENGTH) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN), // data_channel_list_current
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_list_current_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_lists_previous_page_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_lists_next_page_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_lists_cursor
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_lists_insert_menu_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_lists_delete_menu_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_lists_delete_row_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_lists_clear_column_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_lists_delete_rows_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_coupling_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_trigger_source
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_trigger_delay
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_trigger_initiate_continuously
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_IS_BLINKING), // data_trigger_is_initiated
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_trigger_is_manual
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_has_support_for_current_dual_range
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_ranges_supported
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_ranges_mode
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_ranges_auto_ranging
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_ranges_currently_selected
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_text_message
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_serial_status
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_serial_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_serial_is_connected
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_list_countdown
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_ramp_countdown
+    DATA_OPERATION_MASK(DATA_OPERATION_COUNT), // data_io_pins
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_IS_BLINKING), // data_io_pins_inhibit_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_io_pin_number
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_io_pin_polarity
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_io_pin_function_name
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_ntp_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_ntp_server
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_sys_display_background_luminosity_step
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_progress
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_main_app_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_touch_calibration_point
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_simulator_load_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_simulator_load_state2
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_simulator_load
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_simulator_load2
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_selected_theme
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_title
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_short_title
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_short_title_with_colon
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_short_title_without_tracking_icon
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_long_title
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_animations_duration
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot1_info
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot2_info
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot3_info
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot1_test_result
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot2_test_result
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot3_test_result
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot_default1_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot_default2_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot_default3_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET_CONTEXT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_CONTEXT_CURSOR) | DATA_OPERATION_MASK(DATA_OPERATION_RESTORE_CONTEXT) | DATA_OPERATION_MASK(DATA_OPERATION_SET_CONTEXT), // data_slot1_channel_index
+    DATA_OPERATION_MASK(DATA_OPERATION_GET_CONTEXT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_CONTEXT_CURSOR) | DATA_OPERATION_MASK(DATA_OPERATION_RESTORE_CONTEXT) | DATA_OPERATION_MASK(DATA_OPERATION_SET_CONTEXT), // data_slot2_channel_index
+    DATA_OPERATION_MASK(DATA_OPERATION_GET_CONTEXT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_CONTEXT_CURSOR) | DATA_OPERATION_MASK(DATA_OPERATION_RESTORE_CONTEXT) | DATA_OPERATION_MASK(DATA_OPERATION_SET_CONTEXT), // data_slot3_channel_index
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot_def_2ch_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot_max_2ch_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot_min_2ch_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot_micro_2ch_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET_CONTEXT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_CONTEXT_CURSOR) | DATA_OPERATION_MASK(DATA_OPERATION_RESTORE_CONTEXT) | DATA_OPERATION_MASK(DATA_OPERATION_SET_CONTEXT), // data_slot_2ch_ch1_index
+    DATA_OPERATION_MASK(DATA_OPERATION_GET_CONTEXT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_CONTEXT_CURSOR) | DATA_OPERATION_MASK(DATA_OPERATION_RESTORE_CONTEXT) | DATA_OPERATION_MASK(DATA_OPERATION_SET_CONTEXT), // data_slot_2ch_ch2_index
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_front_panel_slot1_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_front_panel_slot2_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_front_panel_slot3_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_battery
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_io_pin_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_dprog
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_dprog_installed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_info_sdcard_status
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_info_has_error
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_settings_has_error
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_info_battery_status
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_fan_mode
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_sys_fan_speed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_is_coupling_type_uncoupled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_is_coupling_type_parallel
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_is_coupling_type_common_gnd
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_is_coupling_type_split_rails
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_is_tracking_allowed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_is_coupling_parallel_allowed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_is_coupling_series_allowed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_coupling_enable_tracking_mode
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_active_coupled_led
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_is_coupling_type_series
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_is_coupled_or_tracked
+    DATA_OPERATIONS_ALL, // data_overlay
+    DATA_OPERATION_MASK(DATA_OPERATION_COUNT), // data_channels_with_list_counter_visible
+    DATA_OPERATION_MASK(DATA_OPERATION_COUNT), // data_channels_with_ramp_counter_visible
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_dlog_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_dlog_toggle_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_DEF) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_SET) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_CURSOR_OFFSET) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_CURSOR_X_VALUE) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_DIV) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_GET_VALUE_FUNC) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_GRAPH_UPDATE_METHOD) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_HORZ_DIVISIONS) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_LABEL) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_OFFSET) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_PAGE_SIZE) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_PERIOD) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_POSITION) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_REFRESH_COUNTER) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_SELECTED_VALUE_INDEX) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_SHOW_LABELS) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_SIZE) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_STYLE) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_VERT_DIVISIONS) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_IS_CURSOR_VISIBLE) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_SET_POSITION) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_TOUCH_DRAG) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_VALUE_IS_VISIBLE), // data_recording
+    DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_GET_VALUE_FUNC) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_GRAPH_UPDATE_METHOD) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_POSITION) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_REFRESH_COUNTER) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_SIZE) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_STYLE), // data_channel_history_values
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_recording_ready
+    DATA_OPERATIONS_ALL, // data_nondrag_overlay
+    DATA_OPERATIONS_ALL, // data_dlog_single_value_overlay
+    DATA_OPERATIONS_ALL, // data_dlog_multiple_values_overlay
+    DATA_OPERATION_MASK(DATA_OPERATION_COUNT), // data_dlog_visible_values
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_dlog_visible_value_label
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_EDIT_VALUE) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_dlog_visible_value_div
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_EDIT_VALUE) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_dlog_visible_value_offset
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_dlog_visible_value_cursor
+    DATA_OPERATION_MASK(DATA_OPERATION_COUNT), // data_dlog_all_values
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_dlog_current_time
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_dlog_file_length
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_dlog_x_axis_offset
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_DEF) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_dlog_x_axis_div
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_dlog_x_axis_max_value
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_dlog_x_axis_max_value_label
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_is_single_page_on_stack
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_is_show_live_recording
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_dlog_view_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_dlog_period
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_dlog_duration
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_dlog_voltage_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_dlog_current_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_dlog_power_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_dlog_start_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_dlog_file_name
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_dlog_value_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_slot_max_2ch_min_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_off_label
+    DATA_OPERATION_MASK(DATA_OPERATION_COUNT) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_PAGE_SIZE) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_POSITION) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_POSITION_INCREMENT) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_GET_SIZE) | DATA_OPERATION_MASK(DATA_OPERATION_YT_DATA_SET_POSITION), // data_file_manager_files
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_file_name
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_file_date_time
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_file_size
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_file_selected
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_is_root_directory
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_current_directory
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_is_directory
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_file_type
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_open_file_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_upload_file_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_rename_file_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_delete_file_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET_BITMAP_IMAGE), // data_file_manager_opened_image
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_script_info
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_script_is_started
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_keypad_ok_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_IS_VALID_VALUE) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_ethernet_host_name
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_mqtt_host
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_DEF) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_mqtt_port
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_mqtt_username
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_mqtt_password
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_mqtt_period
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_dlog_view_show_labels
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_is_any_coupling_allowed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_is_coupling_split_rails_allowed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_list_counter_label
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_ramp_counter_label
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_module_specific_ch_settings
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_firmware_version
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_browser_title
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_has_error_settings
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_settings_page
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_is_reset_by_iwdg
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_dlog_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_browser_is_save_dialog
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_storage_info
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_storage_alarm
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_event_queue_is_long_message_text
+    DATA_OPERATIONS_ALL, // data_event_queue_event_long_message_overlay
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_event_queue_event_is_selected
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_date_time_format
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_date_time_format_is_dmy
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_date_time_format_is_24h
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_date_time_am_pm
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_is_multi_tracking
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_copy_available
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_rsense_installed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_sort_files_option
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_info_brand
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_info_serial
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_list_view
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_is_list_view_option_available
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_file_icon
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_layout
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_file_description
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_touch_raw_x
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_touch_raw_y
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_touch_raw_z1
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_touch_raw_pressed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_touch_calibrated_x
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_touch_calibrated_y
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_touch_calibrated_pressed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_touch_filtered_x
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_touch_filtered_y
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_touch_filtered_pressed
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_can_show_previous_page
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_file_has_description
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_image_open_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_file_manager_image_open_progress
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_alert_message_is_set
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_async_progress
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_io_pin_function
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ALLOW_ZERO) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_io_pin_pwm_frequency
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_io_pin_pwm_duty
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ALLOW_ZERO) | DATA_OPERATION_MASK(DATA_OPERATION_GET_EDIT_VALUE) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_LIMIT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_voltage_ramp_duration
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ALLOW_ZERO) | DATA_OPERATION_MASK(DATA_OPERATION_GET_EDIT_VALUE) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_LIMIT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_current_ramp_duration
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ALLOW_ZERO) | DATA_OPERATION_MASK(DATA_OPERATION_GET_EDIT_VALUE) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_LIMIT) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_channel_output_delay
+    DATA_OPERATIONS_ALL, // data_debug_variables
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_debug_variable_name
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_TEXT_REFRESH_RATE), // data_debug_variable_value
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_ramp_state
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_ramp_and_delay_list_scrollbar_enabled
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_mqtt_in_error
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_PRECISION) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_debug_i_dac
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_PRECISION) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_debug_u_dac
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_debug_i_dac_amper
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_debug_u_dac_voltage
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_TEXT_REFRESH_RATE), // data_debug_i_adc
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_TEXT_REFRESH_RATE), // data_debug_u_adc
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_TEXT_REFRESH_RATE), // data_debug_i_adc_amper
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_TEXT_REFRESH_RATE), // data_debug_u_adc_voltage
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_dlog_view_legend_view_option
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_PRECISION) | DATA_OPERATION_MASK(DATA_OPERATION_GET_ENCODER_STEP_VALUES) | DATA_OPERATION_MASK(DATA_OPERATION_GET_IS_CHANNEL_DATA) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MAX) | DATA_OPERATION_MASK(DATA_OPERATION_GET_MIN) | DATA_OPERATION_MASK(DATA_OPERATION_GET_NAME) | DATA_OPERATION_MASK(DATA_OPERATION_GET_UNIT) | DATA_OPERATION_MASK(DATA_OPERATION_SET), // data_calibration_point_measured_value
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_calibration_value_type
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_calibration_value_is_voltage
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_calibration_point_can_move_to_previous
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_calibration_point_can_move_to_next
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_calibration_point_can_delete
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_calibration_point_info
+    DATA_OPERATION_MASK(DATA_OPERATION_GET) | DATA_OPERATION_MASK(DATA_OPERATION_GET_CANVAS_DRAW_FUNCTION), // data_channel_calibration_chart
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_calibration_point_can_save
+    DATA_OPERATION_MASK(DATA_OPERATION_GET), // data_channel_calibration_chart_zoom
+};
+
+static_assert(sizeof(g_dataOperationsMasks) / sizeof(uint64_t) == DATA_ID_CHANNEL_CALIBRATION_CHART_ZOOM + 1, "Run tools/gen_data_operations.py");
+
+#endif
+
+} // namespace gui
+} // namespace eez
+
+#endif
@@ -18,6 +18,7 @@
 
 #if OPTION_DISPLAY
 
+#include <stdio.h>
 #include <string.h>
 
 #include <eez/util.h>
@@ -719,6 +720,268 @@ void MenuWithButtonsPage::executeAction() {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void showChannelStatistics(AppContext *appContext, int channelIndex) {
+    pushPage(INTERNAL_PAGE_ID_CHANNEL_STATISTICS, ChannelStatisticsPage::create(appContext, channelIndex));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static ChannelStatisticsPage g_channelStatisticsPage;
+
+static const uint32_t CHANNEL_STATISTICS_UPDATE_PERIOD_MS = 500;
+
+// page is as wide as the display less this margin, so it is not resized
+// when the values change
+static const int CHANNEL_STATISTICS_MARGIN = 20;
+
+static const char *g_channelStatisticsButtons[] = { "Reset", "Close" };
+
+ChannelStatisticsPage *ChannelStatisticsPage::create(AppContext *appContext, int channelIndex) {
+    ChannelStatisticsPage *page = &g_channelStatisticsPage;
+
+    page->init(appContext, channelIndex);
+
+    return page;
+}
+
+void ChannelStatisticsPage::init(AppContext *appContext, int channelIndex) {
+    m_appContext = appContext;
+    m_channelIndex = channelIndex;
+    m_lastUpdateTime = millis();
+
+    snprintf(m_title, sizeof(m_title), "Ch%d statistics", channelIndex + 1);
+
+    m_containerRectangleWidget.common.type = WIDGET_TYPE_RECTANGLE;
+    m_containerRectangleWidget.common.data = DATA_ID_NONE;
+    m_containerRectangleWidget.common.action = ACTION_ID_NONE;
+    m_containerRectangleWidget.common.style = STYLE_ID_MENU_WITH_BUTTONS_CONTAINER;
+    m_containerRectangleWidget.common.specific = &m_containerRectangleWidget.specific;
+    m_containerRectangleWidget.specific.flags.invertColors = 1;
+    m_containerRectangleWidget.specific.flags.ignoreLuminosity = 0;
+
+    m_titleTextWidget.common.type = WIDGET_TYPE_TEXT;
+    m_titleTextWidget.common.data = DATA_ID_NONE;
+    m_titleTextWidget.common.action = ACTION_ID_NONE;
+    m_titleTextWidget.common.style = STYLE_ID_MENU_WITH_BUTTONS_MESSAGE;
+    m_titleTextWidget.common.specific = &m_titleTextWidget.specific;
+    m_titleTextWidget.specific.text = m_title;
+    m_titleTextWidget.specific.flags = 0;
+    TextWidget_autoSize(m_titleTextWidget);
+
+    getLines(m_lines);
+
+    for (size_t i = 0; i < NUM_LINES; i++) {
+        m_lineTextWidgets[i].common.type = WIDGET_TYPE_TEXT;
+        m_lineTextWidgets[i].common.data = DATA_ID_NONE;
+        m_lineTextWidgets[i].common.action = ACTION_ID_NONE;
+        m_lineTextWidgets[i].common.style = STYLE_ID_TEXT_MESSAGE;
+        m_lineTextWidgets[i].common.specific = &m_lineTextWidgets[i].specific;
+        m_lineTextWidgets[i].specific.text = m_lines[i];
+        m_lineTextWidgets[i].specific.flags = 0;
+        TextWidget_autoSize(m_lineTextWidgets[i]);
+    }
+
+    for (size_t i = 0; i < NUM_BUTTONS; i++) {
+        m_buttonTextWidgets[i].common.type = WIDGET_TYPE_TEXT;
+        m_buttonTextWidgets[i].common.data = DATA_ID_NONE;
+        m_buttonTextWidgets[i].common.action = i == 0 ? ACTION_ID_INTERNAL_CHANNEL_STATISTICS_RESET : ACTION_ID_INTERNAL_DIALOG_CLOSE;
+        m_buttonTextWidgets[i].common.style = STYLE_ID_MENU_WITH_BUTTONS_BUTTON;
+        m_buttonTextWidgets[i].common.specific = &m_buttonTextWidgets[i].specific;
+        m_buttonTextWidgets[i].specific.text = g_channelStatisticsButtons[i];
+        m_buttonTextWidgets[i].specific.flags = 0;
+        TextWidget_autoSize(m_buttonTextWidgets[i]);
+    }
+
+    const Style *styleContainer = getStyle(STYLE_ID_MENU_WITH_BUTTONS_CONTAINER);
+    const Style *styleButton = getStyle(STYLE_ID_MENU_WITH_BUTTONS_BUTTON);
+
+    int maxButtonWidth = 0;
+    for (size_t i = 0; i < NUM_BUTTONS; i++) {
+        maxButtonWidth = MAX(maxButtonWidth, m_buttonTextWidgets[i].common.w);
+    }
+
+    int buttonsWidth = maxButtonWidth * NUM_BUTTONS + (NUM_BUTTONS - 1) * styleButton->padding_left;
+
+    width = m_appContext->rect.w - 2 * CHANNEL_STATISTICS_MARGIN;
+
+    int contentWidth = width - (styleContainer->border_size_left + styleContainer->padding_left + styleContainer->padding_right + styleContainer->border_size_right);
+    int contentHeight = m_titleTextWidget.common.h + NUM_LINES * m_lineTextWidgets[0].common.h + m_buttonTextWidgets[0].common.h;
+
+    height = styleContainer->border_size_top + styleContainer->padding_top + contentHeight + styleContainer->padding_bottom + styleContainer->border_size_bottom;
+
+    x = m_appContext->rect.x + (m_appContext->rect.w - width) / 2;
+    y = m_appContext->rect.y + (m_appContext->rect.h - height) / 2;
+
+    m_containerRectangleWidget.common.x = 0;
+    m_containerRectangleWidget.common.y = 0;
+    m_containerRectangleWidget.common.w = width;
+    m_containerRectangleWidget.common.h = height;
+
+    int xContent = styleContainer->border_size_left + styleContainer->padding_left;
+    int yContent = styleContainer->border_size_top + styleContainer->padding_top;
+
+    m_titleTextWidget.common.x = xContent + (contentWidth - m_titleTextWidget.common.w) / 2;
+    m_titleTextWidget.common.y = yContent;
+    yContent += m_titleTextWidget.common.h;
+
+    for (size_t i = 0; i < NUM_LINES; i++) {
+        m_lineTextWidgets[i].common.x = xContent;
+        m_lineTextWidgets[i].common.y = yContent;
+        m_lineTextWidgets[i].common.w = contentWidth;
+        yContent += m_lineTextWidgets[i].common.h;
+    }
+
+    int xButtonTextWidget = xContent + (contentWidth - buttonsWidth) / 2;
+    for (size_t i = 0; i < NUM_BUTTONS; i++) {
+        m_buttonTextWidgets[i].common.x = xButtonTextWidget;
+        m_buttonTextWidgets[i].common.y = yContent;
+        m_buttonTextWidgets[i].common.w = maxButtonWidth;
+        xButtonTextWidget += maxButtonWidth + styleButton->padding_left;
+    }
+}
+
+static void valueToText(float value, Unit unit, const char *suffix, char *text, size_t count) {
+    Value(value, unit).toText(text, count);
+    strncat(text, suffix, count - strlen(text) - 1);
+}
+
+void ChannelStatisticsPage::getLines(char lines[NUM_LINES][MAX_LINE_LENGTH + 1]) {
+    Channel::StatisticsSnapshot statistics;
+    Channel::get(m_channelIndex).getStatisticsSnapshot(statistics);
+
+    char min[16];
+    char max[16];
+    char mean[16];
+    char rms[16];
+
+    valueToText(statistics.u.min, UNIT_VOLT, "", min, sizeof(min));
+    valueToText(statistics.u.max, UNIT_VOLT, "", max, sizeof(max));
+    valueToText(statistics.u.getMean(), UNIT_VOLT, "", mean, sizeof(mean));
+    valueToText(statistics.u.getRms(), UNIT_VOLT, "", rms, sizeof(rms));
+    snprintf(lines[0], MAX_LINE_LENGTH + 1, "U  min %s  max %s  mean %s  rms %s", min, max, mean, rms);
+
+    valueToText(statistics.i.min, UNIT_AMPER, "", min, sizeof(min));
+    valueToText(statistics.i.max, UNIT_AMPER, "", max, sizeof(max));
+    valueToText(statistics.i.getMean(), UNIT_AMPER, "", mean, sizeof(mean));
+    valueToText(statistics.i.getRms(), UNIT_AMPER, "", rms, sizeof(rms));
+    snprintf(lines[1], MAX_LINE_LENGTH + 1, "I  min %s  max %s  mean %s  rms %s", min, max, mean, rms);
+
+    // charge and energy are in As and Ws
+    char charge[16];
+    char energy[16];
+    valueToText((float)(statistics.charge / 3600), UNIT_AMPER, "h", charge, sizeof(charge));
+    valueToText((float)(statistics.energy / 3600), UNIT_WATT, "h", energy, sizeof(energy));
+    snprintf(lines[2], MAX_LINE_LENGTH + 1, "Charge %s  Energy %s", charge, energy);
+
+    char time[16];
+    valueToText((float)statistics.energyTime, UNIT_SECOND, "", time, sizeof(time));
+    snprintf(lines[3], MAX_LINE_LENGTH + 1, "Output on %s  Samples %lu", time, (unsigned long)statistics.i.count);
+}
+
+void ChannelStatisticsPage::drawLine(const WidgetCursor &widgetCursor2, size_t i) {
+    WidgetCursor widgetCursor;
+
+    widgetCursor.appContext = m_appContext;
+    widgetCursor.previousState = nullptr;
+    widgetCursor.currentState = widgetCursor2.currentState;
+
+    widgetCursor.widget = &m_lineTextWidgets[i].common;
+    widgetCursor.x = x + m_lineTextWidgets[i].common.x;
+    widgetCursor.y = y + m_lineTextWidgets[i].common.y;
+    widgetCursor.currentState->flags.active = 0;
+    TEXT_draw(widgetCursor);
+}
+
+void ChannelStatisticsPage::drawButtons(const WidgetCursor &widgetCursor2) {
+    WidgetCursor widgetCursor;
+
+    widgetCursor.appContext = m_appContext;
+    widgetCursor.previousState = widgetCursor2.previousState;
+    widgetCursor.currentState = widgetCursor2.currentState;
+
+    for (size_t i = 0; i < NUM_BUTTONS; i++) {
+        widgetCursor.widget = &m_buttonTextWidgets[i].common;
+        widgetCursor.x = x + m_buttonTextWidgets[i].common.x;
+        widgetCursor.y = y + m_buttonTextWidgets[i].common.y;
+        widgetCursor.cursor = i;
+        widgetCursor.currentState->flags.active = isActiveWidget(widgetCursor);
+        TEXT_draw(widgetCursor);
+    }
+}
+
+void ChannelStatisticsPage::refresh(const WidgetCursor &widgetCursor2) {
+    WidgetCursor widgetCursor;
+
+    widgetCursor.appContext = m_appContext;
+    widgetCursor.previousState = nullptr;
+    widgetCursor.currentState = widgetCursor2.currentState;
+
+    widgetCursor.widget = &m_containerRectangleWidget.common;
+    widgetCursor.x = x + m_containerRectangleWidget.common.x;
+    widgetCursor.y = y + m_containerRectangleWidget.common.y;
+    RECTANGLE_draw(widgetCursor);
+
+    widgetCursor.widget = &m_titleTextWidget.common;
+    widgetCursor.x = x + m_titleTextWidget.common.x;
+    widgetCursor.y = y + m_titleTextWidget.common.y;
+    TEXT_draw(widgetCursor);
+
+    for (size_t i = 0; i < NUM_LINES; i++) {
+        drawLine(widgetCursor, i);
+    }
+
+    drawButtons(widgetCursor);
+}
+
+void ChannelStatisticsPage::updatePage(const WidgetCursor &widgetCursor) {
+    uint32_t tickCount = millis();
+    if (tickCount - m_lastUpdateTime >= CHANNEL_STATISTICS_UPDATE_PERIOD_MS) {
+        m_lastUpdateTime = tickCount;
+
+        char lines[NUM_LINES][MAX_LINE_LENGTH + 1];
+        getLines(lines);
+
+        for (size_t i = 0; i < NUM_LINES; i++) {
+            if (strcmp(lines[i], m_lines[i]) != 0) {
+                strcpy(m_lines[i], lines[i]);
+                drawLine(widgetCursor, i);
+            }
+        }
+    }
+
+    drawButtons(widgetCursor);
+}
+
+WidgetCursor ChannelStatisticsPage::findWidget(int x, int y) {
+    WidgetCursor widgetCursor;
+
+    widgetCursor.appContext = m_appContext;
+
+    for (size_t i = 0; i < NUM_BUTTONS; i++) {
+        widgetCursor.widget = &m_buttonTextWidgets[i].common;
+        widgetCursor.x = this->x + m_buttonTextWidgets[i].common.x;
+        widgetCursor.y = this->y + m_buttonTextWidgets[i].common.y;
+        widgetCursor.cursor = i;
+        if (
+            x >= widgetCursor.x && x < widgetCursor.x + m_buttonTextWidgets[i].common.w && 
+            y >= widgetCursor.y && y < widgetCursor.y + m_buttonTextWidgets[i].common.h
+        ) {
+            return widgetCursor;
+        }
+    }
+
+    widgetCursor.widget = &m_containerRectangleWidget.common;
+    widgetCursor.x = this->x + m_containerRectangleWidget.common.x;
+    widgetCursor.y = this->y + m_containerRectangleWidget.common.y;
+    return widgetCursor;
+}
+
+void ChannelStatisticsPage::executeResetAction() {
+    Channel::get(g_channelStatisticsPage.m_channelIndex).resetStatistics();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 } // namespace gui
 } // namespace psu
 } // namespace eez
@@ -182,6 +182,42 @@ private:
     void init(AppContext *appContext, const char *message, const char **menuItems, void(*callback)(int));
 };
 
+////////////////////////////////////////////////////////////////////////////////
+
+void showChannelStatistics(AppContext *appContext, int channelIndex);
+
+class ChannelStatisticsPage : public InternalPage {
+public:
+    static ChannelStatisticsPage *create(AppContext *appContext, int channelIndex);
+
+    void refresh(const WidgetCursor& widgetCursor);
+    void updatePage(const WidgetCursor& widgetCursor);
+    WidgetCursor findWidget(int x, int y);
+
+    static void executeResetAction();
+
+private:
+    static const size_t NUM_LINES = 4;
+    static const size_t MAX_LINE_LENGTH = 100;
+    static const size_t NUM_BUTTONS = 2;
+
+    AppContext *m_appContext;
+    int m_channelIndex;
+    uint32_t m_lastUpdateTime;
+
+    RectangleWidget m_containerRectangleWidget;
+    TextWidget m_titleTextWidget;
+    char m_title[32];
+    TextWidget m_lineTextWidgets[NUM_LINES];
+    char m_lines[NUM_LINES][MAX_LINE_LENGTH + 1];
+    TextWidget m_buttonTextWidgets[NUM_BUTTONS];
+
+    void init(AppContext *appContext, int channelIndex);
+    void getLines(char lines[NUM_LINES][MAX_LINE_LENGTH + 1]);
+    void drawLine(const WidgetCursor &widgetCursor, size_t i);
+    void drawButtons(const WidgetCursor &widgetCursor);
+};
+
 } // namespace gui
 } // namespace psu
 } // namespace eez
@@ -553,6 +553,14 @@ bool PsuAppContext::testExecuteActionOnTouchDown(int action) {
     return action == ACTION_ID_CHANNEL_TOGGLE_OUTPUT || isAutoRepeatAction(action);
 }
 
+int PsuAppContext::getLongTouchActionHook(const WidgetCursor &widgetCursor) {
+    // long touch on channel voltage or current shows its statistics
+    if (widgetCursor.widget->data == DATA_ID_CHANNEL_U_EDIT || widgetCursor.widget->data == DATA_ID_CHANNEL_I_EDIT) {
+        return ACTION_ID_INTERNAL_SHOW_CHANNEL_STATISTICS;
+    }
+    return ACTION_ID_NONE;
+}
+
 bool PsuAppContext::isBlinking(const Cursor cursor, int16_t id) {
     if (g_focusCursor == cursor && g_focusDataId == id && g_focusEditValue.getType() != VALUE_TYPE_NONE) {
         return true;
@@ -2054,6 +2062,14 @@ void action_internal_select_enum_item() {
     g_selectFromEnumPage.selectEnumItem();
 }
 
+void action_internal_show_channel_statistics() {
+    int iChannel = getFoundWidgetAtDown().cursor;
+    if (iChannel < 0) {
+        iChannel = g_channel ? g_channel->channelIndex : 0;
+    }
+    showChannelStatistics(&g_psuAppContext, iChannel);
+}
+
 // from InternalActionsEnum
 static ActionExecFunc g_internalActionExecFunctions[] = {
     0,
@@ -2070,7 +2086,13 @@ static ActionExecFunc g_internalActionExecFunctions[] = {
     ToastMessagePage::executeActionWithoutParam,
 
     // ACTION_ID_INTERNAL_MENU_WITH_BUTTONS
-    MenuWithButtonsPage::executeAction
+    MenuWithButtonsPage::executeAction,
+
+    // ACTION_ID_INTERNAL_SHOW_CHANNEL_STATISTICS
+    action_internal_show_channel_statistics,
+
+    // ACTION_ID_INTERNAL_CHANNEL_STATISTICS_RESET
+    ChannelStatisticsPage::executeResetAction
 };
 
 void executeInternalActionHook(int actionId) {
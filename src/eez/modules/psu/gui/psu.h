@@ -261,6 +261,7 @@ protected:
     bool isAutoRepeatAction(int action) override;
     void onPageTouch(const WidgetCursor &foundWidget, Event &touchEvent) override;
     bool testExecuteActionOnTouchDown(int action) override;
+    int getLongTouchActionHook(const WidgetCursor &widgetCursor) override;
     bool canExecuteActionWhenTouchedOutsideOfActivePage(int pageId, int action) override;
     void updatePage(int i, WidgetCursor &widgetCursor) override;
 
@@ -17,6 +17,7 @@
  */
 
 #include <assert.h>
+#include <string.h>
 
 #if defined EEZ_PLATFORM_STM32
 #include <main.h>
@@ -46,11 +47,33 @@ namespace io_pins {
 static struct {
     unsigned outputFault : 2;
     unsigned outputEnabled : 2;
-    unsigned toutputPulse : 1;
     unsigned inhibited : 1;
-} g_lastState = { 2, 2, 0, 0 };
+} g_lastState = { 2, 2, 0 };
 
-static uint32_t g_toutputPulseStartTickCount;
+// trigger output pulse is ended from the timer interrupt on STM32
+static volatile bool g_toutputPulse;
+static volatile uint32_t g_toutputPulseStartTime;
+
+// Active edges of the TINPUT pins, written from the interrupt and read from PSU thread.
+static const int EDGE_QUEUE_SIZE = 8;
+
+struct EdgeQueue {
+    uint64_t time[EDGE_QUEUE_SIZE];
+    volatile uint8_t head;
+    volatile uint8_t tail;
+    bool lastState;
+    EdgeStats stats;
+};
+
+static EdgeQueue g_edgeQueues[2];
+
+#if defined EEZ_PLATFORM_SIMULATOR
+static struct {
+    uint64_t time[MAX_INJECTED_EDGES];
+    volatile int numEdges;
+    int nextEdge;
+} g_injectedEdges[2];
+#endif
 
 static bool g_pinState[NUM_IO_PINS] = { false, false, false, false };
 
@@ -104,7 +127,158 @@ int ioPinRead(int pin) {
 }
 
 void ioPinWrite(int pin, int state) {
-	g_pins[pin] = state;
+    if (g_pins[pin] != state) {
+        g_pins[pin] = state;
+        if (pin == EXT_TRIG1 || pin == EXT_TRIG2) {
+            // there is no EXTI in simulator
+            onInputPinInterrupt(pin);
+        }
+    }
+}
+
+#endif
+
+static bool isInputPinActive(int pin) {
+    int value = ioPinRead(pin == 0 ? EXT_TRIG1 : EXT_TRIG2);
+    const persist_conf::IOPin &ioPin = persist_conf::devConf.ioPins[pin];
+    return (value && ioPin.polarity == io_pins::POLARITY_POSITIVE) || (!value && ioPin.polarity == io_pins::POLARITY_NEGATIVE);
+}
+
+static void onInputPinEdge(int pin, bool state, uint64_t time) {
+    EdgeQueue &queue = g_edgeQueues[pin];
+
+    if (state == queue.lastState) {
+        return;
+    }
+    queue.lastState = state;
+
+    if (!state) {
+        return;
+    }
+
+    uint8_t tail = queue.tail;
+    uint8_t head = (queue.head + 1) % EDGE_QUEUE_SIZE;
+    if (head == tail) {
+        queue.stats.numDropped++;
+        return;
+    }
+
+    bool wasEmpty = queue.head == tail;
+
+    queue.time[queue.head] = time;
+    queue.head = head;
+
+    // PSU thread drains the whole queue on one message, so fast pulse train can't
+    // fill PSU queue and push out other messages. If this message is lost, edges
+    // are still drained from io_pins::tick.
+    if (wasEmpty) {
+        osMessagePut(g_psuMessageQueueId, PSU_QUEUE_MESSAGE(PSU_QUEUE_MESSAGE_TYPE_IO_PIN_EDGE, pin), 0);
+    }
+}
+
+void onInputPinInterrupt(int pin) {
+    if (persist_conf::devConf.ioPins[pin].function == io_pins::FUNCTION_TINPUT) {
+        uint64_t time = micros64();
+        onInputPinEdge(pin, isInputPinActive(pin), time);
+    }
+}
+
+void onInputPinEdges(int pin) {
+    EdgeQueue &queue = g_edgeQueues[pin];
+
+    while (queue.tail != queue.head) {
+        uint64_t time = queue.time[queue.tail];
+        queue.tail = (queue.tail + 1) % EDGE_QUEUE_SIZE;
+
+        trigger::generateTriggerAt(pin == 0 ? trigger::SOURCE_PIN1 : trigger::SOURCE_PIN2, time);
+
+        uint32_t latency = (uint32_t)(micros64() - time);
+        queue.stats.numEdges++;
+        queue.stats.sumLatency += latency;
+        if (latency > queue.stats.maxLatency) {
+            queue.stats.maxLatency = latency;
+        }
+    }
+}
+
+void getEdgeStats(int pin, EdgeStats &stats) {
+    stats = g_edgeQueues[pin].stats;
+}
+
+void resetEdgeStats() {
+    for (int pin = 0; pin < 2; pin++) {
+        memset(&g_edgeQueues[pin].stats, 0, sizeof(EdgeStats));
+    }
+}
+
+static void endToutputPulse() {
+    for (int pin = 2; pin < NUM_IO_PINS; ++pin) {
+        const persist_conf::IOPin &outputPin = persist_conf::devConf.ioPins[pin];
+        if (outputPin.function == io_pins::FUNCTION_TOUTPUT) {
+            setPinState(pin, false);
+        }
+    }
+
+    g_toutputPulse = false;
+}
+
+#if defined EEZ_PLATFORM_STM32
+
+void onTimerInterrupt() {
+    // DIN1 (PF6) can't have EXTI because EXTI line 6 is taken by the encoder (PC6),
+    // so it is sampled here, i.e. with 200 us resolution
+    onInputPinInterrupt(EXT_TRIG1);
+
+    if (g_toutputPulse && micros() - g_toutputPulseStartTime >= CONF_TOUTPUT_PULSE_WIDTH_MS * 1000L) {
+        endToutputPulse();
+    }
+}
+
+#endif
+
+#if defined EEZ_PLATFORM_SIMULATOR
+
+bool injectEdges(int pin, const uint32_t *delays, int numDelays) {
+    if (numDelays > MAX_INJECTED_EDGES || g_injectedEdges[pin].nextEdge < g_injectedEdges[pin].numEdges) {
+        return false;
+    }
+
+    g_injectedEdges[pin].numEdges = 0;
+    g_injectedEdges[pin].nextEdge = 0;
+
+    uint64_t time = micros64();
+    for (int i = 0; i < numDelays; i++) {
+        time += delays[i];
+        g_injectedEdges[pin].time[i] = time;
+    }
+
+    g_injectedEdges[pin].numEdges = numDelays;
+
+    wakeUpPsuThread();
+
+    return true;
+}
+
+static void tickInjectedEdges() {
+    uint64_t currentTime = micros64();
+
+    for (int pin = 0; pin < 2; pin++) {
+        auto &edges = g_injectedEdges[pin];
+        while (edges.nextEdge < edges.numEdges) {
+            uint64_t time = edges.time[edges.nextEdge];
+            if (time > currentTime) {
+                scheduleTick(time - currentTime);
+                break;
+            }
+            edges.nextEdge++;
+
+            // edge is timestamped with the scripted time, as EXTI would do it
+            g_pins[pin] = !g_pins[pin];
+            if (persist_conf::devConf.ioPins[pin].function == io_pins::FUNCTION_TINPUT) {
+                onInputPinEdge(pin, isInputPinActive(pin), time);
+            }
+        }
+    }
 }
 
 #endif
@@ -138,19 +312,23 @@ uint8_t isOutputEnabled() {
 }
 
 void initInputPin(int pin) {
+    const persist_conf::IOPin &ioPin = persist_conf::devConf.ioPins[pin];
+
 #if defined EEZ_PLATFORM_STM32
     if (!bp3c::flash_slave::g_bootloaderMode || pin != 0) {
         GPIO_InitTypeDef GPIO_InitStruct = { 0 };
 
-        const persist_conf::IOPin &ioPin = persist_conf::devConf.ioPins[pin];
-
         GPIO_InitStruct.Pin = pin == 0 ? UART_RX_DIN1_Pin : DIN2_Pin;
-        GPIO_InitStruct.Mode = GPIO_MODE_INPUT;
+        // DIN2 trigger input is on EXTI line 13, DIN1 is sampled from the timer interrupt
+        GPIO_InitStruct.Mode = pin == 1 && ioPin.function == io_pins::FUNCTION_TINPUT ? GPIO_MODE_IT_RISING_FALLING : GPIO_MODE_INPUT;
         GPIO_InitStruct.Pull = ioPin.polarity == io_pins::POLARITY_POSITIVE ? GPIO_PULLDOWN : GPIO_PULLUP;
         GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
         HAL_GPIO_Init(pin == 0 ? UART_RX_DIN1_GPIO_Port : DIN2_GPIO_Port, &GPIO_InitStruct);
     }
 #endif
+
+    // only the edges after this point are triggers
+    g_edgeQueues[pin].lastState = ioPin.function == io_pins::FUNCTION_TINPUT && isInputPinActive(pin);
 }
 
 uint32_t calcPwmDutyInt(float duty, uint32_t periodInt) {
@@ -304,31 +482,34 @@ void tick(uint32_t tickCount) {
         Channel::onInhibitedChanged(inhibited);
     }
 
-    if (inputPin1.function == io_pins::FUNCTION_TINPUT && inputPin1State && !g_pinState[0]) {
-        trigger::generateTrigger(trigger::SOURCE_PIN1);
+    // edges are normally handled on PSU_QUEUE_MESSAGE_TYPE_IO_PIN_EDGE,
+    // this picks up edges whose message didn't fit into the PSU queue
+    if (inputPin1.function == io_pins::FUNCTION_TINPUT) {
+        onInputPinEdges(0);
     }
-
-    if (inputPin2.function == io_pins::FUNCTION_TINPUT && inputPin2State && !g_pinState[1]) {
-        trigger::generateTrigger(trigger::SOURCE_PIN2);
+    if (inputPin2.function == io_pins::FUNCTION_TINPUT) {
+        onInputPinEdges(1);
     }
 
-    g_pinState[0] = inputPin1State;
-    g_pinState[1] = inputPin2State;
+    // input pins are polled, except trigger inputs which are interrupt driven
+    if ((inputPin1.function != io_pins::FUNCTION_NONE && inputPin1.function != io_pins::FUNCTION_TINPUT) ||
+        (inputPin2.function != io_pins::FUNCTION_NONE && inputPin2.function != io_pins::FUNCTION_TINPUT)) {
+        scheduleTick(CONF_PSU_TICK_POLL_PERIOD_US);
+    }
 
-    // end trigger output pulse
-    if (g_lastState.toutputPulse) {
-        int32_t diff = tickCount - g_toutputPulseStartTickCount;
-        if (diff > CONF_TOUTPUT_PULSE_WIDTH_MS * 1000L) {
-            for (int pin = 2; pin < NUM_IO_PINS; ++pin) {
-                const persist_conf::IOPin &outputPin = persist_conf::devConf.ioPins[pin];
-                if (outputPin.function == io_pins::FUNCTION_TOUTPUT) {
-                    setPinState(pin, false);
-                }
-            }
+#if defined EEZ_PLATFORM_SIMULATOR
+    tickInjectedEdges();
 
-            g_lastState.toutputPulse = 0;
+    // end trigger output pulse, on STM32 this is done from the timer interrupt
+    if (g_toutputPulse) {
+        int32_t diff = tickCount - g_toutputPulseStartTime;
+        if (diff >= CONF_TOUTPUT_PULSE_WIDTH_MS * 1000L) {
+            endToutputPulse();
+        } else {
+            scheduleTick(CONF_TOUTPUT_PULSE_WIDTH_MS * 1000L - diff);
         }
     }
+#endif
 
     enum { UNKNOWN, UNCHANGED, CHANGED } trippedState = UNKNOWN, outputEnabledState = UNKNOWN;
 
@@ -370,14 +551,34 @@ void tick(uint32_t tickCount) {
 
 void onTrigger() {
     // start trigger output pulse
+    bool toutputPulse = false;
+
+    for (int pin = 2; pin < NUM_IO_PINS; ++pin) {
+        const persist_conf::IOPin &outputPin = persist_conf::devConf.ioPins[pin];
+        if (outputPin.function == io_pins::FUNCTION_TOUTPUT) {
+            toutputPulse = true;
+        }
+    }
+
+    if (!toutputPulse) {
+        return;
+    }
+
+    // timer interrupt can end the pulse as soon as g_toutputPulse is set,
+    // so start time must be set before it and pins are set after it
+    g_toutputPulseStartTime = micros();
+    g_toutputPulse = true;
+
     for (int pin = 2; pin < NUM_IO_PINS; ++pin) {
         const persist_conf::IOPin &outputPin = persist_conf::devConf.ioPins[pin];
         if (outputPin.function == io_pins::FUNCTION_TOUTPUT) {
             setPinState(pin, true);
-            g_lastState.toutputPulse = 1;
-            g_toutputPulseStartTickCount = micros();
         }
     }
+
+#if defined EEZ_PLATFORM_SIMULATOR
+    scheduleTick(CONF_TOUTPUT_PULSE_WIDTH_MS * 1000L);
+#endif
 }
 
 void refresh() {
@@ -50,6 +50,39 @@ void tick(uint32_t tickCount);
 void onTrigger();
 void refresh();
 
+// Called from the interrupt (EXTI or timer) when level of the input pin changed.
+// Active edge of the TINPUT pin is timestamped and queued for the PSU thread.
+void onInputPinInterrupt(int pin);
+
+// Called from PSU thread on PSU_QUEUE_MESSAGE_TYPE_IO_PIN_EDGE to generate
+// triggers from the queued edges.
+void onInputPinEdges(int pin);
+
+#if defined EEZ_PLATFORM_STM32
+// Called from the 200 us timer interrupt (see PSU_IncTick), samples input pins
+// without EXTI line and ends trigger output pulse.
+void onTimerInterrupt();
+#endif
+
+struct EdgeStats {
+    uint32_t numEdges;
+    uint32_t numDropped;
+    uint64_t sumLatency;
+    uint32_t maxLatency;
+};
+
+// Latency is the time from the edge to the trigger generation, in microseconds.
+void getEdgeStats(int pin, EdgeStats &stats);
+void resetEdgeStats();
+
+#if defined EEZ_PLATFORM_SIMULATOR
+static const int MAX_INJECTED_EDGES = 32;
+
+// Toggles input pin level after each delay (in microseconds, the first one is
+// relative to now), as if the edges came from the outside through EXTI.
+bool injectEdges(int pin, const uint32_t *delays, int numDelays);
+#endif
+
 // When PSU is in inhibited state all outputs are disabled and execution of LIST on channels is stopped.
 bool isInhibited();
 
@@ -186,6 +186,7 @@ void initDefaultDevConf() {
     strcpy(g_defaultDevConf.ethernetHostName, DEFAULT_ETHERNET_HOST_NAME);
     
     g_defaultDevConf.mqttEnabled = 0;
+    g_defaultDevConf.remoteDisplayEnabled = 0;
     g_defaultDevConf.mqttPort = 1883;
     g_defaultDevConf.mqttPeriod = 15.0f;
 
@@ -1132,6 +1133,17 @@ void enableMqtt(bool enable) {
     setMqttSettings(enable, persist_conf::devConf.mqttHost, persist_conf::devConf.mqttPort, persist_conf::devConf.mqttUsername, persist_conf::devConf.mqttPassword, persist_conf::devConf.mqttPeriod);
 }
 
+void enableRemoteDisplay(bool enable) {
+    g_devConf.remoteDisplayEnabled = enable ? 1 : 0;
+#if OPTION_ETHERNET
+    ethernet::updateRemoteDisplay();
+#endif
+}
+
+bool isRemoteDisplayEnabled() {
+    return g_devConf.remoteDisplayEnabled ? true : false;
+}
+
 void setSdLocked(bool sdLocked) {
     g_devConf.sdLocked = sdLocked ? 1 : 0;
 }
@@ -1331,6 +1343,8 @@ void loadChannelCalibration(Channel &channel) {
         CH_CAL_CONF_VERSION
     )) {
         channel.clearCalibrationConf();
+    } else {
+        channel.compileCalibrationCurves();
     }
 }
 
@@ -187,6 +187,7 @@ struct DeviceConfiguration {
     char ethernetHostName[ETHERNET_HOST_NAME_SIZE + 1];
 
     unsigned mqttEnabled : 1;
+    unsigned remoteDisplayEnabled : 1;
     char mqttHost[64 + 1];
     uint16_t mqttPort;
     char mqttUsername[32 + 1];
@@ -295,6 +296,8 @@ void setNtpSettings(bool enable, const char *ntpServer);
 
 bool setMqttSettings(bool enable, const char *host, uint16_t port, const char *username, const char *password, float period);
 void enableMqtt(bool enable);
+void enableRemoteDisplay(bool enable);
+bool isRemoteDisplayEnabled();
 
 void setSdLocked(bool sdLocked);
 bool isSdLocked();
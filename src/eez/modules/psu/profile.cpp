@@ -109,6 +109,14 @@ void tick() {
 }
 
 void onAfterSdCardMounted() {
+    using namespace eez::scpi;
+
+    if (osThreadGetId() != g_scpiTaskHandle) {
+        // during boot profile names are loaded later in SCPI thread
+        osMessagePut(g_scpiMessageQueueId, SCPI_QUEUE_MESSAGE(SCPI_QUEUE_MESSAGE_TARGET_NONE, SCPI_QUEUE_MESSAGE_TYPE_LOAD_PROFILE_NAMES, 0), osWaitForever);
+        return;
+    }
+
     for (int profileIndex = 1; profileIndex < NUM_PROFILE_LOCATIONS; profileIndex++) {
 		loadProfileName(profileIndex);
     }
@@ -865,7 +873,11 @@ bool WriteContext::property(const char *propertyName, unsigned int value) {
 
 bool WriteContext::property(const char *propertyName, float value) {
     char line[256 + 1];
-    sprintf(line, "\t%s=%g\n", propertyName, value);
+    line[0] = '\t';
+    strcpy(line + 1, propertyName);
+    strcat(line, "=");
+    strcatFloat(line, value);
+    strcat(line, "\n");
     return file.write((uint8_t *)line, strlen(line));
 }
 
@@ -16,10 +16,15 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <atomic>
+#include <string.h>
+
 #if defined(EEZ_PLATFORM_STM32)
 #include <tim.h>
 #endif
 
+#include <eez/platform/stm32/spi.h>
+
 #include <eez/firmware.h>
 #include <eez/system.h>
 #include <eez/sound.h>
@@ -48,6 +53,7 @@
 #include <eez/modules/psu/list_program.h>
 #include <eez/modules/psu/ramp.h>
 #include <eez/modules/psu/trigger.h>
+#include <eez/modules/psu/waveform.h>
 #include <eez/modules/psu/ontime.h>
 
 #if OPTION_DISPLAY
@@ -178,15 +184,30 @@ osThreadId g_psuTaskHandle;
 osMessageQDef(g_psuMessageQueue, PSU_QUEUE_SIZE, uint32_t);
 osMessageQId g_psuMessageQueueId;
 
+static std::atomic<uint32_t> g_psuMessageSequence(0);
+
+// tick scheduler state, next tick deadline is accessed only from the PSU thread
+static uint64_t g_tickUsec;
+static uint64_t g_nextTickUsec;
+static SchedulerStats g_schedulerStats;
+static uint64_t g_schedulerStatsStartTime;
+
 }
 } // namespacee eez::psu
 
 #if defined(EEZ_PLATFORM_STM32)
 extern "C" void PSU_IncTick() {
-    g_tickCount++;
+    if (++g_tickCount == 0) {
+        g_tickCountHigh++;
+    }
 
     using namespace eez::psu;
-    if (ramp::isActive()) {
+
+    io_pins::onTimerInterrupt();
+
+    waveform::onTimerInterrupt();
+
+    if (ramp::isActive() || waveform::isActiveInPsuThread()) {
         osMessagePut(g_psuMessageQueueId, PSU_QUEUE_MESSAGE(PSU_QUEUE_MESSAGE_TYPE_TICK, 0), 0);
     }
 }
@@ -233,22 +254,90 @@ void mainLoop(const void *) {
 #endif
 }
 
+void sendMessageToPsu(uint32_t type, uint32_t param, uint32_t timeout) {
+    g_psuMessageSequence++;
+    osMessagePut(g_psuMessageQueueId, PSU_QUEUE_MESSAGE(type, param), timeout);
+}
+
+uint32_t getPsuMessageSequence() {
+    return g_psuMessageSequence;
+}
+
+void scheduleTick(uint64_t usec) {
+    uint64_t deadline = g_tickUsec + usec;
+    if (deadline < g_nextTickUsec) {
+        g_nextTickUsec = deadline;
+    }
+}
+
+void wakeUpPsuThread() {
+    if (osThreadGetId() != g_psuTaskHandle) {
+        sendMessageToPsu(PSU_QUEUE_MESSAGE_TYPE_WAKE_UP, 0, 0);
+    } else {
+        scheduleTick(0);
+    }
+}
+
+void getSchedulerStats(SchedulerStats &stats) {
+    stats = g_schedulerStats;
+    stats.totalTime = micros64() - g_schedulerStatsStartTime;
+}
+
+void resetSchedulerStats() {
+    memset(&g_schedulerStats, 0, sizeof(g_schedulerStats));
+    g_schedulerStatsStartTime = micros64();
+}
+
+static uint32_t getMessageTimeout() {
+#if CONF_PSU_TICK_SCHEDULER
+    if (g_isBooted) {
+        uint64_t tickUsec = micros64();
+        if (g_nextTickUsec <= tickUsec) {
+            return 0;
+        }
+
+        // Kernel timeout resolution is 1 ms, on STM32 shorter deadlines
+        // of the ramp and waveform are served by the TICK message (see PSU_IncTick).
+        uint64_t timeout = (g_nextTickUsec - tickUsec + 999) / 1000;
+        return timeout < CONF_PSU_TICK_MAX_PERIOD_US / 1000 ? (uint32_t)timeout : CONF_PSU_TICK_MAX_PERIOD_US / 1000;
+    }
+#endif
+    return 1;
+}
+
 bool g_adcMeasureAllFinished = false;
 
 void oneIter() {
-    osEvent event = osMessageGet(g_psuMessageQueueId, 1);
+    osEvent event = osMessageGet(g_psuMessageQueueId, getMessageTimeout());
+
+    uint32_t busyStart = micros();
+    g_schedulerStats.numWakeUps++;
+
+    // every message except TICK (including WAKE_UP) executes full tick
+    bool forceTick = false;
+
     if (event.status == osEventMessage) {
     	uint32_t message = event.value.v;
     	uint32_t type = PSU_QUEUE_MESSAGE_TYPE(message);
 
         if (type == PSU_QUEUE_MESSAGE_TYPE_TICK) {
-#if defined(EEZ_PLATFORM_STM32)
+#if CONF_PSU_TICK_SCHEDULER
+            // posted by PSU_IncTick while ramp or waveform in the PSU thread is active,
+            // full tick is executed only if its deadline is reached
+            uint64_t tickUsec = micros64();
+            ramp::tick(tickUsec);
+            waveform::tick(tickUsec);
+#elif defined(EEZ_PLATFORM_STM32)
             if (g_tickCount % 5) {
-                ramp::tick(micros());
+                uint64_t tickUsec = micros64();
+                ramp::tick(tickUsec);
+                waveform::tick(tickUsec);
                 return;
             }
 #endif
         } else {
+            forceTick = true;
+
             uint32_t param = PSU_QUEUE_MESSAGE_PARAM(message);
             if (type == PSU_QUEUE_MESSAGE_TYPE_CHANGE_POWER_STATE) {
                 changePowerState(param ? true : false);
@@ -284,21 +373,46 @@ void oneIter() {
                 restart();
             } else if (type == PSU_QUEUE_MESSAGE_TYPE_SHUTDOWN) {
                 shutdown();
-            } else if (type == PSU_QUEUE_MESSAGE_TYPE_SET_VOLTAGE) {
-                channel_dispatcher::setVoltageInPsuThread((int)param);
-            } else if (type == PSU_QUEUE_MESSAGE_TYPE_SET_CURRENT) {
-                channel_dispatcher::setCurrentInPsuThread((int)param);
+            } else if (type == PSU_QUEUE_MESSAGE_TYPE_APPLY_SETPOINTS) {
+                channel_dispatcher::applySetpointsInPsuThread();
+            } else if (type == PSU_QUEUE_MESSAGE_TYPE_COMMIT_TRANSACTION) {
+                channel_dispatcher::commitTransactionInPsuThread();
             } else if (type == PSU_QUEUE_MESSAGE_TYPE_CALIBRATION_START) {
                 calibration::start(Channel::get((int)param));
             } else if (type == PSU_QUEUE_MESSAGE_TYPE_CALIBRATION_STOP) {
                 calibration::stop();
+            } else if (type == PSU_QUEUE_MESSAGE_TYPE_RESET_CHANNEL_STATISTICS) {
+                Channel::get(param).resetStatistics();
+            } else if (type == PSU_QUEUE_MESSAGE_TYPE_IO_PIN_EDGE) {
+                io_pins::onInputPinEdges(param);
             }
         }
     } 
     
     if (g_isBooted) {
+        uint64_t tickUsec = micros64();
+
+        bool deadlineReached = tickUsec >= g_nextTickUsec;
+        if (deadlineReached && g_tickUsec != 0) {
+            uint32_t lateness = (uint32_t)(tickUsec - g_nextTickUsec);
+            g_schedulerStats.numDeadlineTicks++;
+            g_schedulerStats.sumLateness += lateness;
+            if (lateness > g_schedulerStats.maxLateness) {
+                g_schedulerStats.maxLateness = lateness;
+            }
+        }
+
+#if CONF_PSU_TICK_SCHEDULER
+        if (deadlineReached || forceTick) {
+            tick();
+        }
+#else
+        (void)forceTick;
         tick();
+#endif
     }
+
+    g_schedulerStats.busyTime += micros() - busyStart;
 }
 
 bool measureAllAdcValuesOnChannel(int channelIndex) {
@@ -307,7 +421,7 @@ bool measureAllAdcValuesOnChannel(int channelIndex) {
 	}
 
     g_adcMeasureAllFinished = false;
-    osMessagePut(eez::psu::g_psuMessageQueueId, PSU_QUEUE_MESSAGE(PSU_QUEUE_MESSAGE_ADC_MEASURE_ALL, channelIndex), 0);
+    sendMessageToPsu(PSU_QUEUE_MESSAGE_ADC_MEASURE_ALL, channelIndex, 0);
 
     int i;
     for (i = 0; i < 100 && !g_adcMeasureAllFinished; ++i) {
@@ -337,7 +451,26 @@ bool testChannels() {
 
     for (int i = 0; i < CH_NUM; ++i) {
         WATCHDOG_RESET();
-        result &= Channel::get(i).test();
+        Channel::get(i).testStart();
+    }
+
+    // each module is on its own SPI bus, so while one channel waits for its ADC
+    // conversion the conversions of all the other channels are running too
+    bool testing;
+    do {
+        testing = false;
+        for (int i = 0; i < CH_NUM; ++i) {
+            if (Channel::get(i).testStep()) {
+                testing = true;
+            }
+        }
+    } while (testing);
+
+    for (int i = 0; i < CH_NUM; ++i) {
+        Channel &channel = Channel::get(i);
+        if (channel.isInstalled()) {
+            result &= channel.isOk();
+        }
     }
 
     return result;
@@ -461,6 +594,9 @@ bool psuReset() {
     //
     list::reset();
 
+    //
+    waveform::reset();
+
     //
     dlog_record::reset();
 
@@ -620,7 +756,7 @@ void changePowerState(bool up) {
     }
 
     if (osThreadGetId() != g_psuTaskHandle) {
-        osMessagePut(g_psuMessageQueueId, PSU_QUEUE_MESSAGE(PSU_QUEUE_MESSAGE_TYPE_CHANGE_POWER_STATE, up ? 1 : 0), osWaitForever);
+        sendMessageToPsu(PSU_QUEUE_MESSAGE_TYPE_CHANGE_POWER_STATE, up ? 1 : 0);
         return;
     }
 
@@ -688,12 +824,19 @@ static int g_tickFuncIndex = 0;
 void tick() {
     WATCHDOG_RESET();
 
-    uint32_t tickCount = micros();
+    uint64_t tickUsec = micros64();
+
+    // subsystems request earlier deadline with scheduleTick
+    g_tickUsec = tickUsec;
+    g_nextTickUsec = tickUsec + CONF_PSU_TICK_MAX_PERIOD_US;
+    g_schedulerStats.numTicks++;
 
-    trigger::tick(tickCount);
-    tickCount = micros();
-    list::tick(tickCount);
-    ramp::tick(tickCount);
+    trigger::tick(tickUsec);
+    list::tick(tickUsec);
+    ramp::tick(tickUsec);
+    waveform::tick(tickUsec);
+
+    uint32_t tickCount = (uint32_t)tickUsec;
 
     for (int i = 0; i < CH_NUM; ++i) {
         Channel::get(i).tick(tickCount);
@@ -710,6 +853,8 @@ void tick() {
         g_diagCallback();
         g_diagCallback = NULL;
     }
+
+    spi::tick();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -775,12 +920,17 @@ MaxCurrentLimitCause getMaxCurrentLimitCause() {
 namespace simulator {
 
 static float g_temperature[temp_sensor::NUM_TEMP_SENSORS];
+static float g_heatsinkTemperatureRise[CH_MAX];
+static float g_sensorTemperatureRise[CH_MAX];
+static uint32_t g_lastTemperatureRiseTick[CH_MAX];
 static bool g_pwrgood[CH_MAX];
 static bool g_rpol[CH_MAX];
 static bool g_cv[CH_MAX];
 static bool g_cc[CH_MAX];
 float g_uSet[CH_MAX];
 float g_iSet[CH_MAX];
+static uint32_t g_seed;
+static uint32_t g_random;
 
 void init() {
     for (int i = 0; i < temp_sensor::NUM_TEMP_SENSORS; ++i) {
@@ -801,7 +951,48 @@ void setTemperature(int sensor, float value) {
     g_temperature[sensor] = value;
 }
 
+// Simulated channel heatsink. It is deliberately not the thermal model from
+// temperature.cpp: heat comes from the losses in the pass element and in the
+// pre-regulator instead of the output power, fan cooling is not linear in rpm
+// and the constants are different. That way the model has an error to correct.
+static const float SIMULATOR_PASS_ELEMENT_HEADROOM = 2.5f; // V
+static const float SIMULATOR_PRE_REGULATOR_LOSS = 0.15f; // of the output power
+static const float SIMULATOR_HEATSINK_RTH = 1.6f; // oC/W with fan stopped
+static const float SIMULATOR_FAN_COOLING = 2.0f;
+static const float SIMULATOR_HEATSINK_TAU = 90.0f; // s
+static const float SIMULATOR_SENSOR_TAU = 8.0f; // s
+
+static float getChannelTemperatureRise(int channelIndex) {
+    uint32_t tickCount = millis();
+    float dt = (tickCount - g_lastTemperatureRiseTick[channelIndex]) / 1000.0f;
+    g_lastTemperatureRiseTick[channelIndex] = tickCount;
+
+    Channel &channel = Channel::get(channelIndex);
+
+    float power = 0;
+    if (channel.isOutputEnabled() && channel.u.mon_last > 0 && channel.i.mon_last > 0) {
+        power = channel.i.mon_last * SIMULATOR_PASS_ELEMENT_HEADROOM +
+            channel.u.mon_last * channel.i.mon_last * SIMULATOR_PRE_REGULATOR_LOSS;
+    }
+
+    float rth = SIMULATOR_HEATSINK_RTH;
+#if OPTION_FAN
+    // convection grows slower than the air flow
+    rth /= 1.0f + SIMULATOR_FAN_COOLING * sqrtf(aux_ps::fan::g_rpm / (float)FAN_NOMINAL_RPM);
+#endif
+
+    float &heatsink = g_heatsinkTemperatureRise[channelIndex];
+    float &sensor = g_sensorTemperatureRise[channelIndex];
+    heatsink += (rth * power - heatsink) * (1.0f - expf(-dt / SIMULATOR_HEATSINK_TAU));
+    sensor += (heatsink - sensor) * (1.0f - expf(-dt / SIMULATOR_SENSOR_TAU));
+
+    return sensor;
+}
+
 float getTemperature(int sensor) {
+    if (sensor >= temp_sensor::CH1 && sensor <= temp_sensor::CH6 && sensor - temp_sensor::CH1 < CH_NUM) {
+        return g_temperature[sensor] + getChannelTemperatureRise(sensor - temp_sensor::CH1);
+    }
     return g_temperature[sensor];
 }
 
@@ -837,6 +1028,30 @@ void setCC(int pin, bool on) {
     g_cc[pin] = on;
 }
 
+void setSeed(uint32_t seed) {
+    g_seed = seed;
+    g_random = seed;
+}
+
+uint32_t getSeed() {
+    return g_seed;
+}
+
+// Returns pseudo random value from [-1, 1] range. The sequence depends only on the
+// seed set with --seed command line option, so the sample stream is reproducible.
+float getNoise() {
+    if (!g_seed) {
+        return 0;
+    }
+
+    // xorshift32
+    g_random ^= g_random << 13;
+    g_random ^= g_random >> 17;
+    g_random ^= g_random << 5;
+
+    return g_random / 2147483647.5f - 1.0f;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 void exit() {
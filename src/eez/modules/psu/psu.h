@@ -75,17 +75,47 @@ enum {
     PSU_QUEUE_SYNC_OUTPUT_ENABLE,
     PSU_QUEUE_MESSAGE_TYPE_HARD_RESET,
     PSU_QUEUE_MESSAGE_TYPE_SHUTDOWN,
-    PSU_QUEUE_MESSAGE_TYPE_SET_VOLTAGE,
-    PSU_QUEUE_MESSAGE_TYPE_SET_CURRENT,
-    PSU_QUEUE_RESET_CHANNELS_HISTORY,
+    PSU_QUEUE_MESSAGE_TYPE_APPLY_SETPOINTS,
+    PSU_QUEUE_MESSAGE_TYPE_COMMIT_TRANSACTION,
     PSU_QUEUE_MESSAGE_TYPE_CALIBRATION_START,
     PSU_QUEUE_MESSAGE_TYPE_CALIBRATION_STOP,
+    PSU_QUEUE_MESSAGE_TYPE_WAKE_UP,
+    PSU_QUEUE_MESSAGE_TYPE_RESET_CHANNEL_STATISTICS,
+    PSU_QUEUE_MESSAGE_TYPE_IO_PIN_EDGE,
 };
 
 #define PSU_QUEUE_MESSAGE(type, param) (((param) << 8) | (type))
 #define PSU_QUEUE_MESSAGE_TYPE(message) ((message) & 0xFF)
 #define PSU_QUEUE_MESSAGE_PARAM(param) ((message) >> 8)
 
+/// Post message to the PSU thread from some other thread.
+/// Every message increments the PSU message sequence number, which is used by the
+/// setpoint mailbox to keep setpoints ordered with the other messages.
+void sendMessageToPsu(uint32_t type, uint32_t param = 0, uint32_t timeout = osWaitForever);
+uint32_t getPsuMessageSequence();
+
+/// PSU thread doesn't poll at fixed rate, it sleeps until the earliest deadline
+/// requested by subsystems or until message arrives. Subsystems call this from
+/// their tick to request next tick not later than usec microseconds after the current one.
+void scheduleTick(uint64_t usec);
+
+/// Execute tick as soon as possible, for the state changed from some other thread
+/// (for example, trigger generated by SCPI or GUI thread).
+void wakeUpPsuThread();
+
+struct SchedulerStats {
+    uint32_t numWakeUps;    // number of times PSU thread was woken up (message or timeout)
+    uint32_t numTicks;      // number of executed ticks
+    uint32_t numDeadlineTicks; // number of ticks executed because deadline was reached
+    uint32_t maxLateness;   // tick start time after deadline, in microseconds
+    uint64_t sumLateness;   // in microseconds
+    uint64_t busyTime;      // time spent outside of osMessageGet, in microseconds
+    uint64_t totalTime;     // in microseconds
+};
+
+void getSchedulerStats(SchedulerStats &stats);
+void resetSchedulerStats();
+
 bool measureAllAdcValuesOnChannel(int channelIndex);
 
 void initChannels();
@@ -149,6 +179,10 @@ void setCV(int pin, bool on);
 bool getCC(int pin);
 void setCC(int pin, bool on);
 
+void setSeed(uint32_t seed);
+uint32_t getSeed();
+float getNoise();
+
 void exit();
 
 } // namespace simulator
@@ -77,6 +77,9 @@ scpi_result_t scpi_cmd_apply(scpi_t *context) {
         return SCPI_RES_ERR;
     }
 
+    // voltage and current are applied in the same PSU tick
+    channel_dispatcher::beginSetpointGroup();
+
     // set voltage
     channel_dispatcher::setVoltage(*channel, voltage);
 
@@ -85,6 +88,8 @@ scpi_result_t scpi_cmd_apply(scpi_t *context) {
         channel_dispatcher::setCurrent(*channel, current);
     }
 
+    channel_dispatcher::endSetpointGroup();
+
     return SCPI_RES_OK;
 }
 
@@ -127,6 +132,107 @@ scpi_result_t scpi_cmd_applyQ(scpi_t *context) {
     return SCPI_RES_OK;
 }
 
+scpi_result_t scpi_cmd_applyStage(scpi_t *context) {
+    Channel *channel = param_channel(context, TRUE);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    float voltage;
+    if (!get_voltage_param(context, voltage, channel, 0)) {
+        return SCPI_RES_ERR;
+    }
+
+    bool stage_current = false;
+    float current;
+
+    scpi_number_t param;
+    if (!SCPI_ParamNumber(context, scpi_special_numbers_def, &param, false)) {
+        if (SCPI_ParamErrorOccurred(context)) {
+            return SCPI_RES_ERR;
+        }
+        // no CURRent parameter
+    } else {
+        if (!get_current_from_param(context, param, current, channel, 0)) {
+            return SCPI_RES_ERR;
+        }
+        stage_current = true;
+    }
+
+    bool stage_output_enable = false;
+    bool enable;
+    if (!SCPI_ParamBool(context, &enable, false)) {
+        if (SCPI_ParamErrorOccurred(context)) {
+            return SCPI_RES_ERR;
+        }
+        // no output state parameter
+    } else {
+        stage_output_enable = true;
+    }
+
+    if (channel->isVoltageLimitExceeded(voltage)) {
+        SCPI_ErrorPush(context, SCPI_ERROR_VOLTAGE_LIMIT_EXCEEDED);
+        return SCPI_RES_ERR;
+    }
+
+    if (stage_current && channel->isCurrentLimitExceeded(current)) {
+        SCPI_ErrorPush(context, SCPI_ERROR_CURRENT_LIMIT_EXCEEDED);
+        return SCPI_RES_ERR;
+    }
+
+    if (channel->isPowerLimitExceeded(voltage, (stage_current ? current : channel_dispatcher::getISet(*channel)))) {
+        SCPI_ErrorPush(context, SCPI_ERROR_POWER_LIMIT_EXCEEDED);
+        return SCPI_RES_ERR;
+    }
+
+    int err;
+    if (!channel_dispatcher::beginTransaction(context, &err)) {
+        SCPI_ErrorPush(context, err);
+        return SCPI_RES_ERR;
+    }
+
+    channel_dispatcher::stageVoltage(*channel, voltage);
+
+    if (stage_current) {
+        channel_dispatcher::stageCurrent(*channel, current);
+    }
+
+    if (stage_output_enable) {
+        channel_dispatcher::stageOutputEnable(*channel, enable);
+    }
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_cmd_applyCommit(scpi_t *context) {
+    int err;
+    if (!channel_dispatcher::commitTransaction(context, &err)) {
+        SCPI_ErrorPush(context, err);
+        return SCPI_RES_ERR;
+    }
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_cmd_applyAbort(scpi_t *context) {
+    channel_dispatcher::abortTransaction(context);
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_cmd_applySkewQ(scpi_t *context) {
+    channel_dispatcher::TransactionStats stats;
+    channel_dispatcher::getLastTransactionStats(stats);
+
+    SCPI_ResultInt(context, stats.numChannels);
+    SCPI_ResultInt(context, stats.numDacWrites);
+    SCPI_ResultInt(context, stats.dacTime);
+    SCPI_ResultInt(context, stats.outputEnableTime);
+    SCPI_ResultInt(context, stats.totalTime);
+
+    return SCPI_RES_OK;
+}
+
 } // namespace scpi
 } // namespace psu
 } // namespace eez
\ No newline at end of file
@@ -39,6 +39,12 @@ scpi_choice_def_t calibration_current_range_choice[] = {
     SCPI_CHOICE_LIST_END /* termination of option list */
 };
 
+scpi_choice_def_t calibration_model_choice[] = {
+    { "LINear", calibration::MODEL_LINEAR },
+    { "CUBic", calibration::MODEL_CUBIC },
+    SCPI_CHOICE_LIST_END /* termination of option list */
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 
 static scpi_result_t calibration_level(scpi_t *context, calibration::Value &calibrationValue) {
@@ -106,6 +112,22 @@ static scpi_result_t calibration_data(scpi_t *context, calibration::Value &calib
     return SCPI_RES_OK;
 }
 
+static scpi_result_t calibration_model(scpi_t *context, calibration::Value &calibrationValue) {
+    if (!calibration::isEnabled()) {
+        SCPI_ErrorPush(context, SCPI_ERROR_CALIBRATION_STATE_IS_OFF);
+        return SCPI_RES_ERR;
+    }
+
+    int32_t model;
+    if (!SCPI_ParamChoice(context, calibration_model_choice, &model, true)) {
+        return SCPI_RES_ERR;
+    }
+
+    calibrationValue.model = (calibration::Model)model;
+
+    return SCPI_RES_OK;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 scpi_result_t scpi_cmd_calibrationClear(scpi_t *context) {
@@ -193,6 +215,28 @@ scpi_result_t scpi_cmd_calibrationCurrentLevel(scpi_t *context) {
     return calibration_level(context, calibration::getCurrent());
 }
 
+scpi_result_t scpi_cmd_calibrationCurrentModel(scpi_t *context) {
+    return calibration_model(context, calibration::getCurrent());
+}
+
+scpi_result_t scpi_cmd_calibrationCurrentModelQ(scpi_t *context) {
+    int model;
+
+    if (calibration::isEnabled()) {
+        model = calibration::getCurrent().model;
+    } else {
+        Channel *channel = getSelectedChannel(context);
+        if (!channel) {
+            return SCPI_RES_ERR;
+        }
+        model = channel->cal_conf.i[channel->flags.currentCurrentRange].model;
+    }
+
+    resultChoiceName(context, calibration_model_choice, model);
+
+    return SCPI_RES_OK;
+}
+
 scpi_result_t scpi_cmd_calibrationCurrentRange(scpi_t *context) {
     if (!calibration::isEnabled()) {
         SCPI_ErrorPush(context, SCPI_ERROR_CALIBRATION_STATE_IS_OFF);
@@ -353,6 +397,28 @@ scpi_result_t scpi_cmd_calibrationVoltageLevel(scpi_t *context) {
     ;
 }
 
+scpi_result_t scpi_cmd_calibrationVoltageModel(scpi_t *context) {
+    return calibration_model(context, calibration::getVoltage());
+}
+
+scpi_result_t scpi_cmd_calibrationVoltageModelQ(scpi_t *context) {
+    int model;
+
+    if (calibration::isEnabled()) {
+        model = calibration::getVoltage().model;
+    } else {
+        Channel *channel = getSelectedChannel(context);
+        if (!channel) {
+            return SCPI_RES_ERR;
+        }
+        model = channel->cal_conf.u.model;
+    }
+
+    resultChoiceName(context, calibration_model_choice, model);
+
+    return SCPI_RES_OK;
+}
+
 scpi_result_t scpi_cmd_calibrationScreenInit(scpi_t *context) {
 #if OPTION_DISPLAY
     psu::gui::showPage(PAGE_ID_TOUCH_CALIBRATION_INTRO);
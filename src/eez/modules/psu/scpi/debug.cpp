@@ -446,7 +446,7 @@ scpi_result_t scpi_cmd_debugDcm220Q(scpi_t *context) {
 }
 
 scpi_result_t scpi_cmd_debugDownloadFirmware(scpi_t *context) {
-#if defined(DEBUG) && defined(EEZ_PLATFORM_STM32)
+#if defined(DEBUG)
     int32_t slotIndex;
     if (!SCPI_ParamInt32(context, &slotIndex, true)) {
         return SCPI_RES_ERR;
@@ -16,15 +16,19 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <math.h>
 #include <stdio.h>
 
+#include <eez/firmware.h>
 #include <eez/system.h>
 #include <eez/index.h>
 
 #include <eez/modules/psu/psu.h>
 #include <eez/modules/psu/calibration.h>
+#include <eez/modules/psu/channel_dispatcher.h>
 #include <eez/modules/psu/datetime.h>
 #include <eez/modules/psu/devices.h>
+#include <eez/modules/psu/io_pins.h>
 #include <eez/modules/psu/scpi/psu.h>
 #include <eez/modules/psu/temperature.h>
 
@@ -32,6 +36,14 @@
 #include <eez/modules/aux_ps/fan.h>
 #endif
 
+#if OPTION_DISPLAY
+#include <eez/gui/gui.h>
+#include <eez/modules/mcu/display.h>
+#include <eez/libs/image/image.h>
+#endif
+
+#include <eez/platform/stm32/spi.h>
+
 namespace eez {
 namespace psu {
 namespace scpi {
@@ -96,6 +108,9 @@ void printCalibrationParameters(scpi_t *context, Unit unit, uint8_t currentRange
     SCPI_ResultText(context, buffer);
 
     if (calParamsExists) {
+        sprintf(buffer, "%s_model=%s", prefix, calibrationValue.model == calibration::MODEL_CUBIC ? "cubic" : "linear");
+        SCPI_ResultText(context, buffer);
+
         for (unsigned int i = 0; i < calibrationValue.numPoints; i++) {
             sprintf(buffer, "%s_point%d_dac=%f", prefix, i + 1, calibrationValue.points[i].dac);
             SCPI_ResultText(context, buffer);
@@ -243,6 +258,17 @@ scpi_result_t scpi_cmd_diagnosticInformationProtectionQ(scpi_t *context) {
             strcatFloat(buffer, sensorTemperature.prot_conf.level);
             strcat(buffer, " oC");
             SCPI_ResultText(context, buffer);
+
+            Channel *sensorChannel = sensor.getChannel();
+            if (sensorChannel) {
+                sprintf(buffer, "temp_%s_predicted=", sensor.name);
+                strcatFloat(buffer, temperature::getChannelPredictedTemperature(sensorChannel));
+                strcat(buffer, " oC");
+                SCPI_ResultText(context, buffer);
+
+                sprintf(buffer, "temp_%s_derated=%d", sensor.name, temperature::isChannelCurrentDerated(sensorChannel) ? 1 : 0);
+                SCPI_ResultText(context, buffer);
+            }
         }
     }
 
@@ -295,6 +321,7 @@ void diagCallback() {
 
 scpi_result_t scpi_cmd_diagnosticInformationRegsQ(scpi_t *context) {
     g_diagCallback = diagCallback;
+    wakeUpPsuThread();
     while (g_diagCallback) {
     	osDelay(1);
     }
@@ -347,6 +374,212 @@ scpi_result_t scpi_cmd_diagnosticInformationRegsQ(scpi_t *context) {
     return SCPI_RES_OK;
 }
 
+scpi_result_t scpi_cmd_diagnosticInformationBootQ(scpi_t *context) {
+    char buffer[1024] = { 0 };
+
+    uint32_t previousTime = 0;
+    for (int i = 0; i < getNumBootSteps(); i++) {
+        const BootStep &bootStep = getBootStep(i);
+        sprintf(buffer + strlen(buffer), "%-10s %5d ms (+%d ms)\n", bootStep.name, (int)bootStep.time, (int)(bootStep.time - previousTime));
+        previousTime = bootStep.time;
+    }
+
+#if OPTION_DISPLAY
+    sprintf(buffer + strlen(buffer), "Assets decompression: %d ms\n", (int)eez::gui::getAssetsDecompressionTime());
+    sprintf(buffer + strlen(buffer), "First frame: %d ms\n", (int)eez::gui::getFirstFrameTime());
+#endif
+
+    SCPI_ResultCharacters(context, buffer, strlen(buffer));
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_cmd_diagnosticInformationSpiQ(scpi_t *context) {
+    char buffer[512] = { 0 };
+
+    for (int slotIndex = 0; slotIndex < NUM_SLOTS; slotIndex++) {
+        spi::Stats stats;
+        spi::getStats(slotIndex, stats);
+
+        uint32_t numTicks = stats.numTicks > 0 ? stats.numTicks : 1;
+        uint32_t transfersPerTick = (uint32_t)((uint64_t)stats.numTransfers * 100 / numTicks); // x100
+        uint32_t bytesPerTick = (uint32_t)((uint64_t)stats.numBytes * 100 / numTicks); // x100
+
+        sprintf(buffer + strlen(buffer), "Slot %d: %d ticks, %d.%02d transfers/tick, %d.%02d bytes/tick, %d us/tick, max %d us/tick\n",
+            slotIndex + 1, (int)stats.numTicks,
+            (int)(transfersPerTick / 100), (int)(transfersPerTick % 100),
+            (int)(bytesPerTick / 100), (int)(bytesPerTick % 100),
+            (int)(stats.time / numTicks), (int)stats.maxTimePerTick);
+    }
+
+    spi::resetStats();
+
+    SCPI_ResultCharacters(context, buffer, strlen(buffer));
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_cmd_diagnosticInformationSetpointQ(scpi_t *context) {
+    uint32_t numWrites;
+    uint32_t numCoalesced;
+    uint32_t numApplies;
+    channel_dispatcher::getSetpointStats(numWrites, numCoalesced, numApplies);
+    channel_dispatcher::resetSetpointStats();
+
+    char buffer[128];
+    sprintf(buffer, "%d setpoint writes, %d coalesced, %d applies\n", (int)numWrites, (int)numCoalesced, (int)numApplies);
+
+    SCPI_ResultCharacters(context, buffer, strlen(buffer));
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_cmd_diagnosticInformationTriggerQ(scpi_t *context) {
+    char buffer[256] = { 0 };
+
+    for (int pin = 0; pin < 2; pin++) {
+        io_pins::EdgeStats stats;
+        io_pins::getEdgeStats(pin, stats);
+
+        uint32_t numEdges = stats.numEdges > 0 ? stats.numEdges : 1;
+
+        sprintf(buffer + strlen(buffer), "Pin %d: %d edges, %d dropped, latency %d us avg, %d us max\n",
+            pin + 1, (int)stats.numEdges, (int)stats.numDropped,
+            (int)(stats.sumLatency / numEdges), (int)stats.maxLatency);
+    }
+
+    io_pins::resetEdgeStats();
+
+    SCPI_ResultCharacters(context, buffer, strlen(buffer));
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_cmd_diagnosticInformationCpuQ(scpi_t *context) {
+    SchedulerStats stats;
+    getSchedulerStats(stats);
+    resetSchedulerStats();
+
+    uint64_t totalTime = stats.totalTime > 0 ? stats.totalTime : 1;
+    uint32_t cpu = (uint32_t)(stats.busyTime * 10000 / totalTime); // x100
+    uint32_t numDeadlineTicks = stats.numDeadlineTicks > 0 ? stats.numDeadlineTicks : 1;
+
+    char buffer[256];
+    sprintf(buffer, "PSU thread: %d.%02d%% CPU, %d wake-ups, %d ticks in %d ms\nDeadline lateness: %d us avg, %d us max\n",
+        (int)(cpu / 100), (int)(cpu % 100),
+        (int)stats.numWakeUps, (int)stats.numTicks, (int)(stats.totalTime / 1000),
+        (int)(stats.sumLateness / numDeadlineTicks), (int)stats.maxLateness);
+
+    SCPI_ResultCharacters(context, buffer, strlen(buffer));
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_cmd_diagnosticInformationFloatQ(scpi_t *context) {
+    static const int NUM_VALUES = 1000;
+    static const int MAX_DECIMAL_PLACES = 4;
+
+    int numMismatches = 0;
+    uint32_t fastTime = 0;
+    uint32_t sprintfTime = 0;
+
+    char fast[64];
+    char reference[64];
+
+    uint32_t seed = 1;
+    for (int i = 0; i < NUM_VALUES; i++) {
+        // values from 1E-8 up to 1E6, like measured, set and saved values
+        seed = seed * 1664525 + 1013904223;
+        float value = ((int32_t)(seed % 2000001) - 1000000) * powf(10.0f, -(float)(seed % 15));
+
+        uint32_t startTime = micros();
+        floatToStr(fast, value);
+        fastTime += micros() - startTime;
+
+        startTime = micros();
+        sprintf(reference, "%g", value);
+        sprintfTime += micros() - startTime;
+
+        if (strcmp(fast, reference) != 0) {
+            numMismatches++;
+        }
+
+        for (int numDecimalPlaces = 0; numDecimalPlaces <= MAX_DECIMAL_PLACES; numDecimalPlaces++) {
+            startTime = micros();
+            floatToStr(fast, value, numDecimalPlaces);
+            fastTime += micros() - startTime;
+
+            startTime = micros();
+            sprintf(reference, "%.*f", numDecimalPlaces, value);
+            sprintfTime += micros() - startTime;
+
+            if (strcmp(fast, reference) != 0) {
+                numMismatches++;
+            }
+        }
+    }
+
+    char buffer[256];
+    sprintf(buffer, "%d conversions, %d mismatches\nfloatToStr: %d us\nsprintf: %d us\n",
+        NUM_VALUES * (MAX_DECIMAL_PLACES + 2), numMismatches, (int)fastTime, (int)sprintfTime);
+
+    SCPI_ResultCharacters(context, buffer, strlen(buffer));
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_cmd_diagnosticInformationScreenshotQ(scpi_t *context) {
+#if OPTION_DISPLAY
+    static const int NUM_ITERATIONS = 5;
+
+    char buffer[256] = { 0 };
+
+    uint32_t startTime = micros();
+    const uint8_t *screenshotPixels = mcu::display::takeScreenshot();
+    sprintf(buffer + strlen(buffer), "Capture: %d us\n", (int)(micros() - startTime));
+
+    static const struct {
+        ImageFormat format;
+        const char *name;
+    } formats[] = {
+        { IMAGE_FORMAT_JPEG, "JPEG" },
+        { IMAGE_FORMAT_QOI, "QOI" }
+    };
+
+    for (unsigned i = 0; i < sizeof(formats) / sizeof(formats[0]); i++) {
+        unsigned char *imageData;
+        size_t imageDataSize = 0;
+        uint32_t minTime = 0xFFFFFFFF;
+        uint32_t totalTime = 0;
+        int err = 0;
+
+        for (int iteration = 0; iteration < NUM_ITERATIONS && !err; iteration++) {
+            startTime = micros();
+            err = imageEncode(formats[i].format, screenshotPixels, &imageData, &imageDataSize);
+            uint32_t time = micros() - startTime;
+            totalTime += time;
+            if (time < minTime) {
+                minTime = time;
+            }
+        }
+
+        if (err) {
+            sprintf(buffer + strlen(buffer), "%s: out of memory\n", formats[i].name);
+        } else {
+            sprintf(buffer + strlen(buffer), "%s: %d bytes, min %d us, avg %d us\n", formats[i].name,
+                (int)imageDataSize, (int)minTime, (int)(totalTime / NUM_ITERATIONS));
+        }
+    }
+
+    SCPI_ResultCharacters(context, buffer, strlen(buffer));
+
+    return SCPI_RES_OK;
+#else
+    SCPI_ErrorPush(context, SCPI_ERROR_HARDWARE_MISSING);
+    return SCPI_RES_ERR;
+#endif
+}
+
 } // namespace scpi
 } // namespace psu
 } // namespace eez
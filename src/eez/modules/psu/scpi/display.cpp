@@ -30,7 +30,7 @@
 #include <eez/modules/psu/dlog_record.h>
 #include <eez/modules/psu/dlog_view.h>
 
-#include <eez/libs/image/jpeg.h>
+#include <eez/libs/image/image.h>
 
 namespace eez {
 namespace psu {
@@ -166,14 +166,28 @@ scpi_result_t scpi_cmd_displayWindowTextClear(scpi_t *context) {
 #endif
 }
 
+static scpi_choice_def_t imageFormatChoice[] = {
+    { "JPEG", IMAGE_FORMAT_JPEG },
+    { "QOI", IMAGE_FORMAT_QOI },
+    SCPI_CHOICE_LIST_END /* termination of option list */
+};
+
 scpi_result_t scpi_cmd_displayDataQ(scpi_t *context) {
 #if OPTION_DISPLAY
+    int32_t format;
+    if (!SCPI_ParamChoice(context, imageFormatChoice, &format, false)) {
+        if (SCPI_ParamErrorOccurred(context)) {
+            return SCPI_RES_ERR;
+        }
+        format = IMAGE_FORMAT_JPEG;
+    }
+
     const uint8_t *screenshotPixels = mcu::display::takeScreenshot();
 
     unsigned char* imageData;
     size_t imageDataSize;
 
-    if (jpegEncode(screenshotPixels, &imageData, &imageDataSize)) {
+    if (imageEncode((ImageFormat)format, screenshotPixels, &imageData, &imageDataSize)) {
     	SCPI_ErrorPush(context, SCPI_ERROR_OUT_OF_MEMORY_FOR_REQ_OP);
     	return SCPI_RES_ERR;
     }
@@ -20,6 +20,10 @@
 
 #include <eez/modules/psu/scpi/psu.h>
 #include <eez/modules/psu/dlog_record.h>
+#include <eez/modules/psu/dlog_export.h>
+#if OPTION_DISPLAY
+#include <eez/modules/psu/gui/psu.h>
+#endif
 
 namespace eez {
 namespace psu {
@@ -778,6 +782,57 @@ scpi_result_t scpi_cmd_senseDlogTraceData(scpi_t *context) {
     return SCPI_RES_OK;
 }
 
+scpi_choice_def_t exportFormatChoice[] = {
+    { "CSV", dlog_export::FORMAT_CSV },
+    { "BINary", dlog_export::FORMAT_BINARY },
+    SCPI_CHOICE_LIST_END /* termination of option list */
+};
+
+scpi_result_t scpi_cmd_dlogExport(scpi_t *context) {
+    if (persist_conf::isSdLocked()) {
+        SCPI_ErrorPush(context, SCPI_ERROR_MEDIA_PROTECTED);
+        return SCPI_RES_ERR;
+    }
+
+    char sourcePath[MAX_PATH_LENGTH + 1];
+    if (!getFilePath(context, sourcePath, true)) {
+        return SCPI_RES_ERR;
+    }
+
+    char destinationPath[MAX_PATH_LENGTH + 1];
+    if (!getFilePath(context, destinationPath, true)) {
+        return SCPI_RES_ERR;
+    }
+
+    int32_t format;
+    if (!SCPI_ParamChoice(context, exportFormatChoice, &format, false)) {
+        if (SCPI_ParamErrorOccurred(context)) {
+            return SCPI_RES_ERR;
+        }
+        format = dlog_export::FORMAT_CSV;
+    }
+
+#if OPTION_DISPLAY
+    psu::gui::showProgressPage("Exporting...");
+#endif
+
+    int err = 0;
+    bool result = dlog_export::exportFile(sourcePath, destinationPath, (dlog_export::Format)format, true, &err);
+
+#if OPTION_DISPLAY
+    psu::gui::hideProgressPage();
+#endif
+
+    if (!result) {
+        if (err != 0) {
+            SCPI_ErrorPush(context, err);
+        }
+        return SCPI_RES_ERR;
+    }
+
+    return SCPI_RES_OK;
+}
+
 
 } // namespace scpi
 } // namespace psu
@@ -66,6 +66,66 @@ scpi_result_t scpi_cmd_measureScalarVoltageDcQ(scpi_t *context) {
     return SCPI_RES_OK;
 }
 
+scpi_result_t scpi_cmd_measureScalarStatisticsQ(scpi_t *context) {
+    Channel *channel = param_channel(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    Channel::StatisticsSnapshot statistics;
+    channel->getStatisticsSnapshot(statistics);
+
+    // Umin,Umax,Umean,Urms,Imin,Imax,Imean,Irms,number of samples
+    float values[] = {
+        statistics.u.min, statistics.u.max, statistics.u.getMean(), statistics.u.getRms(),
+        statistics.i.min, statistics.i.max, statistics.i.getMean(), statistics.i.getRms()
+    };
+
+    char buffer[256] = { 0 };
+    for (unsigned i = 0; i < sizeof(values) / sizeof(float); i++) {
+        strcatFloat(buffer, values[i]);
+        strcat(buffer, ",");
+    }
+    strcatUInt32(buffer, statistics.i.count);
+
+    SCPI_ResultCharacters(context, buffer, strlen(buffer));
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_cmd_measureScalarEnergyQ(scpi_t *context) {
+    Channel *channel = param_channel(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    Channel::StatisticsSnapshot statistics;
+    channel->getStatisticsSnapshot(statistics);
+
+    // Ah,Wh,seconds
+    char buffer[256] = { 0 };
+    strcatFloat(buffer, (float)(statistics.charge / 3600));
+    strcat(buffer, ",");
+    strcatFloat(buffer, (float)(statistics.energy / 3600));
+    strcat(buffer, ",");
+    strcatFloat(buffer, (float)statistics.energyTime);
+
+    SCPI_ResultCharacters(context, buffer, strlen(buffer));
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_cmd_measureStatisticsReset(scpi_t *context) {
+    Channel *channel = param_channel(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    channel->resetStatistics();
+
+    return SCPI_RES_OK;
+}
+
 } // namespace scpi
 } // namespace psu
 } // namespace eez
\ No newline at end of file
@@ -27,6 +27,7 @@
 #include <eez/modules/psu/profile.h>
 #include <eez/modules/psu/scpi/psu.h>
 #include <eez/modules/psu/trigger.h>
+#include <eez/modules/psu/waveform.h>
 
 #include <eez/modules/psu/sd_card.h>
 
@@ -604,6 +605,33 @@ scpi_result_t scpi_cmd_mmemoryStoreList(scpi_t *context) {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+scpi_result_t scpi_cmd_mmemoryLoadFunction(scpi_t *context) {
+    Channel *channel = set_channel_from_command_number(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    if (!trigger::isIdle()) {
+        SCPI_ErrorPush(context, SCPI_ERROR_CANNOT_CHANGE_TRANSIENT_TRIGGER);
+        return SCPI_RES_ERR;
+    }
+
+    char filePath[MAX_PATH_LENGTH + 1];
+    if (!getFilePath(context, filePath, true)) {
+        return SCPI_RES_ERR;
+    }
+
+    int err;
+    if (!waveform::loadUserTable(channel->channelIndex, filePath, &err)) {
+        SCPI_ErrorPush(context, err);
+        return SCPI_RES_ERR;
+    }
+
+    return SCPI_RES_OK;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 scpi_result_t scpi_cmd_mmemoryLoadProfile(scpi_t *context) {
     char filePath[MAX_PATH_LENGTH + 1];
     if (!getFilePath(context, filePath, true)) {
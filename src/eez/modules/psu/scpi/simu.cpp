@@ -16,6 +16,8 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <stdio.h>
+
 #include <eez/modules/psu/psu.h>
 
 #include <eez/modules/psu/scpi/psu.h>
@@ -25,6 +27,10 @@
 #include <eez/modules/psu/channel_dispatcher.h>
 #include <eez/modules/psu/io_pins.h>
 
+#if OPTION_DISPLAY
+#include <eez/gui/gui.h>
+#endif
+
 // SIMULATOR SPECIFC CONFIG
 #define SIM_LOAD_MIN 0
 #define SIM_LOAD_DEF 1000.0f
@@ -330,6 +336,57 @@ scpi_result_t scpi_cmd_simulatorGui(scpi_t *context) {
     return SCPI_RES_ERR;
 }
 
+scpi_result_t scpi_cmd_simulatorGuiDataQ(scpi_t *context) {
+#if OPTION_DISPLAY
+    using namespace eez::gui;
+
+    // data function calls per frame since the last query
+    DataOperationStats stats;
+    getDataOperationStats(stats);
+    resetDataOperationStats();
+
+    uint32_t numCalls = 0;
+    uint32_t numSkipped = 0;
+    for (int i = 0; i < 64; i++) {
+        numCalls += stats.numCalls[i];
+        numSkipped += stats.numSkipped[i];
+    }
+
+    static const DataOperationEnum COLOR_OPERATIONS[] = {
+        DATA_OPERATION_GET_COLOR,
+        DATA_OPERATION_GET_BACKGROUND_COLOR,
+        DATA_OPERATION_GET_ACTIVE_COLOR,
+        DATA_OPERATION_GET_ACTIVE_BACKGROUND_COLOR
+    };
+    uint32_t numColorCalls = 0;
+    uint32_t numColorSkipped = 0;
+    for (unsigned i = 0; i < sizeof(COLOR_OPERATIONS) / sizeof(DataOperationEnum); i++) {
+        numColorCalls += stats.numCalls[COLOR_OPERATIONS[i]];
+        numColorSkipped += stats.numSkipped[COLOR_OPERATIONS[i]];
+    }
+
+    float numFrames = stats.numFrames > 0 ? 1.0f * stats.numFrames : 1.0f;
+
+    char text[256];
+    snprintf(text, sizeof(text),
+        "frames=%u, calls/frame=%.1f, skipped/frame=%.1f, "
+        "get=%.1f/%.1f, color=%.1f/%.1f, blinking=%.1f/%.1f, refresh=%.1f/%.1f, count=%.1f/%.1f",
+        (unsigned)stats.numFrames, numCalls / numFrames, numSkipped / numFrames,
+        stats.numCalls[DATA_OPERATION_GET] / numFrames, stats.numSkipped[DATA_OPERATION_GET] / numFrames,
+        numColorCalls / numFrames, numColorSkipped / numFrames,
+        stats.numCalls[DATA_OPERATION_IS_BLINKING] / numFrames, stats.numSkipped[DATA_OPERATION_IS_BLINKING] / numFrames,
+        stats.numCalls[DATA_OPERATION_GET_TEXT_REFRESH_RATE] / numFrames, stats.numSkipped[DATA_OPERATION_GET_TEXT_REFRESH_RATE] / numFrames,
+        stats.numCalls[DATA_OPERATION_COUNT] / numFrames, stats.numSkipped[DATA_OPERATION_COUNT] / numFrames);
+
+    SCPI_ResultText(context, text);
+
+    return SCPI_RES_OK;
+#else
+    SCPI_ErrorPush(context, SCPI_ERROR_EXECUTION_ERROR);
+    return SCPI_RES_ERR;
+#endif
+}
+
 scpi_result_t scpi_cmd_simulatorExit(scpi_t *context) {
     simulator::exit();
 
@@ -372,6 +429,61 @@ scpi_result_t scpi_cmd_simulatorPin2Q(scpi_t *context) {
     return SCPI_RES_OK;
 }
 
+static scpi_result_t injectEdges(scpi_t *context, int pin) {
+    uint32_t delays[io_pins::MAX_INJECTED_EDGES];
+    int numDelays = 0;
+
+    while (true) {
+        float delay;
+        if (!SCPI_ParamFloat(context, &delay, numDelays == 0)) {
+            if (SCPI_ParamErrorOccurred(context)) {
+                return SCPI_RES_ERR;
+            }
+            break;
+        }
+
+        if (numDelays == io_pins::MAX_INJECTED_EDGES) {
+            SCPI_ErrorPush(context, SCPI_ERROR_TOO_MUCH_DATA);
+            return SCPI_RES_ERR;
+        }
+
+        if (delay < 0 || delay > 60.0f) {
+            SCPI_ErrorPush(context, SCPI_ERROR_DATA_OUT_OF_RANGE);
+            return SCPI_RES_ERR;
+        }
+
+        delays[numDelays++] = (uint32_t)roundf(delay * 1000000.0f);
+    }
+
+    if (!io_pins::injectEdges(pin, delays, numDelays)) {
+        // previous script is still running
+        SCPI_ErrorPush(context, SCPI_ERROR_EXECUTION_ERROR);
+        return SCPI_RES_ERR;
+    }
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_cmd_simulatorPin1Edge(scpi_t *context) {
+    return injectEdges(context, 0);
+}
+
+scpi_result_t scpi_cmd_simulatorPin2Edge(scpi_t *context) {
+    return injectEdges(context, 1);
+}
+
+scpi_result_t scpi_cmd_simulatorTimeQ(scpi_t *context) {
+    // virtual time, real time and speed-up factor
+    float realTime = osKernelRealTime() / 1000000.0f;
+    float virtualTime = osKernelIsVirtualTime() ? osKernelVirtualTime() / 1000000.0f : realTime;
+
+    SCPI_ResultFloat(context, virtualTime);
+    SCPI_ResultFloat(context, realTime);
+    SCPI_ResultFloat(context, realTime > 0 ? virtualTime / realTime : 0.0f);
+
+    return SCPI_RES_OK;
+}
+
 } // namespace scpi
 } // namespace psu
 } // namespace eez
@@ -447,6 +559,11 @@ scpi_result_t scpi_cmd_simulatorGui(scpi_t *context) {
     return SCPI_RES_ERR;
 }
 
+scpi_result_t scpi_cmd_simulatorGuiDataQ(scpi_t *context) {
+    SCPI_ErrorPush(context, SCPI_ERROR_UNDEFINED_HEADER);
+    return SCPI_RES_ERR;
+}
+
 scpi_result_t scpi_cmd_simulatorExit(scpi_t *context) {
     SCPI_ErrorPush(context, SCPI_ERROR_UNDEFINED_HEADER);
     return SCPI_RES_ERR;
@@ -477,6 +594,21 @@ scpi_result_t scpi_cmd_simulatorPin2Q(scpi_t *context) {
     return SCPI_RES_ERR;
 }
 
+scpi_result_t scpi_cmd_simulatorPin1Edge(scpi_t *context) {
+    SCPI_ErrorPush(context, SCPI_ERROR_UNDEFINED_HEADER);
+    return SCPI_RES_ERR;
+}
+
+scpi_result_t scpi_cmd_simulatorPin2Edge(scpi_t *context) {
+    SCPI_ErrorPush(context, SCPI_ERROR_UNDEFINED_HEADER);
+    return SCPI_RES_ERR;
+}
+
+scpi_result_t scpi_cmd_simulatorTimeQ(scpi_t *context) {
+    SCPI_ErrorPush(context, SCPI_ERROR_UNDEFINED_HEADER);
+    return SCPI_RES_ERR;
+}
+
 } // namespace scpi
 } // namespace psu
 } // namespace eez
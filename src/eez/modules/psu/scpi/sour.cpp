@@ -24,6 +24,7 @@
 #include <eez/modules/psu/profile.h>
 #include <eez/modules/psu/scpi/psu.h>
 #include <eez/modules/psu/trigger.h>
+#include <eez/modules/psu/waveform.h>
 
 #define I_STATE 1
 #define P_STATE 2
@@ -800,6 +801,7 @@ static scpi_choice_def_t triggerModeChoice[] = {
     { "FIXed", TRIGGER_MODE_FIXED },
     { "LIST", TRIGGER_MODE_LIST },
     { "STEP", TRIGGER_MODE_STEP },
+    { "FUNCtion", TRIGGER_MODE_FUNCTION },
     SCPI_CHOICE_LIST_END /* termination of option list */
 };
 
@@ -1219,6 +1221,298 @@ scpi_result_t scpi_cmd_sourceVoltageRampDurationQ(scpi_t *context) {
     return get_source_value(context, *channel, UNIT_SECOND, channel->u.rampDuration, RAMP_DURATION_MIN_VALUE, RAMP_DURATION_MAX_VALUE, RAMP_DURATION_DEF_VALUE_U);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+
+static scpi_choice_def_t functionShapeChoice[] = {
+    { "SINusoid", waveform::SHAPE_SINE },
+    { "TRIangle", waveform::SHAPE_TRIANGLE },
+    { "SQUare", waveform::SHAPE_SQUARE },
+    { "RAMP", waveform::SHAPE_RAMP },
+    { "EXPonential", waveform::SHAPE_EXPONENTIAL },
+    { "USER", waveform::SHAPE_USER },
+    SCPI_CHOICE_LIST_END /* termination of option list */
+};
+
+static scpi_choice_def_t functionTypeChoice[] = {
+    { "VOLTage", waveform::TYPE_VOLTAGE },
+    { "CURRent", waveform::TYPE_CURRENT },
+    SCPI_CHOICE_LIST_END /* termination of option list */
+};
+
+static bool get_function_param(scpi_t *context, float &value, scpi_unit_t unit, float min, float max, float def) {
+    scpi_number_t param;
+    if (!SCPI_ParamNumber(context, scpi_special_numbers_def, &param, true)) {
+        return false;
+    }
+
+    if (param.special) {
+        if (param.content.tag == SCPI_NUM_MIN) {
+            value = min;
+        } else if (param.content.tag == SCPI_NUM_MAX) {
+            value = max;
+        } else if (param.content.tag == SCPI_NUM_DEF) {
+            value = def;
+        } else {
+            SCPI_ErrorPush(context, SCPI_ERROR_ILLEGAL_PARAMETER_VALUE);
+            return false;
+        }
+    } else {
+        if (param.unit != SCPI_UNIT_NONE && param.unit != unit) {
+            SCPI_ErrorPush(context, SCPI_ERROR_INVALID_SUFFIX);
+            return false;
+        }
+
+        value = (float)param.content.value;
+
+        if (value < min || value > max) {
+            SCPI_ErrorPush(context, SCPI_ERROR_DATA_OUT_OF_RANGE);
+            return false;
+        }
+    }
+
+    if (!trigger::isIdle()) {
+        SCPI_ErrorPush(context, SCPI_ERROR_CANNOT_CHANGE_TRANSIENT_TRIGGER);
+        return false;
+    }
+
+    return true;
+}
+
+static bool get_function_level_param(scpi_t *context, float &value, Channel &channel) {
+    if (waveform::getType(channel) == waveform::TYPE_VOLTAGE) {
+        return get_function_param(context, value, SCPI_UNIT_VOLT, 0, channel_dispatcher::getUMax(channel), 0);
+    }
+    return get_function_param(context, value, SCPI_UNIT_AMPER, 0, channel_dispatcher::getIMax(channel), 0);
+}
+
+scpi_result_t scpi_cmd_sourceFunctionShape(scpi_t *context) {
+    Channel *channel = set_channel_from_command_number(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    int32_t shape;
+    if (!SCPI_ParamChoice(context, functionShapeChoice, &shape, true)) {
+        return SCPI_RES_ERR;
+    }
+
+    if (!trigger::isIdle()) {
+        SCPI_ErrorPush(context, SCPI_ERROR_CANNOT_CHANGE_TRANSIENT_TRIGGER);
+        return SCPI_RES_ERR;
+    }
+
+    waveform::setShape(*channel, (waveform::Shape)shape);
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_cmd_sourceFunctionShapeQ(scpi_t *context) {
+    Channel *channel = set_channel_from_command_number(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    resultChoiceName(context, functionShapeChoice, waveform::getShape(*channel));
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_cmd_sourceFunctionType(scpi_t *context) {
+    Channel *channel = set_channel_from_command_number(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    int32_t type;
+    if (!SCPI_ParamChoice(context, functionTypeChoice, &type, true)) {
+        return SCPI_RES_ERR;
+    }
+
+    if (!trigger::isIdle()) {
+        SCPI_ErrorPush(context, SCPI_ERROR_CANNOT_CHANGE_TRANSIENT_TRIGGER);
+        return SCPI_RES_ERR;
+    }
+
+    waveform::setType(*channel, (waveform::Type)type);
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_cmd_sourceFunctionTypeQ(scpi_t *context) {
+    Channel *channel = set_channel_from_command_number(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    resultChoiceName(context, functionTypeChoice, waveform::getType(*channel));
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_cmd_sourceFunctionFrequency(scpi_t *context) {
+    Channel *channel = set_channel_from_command_number(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    float frequency;
+    if (!get_function_param(context, frequency, SCPI_UNIT_HERTZ, WAVEFORM_FREQUENCY_MIN, WAVEFORM_FREQUENCY_MAX, WAVEFORM_FREQUENCY_DEF)) {
+        return SCPI_RES_ERR;
+    }
+
+    waveform::setFrequency(*channel, frequency);
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_cmd_sourceFunctionFrequencyQ(scpi_t *context) {
+    Channel *channel = set_channel_from_command_number(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    SCPI_ResultFloat(context, waveform::getFrequency(*channel));
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_cmd_sourceFunctionAmplitude(scpi_t *context) {
+    Channel *channel = set_channel_from_command_number(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    float amplitude;
+    if (!get_function_level_param(context, amplitude, *channel)) {
+        return SCPI_RES_ERR;
+    }
+
+    waveform::setAmplitude(*channel, amplitude);
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_cmd_sourceFunctionAmplitudeQ(scpi_t *context) {
+    Channel *channel = set_channel_from_command_number(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    SCPI_ResultFloat(context, waveform::getAmplitude(*channel));
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_cmd_sourceFunctionOffset(scpi_t *context) {
+    Channel *channel = set_channel_from_command_number(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    float offset;
+    if (!get_function_level_param(context, offset, *channel)) {
+        return SCPI_RES_ERR;
+    }
+
+    waveform::setOffset(*channel, offset);
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_cmd_sourceFunctionOffsetQ(scpi_t *context) {
+    Channel *channel = set_channel_from_command_number(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    SCPI_ResultFloat(context, waveform::getOffset(*channel));
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_cmd_sourceFunctionPhase(scpi_t *context) {
+    Channel *channel = set_channel_from_command_number(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    float phase;
+    if (!get_function_param(context, phase, SCPI_UNIT_DEGREE, WAVEFORM_PHASE_MIN, WAVEFORM_PHASE_MAX, WAVEFORM_PHASE_MIN)) {
+        return SCPI_RES_ERR;
+    }
+
+    waveform::setPhase(*channel, phase);
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_cmd_sourceFunctionPhaseQ(scpi_t *context) {
+    Channel *channel = set_channel_from_command_number(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    SCPI_ResultFloat(context, waveform::getPhase(*channel));
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_cmd_sourceFunctionCount(scpi_t *context) {
+    Channel *channel = set_channel_from_command_number(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    scpi_number_t param;
+    if (!SCPI_ParamNumber(context, scpi_special_numbers_def, &param, true)) {
+        return SCPI_RES_ERR;
+    }
+
+    uint16_t count;
+
+    if (param.special) {
+        if (param.content.tag == SCPI_NUM_INF) {
+            count = 0;
+        } else {
+            SCPI_ErrorPush(context, SCPI_ERROR_ILLEGAL_PARAMETER_VALUE);
+            return SCPI_RES_ERR;
+        }
+    } else {
+        if (param.unit != SCPI_UNIT_NONE) {
+            SCPI_ErrorPush(context, SCPI_ERROR_INVALID_SUFFIX);
+            return SCPI_RES_ERR;
+        }
+
+        int value = (int)param.content.value;
+        if (value < 0 || value > MAX_WAVEFORM_COUNT) {
+            SCPI_ErrorPush(context, SCPI_ERROR_DATA_OUT_OF_RANGE);
+            return SCPI_RES_ERR;
+        }
+
+        count = value;
+    }
+
+    if (!trigger::isIdle()) {
+        SCPI_ErrorPush(context, SCPI_ERROR_CANNOT_CHANGE_TRANSIENT_TRIGGER);
+        return SCPI_RES_ERR;
+    }
+
+    waveform::setCount(*channel, count);
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_cmd_sourceFunctionCountQ(scpi_t *context) {
+    Channel *channel = set_channel_from_command_number(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    SCPI_ResultInt(context, waveform::getCount(*channel));
+
+    return SCPI_RES_OK;
+}
+
 } // namespace scpi
 } // namespace psu
 } // namespace eez
@@ -28,6 +28,7 @@
 #if OPTION_ETHERNET
 #include <eez/modules/psu/ethernet.h>
 #include <eez/modules/psu/ntp.h>
+#include <eez/modules/psu/stream.h>
 #include <eez/mqtt.h>
 #endif
 #include <eez/modules/psu/channel_dispatcher.h>
@@ -787,6 +788,7 @@ static scpi_choice_def_t commInterfaceChoice[] = {
     { "ETHernet", 2 }, 
     { "NTP", 3 }, 
     { "MQTT", 4 }, 
+    { "RDISplay", 5 }, 
     SCPI_CHOICE_LIST_END
 };
 
@@ -814,6 +816,13 @@ scpi_result_t scpi_cmd_systemCommunicateEnable(scpi_t *context) {
         persist_conf::enableNtp(enable);
     } else if (commInterface == 4) {
         persist_conf::enableMqtt(enable);
+    } else if (commInterface == 5) {
+#if OPTION_ETHERNET
+        persist_conf::enableRemoteDisplay(enable);
+#else
+        SCPI_ErrorPush(context, SCPI_ERROR_HARDWARE_MISSING);
+        return SCPI_RES_ERR;
+#endif
     }
 
     return SCPI_RES_OK;
@@ -836,6 +845,8 @@ scpi_result_t scpi_cmd_systemCommunicateEnableQ(scpi_t *context) {
 #endif
     } else if (commInterface == 3) {
         SCPI_ResultBool(context, persist_conf::isNtpEnabled());
+    } else if (commInterface == 5) {
+        SCPI_ResultBool(context, persist_conf::isRemoteDisplayEnabled());
     }
 
     return SCPI_RES_OK;
@@ -1243,6 +1254,95 @@ scpi_result_t scpi_cmd_systemCommunicateNtpQ(scpi_t *context) {
 #endif
 }
 
+#if OPTION_ETHERNET
+static scpi_choice_def_t streamQuantityChoice[] = {
+    { "VOLTage", stream::QUANTITY_VOLTAGE },
+    { "CURRent", stream::QUANTITY_CURRENT },
+    { "BOTH", stream::QUANTITY_VOLTAGE | stream::QUANTITY_CURRENT },
+    SCPI_CHOICE_LIST_END /* termination of option list */
+};
+#endif
+
+scpi_result_t scpi_cmd_systemCommunicateStream(scpi_t *context) {
+#if OPTION_ETHERNET
+    uint32_t channels = param_channels(context, TRUE);
+    if (!channels) {
+        return SCPI_RES_ERR;
+    }
+
+    int32_t quantities;
+    if (!SCPI_ParamChoice(context, streamQuantityChoice, &quantities, TRUE)) {
+        return SCPI_RES_ERR;
+    }
+
+    int32_t decimation;
+    if (!SCPI_ParamInt(context, &decimation, FALSE)) {
+        if (SCPI_ParamErrorOccurred(context)) {
+            return SCPI_RES_ERR;
+        }
+        decimation = 1;
+    }
+
+    if (decimation < 1 || decimation > UINT16_MAX) {
+        SCPI_ErrorPush(context, SCPI_ERROR_DATA_OUT_OF_RANGE);
+        return SCPI_RES_ERR;
+    }
+
+    stream::subscribe(channels & ((1 << CH_NUM) - 1), quantities, decimation);
+
+    return SCPI_RES_OK;
+#else
+    SCPI_ErrorPush(context, SCPI_ERROR_HARDWARE_MISSING);
+    return SCPI_RES_ERR;
+#endif
+}
+
+scpi_result_t scpi_cmd_systemCommunicateStreamQ(scpi_t *context) {
+#if OPTION_ETHERNET
+    uint8_t channels;
+    uint8_t quantities;
+    uint16_t decimation;
+    stream::getSubscription(channels, quantities, decimation);
+
+    char text[32] = "(@";
+    for (int channelIndex = 0; channelIndex < CH_MAX; channelIndex++) {
+        if (channels & (1 << channelIndex)) {
+            sprintf(text + strlen(text), strlen(text) > 2 ? ",%d" : "%d", channelIndex + 1);
+        }
+    }
+    strcat(text, ")");
+    SCPI_ResultText(context, text);
+
+    if (quantities != 0) {
+        resultChoiceName(context, streamQuantityChoice, quantities);
+    } else {
+        SCPI_ResultText(context, "");
+    }
+
+    SCPI_ResultInt(context, decimation);
+
+    return SCPI_RES_OK;
+#else
+    SCPI_ErrorPush(context, SCPI_ERROR_HARDWARE_MISSING);
+    return SCPI_RES_ERR;
+#endif
+}
+
+scpi_result_t scpi_cmd_systemCommunicateStreamStop(scpi_t *context) {
+#if OPTION_ETHERNET
+    uint8_t channels;
+    uint8_t quantities;
+    uint16_t decimation;
+    stream::getSubscription(channels, quantities, decimation);
+    stream::subscribe(channels, quantities, 0);
+
+    return SCPI_RES_OK;
+#else
+    SCPI_ErrorPush(context, SCPI_ERROR_HARDWARE_MISSING);
+    return SCPI_RES_ERR;
+#endif
+}
+
 scpi_result_t scpi_cmd_systemInhibitQ(scpi_t *context) {
     SCPI_ResultBool(context, io_pins::isInhibited());
     return SCPI_RES_OK;
@@ -718,9 +718,8 @@ bool BufferedFileWrite::write(const uint8_t *buf, size_t size) {
 }
 
 bool BufferedFileWrite::print(float value, int numDecimalDigits) {
-    char buf[32];
-    sprintf(buf, "%.*f", numDecimalDigits, value);
-    int len = strlen(buf);
+    char buf[64];
+    int len = floatToStr(buf, value, numDecimalDigits) - buf;
     return write((const uint8_t *)buf, len);
 }
 
@@ -0,0 +1,397 @@
+/*
+ * EEZ Modular Firmware
+ * Copyright (C) 2020-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if OPTION_ETHERNET
+
+#include <string.h>
+
+#include <atomic>
+
+#include <eez/system.h>
+#include <eez/debug.h>
+#include <eez/memory.h>
+#include <eez/modules/mcu/tcp_server.h>
+#include <eez/modules/psu/psu.h>
+#include <eez/modules/psu/stream.h>
+
+#define CONF_SEND_PERIOD_MS 10
+#define CONF_ACCEPT_PERIOD_MS 100
+#define CONF_SEND_BUFFER_SIZE 4096
+
+namespace eez {
+namespace psu {
+namespace stream {
+
+// must be power of 2
+static const uint32_t NUM_SAMPLES = 4096;
+
+static const int SUBSCRIBE_SIZE = 5;
+static const int DATA_HEADER_SIZE = 8;
+static const int DATA_SAMPLE_SIZE = 14;
+static const uint32_t MAX_SAMPLES_PER_MESSAGE = (CONF_SEND_BUFFER_SIZE - DATA_HEADER_SIZE) / DATA_SAMPLE_SIZE;
+
+struct Sample {
+    uint64_t time;
+    uint8_t channelIndex;
+    uint8_t quantity;
+    float value;
+};
+
+// lives in SDRAM (see STREAM_MEMORY)
+struct StreamMemory {
+    Sample samples[NUM_SAMPLES];
+    uint8_t sendBuffer[CONF_SEND_BUFFER_SIZE];
+};
+
+static_assert(sizeof(StreamMemory) <= STREAM_MEMORY_SIZE, "STREAM_MEMORY_SIZE is too small");
+
+static StreamMemory &g_memory = *(StreamMemory *)STREAM_MEMORY;
+
+static void mainLoop(const void *);
+
+#if defined(EEZ_PLATFORM_STM32)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#endif
+
+osThreadDef(g_streamTask, mainLoop, osPriorityBelowNormal, 0, 1024);
+
+#if defined(EEZ_PLATFORM_STM32)
+#pragma GCC diagnostic pop
+#endif
+
+static bool g_threadStarted;
+static volatile bool g_enabled;
+static volatile uint16_t g_port;
+
+static bool g_listening;
+static volatile bool g_clientConnected;
+
+static mcu::TcpServer g_server;
+
+static uint8_t g_inputBuffer[64];
+static int g_inputLength;
+
+static int g_sendLength;
+
+// channel mask (bits 0-7), quantities (bits 8-15) and decimation (bits 16-31),
+// in one word so PSU thread always sees consistent subscription
+static volatile uint32_t g_subscription;
+
+// samples queue, head is changed only by the PSU thread and tail only by the stream thread,
+// head is published with release so the sample it covers is visible before the new head
+static std::atomic<uint32_t> g_head;
+static std::atomic<uint32_t> g_tail;
+static volatile uint32_t g_numDroppedSamples;
+static uint32_t g_numReportedDroppedSamples;
+
+// decimation state, used only by the PSU thread
+static uint32_t g_decimationSubscription;
+static float g_sum[CH_MAX][2];
+static uint16_t g_count[CH_MAX][2];
+
+static struct {
+    uint32_t connectTime;
+    uint32_t samples;
+    uint32_t droppedSamples;
+    uint32_t bytes;
+} g_stats;
+
+////////////////////////////////////////////////////////////////////////////////
+
+static void put8(uint8_t value) {
+    g_memory.sendBuffer[g_sendLength++] = value;
+}
+
+static void put16(uint16_t value) {
+    put8(value & 0xFF);
+    put8(value >> 8);
+}
+
+static void put32(uint32_t value) {
+    put16(value & 0xFFFF);
+    put16(value >> 16);
+}
+
+static void put64(uint64_t value) {
+    put32(value & 0xFFFFFFFF);
+    put32(value >> 32);
+}
+
+static void putFloat(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    put32(bits);
+}
+
+static bool flush() {
+    if (g_sendLength == 0) {
+        return true;
+    }
+
+    bool result = g_server.send(g_memory.sendBuffer, g_sendLength);
+    g_stats.bytes += g_sendLength;
+    g_sendLength = 0;
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static bool sendSamples() {
+    uint32_t head = g_head.load(std::memory_order_acquire);
+    uint32_t tail = g_tail.load(std::memory_order_relaxed);
+
+    while (tail != head) {
+        uint32_t numSamples = head - tail;
+        if (numSamples > MAX_SAMPLES_PER_MESSAGE) {
+            numSamples = MAX_SAMPLES_PER_MESSAGE;
+        }
+
+        uint32_t numDroppedSamples = g_numDroppedSamples;
+
+        put8('D');
+        put8(0);
+        put16(numSamples);
+        put32(numDroppedSamples - g_numReportedDroppedSamples);
+
+        g_stats.droppedSamples += numDroppedSamples - g_numReportedDroppedSamples;
+        g_numReportedDroppedSamples = numDroppedSamples;
+
+        for (uint32_t i = 0; i < numSamples; i++) {
+            Sample &sample = g_memory.samples[(tail + i) % NUM_SAMPLES];
+            put64(sample.time);
+            put8(sample.channelIndex);
+            put8(sample.quantity);
+            putFloat(sample.value);
+        }
+
+        // samples are copied into the send buffer, PSU thread can reuse them
+        tail += numSamples;
+        g_tail.store(tail, std::memory_order_release);
+
+        g_stats.samples += numSamples;
+
+        if (!flush()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool processInput() {
+    int n = g_server.receive(g_inputBuffer + g_inputLength, sizeof(g_inputBuffer) - g_inputLength);
+    if (n < 0) {
+        return false;
+    }
+    g_inputLength += n;
+
+    int i = 0;
+    while (i < g_inputLength) {
+        uint8_t command = g_inputBuffer[i];
+        if (command != 'S') {
+            DebugTrace("STREAM: unknown command %d\n", (int)command);
+            return false;
+        }
+
+        if (i + SUBSCRIBE_SIZE > g_inputLength) {
+            break;
+        }
+
+        const uint8_t *params = g_inputBuffer + i + 1;
+        subscribe(params[0], params[1], params[2] | (params[3] << 8));
+
+        i += SUBSCRIBE_SIZE;
+    }
+
+    g_inputLength -= i;
+    memmove(g_inputBuffer, g_inputBuffer + i, g_inputLength);
+
+    return true;
+}
+
+static bool onClientConnected() {
+    memset(&g_stats, 0, sizeof(g_stats));
+    g_stats.connectTime = millis();
+
+    g_inputLength = 0;
+    g_sendLength = 0;
+
+    // skip whatever is left from the previous client
+    g_tail.store(g_head.load(std::memory_order_acquire), std::memory_order_release);
+    g_numReportedDroppedSamples = g_numDroppedSamples;
+
+    g_clientConnected = true;
+
+    uint8_t channels;
+    uint8_t quantities;
+    uint16_t decimation;
+    getSubscription(channels, quantities, decimation);
+
+    put8('H');
+    put8(PROTOCOL_VERSION);
+    put8(CH_NUM);
+    put8(0);
+    put8(channels);
+    put8(quantities);
+    put16(decimation);
+
+    return flush();
+}
+
+static void disconnectClient() {
+    g_clientConnected = false;
+    g_server.closeClient();
+
+    DebugTrace("STREAM: client disconnected after %d s, %d samples, %d dropped, %d KB sent\n",
+        (int)((millis() - g_stats.connectTime) / 1000), (int)g_stats.samples, (int)g_stats.droppedSamples, (int)(g_stats.bytes / 1024));
+}
+
+static void mainLoop(const void *) {
+    while (1) {
+        if (!g_enabled) {
+            if (g_clientConnected) {
+                disconnectClient();
+            }
+            if (g_listening) {
+                g_server.closeListen();
+                g_listening = false;
+            }
+            osDelay(CONF_ACCEPT_PERIOD_MS);
+            continue;
+        }
+
+        if (!g_listening) {
+            g_listening = g_server.listen(g_port);
+            if (!g_listening) {
+                DebugTrace("STREAM: can't listen on port %d\n", (int)g_port);
+                g_enabled = false;
+                continue;
+            }
+        }
+
+        if (!g_clientConnected) {
+            if (!g_server.accept()) {
+                osDelay(CONF_ACCEPT_PERIOD_MS);
+                continue;
+            }
+
+            if (!onClientConnected()) {
+                disconnectClient();
+                continue;
+            }
+        } else {
+            // only one client at a time
+            g_server.rejectPendingClient();
+        }
+
+        if (!processInput() || !sendSamples()) {
+            disconnectClient();
+            continue;
+        }
+
+        osDelay(CONF_SEND_PERIOD_MS);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void beginServer(uint16_t port) {
+    g_port = port;
+    g_enabled = true;
+
+    if (!g_threadStarted) {
+        g_threadStarted = true;
+        osThreadCreate(osThread(g_streamTask), nullptr);
+    }
+}
+
+void endServer() {
+    g_enabled = false;
+}
+
+bool isClientConnected() {
+    return g_clientConnected;
+}
+
+void subscribe(uint8_t channels, uint8_t quantities, uint16_t decimation) {
+    g_subscription = channels | (quantities << 8) | ((uint32_t)decimation << 16);
+}
+
+void getSubscription(uint8_t &channels, uint8_t &quantities, uint16_t &decimation) {
+    uint32_t subscription = g_subscription;
+    channels = subscription & 0xFF;
+    quantities = (subscription >> 8) & 0xFF;
+    decimation = subscription >> 16;
+}
+
+void addSample(int channelIndex, Quantity quantity, float value) {
+    uint32_t subscription = g_subscription;
+
+    if (!g_clientConnected || (subscription >> 16) == 0) {
+        // start decimation from scratch when streaming is started again
+        g_decimationSubscription = 0;
+        return;
+    }
+
+    if (!(subscription & (1 << channelIndex)) || !((subscription >> 8) & quantity)) {
+        return;
+    }
+
+    if (subscription != g_decimationSubscription) {
+        g_decimationSubscription = subscription;
+        memset(g_count, 0, sizeof(g_count));
+    }
+
+    int quantityIndex = quantity == QUANTITY_VOLTAGE ? 0 : 1;
+
+    uint16_t decimation = subscription >> 16;
+    if (decimation > 1) {
+        if (g_count[channelIndex][quantityIndex] == 0) {
+            g_sum[channelIndex][quantityIndex] = 0;
+        }
+
+        g_sum[channelIndex][quantityIndex] += value;
+        if (++g_count[channelIndex][quantityIndex] < decimation) {
+            return;
+        }
+
+        value = g_sum[channelIndex][quantityIndex] / decimation;
+        g_count[channelIndex][quantityIndex] = 0;
+    }
+
+    uint32_t head = g_head.load(std::memory_order_relaxed);
+    if (head - g_tail.load(std::memory_order_acquire) >= NUM_SAMPLES) {
+        g_numDroppedSamples = g_numDroppedSamples + 1;
+        return;
+    }
+
+    Sample &sample = g_memory.samples[head % NUM_SAMPLES];
+    sample.time = micros64();
+    sample.channelIndex = channelIndex;
+    sample.quantity = quantity;
+    sample.value = value;
+
+    g_head.store(head + 1, std::memory_order_release);
+}
+
+} // namespace stream
+} // namespace psu
+} // namespace eez
+
+#endif
@@ -0,0 +1,70 @@
+/*
+ * EEZ Modular Firmware
+ * Copyright (C) 2020-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/// Measurement stream pushes the monitored voltage and current samples, as they
+/// are received from the ADC in the PSU thread, to a single TCP client
+/// (STREAM_TCP_PORT). Client selects channels, quantities and decimation with
+/// SYSTem:COMMunicate:STReam or with the subscribe message below. With decimation
+/// N every sent sample is the mean of N consecutive ADC samples.
+///
+/// All values are little endian.
+///
+/// Server to client:
+///   hello:      'H', version (1), number of channels (1), 0 (1),
+///               channel mask (1), quantities (1), decimation (2)
+///   data:       'D', 0 (1), number of samples (2), dropped samples (4),
+///               followed by the samples:
+///                 time (8), channel index (1), quantity (1), value (4, float)
+///               Time is in microseconds since the power up.
+///               Dropped samples is the number of samples lost since the previous
+///               data message, because the client didn't keep up.
+///
+/// Client to server:
+///   subscribe:  'S', channel mask (1), quantities (1), decimation (2)
+///               Decimation 0 stops the stream.
+
+namespace eez {
+namespace psu {
+namespace stream {
+
+static const uint8_t PROTOCOL_VERSION = 2;
+
+enum Quantity {
+    QUANTITY_VOLTAGE = 1,
+    QUANTITY_CURRENT = 2
+};
+
+void beginServer(uint16_t port);
+void endServer();
+
+bool isClientConnected();
+
+/// Quantities is the combination of Quantity flags.
+void subscribe(uint8_t channels, uint8_t quantities, uint16_t decimation);
+void getSubscription(uint8_t &channels, uint8_t &quantities, uint16_t &decimation);
+
+/// Called from the PSU thread for every calibrated ADC sample.
+void addSample(int channelIndex, Quantity quantity, float value);
+
+} // namespace stream
+} // namespace psu
+} // namespace eez
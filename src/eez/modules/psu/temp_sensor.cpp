@@ -25,9 +25,10 @@
 #if defined(EEZ_PLATFORM_STM32)
 #include <eez/drivers/tmp1075.h>
 #include <eez/drivers/tc77.h>
-#include <eez/modules/dcm220/channel.h>
 #endif
 
+#include <eez/modules/dcm220/channel.h>
+
 #if OPTION_AUX_TEMP_SENSOR
 #include <eez/modules/aux_ps/fan.h>
 #endif
@@ -83,11 +84,6 @@ float TempSensor::doRead() {
         return NAN;
     }
 
-#if defined(EEZ_PLATFORM_SIMULATOR)
-    return simulator::getTemperature(type);
-#endif
-
-#if defined(EEZ_PLATFORM_STM32)
 #if OPTION_AUX_TEMP_SENSOR
     if (type == AUX) {
         return aux_ps::fan::readTemperature();
@@ -99,6 +95,11 @@ float TempSensor::doRead() {
 		int slotIndex = Channel::get(channelIndex).slotIndex;
 		auto &slot = g_slots[slotIndex];
 
+		if (slot.moduleInfo->moduleType == MODULE_TYPE_DCM220 || slot.moduleInfo->moduleType == MODULE_TYPE_DCM224) {
+			return dcm220::readTemperature(channelIndex);
+		}
+
+#if defined(EEZ_PLATFORM_STM32)
 		if ((slot.moduleInfo->moduleType == MODULE_TYPE_DCP405 && slot.moduleRevision >= MODULE_REVISION_DCP405_R1B1) || slot.moduleInfo->moduleType == MODULE_TYPE_DCP405B) {
 			return drivers::tc77::readTemperature(slotIndex);
 		}
@@ -106,11 +107,11 @@ float TempSensor::doRead() {
 		if (slot.moduleInfo->moduleType == MODULE_TYPE_DCP405 || slot.moduleInfo->moduleType == MODULE_TYPE_DCP505) {
 			return drivers::tmp1075::readTemperature(slotIndex);
 		}
-
-		if (slot.moduleInfo->moduleType == MODULE_TYPE_DCM220 || slot.moduleInfo->moduleType == MODULE_TYPE_DCM224) {
-			return dcm220::readTemperature(channelIndex);
-		}
+#endif
 	}
+
+#if defined(EEZ_PLATFORM_SIMULATOR)
+    return simulator::getTemperature(type);
 #endif
 
     return NAN;
@@ -138,7 +139,8 @@ bool TempSensor::test() {
         generateError(scpi_error);
     } else {
         if (channel) {
-            channel->unlimitMaxCurrent();
+            // thermal derating limit is managed by the thermal model
+            channel->unlimitMaxCurrent(MAX_CURRENT_LIMIT_CAUSE_TEMPERATURE);
         }
     }
 
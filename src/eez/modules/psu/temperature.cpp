@@ -28,12 +28,17 @@
 #include <eez/modules/psu/ethernet.h>
 #endif
 
+#include <eez/modules/psu/calibration.h>
 #include <eez/modules/psu/channel_dispatcher.h>
 #include <eez/modules/psu/event_queue.h>
 #include <eez/modules/psu/persist_conf.h>
 #include <eez/modules/psu/temperature.h>
 #include <eez/sound.h>
 
+#if OPTION_FAN
+#include <eez/modules/aux_ps/fan.h>
+#endif
+
 namespace eez {
 namespace psu {
 namespace temperature {
@@ -47,6 +52,109 @@ TempSensorTemperature sensors[temp_sensor::NUM_TEMP_SENSORS] = { TEMP_SENSORS };
 static uint32_t g_lastMeasuredTick;
 static uint32_t g_maxTempCheckStartTick;
 static float g_lastMaxChannelTemperature;
+static float g_lastMaxPredictedChannelTemperature;
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// First order model of the channel heatsink, heated by the output power and
+/// cooled by the fan. Channel temperature sensor is modeled as a slower follower
+/// of the heatsink and the difference between the modeled and the measured
+/// sensor temperature is used to correct the model.
+struct ThermalModel {
+    bool valid;
+    float heatsink;
+    float sensor;
+    float ambient;
+
+    // heatsink is too hot, max. current is limited with MAX_CURRENT_LIMIT_CAUSE_THERMAL
+    // unless it is already limited for another cause
+    bool derated;
+
+    void update(Channel &channel, float measured, float dt);
+    void updateDerating(Channel &channel, TempSensorTemperature &sensorTemperature);
+};
+
+static ThermalModel g_thermalModels[CH_MAX];
+
+static float getChannelPower(Channel &channel) {
+    if (!channel.isOutputEnabled()) {
+        return 0;
+    }
+    float power = channel.u.mon_last * channel.i.mon_last;
+    return power > 0 ? power : 0;
+}
+
+static float getHeatsinkThermalResistance() {
+#if OPTION_FAN
+    if (aux_ps::fan::g_testResult == TEST_OK) {
+        return THERMAL_MODEL_RTH / (1.0f + THERMAL_MODEL_FAN_COOLING * aux_ps::fan::g_rpm / FAN_NOMINAL_RPM);
+    }
+#endif
+    return THERMAL_MODEL_RTH;
+}
+
+void ThermalModel::update(Channel &channel, float measured, float dt) {
+    float power = getChannelPower(channel);
+    float rth = getHeatsinkThermalResistance();
+
+    if (!valid) {
+        // assume steady state
+        heatsink = measured;
+        sensor = measured;
+        ambient = measured - rth * power;
+        valid = true;
+        return;
+    }
+
+    heatsink += (ambient + rth * power - heatsink) * dt / THERMAL_MODEL_HEATSINK_TAU;
+    sensor += (heatsink - sensor) * dt / THERMAL_MODEL_SENSOR_TAU;
+
+    float error = measured - sensor;
+    heatsink += THERMAL_MODEL_SENSOR_GAIN * error;
+    sensor += THERMAL_MODEL_SENSOR_GAIN * error;
+    ambient += THERMAL_MODEL_AMBIENT_GAIN * error;
+}
+
+void ThermalModel::updateDerating(Channel &channel, TempSensorTemperature &sensorTemperature) {
+#if CONF_THERMAL_DERATING
+    if (!valid) {
+        // faulty sensor already limits max. current (MAX_CURRENT_LIMIT_CAUSE_TEMPERATURE)
+        derated = false;
+        channel.unlimitMaxCurrent(MAX_CURRENT_LIMIT_CAUSE_THERMAL);
+        return;
+    }
+
+    float maxTemperature = FAN_MAX_TEMP;
+    if (sensorTemperature.prot_conf.state && sensorTemperature.prot_conf.level < maxTemperature) {
+        maxTemperature = sensorTemperature.prot_conf.level;
+    }
+
+    float deratingStart = maxTemperature - THERMAL_DERATING_BAND;
+
+    if (!derated) {
+        if (heatsink > deratingStart && !calibration::isEnabled()) {
+            derated = true;
+            event_queue::pushEvent(event_queue::EVENT_WARNING_CH1_CURRENT_DERATED + channel.channelIndex);
+        }
+    } else {
+        if (heatsink < deratingStart - THERMAL_DERATING_BAND) {
+            derated = false;
+        }
+    }
+
+    if (derated) {
+        // other cause (fan or faulty sensor) is not overwritten, thermal limit is
+        // set on the first tick after it is cleared
+        if (!channel.isMaxCurrentLimited()) {
+            channel.limitMaxCurrent(MAX_CURRENT_LIMIT_CAUSE_THERMAL);
+        }
+    } else {
+        channel.unlimitMaxCurrent(MAX_CURRENT_LIMIT_CAUSE_THERMAL);
+    }
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
 
 void init() {
     for (int i = 0; i < temp_sensor::NUM_TEMP_SENSORS; ++i) {
@@ -103,6 +211,31 @@ void tick(uint32_t tickCount) {
         }
 
         g_lastMaxChannelTemperature = maxChannelTemperature;
+
+        // update thermal models
+        float maxPredictedChannelTemperature = FLT_MIN;
+
+        for (int i = 0; i < temp_sensor::NUM_TEMP_SENSORS; ++i) {
+            temp_sensor::TempSensor &sensor = temp_sensor::sensors[i];
+            Channel *channel = sensor.getChannel();
+            if (channel) {
+                temperature::TempSensorTemperature &sensorTemperature = temperature::sensors[i];
+                ThermalModel &thermalModel = g_thermalModels[channel->channelIndex];
+
+                if (sensor.isInstalled() && sensor.g_testResult == TEST_OK && !isNaN(sensorTemperature.temperature)) {
+                    thermalModel.update(*channel, sensorTemperature.temperature, TEMP_SENSOR_READ_EVERY_MS / 1000.0f);
+                    if (thermalModel.heatsink > maxPredictedChannelTemperature) {
+                        maxPredictedChannelTemperature = thermalModel.heatsink;
+                    }
+                } else {
+                    thermalModel.valid = false;
+                }
+
+                thermalModel.updateDerating(*channel, sensorTemperature);
+            }
+        }
+
+        g_lastMaxPredictedChannelTemperature = maxPredictedChannelTemperature;
     }
 }
 
@@ -152,6 +285,22 @@ float getMaxChannelTemperature() {
     return g_lastMaxChannelTemperature;
 }
 
+float getChannelPredictedTemperature(Channel *channel) {
+    ThermalModel &thermalModel = g_thermalModels[channel->channelIndex];
+    if (thermalModel.valid) {
+        return thermalModel.heatsink;
+    }
+    return sensors[temp_sensor::CH1 + channel->channelIndex].temperature;
+}
+
+float getMaxPredictedChannelTemperature() {
+    return g_lastMaxPredictedChannelTemperature;
+}
+
+bool isChannelCurrentDerated(Channel *channel) {
+    return g_thermalModels[channel->channelIndex].derated;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 TempSensorTemperature::TempSensorTemperature(int sensorIndex_)
@@ -51,6 +51,15 @@ void disableChannelProtection(Channel *channel);
 
 float getMaxChannelTemperature();
 
+/// Channel heatsink temperature estimated from the output power. Output power
+/// change shows here before it reaches the channel temperature sensor.
+float getChannelPredictedTemperature(Channel *channel);
+float getMaxPredictedChannelTemperature();
+
+/// True if channel max. current is limited because the estimated heatsink temperature
+/// is close to the OTP level, see CONF_THERMAL_DERATING.
+bool isChannelCurrentDerated(Channel *channel);
+
 class TempSensorTemperature {
 public:
 	ProtectionConfiguration prot_conf;
@@ -24,6 +24,7 @@
 #include <eez/modules/psu/persist_conf.h>
 #include <eez/modules/psu/profile.h>
 #include <eez/modules/psu/ramp.h>
+#include <eez/modules/psu/waveform.h>
 #include <eez/modules/psu/trigger.h>
 #include <eez/scpi/regs.h>
 #include <eez/system.h>
@@ -36,7 +37,7 @@ namespace trigger {
 
 enum State { STATE_IDLE, STATE_INITIATED, STATE_TRIGGERED, STATE_EXECUTING };
 static State g_state;
-static uint32_t g_triggeredTime;
+static uint64_t g_triggeredTime; // in microseconds
 
 bool g_triggerInProgress[CH_MAX];
 
@@ -90,13 +91,13 @@ Source getSource() {
     return (Source)persist_conf::devConf.triggerSource;
 }
 
-void check(uint32_t currentTime) {
-    if (currentTime - g_triggeredTime > persist_conf::devConf.triggerDelay * 1000L) {
+void check(uint64_t currentTime) {
+    if (currentTime - g_triggeredTime > (uint64_t)(persist_conf::devConf.triggerDelay * 1000000L)) {
         startImmediately();
     }
 }
 
-int generateTrigger(Source source, bool checkImmediatelly) {
+static int doGenerateTrigger(Source source, uint64_t triggeredTime, bool checkImmediatelly) {
     bool seqTriggered = persist_conf::devConf.triggerSource == source && g_state == STATE_INITIATED;
 
     bool dlogTriggered = dlog_record::g_parameters.triggerSource == source && dlog_record::isInitiated();
@@ -112,16 +113,27 @@ int generateTrigger(Source source, bool checkImmediatelly) {
     if (seqTriggered) {
         setState(STATE_TRIGGERED);
 
-        g_triggeredTime = micros() / 1000;
+        g_triggeredTime = triggeredTime;
 
         if (checkImmediatelly) {
-            check(g_triggeredTime);
+            check(micros64());
         }
     }
 
+    // trigger delay and DLOG start are handled in PSU thread tick
+    wakeUpPsuThread();
+
     return SCPI_RES_OK;
 }
 
+int generateTrigger(Source source, bool checkImmediatelly) {
+    return doGenerateTrigger(source, micros64(), checkImmediatelly);
+}
+
+int generateTriggerAt(Source source, uint64_t triggeredTime) {
+    return doGenerateTrigger(source, triggeredTime, true);
+}
+
 bool isTriggerFinishedOnAllChannels() {
     for (int i = 0; i < CH_NUM; ++i) {
         if (g_triggerInProgress[i]) {
@@ -236,6 +248,11 @@ int checkTrigger() {
                 if (err) {
                     return err;
                 }
+            } else if (channel.getVoltageTriggerMode() == TRIGGER_MODE_FUNCTION) {
+                int err = waveform::checkLimits(i);
+                if (err) {
+                    return err;
+                }
             } else {
                 if (channel.isVoltageLimitExceeded(channel.u.triggerLevel)) {
                     g_errorChannelIndex = channel.channelIndex;
@@ -281,7 +298,7 @@ int startImmediately() {
     io_pins::onTrigger();
 
     if (osThreadGetId() != g_psuTaskHandle) {
-        osMessagePut(g_psuMessageQueueId, PSU_QUEUE_MESSAGE(PSU_QUEUE_TRIGGER_START_IMMEDIATELY, 0), 0);
+        sendMessageToPsu(PSU_QUEUE_TRIGGER_START_IMMEDIATELY, 0, 0);
     } else {
         startImmediatelyInPsuThread();
     }
@@ -319,6 +336,10 @@ void startImmediatelyInPsuThread() {
         } else if (channel.getVoltageTriggerMode() == TRIGGER_MODE_STEP) {
             ramp::executionStart(channel);
 
+            channel_dispatcher::outputEnableOnNextSync(channel, channel_dispatcher::getTriggerOutputState(channel));
+        } else if (channel.getVoltageTriggerMode() == TRIGGER_MODE_FUNCTION) {
+            waveform::executionStart(channel);
+
             channel_dispatcher::outputEnableOnNextSync(channel, channel_dispatcher::getTriggerOutputState(channel));
         } else {
             setTriggerFinished(channel);
@@ -369,15 +390,16 @@ bool isTriggered() {
 }
 
 bool isActive() {
-    return list::isActive() || ramp::isActive();
+    return list::isActive() || ramp::isActive() || waveform::isActive();
 }
 
 void abort() {
     if (osThreadGetId() != g_psuTaskHandle) {
-        osMessagePut(g_psuMessageQueueId, PSU_QUEUE_MESSAGE(PSU_QUEUE_TRIGGER_ABORT, 0), 0);
+        sendMessageToPsu(PSU_QUEUE_TRIGGER_ABORT, 0, 0);
     } else {
         list::abort();
         ramp::abort();
+        waveform::abort();
 
         bool sync = false;
         for (int i = 0; i < CH_NUM; ++i) {
@@ -395,9 +417,16 @@ void abort() {
     }
 }
 
-void tick(uint32_t tick_usec) {
+void tick(uint64_t tick_usec) {
     if (g_state == STATE_TRIGGERED) {
-        check(tick_usec / 1000);
+        check(tick_usec);
+
+        if (g_state == STATE_TRIGGERED) {
+            // trigger delay expiry
+            uint64_t delay = (uint64_t)(persist_conf::devConf.triggerDelay * 1000000L);
+            uint64_t elapsed = tick_usec - g_triggeredTime;
+            scheduleTick(elapsed < delay ? delay - elapsed + 1 : 0);
+        }
     }
 }
 
@@ -50,6 +50,9 @@ void setCurrent(Channel &channel, float value);
 float getCurrent(Channel &channel);
 
 int generateTrigger(Source source, bool checkImmediatelly = true);
+// Trigger from the edge captured at triggeredTime (see micros64), trigger delay
+// is measured from the edge and not from the time edge was processed.
+int generateTriggerAt(Source source, uint64_t triggeredTime);
 int startImmediately();
 void startImmediatelyInPsuThread();
 int initiate();
@@ -62,7 +65,7 @@ bool isTriggered();
 bool isActive();
 void abort();
 
-void tick(uint32_t tick_usec);
+void tick(uint64_t tick_usec);
 
 }
 }
@@ -0,0 +1,631 @@
+/*
+ * EEZ Modular Firmware
+ * Copyright (C) 2020-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include <cmsis_os.h>
+
+#include <scpi/scpi.h>
+
+#include <eez/system.h>
+#include <eez/scpi/scpi.h>
+
+#include <eez/modules/psu/psu.h>
+#include <eez/modules/psu/channel_dispatcher.h>
+#include <eez/modules/psu/trigger.h>
+#include <eez/modules/psu/sd_card.h>
+#include <eez/modules/psu/waveform.h>
+
+#include <eez/libs/sd_fat/sd_fat.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// exponential shape is 1 - e^(-t / tau), where tau is 1/5 of the period,
+// scaled so that it reaches the full amplitude at the end of the period
+#define EXPONENTIAL_TIME_CONSTANTS 5.0f
+
+namespace eez {
+namespace psu {
+namespace waveform {
+
+static struct {
+    Shape shape;
+    Type type;
+    float frequency;
+    float amplitude;
+    float offset;
+    float phase;
+    uint16_t count;
+
+    float userTable[WAVEFORM_TABLE_SIZE];
+    uint16_t userTableLength;
+} g_parameters[CH_MAX];
+
+// Execution is started and finished by the PSU thread. If the channel module
+// supports it (see ChannelInterface::isWaveformDacSupported), DAC is written by
+// the waveform thread, woken up every CONF_WAVEFORM_UPDATE_PERIOD_US by the timer,
+// so the output doesn't depend on PSU thread load. PSU thread then only updates
+// the setpoint (for the display and protections) with the value last written.
+static struct {
+    int state; // 0 - idle, 1 - waiting for the output enable, 2 - executing
+    bool threadWritesDac;
+    uint64_t startTime; // in microseconds
+    uint64_t period; // in microseconds
+    uint64_t phase; // in microseconds
+    float table[WAVEFORM_TABLE_SIZE];
+    volatile float value; // last value written to the DAC by the waveform thread
+} g_execution[CH_MAX];
+
+static bool g_active;
+static bool g_activeInPsuThread;
+
+static void mainLoop(const void *);
+
+#if defined(EEZ_PLATFORM_STM32)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#endif
+
+osThreadDef(g_waveformTask, mainLoop, osPriorityHigh, 0, 1024);
+
+#if defined(EEZ_PLATFORM_STM32)
+#pragma GCC diagnostic pop
+#endif
+
+// wake ups are not counted, thread always takes the current time
+osMessageQDef(g_waveformMessageQueue, 4, uint32_t);
+osMessageQId g_waveformMessageQueueId;
+
+// state and startTime are changed and the DAC is written only while this is locked,
+// so after abort returns waveform thread doesn't write the DAC anymore
+osMutexId(g_executionMutexId);
+osMutexDef(g_executionMutex);
+
+static bool g_threadStarted;
+static volatile bool g_threadActive;
+
+static void setState(int iChannel, int state) {
+    osMutexWait(g_executionMutexId, osWaitForever);
+    g_execution[iChannel].state = state;
+    osMutexRelease(g_executionMutexId);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void init() {
+    g_waveformMessageQueueId = osMessageCreate(osMessageQ(g_waveformMessageQueue), NULL);
+    g_executionMutexId = osMutexCreate(osMutex(g_executionMutex));
+
+    reset();
+}
+
+void resetChannelWaveform(Channel &channel) {
+    int i = channel.channelIndex;
+
+    g_parameters[i].shape = SHAPE_SINE;
+    g_parameters[i].type = TYPE_VOLTAGE;
+    g_parameters[i].frequency = WAVEFORM_FREQUENCY_DEF;
+    g_parameters[i].amplitude = 0;
+    g_parameters[i].offset = 0;
+    g_parameters[i].phase = 0;
+    g_parameters[i].count = 0;
+    g_parameters[i].userTableLength = 0;
+
+    if (g_execution[i].state) {
+        setState(i, 0);
+    }
+}
+
+void reset() {
+    for (int i = 0; i < CH_NUM; ++i) {
+        resetChannelWaveform(Channel::get(i));
+    }
+}
+
+Shape getShape(Channel &channel) {
+    return g_parameters[channel.channelIndex].shape;
+}
+
+void setShape(Channel &channel, Shape shape) {
+    g_parameters[channel.channelIndex].shape = shape;
+}
+
+Type getType(Channel &channel) {
+    return g_parameters[channel.channelIndex].type;
+}
+
+void setType(Channel &channel, Type type) {
+    g_parameters[channel.channelIndex].type = type;
+}
+
+float getFrequency(Channel &channel) {
+    return g_parameters[channel.channelIndex].frequency;
+}
+
+void setFrequency(Channel &channel, float frequency) {
+    g_parameters[channel.channelIndex].frequency = frequency;
+}
+
+float getAmplitude(Channel &channel) {
+    return g_parameters[channel.channelIndex].amplitude;
+}
+
+void setAmplitude(Channel &channel, float amplitude) {
+    g_parameters[channel.channelIndex].amplitude = amplitude;
+}
+
+float getOffset(Channel &channel) {
+    return g_parameters[channel.channelIndex].offset;
+}
+
+void setOffset(Channel &channel, float offset) {
+    g_parameters[channel.channelIndex].offset = offset;
+}
+
+float getPhase(Channel &channel) {
+    return g_parameters[channel.channelIndex].phase;
+}
+
+void setPhase(Channel &channel, float phase) {
+    g_parameters[channel.channelIndex].phase = phase;
+}
+
+uint16_t getCount(Channel &channel) {
+    return g_parameters[channel.channelIndex].count;
+}
+
+void setCount(Channel &channel, uint16_t count) {
+    g_parameters[channel.channelIndex].count = count;
+}
+
+void setUserTable(Channel &channel, float *table, uint16_t tableLength) {
+    memcpy(g_parameters[channel.channelIndex].userTable, table, tableLength * sizeof(float));
+    g_parameters[channel.channelIndex].userTableLength = tableLength;
+}
+
+float *getUserTable(Channel &channel, uint16_t *tableLength) {
+    *tableLength = g_parameters[channel.channelIndex].userTableLength;
+    return g_parameters[channel.channelIndex].userTable;
+}
+
+bool loadUserTable(sd_card::BufferedFileRead &file, float *table, uint16_t &tableLength, int *err) {
+    tableLength = 0;
+
+    while (true) {
+        sd_card::matchZeroOrMoreSpaces(file);
+        if (!file.available()) {
+            break;
+        }
+
+        float value;
+        if (!sd_card::match(file, value) || value < -1.0f || value > 1.0f || tableLength == WAVEFORM_TABLE_SIZE) {
+            if (err) {
+                *err = SCPI_ERROR_EXECUTION_ERROR;
+            }
+            return false;
+        }
+
+        table[tableLength++] = value;
+
+        sd_card::match(file, CSV_SEPARATOR);
+    }
+
+    if (tableLength == 0) {
+        if (err) {
+            *err = SCPI_ERROR_LIST_IS_EMPTY;
+        }
+        return false;
+    }
+
+    return true;
+}
+
+bool loadUserTable(int iChannel, const char *filePath, int *err) {
+    if (!sd_card::isMounted(err)) {
+        return false;
+    }
+
+    if (!sd_card::exists(filePath, err)) {
+        if (err) {
+            *err = SCPI_ERROR_FILE_NOT_FOUND;
+        }
+        return false;
+    }
+
+    File file;
+    if (!file.open(filePath, FILE_OPEN_EXISTING | FILE_READ)) {
+        if (err) {
+            *err = SCPI_ERROR_MASS_STORAGE_ERROR;
+        }
+        return false;
+    }
+
+    sd_card::BufferedFileRead bufferedFile(file);
+
+    float table[WAVEFORM_TABLE_SIZE];
+    uint16_t tableLength;
+    bool success = loadUserTable(bufferedFile, table, tableLength, err);
+
+    file.close();
+
+    if (success) {
+        setUserTable(Channel::get(iChannel), table, tableLength);
+    }
+
+    return success;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+// returns normalized, i.e. in [-1, 1] range, waveform value for x in [0, 1) range
+static float getShapeValue(int iChannel, float x) {
+    switch (g_parameters[iChannel].shape) {
+    case SHAPE_SINE:
+        return sinf(2.0f * (float)M_PI * x);
+
+    case SHAPE_TRIANGLE:
+        return x < 0.5f ? 4.0f * x - 1.0f : 3.0f - 4.0f * x;
+
+    case SHAPE_SQUARE:
+        return x < 0.5f ? 1.0f : -1.0f;
+
+    case SHAPE_RAMP:
+        return 2.0f * x - 1.0f;
+
+    case SHAPE_EXPONENTIAL:
+        return 2.0f * (1.0f - expf(-EXPONENTIAL_TIME_CONSTANTS * x)) / (1.0f - expf(-EXPONENTIAL_TIME_CONSTANTS)) - 1.0f;
+
+    case SHAPE_USER: {
+        // resample user table to WAVEFORM_TABLE_SIZE points
+        uint16_t tableLength = g_parameters[iChannel].userTableLength;
+        float *table = g_parameters[iChannel].userTable;
+        float position = x * tableLength;
+        int i = (int)position;
+        float a = table[i % tableLength];
+        float b = table[(i + 1) % tableLength];
+        return a + (b - a) * (position - i);
+    }
+    }
+
+    return 0;
+}
+
+static float getTableValue(int iChannel, int i) {
+    return g_parameters[iChannel].offset + g_parameters[iChannel].amplitude * getShapeValue(iChannel, 1.0f * i / WAVEFORM_TABLE_SIZE);
+}
+
+int checkLimits(int iChannel) {
+    Channel &channel = Channel::get(iChannel);
+
+    if (g_parameters[iChannel].shape == SHAPE_USER && g_parameters[iChannel].userTableLength == 0) {
+        g_errorChannelIndex = channel.channelIndex;
+        return SCPI_ERROR_LIST_IS_EMPTY;
+    }
+
+    float min = g_parameters[iChannel].offset;
+    float max = g_parameters[iChannel].offset;
+    for (int i = 0; i < WAVEFORM_TABLE_SIZE; ++i) {
+        float value = getTableValue(iChannel, i);
+        if (value < min) {
+            min = value;
+        }
+        if (value > max) {
+            max = value;
+        }
+    }
+
+    float voltage;
+    float current;
+    if (g_parameters[iChannel].type == TYPE_VOLTAGE) {
+        if (min < channel_dispatcher::getUMin(channel)) {
+            g_errorChannelIndex = channel.channelIndex;
+            return SCPI_ERROR_DATA_OUT_OF_RANGE;
+        }
+        voltage = max;
+        current = channel.i.triggerLevel;
+    } else {
+        if (min < channel_dispatcher::getIMin(channel)) {
+            g_errorChannelIndex = channel.channelIndex;
+            return SCPI_ERROR_DATA_OUT_OF_RANGE;
+        }
+        voltage = channel.u.triggerLevel;
+        current = max;
+    }
+
+    if (channel.isVoltageLimitExceeded(voltage)) {
+        g_errorChannelIndex = channel.channelIndex;
+        return SCPI_ERROR_VOLTAGE_LIMIT_EXCEEDED;
+    }
+
+    if (channel.isCurrentLimitExceeded(current)) {
+        g_errorChannelIndex = channel.channelIndex;
+        return SCPI_ERROR_CURRENT_LIMIT_EXCEEDED;
+    }
+
+    if (channel.isPowerLimitExceeded(voltage, current)) {
+        g_errorChannelIndex = channel.channelIndex;
+        return SCPI_ERROR_POWER_LIMIT_EXCEEDED;
+    }
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static void setValue(Channel &channel, float value) {
+    if (g_parameters[channel.channelIndex].type == TYPE_VOLTAGE) {
+        value = channel_dispatcher::roundChannelValue(channel, UNIT_VOLT, value);
+        if (channel_dispatcher::getUSet(channel) != value) {
+            channel_dispatcher::setVoltage(channel, value);
+        }
+    } else {
+        value = channel_dispatcher::roundChannelValue(channel, UNIT_AMPER, value);
+        if (channel_dispatcher::getISet(channel) != value) {
+            channel_dispatcher::setCurrent(channel, value);
+        }
+    }
+}
+
+// only the setpoint, DAC is written by the waveform thread
+static void setSetpoint(Channel &channel, float value) {
+    if (g_parameters[channel.channelIndex].type == TYPE_VOLTAGE) {
+        if (channel.u.set != value) {
+            channel.setVoltageSetpoint(value);
+        }
+    } else {
+        if (channel.i.set != value) {
+            channel.setCurrentSetpoint(value);
+        }
+    }
+}
+
+// returns table value, linearly interpolated between two neighbouring points,
+// for the given time since the execution start
+static float getValue(int iChannel, uint64_t time) {
+    auto &execution = g_execution[iChannel];
+
+    float position = 1.0f * ((time + execution.phase) % execution.period) * WAVEFORM_TABLE_SIZE / execution.period;
+    int i = (int)position;
+    float a = execution.table[i % WAVEFORM_TABLE_SIZE];
+    float b = execution.table[(i + 1) % WAVEFORM_TABLE_SIZE];
+    return a + (b - a) * (position - i);
+}
+
+// Waveform thread can write the DAC only if the channel setpoint is not
+// shared with other channels (coupling and tracking) and setting it doesn't
+// change the current range (see Channel::doSetCurrent).
+static bool isThreadWritesDacAllowed(Channel &channel) {
+    if (channel.channelIndex < 2 && (channel_dispatcher::getCouplingType() == channel_dispatcher::COUPLING_TYPE_SERIES ||
+                                     channel_dispatcher::getCouplingType() == channel_dispatcher::COUPLING_TYPE_PARALLEL)) {
+        return false;
+    }
+
+    if (channel.flags.trackingEnabled) {
+        return false;
+    }
+
+    if (g_parameters[channel.channelIndex].type == TYPE_CURRENT && channel.hasSupportForCurrentDualRange() &&
+        channel.flags.currentRangeSelectionMode == CURRENT_RANGE_SELECTION_USE_BOTH) {
+        return false;
+    }
+
+    return channel.channelInterface->isWaveformDacSupported(channel.subchannelIndex);
+}
+
+void executionStart(Channel &channel) {
+    int iChannel = channel.channelIndex;
+    auto &execution = g_execution[iChannel];
+
+    for (int i = 0; i < WAVEFORM_TABLE_SIZE; ++i) {
+        execution.table[i] = getTableValue(iChannel, i);
+    }
+
+    execution.period = (uint64_t)roundf(1000000.0f / g_parameters[iChannel].frequency);
+    execution.phase = (uint64_t)roundf(execution.period * g_parameters[iChannel].phase / 360.0f) % execution.period;
+
+    execution.threadWritesDac = isThreadWritesDacAllowed(channel);
+    if (execution.threadWritesDac && !g_threadStarted) {
+        g_threadStarted = true;
+        osThreadCreate(osThread(g_waveformTask), nullptr);
+    }
+
+    if (g_parameters[iChannel].type == TYPE_VOLTAGE) {
+        channel_dispatcher::setCurrent(channel, channel.i.triggerLevel);
+    } else {
+        channel_dispatcher::setVoltage(channel, channel.u.triggerLevel);
+    }
+    setValue(channel, getValue(iChannel, 0));
+
+    execution.value = g_parameters[iChannel].type == TYPE_VOLTAGE ? channel.u.set : channel.i.set;
+
+    setState(iChannel, 1);
+
+    g_active = true;
+    if (!execution.threadWritesDac) {
+        g_activeInPsuThread = true;
+    }
+}
+
+void tick(uint64_t tickUsec) {
+    bool active = false;
+    bool activeInPsuThread = false;
+    bool threadActive = false;
+
+    for (int i = 0; i < CH_NUM; ++i) {
+        auto &execution = g_execution[i];
+        if (!execution.state) {
+            continue;
+        }
+
+        Channel &channel = Channel::get(i);
+
+        if (channel_dispatcher::isTripped(channel)) {
+            g_active = false;
+            trigger::abort();
+            return;
+        }
+
+        if (channel.isOutputEnabled()) {
+            if (execution.state == 1) {
+                osMutexWait(g_executionMutexId, osWaitForever);
+                execution.startTime = tickUsec;
+                execution.state = 2;
+                osMutexRelease(g_executionMutexId);
+            }
+
+            uint64_t time = tickUsec - execution.startTime;
+
+            uint16_t count = g_parameters[i].count;
+            if (count > 0 && time >= count * execution.period) {
+                setState(i, 0);
+                setValue(channel, getValue(i, count * execution.period));
+                trigger::setTriggerFinished(channel);
+                continue;
+            }
+
+            if (execution.threadWritesDac) {
+                setSetpoint(channel, execution.value);
+            } else {
+                setValue(channel, getValue(i, time));
+            }
+        }
+
+        active = true;
+
+        if (!execution.threadWritesDac) {
+            activeInPsuThread = true;
+        } else if (execution.state == 2) {
+            threadActive = true;
+        }
+    }
+
+    if (active) {
+        scheduleTick(CONF_PSU_TICK_POLL_PERIOD_US);
+    }
+
+    g_active = active;
+    g_activeInPsuThread = activeInPsuThread;
+
+    if (threadActive && !g_threadActive) {
+        g_threadActive = true;
+        osMessagePut(g_waveformMessageQueueId, 0, 0);
+    } else {
+        g_threadActive = threadActive;
+    }
+}
+
+// Writes the DAC of the channels executed by the waveform thread. Value is taken
+// for the last multiple of CONF_WAVEFORM_UPDATE_PERIOD_US since the execution start,
+// so it doesn't depend on when exactly thread is woken up.
+static void updateDac() {
+    osMutexWait(g_executionMutexId, osWaitForever);
+
+    uint64_t tickUsec = micros64();
+
+    for (int i = 0; i < CH_NUM; ++i) {
+        auto &execution = g_execution[i];
+        if (execution.state != 2 || !execution.threadWritesDac) {
+            continue;
+        }
+
+        uint64_t time = tickUsec - execution.startTime;
+        time -= time % CONF_WAVEFORM_UPDATE_PERIOD_US;
+
+        // last value is set by the PSU thread when execution is finished
+        uint16_t count = g_parameters[i].count;
+        if (count > 0 && time >= count * execution.period) {
+            continue;
+        }
+
+        Channel &channel = Channel::get(i);
+
+        if (g_parameters[i].type == TYPE_VOLTAGE) {
+            float value = channel.roundChannelValue(UNIT_VOLT, getValue(i, time));
+            if (value != execution.value && channel.channelInterface->setWaveformDacVoltage(channel.subchannelIndex, channel.getCalibratedVoltage(value))) {
+                execution.value = value;
+            }
+        } else {
+            float value = channel.roundChannelValue(UNIT_AMPER, getValue(i, time));
+            if (value != execution.value && channel.channelInterface->setWaveformDacCurrent(channel.subchannelIndex, channel.getCalibratedCurrent(value))) {
+                execution.value = value;
+            }
+        }
+    }
+
+    osMutexRelease(g_executionMutexId);
+}
+
+static void mainLoop(const void *) {
+    while (1) {
+#if defined(EEZ_PLATFORM_STM32)
+        // woken up by onTimerInterrupt
+        osMessageGet(g_waveformMessageQueueId, osWaitForever);
+#else
+        // there is no TIM7 in the simulator, kernel timer is used instead
+        osMessageGet(g_waveformMessageQueueId, g_threadActive ? CONF_WAVEFORM_UPDATE_PERIOD_US / 1000 : osWaitForever);
+#endif
+
+        if (g_threadActive) {
+            updateDac();
+        }
+    }
+}
+
+#if defined(EEZ_PLATFORM_STM32)
+void onTimerInterrupt() {
+    if (g_threadActive) {
+        osMessagePut(g_waveformMessageQueueId, 0, 0);
+    }
+}
+#endif
+
+bool isActive() {
+    return g_active;
+}
+
+bool isActive(Channel &channel) {
+    return g_execution[channel.channelIndex].state != 0;
+}
+
+bool isActiveInPsuThread() {
+    return g_activeInPsuThread;
+}
+
+bool isWritingDac(Channel &channel, Type type) {
+    auto &execution = g_execution[channel.channelIndex];
+    return execution.state == 2 && execution.threadWritesDac && g_parameters[channel.channelIndex].type == type;
+}
+
+void abort() {
+    for (int i = 0; i < CH_NUM; ++i) {
+        if (g_execution[i].state) {
+            setState(i, 0);
+        }
+    }
+
+    g_active = false;
+    g_activeInPsuThread = false;
+    g_threadActive = false;
+}
+
+}
+}
+} // namespace eez::psu::waveform
@@ -0,0 +1,109 @@
+/*
+ * EEZ Modular Firmware
+ * Copyright (C) 2020-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+namespace eez {
+namespace psu {
+
+// forward declaration
+namespace sd_card {
+class BufferedFileRead;
+}
+
+/// Arbitrary waveform (TRIGGER_MODE_FUNCTION) execution.
+/// Waveform is precomputed into the table of WAVEFORM_TABLE_SIZE setpoints when
+/// execution starts, then only the table value for the current time is picked
+/// (and interpolated). DAC is written by the waveform thread, woken up by the timer
+/// every CONF_WAVEFORM_UPDATE_PERIOD_US, or by tick in the PSU thread if the channel
+/// can't be written that way (see waveform.cpp).
+namespace waveform {
+
+enum Shape {
+    SHAPE_SINE,
+    SHAPE_TRIANGLE,
+    SHAPE_SQUARE,
+    SHAPE_RAMP,
+    SHAPE_EXPONENTIAL,
+    SHAPE_USER
+};
+
+enum Type {
+    TYPE_VOLTAGE,
+    TYPE_CURRENT
+};
+
+void init();
+
+void resetChannelWaveform(Channel &channel);
+void reset();
+
+Shape getShape(Channel &channel);
+void setShape(Channel &channel, Shape shape);
+
+Type getType(Channel &channel);
+void setType(Channel &channel, Type type);
+
+float getFrequency(Channel &channel);
+void setFrequency(Channel &channel, float frequency);
+
+float getAmplitude(Channel &channel);
+void setAmplitude(Channel &channel, float amplitude);
+
+float getOffset(Channel &channel);
+void setOffset(Channel &channel, float offset);
+
+float getPhase(Channel &channel);
+void setPhase(Channel &channel, float phase);
+
+uint16_t getCount(Channel &channel);
+void setCount(Channel &channel, uint16_t count);
+
+/// User table values are normalized to [-1, 1] range,
+/// i.e. they are scaled with amplitude and shifted by offset.
+void setUserTable(Channel &channel, float *table, uint16_t tableLength);
+float *getUserTable(Channel &channel, uint16_t *tableLength);
+
+bool loadUserTable(sd_card::BufferedFileRead &file, float *table, uint16_t &tableLength, int *err);
+bool loadUserTable(int iChannel, const char *filePath, int *err);
+
+int checkLimits(int iChannel);
+
+void executionStart(Channel &channel);
+
+void tick(uint64_t tickUsec);
+
+#if defined(EEZ_PLATFORM_STM32)
+/// Called from the TIM7 interrupt, wakes up the waveform thread.
+void onTimerInterrupt();
+#endif
+
+bool isActive();
+bool isActive(Channel &channel);
+
+/// Is some waveform executed by tick in the PSU thread.
+bool isActiveInPsuThread();
+
+/// Is the channel DAC written by the waveform thread.
+bool isWritingDac(Channel &channel, Type type);
+
+void abort();
+
+}
+}
+} // namespace eez::psu::waveform
@@ -22,11 +22,13 @@
 #include <eez/firmware.h>
 #include <eez/mp.h>
 #include <eez/system.h>
+#include <eez/util.h>
 #include <eez/scpi/scpi.h>
 
 #include <eez/libs/sd_fat/sd_fat.h>
 
 #include <eez/modules/psu/psu.h>
+#include <eez/modules/psu/datetime.h>
 #include <eez/modules/psu/event_queue.h>
 #include <eez/modules/psu/scpi/psu.h>
 #include <eez/modules/psu/gui/psu.h>
@@ -41,6 +43,8 @@
 extern "C" {
 #include "py/compile.h"
 #include "py/runtime.h"
+#include "py/emitglue.h"
+#include "py/persistentcode.h"
 #include "py/gc.h"
 #include "py/stackctrl.h"
 }
@@ -79,6 +83,41 @@ static char *g_scriptSource = g_scriptPath + MAX_PATH_LENGTH + 1;
 static const size_t MAX_SCRIPT_LENGTH = 32 * 1024;
 static size_t g_scriptSourceLength;
 
+static uint8_t *g_gcHeap = (uint8_t *)g_scriptSource + MAX_SCRIPT_LENGTH;
+
+// Compiled script cache. Bytecode (.mpy) of the last compiled script is kept in
+// MP_SCRIPT_CACHE and saved on the SD card next to the .py file, so the script is
+// not read, parsed and compiled again until its size or modification time changes.
+// CRC of the bytecode is stored in the cache file to detect a corrupted file.
+static char g_scriptCachePath[MAX_PATH_LENGTH + 1];
+static uint8_t * const g_scriptCache = MP_SCRIPT_CACHE;
+static const size_t MAX_SCRIPT_CACHE_LENGTH = MP_SCRIPT_CACHE_SIZE;
+static size_t g_scriptCacheLength;
+
+static const uint32_t SCRIPT_CACHE_MAGIC = 0x4350594DL; // "MPYC"
+static const uint32_t SCRIPT_CACHE_VERSION = 2;
+
+struct ScriptKey {
+    uint32_t size;
+    uint32_t modified;
+};
+
+struct ScriptCacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    ScriptKey key;
+    uint32_t length;
+    uint32_t crc;
+};
+
+static ScriptKey g_scriptKey;
+static ScriptKey g_scriptCacheKey;
+static bool g_runFromCache;
+static bool g_scriptSourceLoaded;
+
+// set when cached bytecode failed to load, script is compiled from the source next time
+static bool g_ignoreScriptCache;
+
 ////////////////////////////////////////////////////////////////////////////////
 
 using namespace eez::scpi;
@@ -164,6 +203,64 @@ enum {
     QUEUE_MESSAGE_SCPI_RESULT
 };
 
+enum {
+    LOAD_SCRIPT,
+    EXECUTE_SCPI,
+    SAVE_SCRIPT_CACHE
+};
+
+static void scriptCachePrintStrn(void *data, const char *str, size_t len) {
+    if (g_scriptCacheLength + len <= MAX_SCRIPT_CACHE_LENGTH) {
+        memcpy(g_scriptCache + g_scriptCacheLength, str, len);
+    }
+    g_scriptCacheLength += len;
+}
+
+static void saveScriptCache(mp_raw_code_t *rc) {
+    g_scriptCachePath[0] = 0;
+    g_scriptCacheLength = 0;
+
+    mp_print_t print = { nullptr, scriptCachePrintStrn };
+    mp_raw_code_save(rc, &print);
+
+    if (g_scriptCacheLength > MAX_SCRIPT_CACHE_LENGTH) {
+        // doesn't fit, script will be compiled every time
+        g_scriptCacheLength = 0;
+        return;
+    }
+
+    strcpy(g_scriptCachePath, g_scriptPath);
+    g_scriptCacheKey = g_scriptKey;
+
+    osMessagePut(scpi::g_scpiMessageQueueId, SCPI_QUEUE_MP_MESSAGE(SAVE_SCRIPT_CACHE, 0), osWaitForever);
+}
+
+static mp_obj_t compileScript() {
+    if (g_runFromCache) {
+        nlr_buf_t nlr;
+        if (nlr_push(&nlr) == 0) {
+            mp_raw_code_t *rc = mp_raw_code_load_mem(g_scriptCache, g_scriptCacheLength);
+            nlr_pop();
+            return mp_make_function_from_raw_code(rc, MP_OBJ_NULL, MP_OBJ_NULL);
+        } else {
+            g_scriptCachePath[0] = 0;
+            g_scriptCacheLength = 0;
+            if (!g_scriptSourceLoaded) {
+                // source was not read, report the error and don't use the cache next time
+                g_ignoreScriptCache = true;
+                nlr_jump(nlr.ret_val);
+            }
+        }
+    }
+
+    mp_lexer_t *lex = mp_lexer_new_from_str_len(MP_QSTR__lt_stdin_gt_, g_scriptSource, g_scriptSourceLength, 0);
+    qstr source_name = lex->source_name;
+    mp_parse_tree_t parse_tree = mp_parse(lex, MP_PARSE_FILE_INPUT);
+    mp_raw_code_t *rc = mp_compile_to_raw_code(&parse_tree, source_name/*, MP_EMIT_OPT_NONE*/, true);
+    saveScriptCache(rc);
+    return mp_make_function_from_raw_code(rc, MP_OBJ_NULL, MP_OBJ_NULL);
+}
+
 void oneIter() {
     osEvent event = osMessageGet(g_mpMessageQueueId, osWaitForever);
     if (event.status == osEventMessage) {
@@ -173,7 +270,7 @@ void oneIter() {
         	// this version reinitialise MP every time
 			volatile char dummy;
 			mp_stack_set_top((void *)&dummy);
-			gc_init(g_scriptSource + MAX_SCRIPT_LENGTH, MP_BUFFER + MP_BUFFER_SIZE - MAX_SCRIPT_LENGTH);
+			gc_init(g_gcHeap, MP_BUFFER + MP_BUFFER_SIZE - MAX_SCRIPT_LENGTH);
 			mp_init();
 
             nlr_buf_t nlr;
@@ -201,16 +298,13 @@ void oneIter() {
 				volatile char dummy;
 				g_initialized = true;
 				mp_stack_set_top((void *)&dummy);
-				gc_init(g_scriptSource + MAX_SCRIPT_LENGTH, MP_BUFFER + MP_BUFFER_SIZE - MAX_SCRIPT_LENGTH);
+				gc_init(g_gcHeap, MP_BUFFER + MP_BUFFER_SIZE - MAX_SCRIPT_LENGTH);
 				mp_init();
 			}
 
 			nlr_buf_t nlr;
 			if (nlr_push(&nlr) == 0) {
-				mp_lexer_t *lex = mp_lexer_new_from_str_len(MP_QSTR__lt_stdin_gt_, g_scriptSource, g_scriptSourceLength, 0);
-				qstr source_name = lex->source_name;
-				mp_parse_tree_t parse_tree = mp_parse(lex, MP_PARSE_FILE_INPUT);
-				mp_obj_t module_fun = mp_compile(&parse_tree, source_name/*, MP_EMIT_OPT_NONE*/, true);
+				mp_obj_t module_fun = compileScript();
                 //DebugTrace("T3 %d\n", millis());
 				mp_call_function_0(module_fun);
 				nlr_pop();
@@ -230,11 +324,6 @@ void oneIter() {
     }
 }
 
-enum {
-    LOAD_SCRIPT,
-    EXECUTE_SCPI
-};
-
 void startScript(const char *filePath) {
     if (g_state == STATE_IDLE) {
         g_state = STATE_EXECUTING;
@@ -246,42 +335,162 @@ void startScript(const char *filePath) {
     }
 }
 
-void loadScript() {
-    uint32_t fileSize;
-    uint32_t bytesRead;
+static bool getScriptCacheFilePath(const char *scriptPath, char *cacheFilePath) {
+    const char *ext = strrchr(scriptPath, '.');
+    size_t len = ext && !strchr(ext, '/') ? ext - scriptPath : strlen(scriptPath);
+    if (len + 4 > MAX_PATH_LENGTH) {
+        return false;
+    }
+    memcpy(cacheFilePath, scriptPath, len);
+    strcpy(cacheFilePath + len, ".mpy");
+    return true;
+}
+
+static uint32_t getModifiedTime(const char *filePath) {
+    FileInfo fileInfo;
+    if (fileInfo.fstat(filePath) != SD_FAT_RESULT_OK) {
+        return 0;
+    }
+    return psu::datetime::makeTime(
+        fileInfo.getModifiedYear(), fileInfo.getModifiedMonth(), fileInfo.getModifiedDay(),
+        fileInfo.getModifiedHour(), fileInfo.getModifiedMinute(), fileInfo.getModifiedSecond()
+    );
+}
+
+static bool isScriptCached() {
+    return g_scriptCacheLength > 0 && strcmp(g_scriptCachePath, g_scriptPath) == 0 && memcmp(&g_scriptCacheKey, &g_scriptKey, sizeof(ScriptKey)) == 0;
+}
+
+static bool loadScriptCacheFile() {
+    char cacheFilePath[MAX_PATH_LENGTH + 1];
+    if (!getScriptCacheFilePath(g_scriptPath, cacheFilePath)) {
+        return false;
+    }
 
+    eez::File file;
+    if (!file.open(cacheFilePath, FILE_OPEN_EXISTING | FILE_READ)) {
+        return false;
+    }
+
+    g_scriptCachePath[0] = 0;
+    g_scriptCacheLength = 0;
+
+    ScriptCacheHeader header;
+    bool result =
+        file.read(&header, sizeof(header)) == sizeof(header) &&
+        header.magic == SCRIPT_CACHE_MAGIC &&
+        header.version == SCRIPT_CACHE_VERSION &&
+        memcmp(&header.key, &g_scriptKey, sizeof(ScriptKey)) == 0 &&
+        header.length >= 4 && header.length <= MAX_SCRIPT_CACHE_LENGTH &&
+        file.read(g_scriptCache, header.length) == header.length &&
+        crc32(g_scriptCache, header.length) == header.crc &&
+        // .mpy saved by the firmware with different MicroPython version or features
+        g_scriptCache[0] == 'M' && g_scriptCache[1] == MPY_VERSION &&
+        MPY_FEATURE_DECODE_FLAGS(g_scriptCache[2]) == MPY_FEATURE_FLAGS;
+
+    file.close();
+
+    if (result) {
+        strcpy(g_scriptCachePath, g_scriptPath);
+        g_scriptCacheKey = g_scriptKey;
+        g_scriptCacheLength = header.length;
+    }
+
+    return result;
+}
+
+static void saveScriptCacheFile() {
+    char cacheFilePath[MAX_PATH_LENGTH + 1];
+    if (!getScriptCacheFilePath(g_scriptCachePath, cacheFilePath)) {
+        return;
+    }
+
+    eez::File file;
+    if (!file.open(cacheFilePath, FILE_CREATE_ALWAYS | FILE_WRITE)) {
+        return;
+    }
+
+    ScriptCacheHeader header;
+    header.magic = SCRIPT_CACHE_MAGIC;
+    header.version = SCRIPT_CACHE_VERSION;
+    header.key = g_scriptCacheKey;
+    header.length = g_scriptCacheLength;
+    header.crc = crc32(g_scriptCache, g_scriptCacheLength);
+
+    // if this fails, the next load will reject the cache file
+    file.write(&header, sizeof(header));
+    file.write(g_scriptCache, g_scriptCacheLength);
+
+    file.close();
+
+    onSdCardFileChangeHook(cacheFilePath);
+}
+
+static bool loadScriptSource() {
     eez::File file;
     if (!file.open(g_scriptPath, FILE_OPEN_EXISTING | FILE_READ)) {
         generateError(SCPI_ERROR_FILE_NOT_FOUND);
-        goto ErrorNoClose;
+        return false;
     }
 
-    fileSize = file.size();
+    uint32_t fileSize = file.size();
     if (fileSize > MAX_SCRIPT_LENGTH) {
+        file.close();
         generateError(SCPI_ERROR_OUT_OF_DEVICE_MEMORY);
-        goto Error;
+        return false;
     }
 
-    bytesRead = file.read(g_scriptSource, fileSize);
+    uint32_t bytesRead = file.read(g_scriptSource, fileSize);
 
     file.close();
 
     if (bytesRead != fileSize) {
         generateError(SCPI_ERROR_MASS_STORAGE_ERROR);
-        goto Error;
+        return false;
     }
 
     g_scriptSourceLength = fileSize;
 
+    // file could be changed since fstat
+    g_scriptKey.size = fileSize;
+    g_scriptKey.modified = getModifiedTime(g_scriptPath);
+
+    return true;
+}
+
+void loadScript() {
+    FileInfo fileInfo;
+    if (fileInfo.fstat(g_scriptPath) != SD_FAT_RESULT_OK) {
+        generateError(SCPI_ERROR_FILE_NOT_FOUND);
+        goto Error;
+    }
+
+    if (fileInfo.getSize() > MAX_SCRIPT_LENGTH) {
+        generateError(SCPI_ERROR_OUT_OF_DEVICE_MEMORY);
+        goto Error;
+    }
+
+    g_scriptKey.size = fileInfo.getSize();
+    g_scriptKey.modified = getModifiedTime(g_scriptPath);
+
+    // source is read only if the script has to be compiled
+    g_runFromCache = !g_ignoreScriptCache && (isScriptCached() || loadScriptCacheFile());
+    g_ignoreScriptCache = false;
+
+    g_scriptSourceLoaded = false;
+    if (!g_runFromCache) {
+        if (!loadScriptSource()) {
+            goto Error;
+        }
+        g_scriptSourceLoaded = true;
+    }
+
     //DebugTrace("T2 %d\n", millis());
     osMessagePut(g_mpMessageQueueId, QUEUE_MESSAGE_START_SCRIPT, osWaitForever);
 
     return;
 
 Error:
-    file.close();
-
-ErrorNoClose:
     psu::gui::hideAsyncOperationInProgress();
 
     g_state = STATE_IDLE;
@@ -294,6 +503,8 @@ static const char *g_commandOrQueryText;
 void onQueueMessage(uint32_t type, uint32_t param) {
     if (type == LOAD_SCRIPT) {
         loadScript();
+    } else if (type == SAVE_SCRIPT_CACHE) {
+        saveScriptCacheFile();
     } else if (type == EXECUTE_SCPI) {
         input(g_scpiContext, (const char *)g_commandOrQueryText, strlen(g_commandOrQueryText));
         input(g_scpiContext, "\r\n", 2);
@@ -10,6 +10,12 @@
 #include <time.h>
 #endif
 
+#ifndef __EMSCRIPTEN__
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#endif
+
 #ifdef __EMSCRIPTEN__
 #define MAX_THREADS 100
 struct Thread {
@@ -64,11 +70,155 @@ void eez_system_tick() {
 }
 #endif
 
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __EMSCRIPTEN__
+
+// Every thread that waits in osDelay or osMessageGet takes part in the virtual
+// time scheduling, until it calls osThreadLeaveVirtualTime before some other
+// blocking call (for example console input thread before getchar). Threads which
+// never wait there are not taken into account.
+
+#define VT_MAX_THREADS 32
+#define VT_FOREVER 0xFFFFFFFFFFFFFFFFULL
+
+struct VirtualTimeThread {
+    bool active;
+    bool waiting;
+    uint64_t wakeUpTime;
+    osMessageQId queue;
+};
+
+static bool g_virtualTime;
+static uint64_t g_virtualTimeNow;
+static std::chrono::steady_clock::time_point g_realTimeStart = std::chrono::steady_clock::now();
+
+static std::mutex g_vtMutex;
+static std::condition_variable g_vtCondition;
+static VirtualTimeThread g_vtThreads[VT_MAX_THREADS];
+static int g_vtNumThreads;
+static thread_local VirtualTimeThread *g_vtThread;
+
+static bool vtIsReady(VirtualTimeThread &thread) {
+    // on overflow head == tail, receiver must wake up to clear it or sender waits forever
+    return g_virtualTimeNow >= thread.wakeUpTime || (thread.queue && (thread.queue->tail != thread.queue->head || thread.queue->overflow));
+}
+
+// must be called with g_vtMutex locked
+static void vtAdvance() {
+    uint64_t nextWakeUpTime = VT_FOREVER;
+
+    for (int i = 0; i < g_vtNumThreads; i++) {
+        VirtualTimeThread &thread = g_vtThreads[i];
+        if (!thread.active) {
+            continue;
+        }
+        if (!thread.waiting || vtIsReady(thread)) {
+            // someone is still running, time stands still
+            return;
+        }
+        if (thread.wakeUpTime < nextWakeUpTime) {
+            nextWakeUpTime = thread.wakeUpTime;
+        }
+    }
+
+    if (nextWakeUpTime != VT_FOREVER) {
+        g_virtualTimeNow = nextWakeUpTime;
+        g_vtCondition.notify_all();
+    }
+}
+
+static void vtWait(uint64_t wakeUpTime, osMessageQId queue) {
+    std::unique_lock<std::mutex> lock(g_vtMutex);
+
+    if (!g_vtThread) {
+        assert(g_vtNumThreads < VT_MAX_THREADS);
+        g_vtThread = &g_vtThreads[g_vtNumThreads++];
+    }
+
+    VirtualTimeThread &thread = *g_vtThread;
+    thread.active = true;
+    thread.wakeUpTime = wakeUpTime;
+    thread.queue = queue;
+    thread.waiting = true;
+
+    vtAdvance();
+
+    while (!vtIsReady(thread)) {
+        g_vtCondition.wait(lock);
+    }
+
+    thread.waiting = false;
+}
+
+static void vtNotify() {
+    std::unique_lock<std::mutex> lock(g_vtMutex);
+    g_vtCondition.notify_all();
+}
+
+void osThreadLeaveVirtualTime() {
+    std::unique_lock<std::mutex> lock(g_vtMutex);
+    if (g_vtThread && g_vtThread->active) {
+        g_vtThread->active = false;
+        // this thread could be the last one time was waiting for
+        vtAdvance();
+    }
+}
+
+void osKernelSetVirtualTime(bool enable) {
+    g_virtualTime = enable;
+    g_realTimeStart = std::chrono::steady_clock::now();
+}
+
+bool osKernelIsVirtualTime() {
+    return g_virtualTime;
+}
+
+uint64_t osKernelVirtualTime() {
+    std::unique_lock<std::mutex> lock(g_vtMutex);
+    return g_virtualTimeNow;
+}
+
+uint64_t osKernelRealTime() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - g_realTimeStart).count();
+}
+
+#else
+
+void osKernelSetVirtualTime(bool enable) {
+}
+
+void osThreadLeaveVirtualTime() {
+}
+
+bool osKernelIsVirtualTime() {
+    return false;
+}
+
+uint64_t osKernelVirtualTime() {
+    return 0;
+}
+
+uint64_t osKernelRealTime() {
+    return 0;
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
 osStatus osKernelStart(void) {
     return osOK;
 }
 
 osStatus osDelay(uint32_t millisec) {
+#ifndef __EMSCRIPTEN__
+    if (g_virtualTime) {
+        vtWait(osKernelVirtualTime() + millisec * (uint64_t)1000, nullptr);
+        return osOK;
+    }
+#endif
+
 #ifdef EEZ_PLATFORM_SIMULATOR_WIN32
     Sleep(millisec);
     return osOK;
@@ -87,31 +237,24 @@ uint32_t osKernelSysTickFrequency;
 uint32_t osKernelSysTickFrequency = 1000000;
 #endif
 
-uint32_t osKernelSysTick() {
-#ifdef EEZ_PLATFORM_SIMULATOR_WIN32
-    static bool isFirstTime = true;
-    static LARGE_INTEGER frequency;
-    static LARGE_INTEGER startTime;
-
-    if (isFirstTime) {
-        isFirstTime = false;
-        QueryPerformanceFrequency(&frequency);
-        QueryPerformanceCounter(&startTime);
-        return 0;
-    } else {
-        LARGE_INTEGER currentTime;
-        QueryPerformanceCounter(&currentTime);
+static uint64_t g_startTime;
 
-        auto diff = (currentTime.QuadPart - startTime.QuadPart) * 1000 / frequency.QuadPart;
+void osKernelSetStartTime(uint64_t usec) {
+    g_startTime = usec;
+}
 
-        return uint32_t(diff % 4294967296);
-    }
-#else
+uint64_t osKernelSysTickMicros() {
+#ifdef __EMSCRIPTEN__
     timeval tv;
     gettimeofday(&tv, NULL);
-    uint64_t micros = tv.tv_sec * (uint64_t)1000000 + tv.tv_usec;
-    return uint32_t((micros / 1000) % 4294967296);
-#endif    
+    return g_startTime + tv.tv_sec * (uint64_t)1000000 + tv.tv_usec;
+#else
+    return g_startTime + (g_virtualTime ? osKernelVirtualTime() : osKernelRealTime());
+#endif
+}
+
+uint32_t osKernelSysTick() {
+    return uint32_t((osKernelSysTickMicros() / 1000) % 4294967296);
 }
 
 osMessageQId osMessageCreate(osMessageQId queue_id, osThreadId thread_id) {
@@ -124,6 +267,21 @@ osMessageQId osMessageCreate(osMessageQId queue_id, osThreadId thread_id) {
 osEvent osMessageGet(osMessageQId queue_id, uint32_t millisec) {
     if (millisec == 0) millisec = 1;
 
+#ifndef __EMSCRIPTEN__
+    if (g_virtualTime) {
+        vtWait(millisec == osWaitForever ? VT_FOREVER : osKernelVirtualTime() + millisec * (uint64_t)1000, queue_id);
+        if (queue_id->tail == queue_id->head) {
+            if (queue_id->overflow) {
+                queue_id->overflow = 0;
+            }
+            return {
+                osOK,
+                0
+            };
+        }
+    }
+#endif
+
     while (queue_id->tail == queue_id->head) {
         if (queue_id->overflow) {
             queue_id->overflow = 0;
@@ -175,6 +333,11 @@ osStatus osMessagePut(osMessageQId queue_id, uint32_t info, uint32_t millisec) {
     if (queue_id->head == queue_id->tail) {
         queue_id->overflow = 1;
     }
+#ifndef __EMSCRIPTEN__
+    if (g_virtualTime) {
+        vtNotify();
+    }
+#endif
     return osOK;
 }
 
@@ -187,10 +350,9 @@ Mutex *osMutexCreate(Mutex &mutex) {
 }
 
 osStatus osMutexWait(Mutex *mutex, unsigned int timeout) {
-    while (mutex->locked) {
+    while (mutex->locked.exchange(true)) {
     	osDelay(1);
     }
-    mutex->locked = true;
     return osOK;
 }
 
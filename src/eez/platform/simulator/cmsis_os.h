@@ -2,6 +2,8 @@
 
 #include <stdint.h>
 
+#include <atomic>
+
 typedef enum {
     osOK = 0,
     osEventMessage = 0x10
@@ -10,7 +12,8 @@ typedef enum {
 typedef enum {
     osPriorityBelowNormal   = -1,
     osPriorityNormal = 0,
-    osPriorityAboveNormal = 1
+    osPriorityAboveNormal = 1,
+    osPriorityHigh = 2
 } osPriority;
 
 typedef void (*os_pthread)(void const *argument);
@@ -70,9 +73,29 @@ osStatus osKernelStart(void);
 osStatus osDelay(uint32_t millisec);
 
 uint32_t osKernelSysTick(void);
+uint64_t osKernelSysTickMicros(void); // in microseconds, never wraps around
+
+// Offset added to the kernel time (simulator only), e.g. to start the simulation
+// just before the point where 32-bit microseconds counter wraps around.
+void osKernelSetStartTime(uint64_t usec);
 
 extern uint32_t osKernelSysTickFrequency;
 
+// Virtual time (simulator only).
+// When enabled, osKernelSysTick, osDelay and osMessageGet timeouts are driven by
+// a virtual clock which is advanced to the next pending wake up time as soon as
+// every thread is waiting, i.e. the simulation runs as fast as the CPU allows.
+void osKernelSetVirtualTime(bool enable);
+bool osKernelIsVirtualTime();
+uint64_t osKernelVirtualTime(); // in microseconds
+uint64_t osKernelRealTime(); // in microseconds
+
+// Thread takes part in the virtual time from its first osDelay or osMessageGet.
+// Call this before the thread blocks anywhere else (stdin, blocking socket, ...),
+// otherwise virtual time would wait for it forever. Thread takes part again from
+// its next osDelay or osMessageGet.
+void osThreadLeaveVirtualTime();
+
 //
 
 #define osWaitForever     0xFFFFFFFF
@@ -112,7 +135,7 @@ uint32_t osMessageWaiting(osMessageQId queue_id);
 // Mutex
 
 struct Mutex {
-    bool locked;
+    std::atomic<bool> locked;
 };
 
 #define osMutexDef(mutex) Mutex mutex
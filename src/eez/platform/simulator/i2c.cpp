@@ -0,0 +1,140 @@
+/*
+ * EEZ Modular Firmware
+ * Copyright (C) 2015-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Simulated I2C bus with the register level model of the MAX31760 fan
+// controller, so fan.cpp runs the same code as on the target.
+
+#include <math.h>
+#include <string.h>
+
+#include <eez/platform/stm32/i2c.h>
+
+#include <eez/util.h>
+
+#include <eez/modules/psu/psu.h>
+#include <eez/modules/psu/temp_sensor.h>
+
+#include <eez/modules/aux_ps/fan.h>
+
+namespace eez {
+namespace psu {
+namespace i2c {
+
+////////////////////////////////////////////////////////////////////////////////
+// MAX31760 fan controller with the fan on TACH1 and the AUX temperature sensor
+// (local temperature)
+
+struct Max31760Model {
+    static const uint8_t DEVICE_ADDRESS = 0xAE;
+
+    static const uint8_t NUM_REGS = 0x5B;
+
+    static const uint8_t REG_CR2 = 0x01;
+    static const uint8_t REG_CR3 = 0x02;
+    static const uint8_t REG_PWMR = 0x50;
+    static const uint8_t REG_TC1H = 0x52;
+    static const uint8_t REG_TC1L = 0x53;
+    static const uint8_t REG_LTH = 0x58;
+    static const uint8_t REG_LTL = 0x59;
+    static const uint8_t REG_STATUS = 0x5A;
+
+    static const uint8_t CR2_STBY = 0x80;
+    static const uint8_t CR3_CLR_FAIL = 0x80;
+
+    static const int NUM_TACH_PULSES_PER_REVOLUTION = 2;
+
+    uint8_t regs[NUM_REGS];
+    uint8_t address;
+
+    int getRpm() {
+        uint8_t pwm = regs[REG_PWMR];
+        if ((regs[REG_CR2] & CR2_STBY) || pwm < FAN_MIN_PWM) {
+            return 0;
+        }
+        return (int)roundf(remap(pwm, FAN_MIN_PWM, 500, FAN_MAX_PWM, 3200));
+    }
+
+    uint8_t readReg(uint8_t reg) {
+        if (reg == REG_TC1H || reg == REG_TC1L) {
+            // TACH count is number of 100 kHz clock periods between two tach pulses
+            int rpm = getRpm();
+            uint16_t tc = rpm > 0 ? (uint16_t)MIN(60 * 100000 / NUM_TACH_PULSES_PER_REVOLUTION / rpm, 0xFFFF) : 0xFFFF;
+            return reg == REG_TC1H ? tc >> 8 : tc & 0xFF;
+        }
+
+        if (reg == REG_LTH || reg == REG_LTL) {
+            // 11 bits, 0.125 degree resolution, left aligned
+            int16_t t = (int16_t)roundf(simulator::getTemperature(temp_sensor::AUX) / 0.125f) << 5;
+            return reg == REG_LTH ? (uint8_t)(t >> 8) : (uint8_t)t;
+        }
+
+        return regs[reg];
+    }
+
+    void writeReg(uint8_t reg, uint8_t value) {
+        if (reg == REG_CR3) {
+            if (value & CR3_CLR_FAIL) {
+                regs[REG_STATUS] = 0;
+            }
+            value &= ~CR3_CLR_FAIL;
+        }
+        regs[reg] = value;
+    }
+
+    bool transmit(uint8_t *data, uint16_t size) {
+        if (size == 0 || data[0] >= NUM_REGS) {
+            return false;
+        }
+        address = data[0];
+        for (uint16_t i = 1; i < size; i++) {
+            writeReg(address, data[i]);
+            address = (address + 1) % NUM_REGS;
+        }
+        return true;
+    }
+
+    bool receive(uint8_t *data, uint16_t size) {
+        for (uint16_t i = 0; i < size; i++) {
+            data[i] = readReg(address);
+            address = (address + 1) % NUM_REGS;
+        }
+        return true;
+    }
+};
+
+static Max31760Model g_max31760;
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool transmit(uint8_t deviceAddress, uint8_t *data, uint16_t size, uint32_t timeout) {
+    if (deviceAddress == Max31760Model::DEVICE_ADDRESS) {
+        return g_max31760.transmit(data, size);
+    }
+    return false;
+}
+
+bool receive(uint8_t deviceAddress, uint8_t *data, uint16_t size, uint32_t timeout) {
+    if (deviceAddress == Max31760Model::DEVICE_ADDRESS) {
+        return g_max31760.receive(data, size);
+    }
+    return false;
+}
+
+} // namespace i2c
+} // namespace psu
+} // namespace eez
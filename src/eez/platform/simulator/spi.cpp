@@ -0,0 +1,763 @@
+/*
+ * EEZ Modular Firmware
+ * Copyright (C) 2015-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Simulated SPI bus. Every transfer is handed byte by byte to the register
+// level model of the chip selected in the slot, so DCP405/DCP505 drivers
+// (ioexp.cpp, adc.cpp and dac.cpp) and DCM220 driver run the same code as on
+// the target.
+
+#include <math.h>
+#include <string.h>
+
+#include <cmsis_os.h>
+
+#include <eez/platform/stm32/spi.h>
+
+#include <eez/index.h>
+#include <eez/system.h>
+#include <eez/util.h>
+
+#include <eez/modules/psu/psu.h>
+#include <eez/modules/psu/channel_dispatcher.h>
+#include <eez/modules/psu/temp_sensor.h>
+
+#include <eez/modules/dcpX05/adc.h>
+#include <eez/modules/dcpX05/dac.h>
+#include <eez/modules/dcpX05/ioexp.h>
+
+namespace eez {
+namespace psu {
+namespace spi {
+
+static bool isDcpX05(uint8_t slotIndex) {
+    auto &slot = g_slots[slotIndex];
+    return slot.moduleInfo->moduleType == MODULE_TYPE_DCP405 ||
+        slot.moduleInfo->moduleType == MODULE_TYPE_DCP405B ||
+        slot.moduleInfo->moduleType == MODULE_TYPE_DCP505;
+}
+
+static bool isDcm220(uint8_t slotIndex) {
+    auto &slot = g_slots[slotIndex];
+    return slot.moduleInfo->moduleType == MODULE_TYPE_DCM220 ||
+        slot.moduleInfo->moduleType == MODULE_TYPE_DCM224;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// I/O expander MCP23S17 (IOCON.BANK = 0 register map)
+
+struct IoExpanderModel {
+    static const uint8_t NUM_REGS = 22;
+
+    static const uint8_t REG_IODIRA = 0x00;
+    static const uint8_t REG_IPOLA = 0x02;
+    static const uint8_t REG_IOCON = 0x0A;
+    static const uint8_t REG_IOCON_ALT = 0x0B;
+    static const uint8_t REG_GPIOA = 0x12;
+    static const uint8_t REG_GPIOB = 0x13;
+    static const uint8_t REG_OLATA = 0x14;
+
+    static const uint8_t IOCON_SEQOP = 0B00100000;
+
+    bool poweredUp;
+    uint8_t regs[NUM_REGS];
+
+    int byteIndex;
+    bool readOp;
+    uint8_t address;
+
+    void powerUp() {
+        memset(regs, 0, sizeof(regs));
+        regs[REG_IODIRA] = 0xFF;
+        regs[REG_IODIRA + 1] = 0xFF;
+        poweredUp = true;
+    }
+
+    uint16_t getOutputs() {
+        return (regs[REG_OLATA + 1] << 8) | regs[REG_OLATA];
+    }
+
+    bool getOutput(int io_bit) {
+        return getOutputs() & (1 << io_bit) ? true : false;
+    }
+
+    uint8_t readReg(uint8_t slotIndex, uint8_t reg);
+    void writeReg(uint8_t reg, uint8_t value);
+
+    void select() {
+        if (!poweredUp) {
+            powerUp();
+        }
+        byteIndex = 0;
+    }
+
+    uint8_t transfer(uint8_t slotIndex, uint8_t input) {
+        uint8_t output = 0;
+
+        if (byteIndex == 0) {
+            readOp = input & 1;
+        } else if (byteIndex == 1) {
+            address = input;
+        } else {
+            if (address < NUM_REGS) {
+                if (readOp) {
+                    output = readReg(slotIndex, address);
+                } else {
+                    writeReg(address, input);
+                }
+            }
+
+            // with SEQOP disabled address pointer toggles between A and B register
+            if (regs[REG_IOCON] & IOCON_SEQOP) {
+                address ^= 1;
+            } else {
+                address = (address + 1) % NUM_REGS;
+            }
+        }
+
+        byteIndex++;
+
+        return output;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// ADC ADS1120
+
+struct AdcModel {
+    static const uint8_t CMD_RESET = 0B00000110;
+    static const uint8_t CMD_START = 0B00001000;
+    static const uint8_t CMD_POWERDOWN = 0B00000010;
+    static const uint8_t CMD_RDATA = 0B00010000;
+    static const uint8_t CMD_RREG = 0B00100000;
+    static const uint8_t CMD_WREG = 0B01000000;
+
+    enum State {
+        STATE_COMMAND,
+        STATE_RDATA,
+        STATE_RREG,
+        STATE_WREG
+    };
+
+    uint8_t regs[4];
+
+    State state;
+    uint8_t address;
+    uint8_t count;
+
+    bool converting;
+    uint32_t conversionStartTime;
+    int16_t conversionData;
+    int16_t data;
+
+    uint32_t getConversionTime() {
+        // data rate in normal mode, turbo mode doubles it and duty-cycle mode divides it by 4
+        static const uint32_t SPS[] = { 20, 45, 90, 175, 330, 600, 1000, 1000 };
+        uint32_t sps = SPS[regs[1] >> 5];
+        uint8_t mode = (regs[1] >> 3) & 3;
+        if (mode == 2) {
+            return 1000000 / (2 * sps);
+        }
+        if (mode == 1) {
+            return 4 * 1000000 / sps;
+        }
+        return 1000000 / sps;
+    }
+
+    bool isDataReady() {
+        return converting && micros() - conversionStartTime >= getConversionTime();
+    }
+
+    void start(uint8_t slotIndex);
+
+    void select() {
+        state = STATE_COMMAND;
+    }
+
+    uint8_t transfer(uint8_t slotIndex, uint8_t input) {
+        uint8_t output = 0;
+
+        if (state == STATE_COMMAND) {
+            if (input == CMD_RESET) {
+                memset(regs, 0, sizeof(regs));
+                converting = false;
+            } else if ((input & 0xFE) == CMD_START) {
+                start(slotIndex);
+            } else if ((input & 0xFE) == CMD_POWERDOWN) {
+                converting = false;
+            } else if ((input & 0xFE) == CMD_RDATA) {
+                if (isDataReady()) {
+                    data = conversionData;
+                }
+                // DRDY goes back high after data is read
+                converting = false;
+                state = STATE_RDATA;
+                count = 2;
+            } else if ((input & 0xF0) == CMD_RREG || (input & 0xF0) == CMD_WREG) {
+                state = (input & 0xF0) == CMD_RREG ? STATE_RREG : STATE_WREG;
+                address = (input >> 2) & 3;
+                count = (input & 3) + 1;
+            }
+        } else {
+            if (state == STATE_RDATA) {
+                output = count == 2 ? (uint8_t)(data >> 8) : (uint8_t)data;
+            } else if (state == STATE_RREG) {
+                output = regs[address++ & 3];
+            } else {
+                regs[address++ & 3] = input;
+            }
+
+            if (--count == 0) {
+                state = STATE_COMMAND;
+            }
+        }
+
+        return output;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// DAC DAC8552, buffer A is current and buffer B is voltage
+
+struct DacModel {
+    static const uint8_t CTRL_LDB = 0B00100000;
+    static const uint8_t CTRL_LDA = 0B00010000;
+    static const uint8_t CTRL_BUFFER_SELECT = 0B00000100;
+
+    uint8_t frame[3];
+    int byteIndex;
+
+    uint16_t buffer[2];
+    uint16_t output[2];
+
+    void select() {
+        byteIndex = 0;
+    }
+
+    uint8_t transfer(uint8_t slotIndex, uint8_t input) {
+        if (byteIndex < 3) {
+            frame[byteIndex++] = input;
+            if (byteIndex == 3) {
+                buffer[frame[0] & CTRL_BUFFER_SELECT ? 1 : 0] = (frame[1] << 8) | frame[2];
+                if (frame[0] & CTRL_LDA) {
+                    output[0] = buffer[0];
+                }
+                if (frame[0] & CTRL_LDB) {
+                    output[1] = buffer[1];
+                }
+            }
+        }
+        return 0;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// DCM220/DCM224 slave MCU. Master sends 20 bytes frame with output enables
+// and DAC values and at the same time receives the frame prepared after the
+// previous one: REG0 flags, U/I monitor ADC values, NTC ADC values and CRC.
+
+struct Dcm220Model {
+    static const uint8_t BUFFER_SIZE = 20;
+
+    static const uint8_t SPI_SLAVE_SYNBYTE = 0x53;
+    static const uint8_t SPI_MASTER_SYNBYTE = 0xAC;
+
+    static const uint8_t REG0_OE1_MASK = 1 << 0;
+    static const uint8_t REG0_CC1_MASK = 1 << 1;
+    static const uint8_t REG0_OE2_MASK = 1 << 2;
+    static const uint8_t REG0_CC2_MASK = 1 << 3;
+    static const uint8_t REG0_PWRGOOD_MASK = 1 << 4;
+
+    static const uint16_t DAC_MAX = 4095;
+    static const uint16_t ADC_MAX = 65535;
+
+    bool poweredUp;
+    bool irq;
+
+    uint8_t input[BUFFER_SIZE];
+    uint8_t output[BUFFER_SIZE];
+    int byteIndex;
+
+    void setSyncResponse() {
+        memset(output, 0, sizeof(output));
+        output[0] = SPI_SLAVE_SYNBYTE;
+        output[1] = 1; // firmware version 1.0
+        output[2] = 0;
+        // idw0, idw1 and idw2 (STM32 unique ID)
+        for (int i = 3; i < 15; i++) {
+            output[i] = 0x10 + i;
+        }
+    }
+
+    void select() {
+        if (!poweredUp) {
+            setSyncResponse();
+            irq = true;
+            poweredUp = true;
+        }
+        byteIndex = 0;
+        memset(input, 0, sizeof(input));
+        irq = false;
+    }
+
+    uint8_t transfer(uint8_t input_) {
+        uint8_t result = 0;
+        if (byteIndex < BUFFER_SIZE) {
+            result = output[byteIndex];
+            input[byteIndex++] = input_;
+        }
+        return result;
+    }
+
+    void deselect(uint8_t slotIndex);
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+static IoExpanderModel g_ioexp[NUM_SLOTS];
+static AdcModel g_adc[NUM_SLOTS];
+static DacModel g_dac[NUM_SLOTS];
+static Dcm220Model g_dcm220[NUM_SLOTS];
+
+static int g_selectedChip[NUM_SLOTS];
+
+// On STM32 select enters critical section (see platform/stm32/spi.cpp),
+// here the slot is locked until deselect, e.g. waveform thread writes the DAC
+// while PSU thread could use the same slot.
+static Mutex g_slotMutex[NUM_SLOTS];
+
+static Stats g_stats[NUM_SLOTS];
+static uint64_t g_timeNs[NUM_SLOTS];
+static uint32_t g_timeInTickNs[NUM_SLOTS];
+
+////////////////////////////////////////////////////////////////////////////////
+// Analog part of the channel, driven by DAC and I/O expander outputs.
+// Ideal source with the resistive load set on the simulator front panel.
+
+static float g_uMon[CH_MAX];
+static float g_iMon[CH_MAX];
+
+static float getUSet(Channel &channel) {
+    return remap(g_dac[channel.slotIndex].output[1], (float)DigitalAnalogConverter::DAC_MIN, channel.params.U_MIN, (float)DigitalAnalogConverter::DAC_MAX, channel.params.U_MAX);
+}
+
+static float getISet(Channel &channel) {
+    return remap(g_dac[channel.slotIndex].output[0], (float)DigitalAnalogConverter::DAC_MIN, channel.params.I_MIN, (float)DigitalAnalogConverter::DAC_MAX, channel.getDualRangeMax());
+}
+
+static void updateValues(Channel &channel) {
+    int channelIndex = channel.channelIndex;
+
+    bool series = false;
+    bool parallel = false;
+    Channel &channel0 = Channel::get(0);
+    Channel &channel1 = Channel::get(1);
+    if (channelIndex == 0 || channelIndex == 1) {
+        if (channel_dispatcher::getCouplingType() == channel_dispatcher::COUPLING_TYPE_SERIES) {
+            series = true;
+        } else if (channel_dispatcher::getCouplingType() == channel_dispatcher::COUPLING_TYPE_PARALLEL) {
+            parallel = true;
+        }
+    }
+
+    if (series || parallel) {
+        if (channelIndex == 1) {
+            return;
+        }
+    }
+
+    IoExpanderModel &ioexp = g_ioexp[channel.slotIndex];
+    bool remoteProgramming = ioexp.getOutput(IOExpander::IO_BIT_OUT_REMOTE_PROGRAMMING);
+
+    if (channel.simulator.getLoadEnabled()) {
+        float u_set_v;
+        if (series) {
+            u_set_v = remoteProgramming
+                ? remap(channel0.simulator.voltProgExt + channel1.simulator.voltProgExt, 0, 0, 2.5, channel.u.max)
+                : getUSet(channel0) + getUSet(channel1);
+        } else {
+            u_set_v = remoteProgramming
+                ? remap(channel.simulator.voltProgExt, 0, 0, 2.5, channel.u.max)
+                : getUSet(channel);
+        }
+
+        float i_set_a;
+        if (parallel) {
+            i_set_a = getISet(channel0) + getISet(channel1);
+        } else {
+            i_set_a = getISet(channel);
+        }
+
+        float u_mon_v = i_set_a * channel.simulator.load;
+        float i_mon_a = i_set_a;
+        if (u_mon_v > u_set_v) {
+            u_mon_v = u_set_v;
+            i_mon_a = u_set_v / channel.simulator.load;
+
+            simulator::setCV(channel.channelIndex, true);
+            simulator::setCC(channel.channelIndex, false);
+        } else {
+            simulator::setCV(channel.channelIndex, false);
+            simulator::setCC(channel.channelIndex, true);
+        }
+
+        if (series) {
+            g_uMon[0] = u_mon_v / 2;
+            g_uMon[1] = u_mon_v / 2;
+        } else {
+            g_uMon[channelIndex] = u_mon_v;
+        }
+
+        if (parallel) {
+            g_iMon[0] = i_mon_a / 2;
+            g_iMon[1] = i_mon_a / 2;
+        } else {
+            g_iMon[channelIndex] = i_mon_a;
+        }
+
+        return;
+    } else {
+        if (ioexp.getOutput(IOExpander::IO_BIT_OUT_OUTPUT_ENABLE)) {
+            if (series) {
+                g_uMon[0] = getUSet(channel0);
+                g_uMon[1] = getUSet(channel1);
+            } else {
+                g_uMon[channelIndex] = getUSet(channel);
+            }
+
+            if (series) {
+                g_iMon[0] = 0;
+                g_iMon[1] = 0;
+            } else {
+                g_iMon[channelIndex] = 0;
+            }
+
+            if (getUSet(channel) > 0 && getISet(channel) > 0) {
+                simulator::setCV(channel.channelIndex, true);
+                simulator::setCC(channel.channelIndex, false);
+            } else {
+                simulator::setCV(channel.channelIndex, false);
+                simulator::setCC(channel.channelIndex, true);
+            }
+            return;
+        }
+    }
+
+    g_uMon[channelIndex] = 0;
+    g_iMon[channelIndex] = 0;
+    simulator::setCV(channel.channelIndex, true);
+    simulator::setCC(channel.channelIndex, false);
+}
+
+static uint16_t getIoExpanderInputs(uint8_t slotIndex) {
+    Channel &channel = Channel::getBySlotIndex(slotIndex);
+    auto &slot = g_slots[slotIndex];
+
+    updateValues(channel);
+
+    uint16_t inputs = 0;
+
+    if (!simulator::getRPol(channel.channelIndex)) {
+        inputs |= 1 << IOExpander::IO_BIT_IN_RPOL;
+    }
+
+    if (simulator::getCC(channel.channelIndex)) {
+        inputs |= 1 << IOExpander::IO_BIT_IN_CC_ACTIVE;
+    }
+
+    if (simulator::getCV(channel.channelIndex)) {
+        inputs |= 1 << IOExpander::IO_BIT_IN_CV_ACTIVE;
+    }
+
+    if (simulator::getPwrgood(channel.channelIndex)) {
+        inputs |= 1 << IOExpander::IO_BIT_IN_PWRGOOD;
+    }
+
+    // DRDY is active low
+    bool adcReady = g_adc[slotIndex].isDataReady();
+    if (slot.moduleInfo->moduleType == MODULE_TYPE_DCP505) {
+        if (!adcReady) {
+            inputs |= 1 << IOExpander::DCP505_IO_BIT_IN_ADC_DRDY;
+        }
+    } else {
+        if (!adcReady) {
+            inputs |= 1 << IOExpander::DCP405_IO_BIT_IN_ADC_DRDY;
+        }
+
+        // HW OVP fault is active low
+        if (slot.moduleInfo->moduleType == MODULE_TYPE_DCP405 && slot.moduleRevision >= MODULE_REVISION_DCP405_R2B5) {
+            inputs |= 1 << IOExpander::DCP405_R2B5_IO_BIT_IN_OVP_FAULT;
+        }
+    }
+
+    return inputs;
+}
+
+uint8_t IoExpanderModel::readReg(uint8_t slotIndex, uint8_t reg) {
+    if (reg == REG_GPIOA || reg == REG_GPIOB) {
+        int port = reg - REG_GPIOA;
+        uint8_t inputs = (uint8_t)(getIoExpanderInputs(slotIndex) >> (8 * port)) ^ regs[REG_IPOLA + port];
+        uint8_t iodir = regs[REG_IODIRA + port];
+        return (regs[REG_OLATA + port] & ~iodir) | (inputs & iodir);
+    }
+    return regs[reg];
+}
+
+void IoExpanderModel::writeReg(uint8_t reg, uint8_t value) {
+    if (reg == REG_GPIOA || reg == REG_GPIOB) {
+        regs[REG_OLATA + reg - REG_GPIOA] = value;
+    } else if (reg == REG_IOCON || reg == REG_IOCON_ALT) {
+        regs[REG_IOCON] = value;
+        regs[REG_IOCON_ALT] = value;
+    } else {
+        regs[reg] = value;
+    }
+}
+
+void AdcModel::start(uint8_t slotIndex) {
+    Channel &channel = Channel::getBySlotIndex(slotIndex);
+
+    updateValues(channel);
+
+    // input multiplexer, AINP: AIN0 is U_MON, AIN1 is I_SET, AIN2 is U_SET and AIN3 is I_MON
+    uint8_t mux = regs[0] >> 4;
+
+    float value;
+    if (mux == 0x8) {
+        value = remap(g_uMon[channel.channelIndex], channel.params.U_MIN, (float)AnalogDigitalConverter::ADC_MIN, channel.params.U_MAX, (float)AnalogDigitalConverter::ADC_MAX) + simulator::getNoise();
+    } else if (mux == 0x9) {
+        value = remap(getISet(channel), channel.params.I_MIN, (float)AnalogDigitalConverter::ADC_MIN, channel.getDualRangeMax(), (float)AnalogDigitalConverter::ADC_MAX);
+    } else if (mux == 0xA) {
+        value = remap(getUSet(channel), channel.params.U_MIN, (float)AnalogDigitalConverter::ADC_MIN, channel.params.U_MAX, (float)AnalogDigitalConverter::ADC_MAX);
+    } else if (mux == 0xB) {
+        value = remap(g_iMon[channel.channelIndex], channel.params.I_MIN, (float)AnalogDigitalConverter::ADC_MIN, channel.getDualRangeMax(), (float)AnalogDigitalConverter::ADC_MAX) + simulator::getNoise();
+    } else {
+        value = 0;
+    }
+
+    conversionData = (int16_t)clamp(roundf(value), (float)AnalogDigitalConverter::ADC_MIN, (float)AnalogDigitalConverter::ADC_MAX);
+    conversionStartTime = micros();
+    converting = true;
+}
+
+// NTC voltage divider, inverse of dcm220::calcTemperature
+static uint16_t getDcm220TemperatureAdc(float temperature) {
+    static const float RF = 3300.0f;
+    static const float T25 = 298.15f;
+    static const float R25 = 10000.0f;
+    static const float BETA = 3570.0f;
+    static const float ADC_MAX_FOR_TEMP = 4095.0f;
+    static const float TEMP_OFFSET = 10.0f;
+
+    float Tkelvin = temperature + TEMP_OFFSET + 273.15f;
+    float RT = R25 * expf(BETA * (1 / Tkelvin - 1 / T25));
+    return (uint16_t)roundf(ADC_MAX_FOR_TEMP * RF / (RF + RT));
+}
+
+void Dcm220Model::deselect(uint8_t slotIndex) {
+    if (input[0] == SPI_MASTER_SYNBYTE) {
+        setSyncResponse();
+        irq = true;
+        return;
+    }
+
+    auto &slot = g_slots[slotIndex];
+    float iMaxForRemap = slot.moduleInfo->moduleType == MODULE_TYPE_DCM224 ? 5.0f : 4.1667f;
+
+    uint16_t *dacValues = (uint16_t *)(input + 2);
+    uint16_t *adcValues = (uint16_t *)(output + 2);
+    uint16_t *temperatureValues = (uint16_t *)(output + 10);
+
+    memset(output, 0, sizeof(output));
+
+    bool pwrGood = true;
+
+    for (int subchannelIndex = 0; subchannelIndex < 2; subchannelIndex++) {
+        Channel &channel = Channel::getBySlotIndex(slotIndex, subchannelIndex);
+
+        bool outputEnabled = input[0] & (subchannelIndex == 0 ? REG0_OE1_MASK : REG0_OE2_MASK) ? true : false;
+        float u_set_v = remap(dacValues[2 * subchannelIndex], 0, 0, (float)DAC_MAX, channel.params.U_MAX);
+        float i_set_a = remap(dacValues[2 * subchannelIndex + 1], 0, 0, (float)DAC_MAX, iMaxForRemap);
+
+        float u_mon_v = 0;
+        float i_mon_a = 0;
+        bool cc = false;
+        if (outputEnabled) {
+            if (channel.simulator.getLoadEnabled()) {
+                u_mon_v = i_set_a * channel.simulator.load;
+                i_mon_a = i_set_a;
+                if (u_mon_v > u_set_v) {
+                    u_mon_v = u_set_v;
+                    i_mon_a = u_set_v / channel.simulator.load;
+                } else {
+                    cc = true;
+                }
+            } else {
+                u_mon_v = u_set_v;
+                cc = u_set_v <= 0 || i_set_a <= 0;
+            }
+        }
+
+        simulator::setCC(channel.channelIndex, cc);
+        if (cc) {
+            output[0] |= subchannelIndex == 0 ? REG0_CC1_MASK : REG0_CC2_MASK;
+        }
+
+        if (!simulator::getPwrgood(channel.channelIndex)) {
+            pwrGood = false;
+        }
+
+        // I_MON full scale is 2 V at 2.5 V reference
+        float uMonAdc = remap(u_mon_v, 0, 0, channel.params.U_MAX, (float)ADC_MAX) + simulator::getNoise();
+        float iMonAdc = remap(i_mon_a, 0, 0, iMaxForRemap, 2.0f * ADC_MAX / 2.5f) + simulator::getNoise();
+        adcValues[2 * subchannelIndex] = (uint16_t)clamp(roundf(uMonAdc), 0, (float)ADC_MAX);
+        adcValues[2 * subchannelIndex + 1] = (uint16_t)clamp(roundf(iMonAdc), 0, (float)ADC_MAX);
+
+        temperatureValues[subchannelIndex] = getDcm220TemperatureAdc(simulator::getTemperature(temp_sensor::CH1 + channel.channelIndex));
+    }
+
+    if (pwrGood) {
+        output[0] |= REG0_PWRGOOD_MASK;
+    }
+
+    uint32_t crc = crc32(output, BUFFER_SIZE - 4);
+    memcpy(output + BUFFER_SIZE - 4, &crc, 4);
+
+    irq = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Bus time on the target: SPI2 (slot 1) is clocked from APB1 at 54 MHz,
+// SPI4 and SPI5 (slots 2 and 3) from APB2 at 108 MHz. DCM220 uses prescaler 64,
+// all other chips prescaler 16.
+static uint32_t getTransferTimeNs(uint8_t slotIndex, uint16_t size) {
+    uint32_t pclkMHz = slotIndex == 0 ? 54 : 108;
+    uint32_t prescaler = g_selectedChip[slotIndex] == CHIP_DCM220 ? 64 : 16;
+    return size * 8 * prescaler * 1000 / pclkMHz;
+}
+
+static void addStats(uint8_t slotIndex, uint16_t size) {
+    uint32_t time = getTransferTimeNs(slotIndex, size);
+    g_stats[slotIndex].numTransfers++;
+    g_stats[slotIndex].numBytes += size;
+    g_timeNs[slotIndex] += time;
+    g_timeInTickNs[slotIndex] += time;
+}
+
+static uint8_t transferByte(uint8_t slotIndex, uint8_t input) {
+    int chip = g_selectedChip[slotIndex];
+
+    if (isDcm220(slotIndex)) {
+        return chip == CHIP_DCM220 ? g_dcm220[slotIndex].transfer(input) : 0;
+    }
+
+    if (!isDcpX05(slotIndex)) {
+        return 0;
+    }
+
+    if (chip == CHIP_IOEXP) {
+        return g_ioexp[slotIndex].transfer(slotIndex, input);
+    }
+    if (chip == CHIP_ADC) {
+        return g_adc[slotIndex].transfer(slotIndex, input);
+    }
+    if (chip == CHIP_DAC) {
+        return g_dac[slotIndex].transfer(slotIndex, input);
+    }
+    return 0;
+}
+
+void init(uint8_t slotIndex, int chip) {
+}
+
+void select(uint8_t slotIndex, int chip) {
+    osMutexWait(&g_slotMutex[slotIndex], osWaitForever);
+
+    g_selectedChip[slotIndex] = chip;
+
+    if (chip == CHIP_IOEXP) {
+        g_ioexp[slotIndex].select();
+    } else if (chip == CHIP_ADC) {
+        g_adc[slotIndex].select();
+    } else if (chip == CHIP_DAC) {
+        g_dac[slotIndex].select();
+    } else if (chip == CHIP_DCM220) {
+        g_dcm220[slotIndex].select();
+    }
+}
+
+void deselect(uint8_t slotIndex) {
+    if (g_selectedChip[slotIndex] == CHIP_DCM220 && isDcm220(slotIndex)) {
+        g_dcm220[slotIndex].deselect(slotIndex);
+    }
+    g_selectedChip[slotIndex] = -1;
+
+    osMutexRelease(&g_slotMutex[slotIndex]);
+}
+
+void transfer(uint8_t slotIndex, uint8_t *input, uint8_t *output, uint16_t size) {
+    for (uint16_t i = 0; i < size; i++) {
+        output[i] = transferByte(slotIndex, input[i]);
+    }
+    addStats(slotIndex, size);
+}
+
+void transmit(uint8_t slotIndex, uint8_t *input, uint16_t size) {
+    for (uint16_t i = 0; i < size; i++) {
+        transferByte(slotIndex, input[i]);
+    }
+    addStats(slotIndex, size);
+}
+
+void receive(uint8_t slotIndex, uint8_t *output, uint16_t size) {
+    for (uint16_t i = 0; i < size; i++) {
+        output[i] = transferByte(slotIndex, 0);
+    }
+    addStats(slotIndex, size);
+}
+
+bool isIrqSet(uint8_t slotIndex) {
+    return isDcm220(slotIndex) && g_dcm220[slotIndex].irq;
+}
+
+void tick() {
+    for (int slotIndex = 0; slotIndex < NUM_SLOTS; slotIndex++) {
+        g_stats[slotIndex].numTicks++;
+        uint32_t timeInTick = g_timeInTickNs[slotIndex] / 1000;
+        if (timeInTick > g_stats[slotIndex].maxTimePerTick) {
+            g_stats[slotIndex].maxTimePerTick = timeInTick;
+        }
+        g_timeInTickNs[slotIndex] = 0;
+    }
+}
+
+void getStats(uint8_t slotIndex, Stats &stats) {
+    stats = g_stats[slotIndex];
+    stats.time = (uint32_t)(g_timeNs[slotIndex] / 1000);
+}
+
+void resetStats() {
+    for (int slotIndex = 0; slotIndex < NUM_SLOTS; slotIndex++) {
+        memset(&g_stats[slotIndex], 0, sizeof(Stats));
+        g_timeNs[slotIndex] = 0;
+    }
+}
+
+} // namespace spi
+} // namespace psu
+} // namespace eez
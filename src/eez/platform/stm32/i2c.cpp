@@ -0,0 +1,44 @@
+/*
+ * EEZ Modular Firmware
+ * Copyright (C) 2015-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <i2c.h>
+#include <cmsis_os.h>
+
+#include <eez/platform/stm32/i2c.h>
+
+namespace eez {
+namespace psu {
+namespace i2c {
+
+bool transmit(uint8_t deviceAddress, uint8_t *data, uint16_t size, uint32_t timeout) {
+    taskENTER_CRITICAL();
+    HAL_StatusTypeDef returnValue = HAL_I2C_Master_Transmit(&hi2c1, deviceAddress, data, size, timeout);
+    taskEXIT_CRITICAL();
+    return returnValue == HAL_OK;
+}
+
+bool receive(uint8_t deviceAddress, uint8_t *data, uint16_t size, uint32_t timeout) {
+    taskENTER_CRITICAL();
+    HAL_StatusTypeDef returnValue = HAL_I2C_Master_Receive(&hi2c1, deviceAddress, data, size, timeout);
+    taskEXIT_CRITICAL();
+    return returnValue == HAL_OK;
+}
+
+} // namespace i2c
+} // namespace psu
+} // namespace eez
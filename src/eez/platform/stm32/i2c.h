@@ -0,0 +1,34 @@
+/*
+ * EEZ Modular Firmware
+ * Copyright (C) 2015-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+namespace eez {
+namespace psu {
+namespace i2c {
+
+// Master transfers on the I2C1 bus (fan controller, module EEPROMs, ...),
+// return false on NACK or timeout.
+bool transmit(uint8_t deviceAddress, uint8_t *data, uint16_t size, uint32_t timeout);
+bool receive(uint8_t deviceAddress, uint8_t *data, uint16_t size, uint32_t timeout);
+
+} // namespace i2c
+} // namespace psu
+} // namespace eez
@@ -16,12 +16,15 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <string.h>
+
 #include <spi.h>
 #include <cmsis_os.h>
 
 #include <eez/platform/stm32/spi.h>
 
 #include <eez/index.h>
+#include <eez/system.h>
 
 namespace eez {
 namespace psu {
@@ -35,6 +38,39 @@ static GPIO_TypeDef *SPI_CSB_GPIO_Port[] = { SPI2_CSB_GPIO_Port, SPI4_CSB_GPIO_P
 static const uint16_t SPI_CSA_Pin[] = { SPI2_CSA_Pin, SPI4_CSA_Pin, SPI5_CSA_Pin };
 static const uint16_t SPI_CSB_Pin[] = { SPI2_CSB_Pin, SPI4_CSB_Pin, SPI5_CSB_Pin };
 
+static GPIO_TypeDef *SPI_IRQ_GPIO_Port[] = { SPI2_IRQ_GPIO_Port, SPI4_IRQ_GPIO_Port, SPI5_IRQ_GPIO_Port };
+static const uint16_t SPI_IRQ_Pin[] = { SPI2_IRQ_Pin, SPI4_IRQ_Pin, SPI5_IRQ_Pin };
+
+static Stats g_stats[NUM_SLOTS];
+
+// Transfers are timed in CPU cycles. micros() can't be used here because it
+// depends on the TIM7 interrupt, which is masked between select and deselect.
+static uint64_t g_cycles[NUM_SLOTS];
+static uint32_t g_cyclesInTick[NUM_SLOTS];
+static uint32_t g_maxCyclesPerTick[NUM_SLOTS];
+
+static uint32_t getCycleCount() {
+    if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->LAR = 0xC5ACCE55; // unlock DWT registers
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    return DWT->CYCCNT;
+}
+
+static uint32_t cyclesToMicros(uint64_t cycles) {
+    return (uint32_t)(cycles / (SystemCoreClock / 1000000));
+}
+
+static void addStats(uint8_t slotIndex, uint16_t size, uint32_t startCycles) {
+    uint32_t cycles = getCycleCount() - startCycles;
+    g_stats[slotIndex].numTransfers++;
+    g_stats[slotIndex].numBytes += size;
+    g_cycles[slotIndex] += cycles;
+    g_cyclesInTick[slotIndex] += cycles;
+}
+
 void init(uint8_t slotIndex, int chip) {
     // if (chip == CHIP_IOEXP ) {
     // 	spiHandle[slotIndex]->Init.Direction = SPI_DIRECTION_2LINES;
@@ -153,15 +189,49 @@ void deselect(uint8_t slotIndex) {
 }
 
 void transfer(uint8_t slotIndex, uint8_t *input, uint8_t *output, uint16_t size) {
+    uint32_t startCycles = getCycleCount();
     HAL_SPI_TransmitReceive(spiHandle[slotIndex], input, output, size, 10);
+    addStats(slotIndex, size, startCycles);
 }
 
 void transmit(uint8_t slotIndex, uint8_t *input, uint16_t size) {
+    uint32_t startCycles = getCycleCount();
     HAL_SPI_Transmit(spiHandle[slotIndex], input, size, 10);
+    addStats(slotIndex, size, startCycles);
 }
 
 void receive(uint8_t slotIndex, uint8_t *output, uint16_t size) {
+    uint32_t startCycles = getCycleCount();
     HAL_SPI_Receive(spiHandle[slotIndex], output, size, 10);
+    addStats(slotIndex, size, startCycles);
+}
+
+bool isIrqSet(uint8_t slotIndex) {
+    return HAL_GPIO_ReadPin(SPI_IRQ_GPIO_Port[slotIndex], SPI_IRQ_Pin[slotIndex]) == GPIO_PIN_SET;
+}
+
+void tick() {
+    for (int slotIndex = 0; slotIndex < NUM_SLOTS; slotIndex++) {
+        g_stats[slotIndex].numTicks++;
+        if (g_cyclesInTick[slotIndex] > g_maxCyclesPerTick[slotIndex]) {
+            g_maxCyclesPerTick[slotIndex] = g_cyclesInTick[slotIndex];
+        }
+        g_cyclesInTick[slotIndex] = 0;
+    }
+}
+
+void getStats(uint8_t slotIndex, Stats &stats) {
+    stats = g_stats[slotIndex];
+    stats.time = cyclesToMicros(g_cycles[slotIndex]);
+    stats.maxTimePerTick = cyclesToMicros(g_maxCyclesPerTick[slotIndex]);
+}
+
+void resetStats() {
+    for (int slotIndex = 0; slotIndex < NUM_SLOTS; slotIndex++) {
+        memset(&g_stats[slotIndex], 0, sizeof(Stats));
+        g_cycles[slotIndex] = 0;
+        g_maxCyclesPerTick[slotIndex] = 0;
+    }
 }
 
 } // namespace spi
@@ -39,6 +39,24 @@ void transfer(uint8_t slotIndex, uint8_t *input, uint8_t *output, uint16_t size)
 void transmit(uint8_t slotIndex, uint8_t *input, uint16_t size);
 void receive(uint8_t slotIndex, uint8_t *output, uint16_t size);
 
+// SPIx_IRQ line, set by the module slave (DCM220) when it is ready
+bool isIrqSet(uint8_t slotIndex);
+
+// Bus usage statistics, per slot. Transfers are synchronous (polled HAL calls
+// with interrupts masked from select to deselect), so time is also the CPU
+// time the PSU thread spends on SPI.
+struct Stats {
+    uint32_t numTicks;
+    uint32_t numTransfers;
+    uint32_t numBytes;
+    uint32_t time; // time spent in transfers, in microseconds
+    uint32_t maxTimePerTick; // in microseconds
+};
+
+void tick(); // called once per PSU tick
+void getStats(uint8_t slotIndex, Stats &stats);
+void resetStats();
+
 } // namespace spi
 } // namespace psu
 } // namespace eez
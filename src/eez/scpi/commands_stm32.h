@@ -19,6 +19,8 @@
     SCPI_COMMAND("ABORt:DLOG", scpi_cmd_abortDlog) \
     SCPI_COMMAND("CALibration:CLEar", scpi_cmd_calibrationClear) \
     SCPI_COMMAND("CALibration:CURRent:LEVel", scpi_cmd_calibrationCurrentLevel) \
+    SCPI_COMMAND("CALibration:CURRent:MODel", scpi_cmd_calibrationCurrentModel) \
+    SCPI_COMMAND("CALibration:CURRent:MODel?", scpi_cmd_calibrationCurrentModelQ) \
     SCPI_COMMAND("CALibration:CURRent:RANGe", scpi_cmd_calibrationCurrentRange) \
     SCPI_COMMAND("CALibration:CURRent[:DATA]", scpi_cmd_calibrationCurrentData) \
     SCPI_COMMAND("CALibration:PASSword:NEW", scpi_cmd_calibrationPasswordNew) \
@@ -28,6 +30,8 @@
     SCPI_COMMAND("CALibration:STATe", scpi_cmd_calibrationState) \
     SCPI_COMMAND("CALibration:STATe?", scpi_cmd_calibrationStateQ) \
     SCPI_COMMAND("CALibration:VOLTage:LEVel", scpi_cmd_calibrationVoltageLevel) \
+    SCPI_COMMAND("CALibration:VOLTage:MODel", scpi_cmd_calibrationVoltageModel) \
+    SCPI_COMMAND("CALibration:VOLTage:MODel?", scpi_cmd_calibrationVoltageModelQ) \
     SCPI_COMMAND("CALibration:VOLTage[:DATA]", scpi_cmd_calibrationVoltageData) \
     SCPI_COMMAND("CALibration[:MODE]", scpi_cmd_calibrationMode) \
     SCPI_COMMAND("CALibration[:MODE]?", scpi_cmd_calibrationModeQ) \
@@ -37,6 +41,13 @@
     SCPI_COMMAND("DIAGnostic[:INFOrmation]:PROTection?", scpi_cmd_diagnosticInformationProtectionQ) \
     SCPI_COMMAND("DIAGnostic[:INFOrmation]:TEST?", scpi_cmd_diagnosticInformationTestQ) \
     SCPI_COMMAND("DIAGnostic[:INFOrmation]:REGS?", scpi_cmd_diagnosticInformationRegsQ) \
+    SCPI_COMMAND("DIAGnostic[:INFOrmation]:BOOT?", scpi_cmd_diagnosticInformationBootQ) \
+    SCPI_COMMAND("DIAGnostic[:INFOrmation]:SPI?", scpi_cmd_diagnosticInformationSpiQ) \
+    SCPI_COMMAND("DIAGnostic[:INFOrmation]:SETPoint?", scpi_cmd_diagnosticInformationSetpointQ) \
+    SCPI_COMMAND("DIAGnostic[:INFOrmation]:CPU?", scpi_cmd_diagnosticInformationCpuQ) \
+    SCPI_COMMAND("DIAGnostic[:INFOrmation]:TRIGger?", scpi_cmd_diagnosticInformationTriggerQ) \
+    SCPI_COMMAND("DIAGnostic[:INFOrmation]:FLOat?", scpi_cmd_diagnosticInformationFloatQ) \
+    SCPI_COMMAND("DIAGnostic[:INFOrmation]:SCReenshot?", scpi_cmd_diagnosticInformationScreenshotQ) \
     SCPI_COMMAND("DISPlay:BRIGhtness", scpi_cmd_displayBrightness) \
     SCPI_COMMAND("DISPlay:BRIGhtness?", scpi_cmd_displayBrightnessQ) \
     SCPI_COMMAND("DISPlay:VIEW", scpi_cmd_displayView) \
@@ -55,6 +66,7 @@
     SCPI_COMMAND("DISPlay[:WINdow]:DIALog:DATA", scpi_cmd_displayWindowDialogData) \
     SCPI_COMMAND("DISPlay[:WINdow]:DIALog:CLOSe", scpi_cmd_displayWindowDialogClose) \
     SCPI_COMMAND("DISPlay[:WINdow]:ERRor", scpi_cmd_displayWindowError) \
+    SCPI_COMMAND("DLOG:EXPort", scpi_cmd_dlogExport) \
     SCPI_COMMAND("INITiate:CONTinuous", scpi_cmd_initiateContinuous) \
     SCPI_COMMAND("INITiate:CONTinuous?", scpi_cmd_initiateContinuousQ) \
     SCPI_COMMAND("INITiate:DLOG", scpi_cmd_initiateDlog) \
@@ -76,7 +88,10 @@
     SCPI_COMMAND("INSTrument[:SELect]?", scpi_cmd_instrumentSelectQ) \
     SCPI_COMMAND("INSTrument:MEMOry", scpi_cmd_instrumentMemory) \
     SCPI_COMMAND("MEASure[:SCALar]:CURRent[:DC]?", scpi_cmd_measureScalarCurrentDcQ) \
+    SCPI_COMMAND("MEASure[:SCALar]:ENERgy?", scpi_cmd_measureScalarEnergyQ) \
     SCPI_COMMAND("MEASure[:SCALar]:POWer[:DC]?", scpi_cmd_measureScalarPowerDcQ) \
+    SCPI_COMMAND("MEASure[:SCALar]:STATistics?", scpi_cmd_measureScalarStatisticsQ) \
+    SCPI_COMMAND("MEASure:STATistics:RESet", scpi_cmd_measureStatisticsReset) \
     SCPI_COMMAND("MEASure[:SCALar][:VOLTage][:DC]?", scpi_cmd_measureScalarVoltageDcQ) \
     SCPI_COMMAND("MEMory:NSTates?", scpi_cmd_memoryNstatesQ) \
     SCPI_COMMAND("MEMory:STATe:CATalog?", scpi_cmd_memoryStateCatalogQ) \
@@ -103,6 +118,7 @@
     SCPI_COMMAND("MMEMory:DOWNload:FNAMe", scpi_cmd_mmemoryDownloadFname) \
     SCPI_COMMAND("MMEMory:DOWNload:SIZE", scpi_cmd_mmemoryDownloadSize) \
     SCPI_COMMAND("MMEMory:INFOrmation?", scpi_cmd_mmemoryInformationQ) \
+    SCPI_COMMAND("MMEMory:LOAD:FUNCtion#", scpi_cmd_mmemoryLoadFunction) \
     SCPI_COMMAND("MMEMory:LOAD:LIST#", scpi_cmd_mmemoryLoadList) \
     SCPI_COMMAND("MMEMory:LOAD:PROFile", scpi_cmd_mmemoryLoadProfile) \
     SCPI_COMMAND("MMEMory:LOCK", scpi_cmd_mmemoryLock) \
@@ -184,6 +200,20 @@
     SCPI_COMMAND("[SOURce#]:CURRent[:LEVel][:IMMediate][:AMPLitude]?", scpi_cmd_sourceCurrentLevelImmediateAmplitudeQ) \
     SCPI_COMMAND("[SOURce#]:CURRent:RAMP:DURation", scpi_cmd_sourceCurrentRampDuration) \
     SCPI_COMMAND("[SOURce#]:CURRent:RAMP:DURation?", scpi_cmd_sourceCurrentRampDurationQ) \
+    SCPI_COMMAND("[SOURce#]:FUNCtion:AMPLitude", scpi_cmd_sourceFunctionAmplitude) \
+    SCPI_COMMAND("[SOURce#]:FUNCtion:AMPLitude?", scpi_cmd_sourceFunctionAmplitudeQ) \
+    SCPI_COMMAND("[SOURce#]:FUNCtion:COUNt", scpi_cmd_sourceFunctionCount) \
+    SCPI_COMMAND("[SOURce#]:FUNCtion:COUNt?", scpi_cmd_sourceFunctionCountQ) \
+    SCPI_COMMAND("[SOURce#]:FUNCtion:FREQuency", scpi_cmd_sourceFunctionFrequency) \
+    SCPI_COMMAND("[SOURce#]:FUNCtion:FREQuency?", scpi_cmd_sourceFunctionFrequencyQ) \
+    SCPI_COMMAND("[SOURce#]:FUNCtion:OFFSet", scpi_cmd_sourceFunctionOffset) \
+    SCPI_COMMAND("[SOURce#]:FUNCtion:OFFSet?", scpi_cmd_sourceFunctionOffsetQ) \
+    SCPI_COMMAND("[SOURce#]:FUNCtion:PHASe", scpi_cmd_sourceFunctionPhase) \
+    SCPI_COMMAND("[SOURce#]:FUNCtion:PHASe?", scpi_cmd_sourceFunctionPhaseQ) \
+    SCPI_COMMAND("[SOURce#]:FUNCtion:SHAPe", scpi_cmd_sourceFunctionShape) \
+    SCPI_COMMAND("[SOURce#]:FUNCtion:SHAPe?", scpi_cmd_sourceFunctionShapeQ) \
+    SCPI_COMMAND("[SOURce#]:FUNCtion:TYPE", scpi_cmd_sourceFunctionType) \
+    SCPI_COMMAND("[SOURce#]:FUNCtion:TYPE?", scpi_cmd_sourceFunctionTypeQ) \
     SCPI_COMMAND("[SOURce#]:LIST:COUNt", scpi_cmd_sourceListCount) \
     SCPI_COMMAND("[SOURce#]:LIST:COUNt?", scpi_cmd_sourceListCountQ) \
     SCPI_COMMAND("[SOURce#]:LIST:CURRent[:LEVel]", scpi_cmd_sourceListCurrentLevel) \
@@ -290,6 +320,9 @@
     SCPI_COMMAND("SYSTem:COMMunicate:NTP?", scpi_cmd_systemCommunicateNtpQ) \
     SCPI_COMMAND("SYSTem:COMMunicate:RLSTate", scpi_cmd_systemCommunicateRlstate) \
     SCPI_COMMAND("SYSTem:COMMunicate:RLSTate?", scpi_cmd_systemCommunicateRlstateQ) \
+    SCPI_COMMAND("SYSTem:COMMunicate:STReam", scpi_cmd_systemCommunicateStream) \
+    SCPI_COMMAND("SYSTem:COMMunicate:STReam?", scpi_cmd_systemCommunicateStreamQ) \
+    SCPI_COMMAND("SYSTem:COMMunicate:STReam:STOP", scpi_cmd_systemCommunicateStreamStop) \
     SCPI_COMMAND("SYSTem:COMMunicate:MQTT:SETTings", scpi_cmd_systemCommunicateMqttSettings) \
     SCPI_COMMAND("SYSTem:COMMunicate:MQTT:STATe?", scpi_cmd_systemCommunicateMqttStateQ) \
     SCPI_COMMAND("SYSTem:CPU:INFOrmation:ONTime:LAST?", scpi_cmd_systemCpuInformationOntimeLastQ) \
@@ -361,17 +394,24 @@
     SCPI_COMMAND("TRIGger[:SEQuence][:IMMediate]", scpi_cmd_triggerSequenceImmediate) \
     SCPI_COMMAND("APPLy", scpi_cmd_apply) \
     SCPI_COMMAND("APPLy?", scpi_cmd_applyQ) \
+    SCPI_COMMAND("APPLy:STAGe", scpi_cmd_applyStage) \
+    SCPI_COMMAND("APPLy:COMMit", scpi_cmd_applyCommit) \
+    SCPI_COMMAND("APPLy:ABORt", scpi_cmd_applyAbort) \
+    SCPI_COMMAND("APPLy:SKEW?", scpi_cmd_applySkewQ) \
     SCPI_COMMAND("DEBUg?", scpi_cmd_debugQ) \
     SCPI_COMMAND("SIMUlator:EXIT", scpi_cmd_simulatorExit) \
     SCPI_COMMAND("SIMUlator:GUI", scpi_cmd_simulatorGui) \
+    SCPI_COMMAND("SIMUlator:GUI:DATA?", scpi_cmd_simulatorGuiDataQ) \
     SCPI_COMMAND("SIMUlator:LOAD", scpi_cmd_simulatorLoad) \
     SCPI_COMMAND("SIMUlator:LOAD:STATe", scpi_cmd_simulatorLoadState) \
     SCPI_COMMAND("SIMUlator:LOAD:STATe?", scpi_cmd_simulatorLoadStateQ) \
     SCPI_COMMAND("SIMUlator:LOAD?", scpi_cmd_simulatorLoadQ) \
     SCPI_COMMAND("SIMUlator:PIN1", scpi_cmd_simulatorPin1) \
     SCPI_COMMAND("SIMUlator:PIN1?", scpi_cmd_simulatorPin1Q) \
+    SCPI_COMMAND("SIMUlator:PIN1:EDGE", scpi_cmd_simulatorPin1Edge) \
     SCPI_COMMAND("SIMUlator:PIN2", scpi_cmd_simulatorPin2) \
     SCPI_COMMAND("SIMUlator:PIN2?", scpi_cmd_simulatorPin2Q) \
+    SCPI_COMMAND("SIMUlator:PIN2:EDGE", scpi_cmd_simulatorPin2Edge) \
     SCPI_COMMAND("SIMUlator:PWRGood", scpi_cmd_simulatorPwrgood) \
     SCPI_COMMAND("SIMUlator:PWRGood?", scpi_cmd_simulatorPwrgoodQ) \
     SCPI_COMMAND("SIMUlator:QUIT", scpi_cmd_simulatorQuit) \
@@ -379,6 +419,7 @@
     SCPI_COMMAND("SIMUlator:RPOL?", scpi_cmd_simulatorRpolQ) \
     SCPI_COMMAND("SIMUlator:TEMPerature", scpi_cmd_simulatorTemperature) \
     SCPI_COMMAND("SIMUlator:TEMPerature?", scpi_cmd_simulatorTemperatureQ) \
+    SCPI_COMMAND("SIMUlator:TIME?", scpi_cmd_simulatorTimeQ) \
     SCPI_COMMAND("SIMUlator:VOLTage:PROGram:EXTernal", scpi_cmd_simulatorVoltageProgramExternal) \
     SCPI_COMMAND("SIMUlator:VOLTage:PROGram:EXTernal?", scpi_cmd_simulatorVoltageProgramExternalQ) \
     SCPI_COMMAND("DEBUg", scpi_cmd_debug) \
@@ -251,6 +251,8 @@ void oneIter() {
                 psu::gui::ChSettingsListsPage::doExportList();
             } else if (type == SCPI_QUEUE_MESSAGE_TYPE_LOAD_PROFILE) {
                 profile::loadProfileParametersToCache(param);
+            } else if (type == SCPI_QUEUE_MESSAGE_TYPE_LOAD_PROFILE_NAMES) {
+                profile::onAfterSdCardMounted();
             } else if (type == SCPI_QUEUE_MESSAGE_TYPE_USER_PROFILES_PAGE_SAVE) {
                 psu::gui::UserProfilesPage::doSaveProfile();
             } else if (type == SCPI_QUEUE_MESSAGE_TYPE_USER_PROFILES_PAGE_RECALL) {
@@ -263,8 +265,6 @@ void oneIter() {
                 psu::gui::UserProfilesPage::doDeleteProfile();
             } else if (type == SCPI_QUEUE_MESSAGE_TYPE_USER_PROFILES_PAGE_EDIT_REMARK) {
                 psu::gui::UserProfilesPage::doEditRemark();
-            } else if (type == SCPI_QUEUE_MESSAGE_TYPE_SOUND_TICK) {
-                sound::tick();
             }
         }
     } else {
@@ -277,8 +277,6 @@ void oneIter() {
 
         event_queue::tick();
 
-        sound::tick();
-
     	if (diff >= 1000000L) { // 1 sec
             g_timer1LastTickCount = tickCount;
 
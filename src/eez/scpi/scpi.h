@@ -71,14 +71,14 @@ enum {
     SCPI_QUEUE_MESSAGE_TYPE_LISTS_PAGE_IMPORT_LIST,
     SCPI_QUEUE_MESSAGE_TYPE_LISTS_PAGE_EXPORT_LIST,
     SCPI_QUEUE_MESSAGE_TYPE_LOAD_PROFILE,
+    SCPI_QUEUE_MESSAGE_TYPE_LOAD_PROFILE_NAMES,
     SCPI_QUEUE_MESSAGE_TYPE_USER_PROFILES_PAGE_SAVE,
     SCPI_QUEUE_MESSAGE_TYPE_USER_PROFILES_PAGE_RECALL,
     SCPI_QUEUE_MESSAGE_TYPE_USER_PROFILES_PAGE_IMPORT,
     SCPI_QUEUE_MESSAGE_TYPE_USER_PROFILES_PAGE_EXPORT,
     SCPI_QUEUE_MESSAGE_TYPE_USER_PROFILES_PAGE_DELETE,
     SCPI_QUEUE_MESSAGE_TYPE_USER_PROFILES_PAGE_EDIT_REMARK,
-    SCPI_QUEUE_MESSAGE_TYPE_EVENT_QUEUE_REFRESH,
-    SCPI_QUEUE_MESSAGE_TYPE_SOUND_TICK
+    SCPI_QUEUE_MESSAGE_TYPE_EVENT_QUEUE_REFRESH
 };
 
 extern char g_listFilePath[CH_MAX][MAX_PATH_LENGTH];
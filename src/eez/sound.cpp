@@ -1438,15 +1438,15 @@ static const size_t g_shutterSamplesSize = sizeof(g_shutterSamples) / sizeof(uin
 #endif
 
 struct Tune {
-	float *tune;
-	uint32_t sampleRate;
+	float *notes;
 	float durationBetweenNotesFactor;
 #if defined(EEZ_PLATFORM_SIMULATOR)
-	int16_t *pSamples;
+	const int16_t *pSamples;
 #elif defined(EEZ_PLATFORM_STM32)
-	uint8_t *pSamples;
+	const uint8_t *pSamples;
 #endif
-	unsigned int numSamples;
+	uint32_t numSamples;
+	uint32_t sampleRate;
 };
 
 #if !defined(__EMSCRIPTEN__)
@@ -1454,96 +1454,256 @@ struct Tune {
 #if defined(EEZ_PLATFORM_SIMULATOR)
 #define SAMPLE_RATE 48000
 #elif defined(EEZ_PLATFORM_STM32)
-#define SAMPLE_RATE 12000
+#define SAMPLE_RATE 24000
 #endif
 
+// tunes with higher index have higher priority when all voices are busy
 Tune g_tunes[] = {
-	{ g_clickTune, SAMPLE_RATE, 1.3f },
-	{ nullptr, 48000, 0, g_shutterSamples, g_shutterSamplesSize },
-	{ g_beepTune, SAMPLE_RATE, 1.3f },
-	{ g_powerUpTune, SAMPLE_RATE, 1.3f },
-	{ g_powerDownTune, SAMPLE_RATE, 0.75f }
+	{ g_clickTune, 1.3f },
+	{ nullptr, 0, g_shutterSamples, g_shutterSamplesSize, 48000 },
+	{ g_beepTune, 1.3f },
+	{ g_powerUpTune, 1.3f },
+	{ g_powerDownTune, 0.75f }
 };
 
-#endif
-
-static int g_playNextTuneIndex = -1;
-static int g_currentTuneIndex = -1;
-static uint32_t g_currentTuneStartPlayTime;
-
 ////////////////////////////////////////////////////////////////////////////////
 
 #define PI 3.14159265f
 
-#if defined(EEZ_PLATFORM_SIMULATOR) && !defined(__EMSCRIPTEN__)
-static const uint32_t g_memoryForTuneSamplesSize = 256000;
-int16_t g_memoryForTuneSamples[g_memoryForTuneSamplesSize];
-SDL_AudioDeviceID g_audioDevice;
+// Tunes are not rendered in advance. Every playing tune is a voice of the mixer
+// and voices are mixed, a block at a time, from the audio callback (simulator)
+// or from the DAC DMA half/full transfer complete interrupt (STM32).
+
+static const int NUM_VOICES = 4;
+
+// wavetable index is the upper WAVETABLE_BITS bits of the phase accumulator
+static const int WAVETABLE_BITS = 8;
+static const int WAVETABLE_SIZE = 1 << WAVETABLE_BITS;
+static int16_t g_wavetable[WAVETABLE_SIZE];
+
+static const int MIX_BUFFER_SIZE = 256;
+static int32_t g_mixBuffer[MIX_BUFFER_SIZE];
+
+struct Voice {
+	// nullptr if voice is free
+	const Tune *tune;
+
+	// index of the current note in tune->notes
+	int note;
+	bool pause;
+	uint32_t samplesLeft;
+
+	// wavetable phase for notes, 16.16 sample position for sampled tune
+	uint32_t phase;
+	uint32_t phaseStep;
+};
+
+static Voice g_voices[NUM_VOICES];
+
+#if defined(EEZ_PLATFORM_SIMULATOR)
+static SDL_AudioDeviceID g_audioDevice;
 #elif defined(EEZ_PLATFORM_STM32)
-static const uint32_t g_memoryForTuneSamplesSize = SOUND_TUNES_MEMORY_SIZE;
-uint8_t *g_memoryForTuneSamples = SOUND_TUNES_MEMORY;
+static uint8_t * const g_buffer = SOUND_BUFFER;
+static const uint32_t BUFFER_HALF_SIZE = SOUND_BUFFER_SIZE / 2;
+static volatile bool g_outputRunning;
+static int g_numSilentHalves;
 #endif
 
-#if !defined(__EMSCRIPTEN__)
+static void startNote(Voice &voice) {
+	const float *notes = voice.tune->notes;
+	voice.pause = false;
+	voice.samplesLeft = (uint32_t)roundf(SAMPLE_RATE * notes[voice.note + 1]);
+	voice.phase = 0;
+	voice.phaseStep = (uint32_t)(notes[voice.note] / SAMPLE_RATE * 4294967296.0f);
+}
+
+// Called when current note or pause between notes is finished,
+// returns false if there is nothing more to play.
+static bool nextNote(Voice &voice) {
+	const float *notes = voice.tune->notes;
 
-uint32_t g_memoryForTuneSamplesOffset;
+	if (voice.pause) {
+		voice.note += 2;
+		startNote(voice);
+		return true;
+	}
 
+	if (isNaN(notes[voice.note + 2])) {
+		return false;
+	}
+
+	voice.pause = true;
+	voice.samplesLeft = (uint32_t)roundf(voice.tune->durationBetweenNotesFactor * SAMPLE_RATE * notes[voice.note + 1]);
+	return true;
+}
+
+static inline int32_t getSample(const Tune &tune, uint32_t position) {
 #if defined(EEZ_PLATFORM_SIMULATOR)
-unsigned int generateTuneSamples(float *tune, int sampleRate, int16_t *pMemBuffer, float durationBetweenNotesFactor) {
+	return tune.pSamples[position];
 #elif defined(EEZ_PLATFORM_STM32)
-unsigned int generateTuneSamples(float *tune, int sampleRate, uint8_t *pMemBuffer, float durationBetweenNotesFactor) {
+	return (tune.pSamples[position] - 128) << 8;
 #endif
+}
+
+static void mixVoice(Voice &voice, int numSamples) {
+	const Tune &tune = *voice.tune;
+	int i = 0;
 
-    unsigned int size = 0;
-	for (int i = 0; !isNaN(tune[i]); i += 2) {
-        if (i > 0) {
-            // add silence between notes
-			unsigned int silence = (unsigned int)roundf(durationBetweenNotesFactor * sampleRate * tune[i - 1]);
-            memset(pMemBuffer, 0, silence * sizeof(uint16_t));
-			size += silence;
-            pMemBuffer += silence;
+	if (!tune.notes) {
+		for (; i < numSamples; i++) {
+			uint32_t position = voice.phase >> 16;
+			if (position >= tune.numSamples) {
+				voice.tune = nullptr;
+				return;
+			}
+			g_mixBuffer[i] += getSample(tune, position);
+			voice.phase += voice.phaseStep;
 		}
+		return;
+	}
+
+	while (i < numSamples) {
+		if (voice.samplesLeft == 0) {
+			if (!nextNote(voice)) {
+				voice.tune = nullptr;
+				return;
+			}
+			continue;
+		}
+
+		int n = MIN((int)voice.samplesLeft, numSamples - i);
+		voice.samplesLeft -= n;
+
+		if (voice.pause) {
+			i += n;
+		} else {
+			for (; n > 0; n--) {
+				g_mixBuffer[i++] += g_wavetable[voice.phase >> (32 - WAVETABLE_BITS)];
+				voice.phase += voice.phaseStep;
+			}
+		}
+	}
+}
+
+static inline int32_t saturate(int32_t value, int32_t min, int32_t max) {
+	return value < min ? min : value > max ? max : value;
+}
+
+// Mixes all the active voices into g_mixBuffer, returns false if no voice is active.
+static bool mixVoices(int numSamples) {
+	bool active = false;
 
-		unsigned int duration = (unsigned int)roundf(sampleRate * tune[i + 1]);
-		size += duration;
-		
-        float f = 2 * PI * tune[i] / sampleRate;
+	memset(g_mixBuffer, 0, numSamples * sizeof(int32_t));
+
+	for (int i = 0; i < NUM_VOICES; i++) {
+		if (g_voices[i].tune) {
+			mixVoice(g_voices[i], numSamples);
+			active = true;
+		}
+	}
+
+	return active;
+}
+
+////////////////////////////////////////////////////////////////////////////////
 
-		for (unsigned int k = 0; k < duration; k++) {
 #if defined(EEZ_PLATFORM_SIMULATOR)
-			*pMemBuffer++ = (int16_t)clamp(32767.5f * sinf(k * f), -32768.0f, 32767.0f);
+
+static void audioCallback(void *userdata, Uint8 *stream, int len) {
+	int16_t *samples = (int16_t *)stream;
+	int numSamples = len / sizeof(int16_t);
+
+	while (numSamples > 0) {
+		int n = MIN(numSamples, MIX_BUFFER_SIZE);
+
+		if (mixVoices(n)) {
+			for (int i = 0; i < n; i++) {
+				samples[i] = (int16_t)saturate(g_mixBuffer[i], -32768, 32767);
+			}
+		} else {
+			memset(samples, 0, n * sizeof(int16_t));
+		}
+
+		samples += n;
+		numSamples -= n;
+	}
+}
+
+static void lock() {
+	SDL_LockAudioDevice(g_audioDevice);
+}
+
+static void unlock() {
+	SDL_UnlockAudioDevice(g_audioDevice);
+}
+
 #elif defined(EEZ_PLATFORM_STM32)
-			*pMemBuffer++ = (uint8_t)clamp(127.5f + 127.5f * sinf(k * f), 0.0f, 255.0f);
-#endif
+
+static void fillBufferHalf(int half) {
+	uint8_t *samples = g_buffer + half * BUFFER_HALF_SIZE;
+
+	if (mixVoices(BUFFER_HALF_SIZE)) {
+		g_numSilentHalves = 0;
+		for (uint32_t i = 0; i < BUFFER_HALF_SIZE; i++) {
+			samples[i] = (uint8_t)saturate((g_mixBuffer[i] >> 8) + 128, 0, 255);
 		}
+	} else {
+		g_numSilentHalves++;
+		memset(samples, 128, BUFFER_HALF_SIZE);
+	}
+}
 
+static void onBufferHalfTransferred(int half) {
+	if (g_numSilentHalves >= 2) {
+		// whole buffer is silent, stop until the next tune
+		HAL_DAC_Stop_DMA(&hdac, DAC_CHANNEL_1);
+		HAL_TIM_Base_Stop(&htim6);
+		g_outputRunning = false;
+		return;
 	}
 
-	// add zero to the end
-	*pMemBuffer = 0;
-	size++;
+	fillBufferHalf(half);
+}
 
-	return size;
+extern "C" void HAL_DAC_ConvHalfCpltCallbackCh1(DAC_HandleTypeDef *) {
+	onBufferHalfTransferred(0);
 }
 
-#endif
+extern "C" void HAL_DAC_ConvCpltCallbackCh1(DAC_HandleTypeDef *) {
+	onBufferHalfTransferred(1);
+}
 
-////////////////////////////////////////////////////////////////////////////////
+static void startOutput() {
+	if (!g_outputRunning) {
+		g_numSilentHalves = 0;
+		fillBufferHalf(0);
+		fillBufferHalf(1);
 
-#if !defined(__EMSCRIPTEN__)
-void initTune(Tune &tuneDef) {
-    if (!tuneDef.pSamples) {
-		tuneDef.pSamples = g_memoryForTuneSamples + g_memoryForTuneSamplesOffset;
-		tuneDef.numSamples = generateTuneSamples(tuneDef.tune, tuneDef.sampleRate, tuneDef.pSamples, tuneDef.durationBetweenNotesFactor);
-        g_memoryForTuneSamplesOffset += tuneDef.numSamples;
-        assert(g_memoryForTuneSamplesOffset * sizeof(uint8_t) <= g_memoryForTuneSamplesSize);
+		HAL_TIM_Base_Start(&htim6);
+		HAL_DAC_Start_DMA(&hdac, DAC_CHANNEL_1, (uint32_t *)g_buffer, SOUND_BUFFER_SIZE, DAC_ALIGN_8B_R);
+		g_outputRunning = true;
 	}
 }
+
+static void lock() {
+	taskENTER_CRITICAL();
+}
+
+static void unlock() {
+	taskEXIT_CRITICAL();
+}
+
+#endif
+
 #endif
 
+////////////////////////////////////////////////////////////////////////////////
+
 void init() {
 #if !defined(__EMSCRIPTEN__)
-	initTune(g_tunes[POWER_UP_TUNE]);
+	for (int i = 0; i < WAVETABLE_SIZE; i++) {
+		g_wavetable[i] = (int16_t)clamp(32767.5f * sinf(2 * PI * i / WAVETABLE_SIZE), -32768.0f, 32767.0f);
+	}
 #endif
 
 #if defined(EEZ_PLATFORM_SIMULATOR) && !defined(__EMSCRIPTEN__)
@@ -1556,37 +1716,28 @@ void init() {
 	desiredSpec.freq = SAMPLE_RATE;
 	desiredSpec.format = AUDIO_S16SYS;
 	desiredSpec.channels = 1;
-	desiredSpec.samples = 2048;
+	desiredSpec.samples = 512;
+	desiredSpec.callback = audioCallback;
 
 	SDL_AudioSpec obtainedSpec;
 
 	g_audioDevice = SDL_OpenAudioDevice(NULL, 0, &desiredSpec, &obtainedSpec, 0);
 	if (g_audioDevice == 0) {
 		printf("Failed to open audio: %s\n", SDL_GetError());
+	} else {
+		SDL_PauseAudioDevice(g_audioDevice, 0);
 	}
 #endif
-}
 
-void startPlay(int iTune) {
-#if !defined(__EMSCRIPTEN__)
-    Tune &tuneDef = g_tunes[iTune];
-	initTune(tuneDef);
-#if defined(EEZ_PLATFORM_SIMULATOR)
-    SDL_QueueAudio(g_audioDevice, tuneDef.pSamples, tuneDef.numSamples * 2);
-    SDL_PauseAudioDevice(g_audioDevice, 0);
-#elif defined(EEZ_PLATFORM_STM32)
-	HAL_DAC_Stop_DMA(&hdac, DAC_CHANNEL_1);
-	HAL_TIM_Base_Stop(&htim6);
+#if defined(EEZ_PLATFORM_STM32)
 	HAL_TIM_Base_DeInit(&htim6);
-	htim6.Init.Period = 108000000 / tuneDef.sampleRate - 1;
+	htim6.Init.Period = 108000000 / SAMPLE_RATE - 1;
 	HAL_TIM_Base_Init(&htim6);
-	HAL_TIM_Base_Start(&htim6);
-	HAL_DAC_Start_DMA(&hdac, DAC_CHANNEL_1, (uint32_t *)tuneDef.pSamples, tuneDef.numSamples, DAC_ALIGN_8B_R);
-#endif
 #endif
 }
 
-void tick() {
+// Can be called from any thread, tune starts playing with the next mixed block.
+static void playTune(int iTune) {
 #if !defined(__EMSCRIPTEN__)
 #if defined(EEZ_PLATFORM_SIMULATOR)
 	if (!g_audioDevice) {
@@ -1594,41 +1745,53 @@ void tick() {
 	}
 #endif
 
-	if (g_currentTuneIndex != -1) {
-		Tune &tuneDef = g_tunes[g_currentTuneIndex];
-		uint32_t duration = tuneDef.numSamples * 1000 / tuneDef.sampleRate;
-		if (millis() - g_currentTuneStartPlayTime > duration) {
-			g_currentTuneIndex = -1;
+	const Tune &tune = g_tunes[iTune];
+
+	lock();
+
+	// restart if the same tune is already playing, else use free voice,
+	// else steal the voice playing the tune with the lowest priority
+	Voice *voice = nullptr;
+	for (int i = 0; i < NUM_VOICES && !voice; i++) {
+		if (g_voices[i].tune == &tune) {
+			voice = &g_voices[i];
 		}
 	}
 
-	int iTune = g_playNextTuneIndex;
-	if (iTune != -1) {
-		g_currentTuneIndex = g_playNextTuneIndex;
-		g_playNextTuneIndex = -1;
-
-    	startPlay(g_currentTuneIndex);
+	for (int i = 0; i < NUM_VOICES && !voice; i++) {
+		if (!g_voices[i].tune) {
+			voice = &g_voices[i];
+		}
+	}
 
-        g_currentTuneStartPlayTime = millis();
+	if (!voice) {
+		int lowestTuneIndex = iTune;
+		for (int i = 0; i < NUM_VOICES; i++) {
+			int tuneIndex = g_voices[i].tune - g_tunes;
+			if (tuneIndex < lowestTuneIndex) {
+				lowestTuneIndex = tuneIndex;
+				voice = &g_voices[i];
+			}
+		}
 	}
-#endif
-}
 
-static void playTune(int iTune) {
-	if (iTune > g_playNextTuneIndex && iTune > g_currentTuneIndex) {
-		g_playNextTuneIndex = iTune;
-    	if (
-			osThreadGetId() == scpi::g_scpiTaskHandle ||
-			osThreadGetId() == psu::g_psuTaskHandle ||
-			g_playNextTuneIndex == POWER_UP_TUNE ||
-			(g_playNextTuneIndex == BEEP_TUNE && !g_isBooted)
-		) {
-			tick();
+	if (voice) {
+		voice->tune = &tune;
+		voice->note = 0;
+		if (tune.notes) {
+			startNote(*voice);
 		} else {
-			using namespace scpi;
-			osMessagePut(g_scpiMessageQueueId, SCPI_QUEUE_MESSAGE(SCPI_QUEUE_MESSAGE_TARGET_NONE, SCPI_QUEUE_MESSAGE_TYPE_SOUND_TICK, 0), osWaitForever);
+			voice->phase = 0;
+			voice->phaseStep = (tune.sampleRate << 16) / SAMPLE_RATE;
 		}
+
+#if defined(EEZ_PLATFORM_STM32)
+		startOutput();
+#endif
 	}
+
+	unlock();
+#endif
 }
 
 void playPowerUp(PlayPowerUpCondition condition) {
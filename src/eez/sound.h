@@ -24,7 +24,6 @@ namespace eez {
 namespace sound {
 
 void init();
-void tick();
 
 /// Play power up tune.
 enum PlayPowerUpCondition {
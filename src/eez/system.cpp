@@ -22,18 +22,13 @@
 
 #if defined(EEZ_PLATFORM_STM32)
 volatile uint32_t g_tickCount;
+volatile uint32_t g_tickCountHigh;
 #endif
 
 namespace eez {
 
 uint32_t millis() {
-#if defined(EEZ_PLATFORM_STM32)
-    return g_tickCount / 5;
-#endif
-
-#if defined(EEZ_PLATFORM_SIMULATOR)
-    return osKernelSysTick();
-#endif
+    return (uint32_t)(micros64() / 1000);
 }
 
 void delay(uint32_t millis) {
@@ -47,18 +42,26 @@ void delay(uint32_t millis) {
 }
 
 uint32_t micros() {
+    return (uint32_t)micros64();
+}
+
+uint64_t micros64() {
 #if defined(EEZ_PLATFORM_STM32)
-    auto tc1 = g_tickCount;
-	auto cnt = TIM7->CNT;
-	auto tc2 = g_tickCount;
-	if (tc1 == tc2) {
-		return tc1 * 200 + 2 * cnt;
-	}
-	return tc2 * 200;
+    // g_tickCount is incremented every 200 us (TIM7 period) and g_tickCountHigh
+    // when g_tickCount wraps around, read again if tick interrupt came in between
+    uint32_t high;
+    uint32_t tc;
+    uint32_t cnt;
+    do {
+        high = g_tickCountHigh;
+        tc = g_tickCount;
+        cnt = TIM7->CNT;
+    } while (tc != g_tickCount || high != g_tickCountHigh);
+    return ((((uint64_t)high) << 32) | tc) * 200 + 2 * cnt;
 #endif
 
 #if defined(EEZ_PLATFORM_SIMULATOR)
-	return osKernelSysTick() * 1000;
+    return osKernelSysTickMicros();
 #endif
 }
 
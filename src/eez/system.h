@@ -26,6 +26,7 @@
 #include <iwdg.h>
 #define WATCHDOG_RESET(...) HAL_IWDG_Refresh(&hiwdg)
 extern volatile uint32_t g_tickCount;
+extern volatile uint32_t g_tickCountHigh;
 #else
 #define WATCHDOG_RESET(...) 0
 #endif
@@ -33,6 +34,9 @@ extern volatile uint32_t g_tickCount;
 namespace eez {
 
 uint32_t micros();
+// Monotonic time since boot in microseconds. Unlike micros(), which wraps around
+// after about 71 minutes, it never wraps, so use it for timers which can run longer.
+uint64_t micros64();
 uint32_t millis();
 void delay(uint32_t millis);
 void delayMicroseconds(uint32_t microseconds);
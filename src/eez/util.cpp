@@ -108,12 +108,212 @@ void strcatUInt32(char *str, uint32_t value) {
     sprintf(str, "%lu", (unsigned long)value);
 }
 
+static const uint64_t g_pow10[] = {
+    1ULL,
+    10ULL,
+    100ULL,
+    1000ULL,
+    10000ULL,
+    100000ULL,
+    1000000ULL,
+    10000000ULL,
+    100000000ULL,
+    1000000000ULL,
+    10000000000ULL
+};
+
+// 1E-4 ... 1E6, used to estimate decimal exponent
+static const float g_pow10f[] = {
+    1E-4f, 1E-3f, 1E-2f, 1E-1f, 1E0f, 1E1f, 1E2f, 1E3f, 1E4f, 1E5f, 1E6f
+};
+
+// max. number of decimal places (or significant digits) handled without sprintf,
+// i.e. mantissa * 10^FLOAT_TO_STR_MAX_DIGITS must fit into 63 bits
+#define FLOAT_TO_STR_MAX_DIGITS 10
+
+// "%g" precision
+#define FLOAT_TO_STR_G_PRECISION 6
+
+// Splits float into sign, mantissa and binary exponent, i.e. |value| = mantissa * 2^exponent.
+static bool decomposeFloat(float value, bool &negative, uint32_t &mantissa, int &exponent) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    negative = (bits >> 31) != 0;
+
+    uint32_t biasedExponent = (bits >> 23) & 0xFF;
+    if (biasedExponent == 0xFF) {
+        // NaN or infinity
+        return false;
+    }
+
+    mantissa = bits & 0x7FFFFF;
+    if (biasedExponent == 0) {
+        exponent = -149;
+    } else {
+        mantissa |= 0x800000;
+        exponent = (int)biasedExponent - 150;
+    }
+
+    return true;
+}
+
+// Rounds mantissa * 2^exponent * 10^k to the nearest integer, ties to even as printf does.
+// Returns false if result doesn't fit into 63 bits.
+static bool scaleAndRound(uint32_t mantissa, int exponent, int k, uint64_t &result) {
+    uint64_t scaled = mantissa * g_pow10[k];
+
+    if (exponent >= 0) {
+        if (exponent >= 63 || scaled > (UINT64_MAX >> 1) >> exponent) {
+            return false;
+        }
+        result = scaled << exponent;
+        return true;
+    }
+
+    int shift = -exponent;
+    if (shift >= 64) {
+        // scaled < 2^63, i.e. less then half
+        result = 0;
+        return true;
+    }
+
+    uint64_t quotient = scaled >> shift;
+    uint64_t remainder = scaled & ((1ULL << shift) - 1);
+    uint64_t half = 1ULL << (shift - 1);
+    if (remainder > half || (remainder == half && (quotient & 1))) {
+        quotient++;
+    }
+
+    result = quotient;
+    return true;
+}
+
+static char *writeDigits(char *str, uint64_t value, int minNumDigits) {
+    char digits[20];
+    int numDigits = 0;
+
+    uint32_t value32;
+
+    while (value > UINT32_MAX) {
+        digits[numDigits++] = '0' + (char)(value % 10);
+        value /= 10;
+    }
+
+    value32 = (uint32_t)value;
+    while (value32 > 0) {
+        digits[numDigits++] = '0' + (char)(value32 % 10);
+        value32 /= 10;
+    }
+
+    while (numDigits < minNumDigits) {
+        digits[numDigits++] = '0';
+    }
+
+    while (numDigits > 0) {
+        *str++ = digits[--numDigits];
+    }
+
+    return str;
+}
+
+// Writes value / 10^numDecimalPlaces.
+static char *writeFixed(char *str, bool negative, uint64_t value, int numDecimalPlaces) {
+    if (negative) {
+        *str++ = '-';
+    }
+
+    str = writeDigits(str, value / g_pow10[numDecimalPlaces], 1);
+
+    if (numDecimalPlaces > 0) {
+        *str++ = '.';
+        str = writeDigits(str, value % g_pow10[numDecimalPlaces], numDecimalPlaces);
+    }
+
+    *str = 0;
+
+    return str;
+}
+
+char *floatToStr(char *str, float value) {
+    bool negative;
+    uint32_t mantissa;
+    int exponent;
+    if (decomposeFloat(value, negative, mantissa, exponent)) {
+        if (mantissa == 0) {
+            return writeFixed(str, negative, 0, 0);
+        }
+
+        // decimal exponent estimate, corrected below after rounding
+        float absValue = fabsf(value);
+        int decimalExponent = -5;
+        while (decimalExponent < FLOAT_TO_STR_G_PRECISION && absValue >= g_pow10f[decimalExponent + 5]) {
+            decimalExponent++;
+        }
+
+        for (int i = 0; i < 3; i++) {
+            int k = FLOAT_TO_STR_G_PRECISION - 1 - decimalExponent;
+            if (k < 0 || k > FLOAT_TO_STR_MAX_DIGITS) {
+                break;
+            }
+
+            uint64_t digits;
+            if (!scaleAndRound(mantissa, exponent, k, digits)) {
+                break;
+            }
+
+            if (digits >= g_pow10[FLOAT_TO_STR_G_PRECISION]) {
+                decimalExponent++;
+            } else if (digits < g_pow10[FLOAT_TO_STR_G_PRECISION - 1]) {
+                decimalExponent--;
+            } else {
+                if (decimalExponent < -4 || decimalExponent >= FLOAT_TO_STR_G_PRECISION) {
+                    // exponential notation
+                    break;
+                }
+
+                char *end = writeFixed(str, negative, digits, k);
+
+                // remove trailing zeros and decimal point
+                if (k > 0) {
+                    while (end[-1] == '0') {
+                        --end;
+                    }
+                    if (end[-1] == '.') {
+                        --end;
+                    }
+                    *end = 0;
+                }
+
+                return end;
+            }
+        }
+    }
+
+    return str + sprintf(str, "%g", value);
+}
+
+char *floatToStr(char *str, float value, int numDecimalPlaces) {
+    bool negative;
+    uint32_t mantissa;
+    int exponent;
+    uint64_t digits;
+    if (numDecimalPlaces >= 0 && numDecimalPlaces <= FLOAT_TO_STR_MAX_DIGITS &&
+        decomposeFloat(value, negative, mantissa, exponent) &&
+        scaleAndRound(mantissa, exponent, numDecimalPlaces, digits)
+    ) {
+        return writeFixed(str, negative, digits, numDecimalPlaces);
+    }
+
+    return str + sprintf(str, "%.*f", numDecimalPlaces, value);
+}
+
 void strcatFloat(char *str, float value) {
-    sprintf(str + strlen(str), "%g", value);
+    floatToStr(str + strlen(str), value);
 }
 
 void strcatFloat(char *str, float value, int numDecimalPlaces) {
-    sprintf(str + strlen(str), "%.*f", numDecimalPlaces, value);
+    floatToStr(str + strlen(str), value, numDecimalPlaces);
 }
 
 void strcatVoltage(char *str, float value) {
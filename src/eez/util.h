@@ -60,6 +60,13 @@ void strcatUInt32(char *str, uint32_t value);
 void strcatFloat(char *str, float value);
 void strcatFloat(char *str, float value, int numDecimalPlaces);
 
+/// Float to text conversion, the result is exactly the same as with sprintf "%g" and "%.*f",
+/// but values in the usual range are converted using only integer arithmetic.
+/// Everything else (NaN, infinity, exponential notation, ...) is passed to sprintf.
+/// Returns pointer to the terminating zero.
+char *floatToStr(char *str, float value);
+char *floatToStr(char *str, float value, int numDecimalPlaces);
+
 void strcatVoltage(char *str, float value);
 void strcatCurrent(char *str, float value);
 void strcatPower(char *str, float value);
@@ -0,0 +1,25 @@
+#include <stdint.h>
+
+// Frozen Python modules, i.e. shared helper libraries built into the firmware.
+// They are imported like any other module (`import name`), compiled on first
+// import and, since MicroPython is not reinitialised between scripts, kept in
+// memory for all subsequent script runs.
+//
+// Generate these tables with `tools/make-frozen.py <dir>` from the MicroPython
+// source tree, where <dir> contains the helper `.py` files:
+//
+//   - mp_frozen_str_names: NUL separated module file names ("name.py"), terminated by an empty name
+//   - mp_frozen_str_sizes: size of each module source, terminated by 0
+//   - mp_frozen_str_content: NUL separated module sources
+
+const char mp_frozen_str_names[] = {
+    "\0"
+};
+
+const uint32_t mp_frozen_str_sizes[] = {
+    0
+};
+
+const char mp_frozen_str_content[] = {
+    "\0"
+};
@@ -166,6 +166,9 @@ QDEF(MP_QSTR_value, (const byte*)"\x4e\x05" "value")
 QDEF(MP_QSTR_values, (const byte*)"\x7d\x06" "values")
 QDEF(MP_QSTR_write, (const byte*)"\x98\x05" "write")
 QDEF(MP_QSTR_zip, (const byte*)"\xe6\x03" "zip")
+QDEF(MP_QSTR_CC, (const byte*)"\xe5\x02" "CC")
+QDEF(MP_QSTR_CV, (const byte*)"\xf0\x02" "CV")
+QDEF(MP_QSTR_UR, (const byte*)"\xa2\x02" "UR")
 QDEF(MP_QSTR___add__, (const byte*)"\xc4\x07" "__add__")
 QDEF(MP_QSTR___bool__, (const byte*)"\x2b\x08" "__bool__")
 QDEF(MP_QSTR___build_class__, (const byte*)"\x42\x0f" "__build_class__")
@@ -222,6 +225,7 @@ QDEF(MP_QSTR_function, (const byte*)"\x27\x08" "function")
 QDEF(MP_QSTR_generator, (const byte*)"\x96\x09" "generator")
 QDEF(MP_QSTR_getI, (const byte*)"\xda\x04" "getI")
 QDEF(MP_QSTR_getOutputMode, (const byte*)"\x4f\x0d" "getOutputMode")
+QDEF(MP_QSTR_getSnapshot, (const byte*)"\x1f\x0b" "getSnapshot")
 QDEF(MP_QSTR_getU, (const byte*)"\xc6\x04" "getU")
 QDEF(MP_QSTR_heap_lock, (const byte*)"\xad\x09" "heap_lock")
 QDEF(MP_QSTR_heap_unlock, (const byte*)"\x56\x0b" "heap_unlock")
@@ -248,6 +252,7 @@ QDEF(MP_QSTR_radians, (const byte*)"\x87\x07" "radians")
 QDEF(MP_QSTR_real, (const byte*)"\xbf\x04" "real")
 QDEF(MP_QSTR_scpi, (const byte*)"\xec\x04" "scpi")
 QDEF(MP_QSTR_setI, (const byte*)"\x4e\x04" "setI")
+QDEF(MP_QSTR_setList, (const byte*)"\xe5\x07" "setList")
 QDEF(MP_QSTR_setU, (const byte*)"\x52\x04" "setU")
 QDEF(MP_QSTR_sin, (const byte*)"\xb1\x03" "sin")
 QDEF(MP_QSTR_sleep, (const byte*)"\xea\x05" "sleep")
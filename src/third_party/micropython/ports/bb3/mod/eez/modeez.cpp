@@ -23,6 +23,7 @@
 
 #include <eez/modules/psu/psu.h>
 #include <eez/modules/psu/channel_dispatcher.h>
+#include <eez/modules/psu/list_program.h>
 #include <eez/modules/psu/trigger.h>
 #include <eez/modules/psu/dlog_record.h>
 
@@ -156,15 +157,7 @@ mp_obj_t modeez_getOutputMode(mp_obj_t channelIndexObj) {
     return mp_obj_new_str(modeStr, strlen(modeStr));
 }
 
-mp_obj_t modeez_dlogTraceData(size_t n_args, const mp_obj_t *args) {
-    if (!dlog_record::isTraceExecuting()) {
-        mp_raise_ValueError("DLOG trace data not started");
-    }
-
-    if (n_args == 1 && mp_obj_is_type(args[0], &mp_type_list)) {
-        mp_obj_get_array(args[0], &n_args, (mp_obj_t **)&args);
-    }
-
+static void dlogTraceRow(size_t n_args, const mp_obj_t *args) {
     if (n_args < dlog_record::g_recording.parameters.numYAxes) {
         mp_raise_ValueError("Too few values");
     }
@@ -183,6 +176,138 @@ mp_obj_t modeez_dlogTraceData(size_t n_args, const mp_obj_t *args) {
     }
 
     dlog_record::log(values);
+}
+
+mp_obj_t modeez_dlogTraceData(size_t n_args, const mp_obj_t *args) {
+    if (!dlog_record::isTraceExecuting()) {
+        mp_raise_ValueError("DLOG trace data not started");
+    }
+
+    if (n_args == 1 && (mp_obj_is_type(args[0], &mp_type_list) || mp_obj_is_type(args[0], &mp_type_tuple))) {
+        mp_obj_get_array(args[0], &n_args, (mp_obj_t **)&args);
+
+        if (n_args > 0 && (mp_obj_is_type(args[0], &mp_type_list) || mp_obj_is_type(args[0], &mp_type_tuple))) {
+            // many rows at once, i.e. [[y1, y2, ...], [y1, y2, ...], ...]
+            for (size_t i = 0; i < n_args; i++) {
+                size_t rowLength;
+                mp_obj_t *row;
+                mp_obj_get_array(args[i], &rowLength, &row);
+                dlogTraceRow(rowLength, row);
+            }
+            return mp_const_none;
+        }
+    }
+
+    dlogTraceRow(n_args, args);
+
+    return mp_const_none;
+}
+
+static Channel &getChannel(mp_obj_t channelIndexObj) {
+    int channelIndex = mp_obj_get_int(channelIndexObj) - 1;
+    if (channelIndex < 0 || channelIndex >= CH_NUM) {
+        mp_raise_ValueError("Invalid channel index");
+    }
+    return Channel::get(channelIndex);
+}
+
+static mp_obj_t getChannelSnapshot(Channel &channel) {
+    float u = channel_dispatcher::getUMonLast(channel);
+    float i = channel_dispatcher::getIMonLast(channel);
+
+    // mode is returned as interned string, so no allocation is needed
+    ChannelMode mode = channel.getMode();
+    qstr modeQstr = mode == CHANNEL_MODE_CV ? MP_QSTR_CV : mode == CHANNEL_MODE_CC ? MP_QSTR_CC : MP_QSTR_UR;
+
+    mp_obj_t items[4] = {
+        mp_obj_new_float(u),
+        mp_obj_new_float(i),
+        mp_obj_new_float(u * i),
+        MP_OBJ_NEW_QSTR(modeQstr)
+    };
+
+    return mp_obj_new_tuple(4, items);
+}
+
+// getSnapshot(channelIndex) returns (U, I, P, mode) of one channel,
+// getSnapshot() returns a tuple of (U, I, P, mode) for all channels.
+mp_obj_t modeez_getSnapshot(size_t n_args, const mp_obj_t *args) {
+    if (n_args == 1) {
+        return getChannelSnapshot(getChannel(args[0]));
+    }
+
+    mp_obj_t items[CH_MAX];
+    for (int i = 0; i < CH_NUM; i++) {
+        items[i] = getChannelSnapshot(Channel::get(i));
+    }
+    return mp_obj_new_tuple(CH_NUM, items);
+}
+
+static float *getFloatList(mp_obj_t listObj, uint16_t *listLength) {
+    size_t length;
+    mp_obj_t *items;
+    mp_obj_get_array(listObj, &length, &items);
+
+    if (length == 0) {
+        mp_raise_ValueError("List is empty");
+    }
+
+    if (length > MAX_LIST_LENGTH) {
+        mp_raise_ValueError("Too many list points");
+    }
+
+    float *list = m_new(float, length);
+    for (size_t i = 0; i < length; i++) {
+        list[i] = (float)mp_obj_get_float(items[i]);
+    }
+
+    *listLength = (uint16_t)length;
+    return list;
+}
+
+// setList(channelIndex, dwellList, voltageList, currentList)
+mp_obj_t modeez_setList(size_t n_args, const mp_obj_t *args) {
+    Channel &channel = getChannel(args[0]);
+
+    uint16_t dwellListLength;
+    float *dwellList = getFloatList(args[1], &dwellListLength);
+
+    uint16_t voltageListLength;
+    float *voltageList = getFloatList(args[2], &voltageListLength);
+
+    uint16_t currentListLength;
+    float *currentList = getFloatList(args[3], &currentListLength);
+
+    if (!list::areListLengthsEquivalent(dwellListLength, voltageListLength, currentListLength)) {
+        mp_raise_ValueError("List lengths are not equivalent");
+    }
+
+    for (int i = 0; i < voltageListLength; i++) {
+        if (channel.isVoltageLimitExceeded(voltageList[i])) {
+            mp_raise_ValueError("Voltage limit exceeded");
+        }
+    }
+
+    for (int i = 0; i < currentListLength; i++) {
+        if (channel.isCurrentLimitExceeded(currentList[i])) {
+            mp_raise_ValueError("Current limit exceeded");
+        }
+    }
+
+    float powerMaxLimit = channel_dispatcher::getPowerMaxLimit(channel);
+    for (int i = 0; i < MAX(voltageListLength, currentListLength); i++) {
+        if (voltageList[i % voltageListLength] * currentList[i % currentListLength] > powerMaxLimit) {
+            mp_raise_ValueError("Power limit exceeded");
+        }
+    }
+
+    if (!trigger::isIdle()) {
+        mp_raise_ValueError("Can not change transient trigger");
+    }
+
+    channel_dispatcher::setDwellList(channel, dwellList, dwellListLength);
+    channel_dispatcher::setVoltageList(channel, voltageList, voltageListLength);
+    channel_dispatcher::setCurrentList(channel, currentList, currentListLength);
 
     return mp_const_none;
 }
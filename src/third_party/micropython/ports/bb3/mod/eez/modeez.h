@@ -27,3 +27,5 @@ mp_obj_t modeez_getI(mp_obj_t channelIndexObj);
 mp_obj_t modeez_setI(mp_obj_t channelIndexObj, mp_obj_t value);
 mp_obj_t modeez_getOutputMode(mp_obj_t channelIndexObj);
 mp_obj_t modeez_dlogTraceData(size_t n_args, const mp_obj_t *args);
+mp_obj_t modeez_getSnapshot(size_t n_args, const mp_obj_t *args);
+mp_obj_t modeez_setList(size_t n_args, const mp_obj_t *args);
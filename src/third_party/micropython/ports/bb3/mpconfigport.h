@@ -50,6 +50,13 @@
 #define MICROPY_PY_UTIME            (1)
 #define MICROPY_PY_UTIME_MP_HAL     (1)
 
+// compiled scripts are cached as .mpy (see eez/mp.cpp)
+#define MICROPY_PERSISTENT_CODE_LOAD (1)
+#define MICROPY_PERSISTENT_CODE_SAVE (1)
+
+// shared helper libraries can be frozen into the firmware (see frozen.c)
+#define MICROPY_MODULE_FROZEN_STR   (1)
+
 // type definitions for the specific machine
 
 #define MICROPY_MAKE_POINTER_CALLABLE(p) ((void*)((mp_uint_t)(p) | 1))
@@ -240,6 +240,8 @@ void EXTI15_10_IRQHandler(void)
   HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_11);
   HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_15);
   /* USER CODE BEGIN EXTI15_10_IRQn 1 */
+  /* DIN2, EXTI is enabled at runtime when pin is used as trigger input */
+  HAL_GPIO_EXTI_IRQHandler(DIN2_Pin);
 
   /* USER CODE END EXTI15_10_IRQn 1 */
 }
@@ -129,7 +129,13 @@ void sntpSetSystemTimeUs(uint32_t t, uint32_t us);
 #define CHECKSUM_CHECK_ICMP6 0
 /*-----------------------------------------------------------------------------*/
 /* USER CODE BEGIN 1 */
-
+/* SCPI, remote display and stream servers: 3 listening netconns, 3 clients
+   and one more for the connection being rejected while a client is active */
+#define MEMP_NUM_NETCONN 8
+/* 3 clients, MQTT (raw API) and room for connections in TIME_WAIT */
+#define MEMP_NUM_TCP_PCB 8
+/* required by netconn_set_sendtimeout, see TcpServer::accept */
+#define LWIP_SO_SNDTIMEO 1
 /* USER CODE END 1 */
 
 #ifdef __cplusplus
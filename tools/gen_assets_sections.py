@@ -0,0 +1,245 @@
+#!/usr/bin/env python3
+#
+# Splits the GUI assets blob in src/eez/gui/document_*.cpp into independently
+# LZ4 compressed sections (see decompressAssets() in src/eez/gui/assets.cpp).
+# EEZ Studio generates the assets as one LZ4 block, so run this from the
+# repository root after the document_*.cpp files are regenerated:
+#
+#     python3 tools/gen_assets_sections.py
+#
+# With --check nothing is written, it only fails if some document still has
+# the assets in one block. CMake build runs it in this mode whenever any of
+# the documents change.
+#
+# Section 0 holds everything except bitmaps, i.e. document, styles, fonts and
+# colors, with the colors moved right after the fonts. It is decompressed
+# before the first frame. Section i > 0 holds the bitmap with ID i, it is
+# decompressed on first use.
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+ROOT = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), '..'))
+DOCUMENTS = [
+    ('src/eez/gui/document_stm32.cpp', 'src/eez/gui/document_stm32.h'),
+    ('src/eez/gui/document_simulator.cpp', 'src/eez/gui/document_simulator.h'),
+]
+
+ASSETS_SECTIONS_MAGIC = 0x53415A45 # "EZAS"
+
+# indexes of the offsets in the header of decompressed assets, see initAssets()
+HEADER_DOCUMENT = 0
+HEADER_STYLES = 1
+HEADER_FONTS = 2
+HEADER_BITMAPS = 3
+HEADER_COLORS = 4
+
+ARRAY_RE = re.compile(r'const uint8_t assets\[(\d+)\] = \{\n(.*?)\n\};\n', re.S)
+EXTERN_RE = re.compile(r'extern const uint8_t assets\[\d+\];')
+
+LZ4_MIN_MATCH = 4
+LZ4_MF_LIMIT = 12 # last match must start at least this many bytes before the end
+LZ4_LAST_LITERALS = 5
+LZ4_MAX_OFFSET = 65535
+
+
+def lz4_decompress(src, size):
+    dst = bytearray()
+    i = 0
+    while i < len(src):
+        token = src[i]
+        i += 1
+
+        length = token >> 4
+        if length == 15:
+            while True:
+                b = src[i]
+                i += 1
+                length += b
+                if b != 255:
+                    break
+        dst += src[i:i + length]
+        i += length
+        if i == len(src):
+            break
+
+        offset = src[i] | (src[i + 1] << 8)
+        i += 2
+        length = token & 15
+        if length == 15:
+            while True:
+                b = src[i]
+                i += 1
+                length += b
+                if b != 255:
+                    break
+        length += LZ4_MIN_MATCH
+        start = len(dst) - offset
+        if offset >= length:
+            dst += dst[start:start + length]
+        else:
+            for j in range(length):
+                dst.append(dst[start + j])
+
+    if len(dst) != size:
+        raise ValueError('LZ4 block decompressed to %d bytes instead of %d' % (len(dst), size))
+    return bytes(dst)
+
+
+def lz4_write_length(dst, length):
+    length -= 15
+    while length >= 255:
+        dst.append(255)
+        length -= 255
+    dst.append(length)
+
+
+def lz4_compress(src):
+    dst = bytearray()
+    n = len(src)
+    table = {}
+    anchor = 0
+    i = 0
+    match_limit = n - LZ4_MF_LIMIT
+    while i < match_limit:
+        key = src[i:i + LZ4_MIN_MATCH]
+        candidate = table.get(key)
+        table[key] = i
+        if candidate is None or i - candidate > LZ4_MAX_OFFSET:
+            i += 1
+            continue
+
+        # extend the match, it must stop LZ4_LAST_LITERALS before the end
+        length = LZ4_MIN_MATCH
+        max_length = n - LZ4_LAST_LITERALS - i
+        while length < max_length and src[candidate + length] == src[i + length]:
+            length += 1
+
+        literals = i - anchor
+        match = length - LZ4_MIN_MATCH
+        dst.append((min(literals, 15) << 4) | min(match, 15))
+        if literals >= 15:
+            lz4_write_length(dst, literals)
+        dst += src[anchor:i]
+        offset = i - candidate
+        dst.append(offset & 0xFF)
+        dst.append(offset >> 8)
+        if match >= 15:
+            lz4_write_length(dst, match)
+
+        i += length
+        anchor = i
+
+    literals = n - anchor
+    dst.append(min(literals, 15) << 4)
+    if literals >= 15:
+        lz4_write_length(dst, literals)
+    dst += src[anchor:]
+    return bytes(dst)
+
+
+def is_sectioned(blob):
+    return struct.unpack_from('<I', blob, 0)[0] == ASSETS_SECTIONS_MAGIC
+
+
+def split_sections(blob):
+    decompressed = lz4_decompress(blob[4:], struct.unpack_from('<I', blob, 0)[0])
+
+    header = list(struct.unpack_from('<5I', decompressed, 0))
+    bitmaps_begin = header[HEADER_BITMAPS]
+    bitmaps_end = header[HEADER_COLORS]
+    if not header[HEADER_FONTS] <= bitmaps_begin <= bitmaps_end:
+        raise ValueError('unexpected assets layout: %r' % header)
+
+    # bitmaps data starts with the table of uint32_t offsets, one per bitmap
+    num_bitmaps = struct.unpack_from('<I', decompressed, bitmaps_begin)[0] // 4 if bitmaps_end > bitmaps_begin else 0
+    offsets = list(struct.unpack_from('<%dI' % num_bitmaps, decompressed, bitmaps_begin)) + [bitmaps_end - bitmaps_begin]
+    bitmaps = [decompressed[bitmaps_begin + offsets[i]:bitmaps_begin + offsets[i + 1]] for i in range(num_bitmaps)]
+
+    # colors only use offsets relative to their own start, so they can be moved
+    header[HEADER_BITMAPS] = 0
+    header[HEADER_COLORS] = bitmaps_begin
+    main = struct.pack('<5I', *header) + decompressed[20:bitmaps_begin] + decompressed[bitmaps_end:]
+
+    return [main] + bitmaps
+
+
+def build_sections_blob(sections):
+    compressed = [lz4_compress(section) for section in sections]
+    for section, data in zip(sections, compressed):
+        assert lz4_decompress(data, len(section)) == section
+
+    toc_size = 8 + 12 * len(sections)
+    blob = bytearray(struct.pack('<2I', ASSETS_SECTIONS_MAGIC, len(sections)))
+    offset = toc_size
+    for section, data in zip(sections, compressed):
+        blob += struct.pack('<3I', offset, len(data), len(section))
+        # keep every section 4 bytes aligned
+        offset += (len(data) + 3) & ~3
+    for data in compressed:
+        blob += data + bytes(-len(data) % 4)
+    return bytes(blob)
+
+
+def format_array(blob):
+    lines = []
+    for i in range(0, len(blob), 16):
+        lines.append('    ' + ', '.join('0x%02X' % b for b in blob[i:i + 16]))
+    return ',\n'.join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--check', action='store_true', help='only check that the assets are already split into sections')
+    args = parser.parse_args()
+
+    result = 0
+
+    for cpp_path, h_path in DOCUMENTS:
+        with open(os.path.join(ROOT, cpp_path), encoding='utf-8', newline='') as f:
+            cpp = f.read()
+
+        match = ARRAY_RE.search(cpp)
+        if not match:
+            sys.stderr.write('%s: assets array not found\n' % cpp_path)
+            return 1
+        blob = bytes(int(x, 16) for x in re.findall(r'0x([0-9A-Fa-f]{2})', match.group(2)))
+        if len(blob) != int(match.group(1)):
+            sys.stderr.write('%s: assets array size mismatch\n' % cpp_path)
+            return 1
+
+        if is_sectioned(blob):
+            continue
+
+        if args.check:
+            sys.stderr.write('%s has the assets in one block, run: python3 tools/gen_assets_sections.py\n' % cpp_path)
+            result = 1
+            continue
+
+        sections = split_sections(blob)
+        new_blob = build_sections_blob(sections)
+
+        cpp = cpp[:match.start()] + 'const uint8_t assets[%d] = {\n%s\n};\n' % (len(new_blob), format_array(new_blob)) + cpp[match.end():]
+        with open(os.path.join(ROOT, cpp_path), 'w', encoding='utf-8', newline='') as f:
+            f.write(cpp)
+
+        with open(os.path.join(ROOT, h_path), encoding='utf-8', newline='') as f:
+            h = f.read()
+        h, count = EXTERN_RE.subn('extern const uint8_t assets[%d];' % len(new_blob), h)
+        if count != 1:
+            sys.stderr.write('%s: assets declaration not found\n' % h_path)
+            return 1
+        with open(os.path.join(ROOT, h_path), 'w', encoding='utf-8', newline='') as f:
+            f.write(h)
+
+        sys.stdout.write('%s: %d bytes in one block -> %d bytes in %d sections (%d bytes decompressed at boot)\n' %
+                         (cpp_path, len(blob), len(new_blob), len(sections), len(sections[0])))
+
+    return result
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,394 @@
+#!/usr/bin/env python3
+#
+# Generates src/eez/modules/psu/gui/data_operations.cpp, the table of data
+# operations implemented by each data function (see DATA_OPERATION_FUNCTION in
+# src/eez/gui/gui.h). Run from the repository root after adding or changing
+# data functions or after the document_*.cpp files are regenerated:
+#
+#     python3 tools/gen_data_operations.py
+#
+# With --check nothing is written, it only fails if the checked-in file is not
+# up to date. CMake build runs it in this mode whenever any source file changes.
+#
+# A data function gets the mask of operations it implements only if all its
+# code outside of "if (operation == DATA_OPERATION_...)" branches is local
+# variable declarations, ifs without side effects and calls which pass the
+# operation to another data function, otherwise it gets DATA_OPERATIONS_ALL,
+# i.e. it is called for every operation as before.
+
+import argparse
+import os
+import re
+import sys
+
+ROOT = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), '..'))
+SOURCE_DIRS = ['src/eez']
+OUTPUT = 'src/eez/modules/psu/gui/data_operations.cpp'
+DOCUMENTS = [
+    ('EEZ_PLATFORM_STM32', 'src/eez/gui/document_stm32.cpp'),
+    ('EEZ_PLATFORM_SIMULATOR', 'src/eez/gui/document_simulator.cpp'),
+]
+
+ALL = None
+
+FUNCTION_RE = re.compile(
+    r'^void\s+(data_\w+)\s*\(\s*DataOperationEnum\s+(\w+)\s*,\s*Cursor\s+\w+\s*,\s*Value\s*&\s*(\w+)\s*\)\s*\{',
+    re.M)
+
+TOKEN_RE = re.compile(r'\s*(?:(\w+)|(==|!=|&&|\|\||::|->|.))', re.S)
+
+
+def strip_comments_and_strings(text):
+    def replace(match):
+        s = match.group(0)
+        if s.startswith('/'):
+            return ' ' if s.startswith('/*') else ''
+        return '""' if s.startswith('"') else "' '"
+    text = re.sub(r'//[^\n]*|/\*.*?\*/|"(?:\\.|[^"\\\n])*"|\'(?:\\.|[^\'\\\n])*\'', replace, text, flags=re.S)
+    # code from all #if branches is analyzed
+    return re.sub(r'^[ \t]*#.*$', '', text, flags=re.M)
+
+
+def tokenize_block(text, pos):
+    # tokens of the block which starts with "{" at pos, without the braces
+    tokens = []
+    depth = 0
+    while pos < len(text):
+        match = TOKEN_RE.match(text, pos)
+        if not match or match.end() == pos:
+            break
+        pos = match.end()
+        token = match.group(1) or match.group(2)
+        if not token.strip():
+            continue
+        if token == '{':
+            depth += 1
+        elif token == '}':
+            depth -= 1
+            if depth == 0:
+                return tokens[1:]
+        tokens.append(token)
+    raise ValueError('unbalanced {')
+
+
+def find_closing(tokens, i, open_token, close_token):
+    depth = 0
+    for j in range(i, len(tokens)):
+        if tokens[j] == open_token:
+            depth += 1
+        elif tokens[j] == close_token:
+            depth -= 1
+            if depth == 0:
+                return j
+    raise ValueError('unbalanced ' + open_token)
+
+
+def statement_end(tokens, i):
+    # returns index after the statement which starts at i
+    if tokens[i] == '{':
+        return find_closing(tokens, i, '{', '}') + 1
+    if tokens[i] == 'if':
+        j = find_closing(tokens, i + 1, '(', ')') + 1
+        j = statement_end(tokens, j)
+        if j < len(tokens) and tokens[j] == 'else':
+            j = statement_end(tokens, j + 1)
+        return j
+    if tokens[i] in ('for', 'while', 'switch'):
+        j = find_closing(tokens, i + 1, '(', ')') + 1
+        return statement_end(tokens, j)
+    if tokens[i] == 'do':
+        j = statement_end(tokens, i + 1)
+        while tokens[j] != ';':
+            j += 1
+        return j + 1
+    depth = 0
+    j = i
+    while j < len(tokens):
+        if tokens[j] in ('(', '{', '['):
+            depth += 1
+        elif tokens[j] in (')', '}', ']'):
+            depth -= 1
+        elif tokens[j] == ';' and depth == 0:
+            return j + 1
+        j += 1
+    return j
+
+
+def split_top_level(tokens, separator):
+    parts = [[]]
+    depth = 0
+    for token in tokens:
+        if token == '(':
+            depth += 1
+        elif token == ')':
+            depth -= 1
+        if token == separator and depth == 0:
+            parts.append([])
+        else:
+            parts[-1].append(token)
+    return parts
+
+
+def strip_parens(tokens):
+    while len(tokens) > 2 and tokens[0] == '(' and find_closing(tokens, 0, '(', ')') == len(tokens) - 1:
+        tokens = tokens[1:-1]
+    return tokens
+
+
+def guarded_operations(cond, operation):
+    # set of operations for which condition can be true, ALL if it doesn't depend on operation only
+    cond = strip_parens(cond)
+    disjuncts = split_top_level(cond, '||')
+    if len(disjuncts) > 1:
+        result = set()
+        for disjunct in disjuncts:
+            operations = guarded_operations(disjunct, operation)
+            if operations is ALL:
+                return ALL
+            result |= operations
+        return result
+
+    result = ALL
+    for conjunct in split_top_level(cond, '&&'):
+        conjunct = strip_parens(conjunct)
+        if len(conjunct) == 3 and conjunct[0] == operation and conjunct[1] == '==' and conjunct[2].startswith('DATA_OPERATION_'):
+            operations = {conjunct[2]}
+        elif operation in conjunct and '||' in conjunct:
+            operations = guarded_operations(conjunct, operation)
+        else:
+            continue
+        if operations is not ALL:
+            result = operations if result is ALL else result & operations
+    return result
+
+
+def is_declaration(tokens):
+    # e.g. "int iChannel = ...;" or "Channel &channel = ...;" or "auto page = ...;"
+    i = 0
+    if tokens[i] == 'const':
+        i += 1
+    if i >= len(tokens) or not re.match(r'^\w+$', tokens[i]) or tokens[i] in ('return', 'delete', 'goto', 'break', 'continue'):
+        return False
+    i += 1
+    while i < len(tokens) and tokens[i] == '::':
+        i += 2
+    while i < len(tokens) and tokens[i] in ('&', '*'):
+        i += 1
+    if i >= len(tokens) or not re.match(r'^\w+$', tokens[i]):
+        return False
+    i += 1
+    return i < len(tokens) and tokens[i] in ('=', ';', '[')
+
+
+def forwarded_to(statement, operation, value):
+    # e.g. "data_channel_u_mon(operation, cursor, value);"
+    if len(statement) >= 8 and statement[0].startswith('data_') and statement[1] == '(' and \
+            statement[2] == operation and statement[3] == ',' and \
+            statement[-4:] == [',', value, ')', ';'] and \
+            find_closing(statement, 1, '(', ')') == len(statement) - 2 and \
+            operation not in statement[4:] and value not in statement[:-3]:
+        return statement[0]
+    return None
+
+
+def analyze_block(tokens, operation, value):
+    # returns set of handled operations (and ('call', data_function) for the
+    # forwarded operations) or ALL
+    result = set()
+    i = 0
+    while i < len(tokens):
+        end = statement_end(tokens, i)
+        statement = tokens[i:end]
+
+        if statement[0] == '{':
+            operations = analyze_block(statement[1:-1], operation, value)
+            if operations is ALL:
+                return ALL
+            result |= operations
+        elif statement[0] == 'if':
+            j = 1
+            while True:
+                cond_end = find_closing(statement, j, '(', ')')
+                cond = statement[j + 1:cond_end]
+                branch_end = statement_end(statement, cond_end + 1)
+                branch = statement[cond_end + 1:branch_end]
+
+                operations = guarded_operations(cond, operation)
+                if operations is ALL:
+                    if operation in cond or value in cond:
+                        return ALL
+                    operations = analyze_block(branch, operation, value)
+                    if operations is ALL:
+                        return ALL
+                result |= operations
+
+                if branch_end < len(statement) and statement[branch_end] == 'else':
+                    if statement[branch_end + 1] == 'if':
+                        j = branch_end + 2
+                        continue
+                    operations = analyze_block(statement[branch_end + 1:], operation, value)
+                    if operations is ALL:
+                        return ALL
+                    result |= operations
+                break
+        elif statement == ['return', ';'] or statement == [';']:
+            pass
+        elif forwarded_to(statement, operation, value):
+            result.add(('call', forwarded_to(statement, operation, value)))
+        elif is_declaration(statement) and operation not in statement and value not in statement:
+            pass
+        else:
+            return ALL
+
+        i = end
+    return result
+
+
+def analyze_sources():
+    functions = {}
+    for source_dir in SOURCE_DIRS:
+        for root, dirs, files in os.walk(os.path.join(ROOT, source_dir)):
+            for name in sorted(files):
+                if not name.endswith('.cpp'):
+                    continue
+                with open(os.path.join(root, name), encoding='utf-8', errors='replace') as f:
+                    text = strip_comments_and_strings(f.read())
+                for match in FUNCTION_RE.finditer(text):
+                    name_, operation, value = match.groups()
+                    try:
+                        body = tokenize_block(text, match.end() - 1)
+                        operations = analyze_block(body, operation, value)
+                    except (ValueError, IndexError):
+                        operations = ALL
+                    # defined in more then one place (e.g. per platform), use union
+                    if name_ in functions:
+                        if functions[name_] is ALL or operations is ALL:
+                            operations = ALL
+                        else:
+                            operations = functions[name_] | operations
+                    functions[name_] = operations
+
+    resolved = {}
+
+    def resolve(name, visiting):
+        if name in resolved:
+            return resolved[name]
+        operations = functions.get(name, ALL)
+        if operations is not ALL:
+            result = set()
+            for operation in operations:
+                if isinstance(operation, tuple):
+                    if operation[1] in visiting:
+                        return ALL
+                    callee = resolve(operation[1], visiting | {name})
+                    if callee is ALL:
+                        result = ALL
+                        break
+                    result |= callee
+                else:
+                    result.add(operation)
+            operations = result if result else ALL
+        resolved[name] = operations
+        return operations
+
+    for name in functions:
+        resolve(name, set())
+
+    return resolved
+
+
+def read_data_functions(path):
+    with open(os.path.join(ROOT, path), encoding='utf-8') as f:
+        text = f.read()
+    match = re.search(r'DataOperationsFunction g_dataOperationsFunctions\[\] = \{(.*?)\};', text, re.S)
+    return [name.strip() for name in match.group(1).split(',') if name.strip()]
+
+
+def read_last_data_id(path):
+    with open(os.path.join(ROOT, path.replace('.cpp', '.h')), encoding='utf-8') as f:
+        text = f.read()
+    match = re.search(r'enum DataEnum \{(.*?)\};', text, re.S)
+    return re.findall(r'(DATA_ID_\w+)', match.group(1))[-1]
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generates %s" % OUTPUT)
+    parser.add_argument("--check", action="store_true", help="fail if %s is not up to date" % OUTPUT)
+    args = parser.parse_args()
+
+    functions = analyze_sources()
+
+    lines = []
+    lines.append('/*')
+    lines.append(' * EEZ Modular Firmware')
+    lines.append(' * Copyright (C) 2020-present, Envox d.o.o.')
+    lines.append(' *')
+    lines.append(' * This program is free software: you can redistribute it and/or modify')
+    lines.append(' * it under the terms of the GNU General Public License as published by')
+    lines.append(' * the Free Software Foundation, either version 3 of the License, or')
+    lines.append(' * (at your option) any later version.')
+    lines.append('')
+    lines.append(' * This program is distributed in the hope that it will be useful,')
+    lines.append(' * but WITHOUT ANY WARRANTY; without even the implied warranty of')
+    lines.append(' * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the')
+    lines.append(' * GNU General Public License for more details.')
+    lines.append('')
+    lines.append(' * You should have received a copy of the GNU General Public License')
+    lines.append(' * along with this program.  If not, see <http://www.gnu.org/licenses/>.')
+    lines.append(' */')
+    lines.append('')
+    lines.append('// Generated by tools/gen_data_operations.py, do not edit.')
+    lines.append('')
+    lines.append('#if OPTION_DISPLAY')
+    lines.append('')
+    lines.append('#include <eez/gui/gui.h>')
+    lines.append('')
+    lines.append('namespace eez {')
+    lines.append('namespace gui {')
+
+    numRestricted = 0
+    numTotal = 0
+    for i, (platform, document) in enumerate(DOCUMENTS):
+        lines.append('')
+        lines.append('#%s defined(%s)' % ('if' if i == 0 else 'elif', platform))
+        lines.append('')
+        lines.append('const uint64_t g_dataOperationsMasks[] = {')
+        for name in read_data_functions(document):
+            operations = functions.get(name, ALL)
+            numTotal += 1
+            if operations is ALL:
+                mask = 'DATA_OPERATIONS_ALL'
+            else:
+                numRestricted += 1
+                mask = ' | '.join('DATA_OPERATION_MASK(%s)' % operation for operation in sorted(operations))
+            lines.append('    %s, // %s' % (mask, name))
+        lines.append('};')
+        lines.append('')
+        lines.append('static_assert(sizeof(g_dataOperationsMasks) / sizeof(uint64_t) == %s + 1, "Run tools/gen_data_operations.py");' % read_last_data_id(document))
+    lines.append('')
+    lines.append('#endif')
+    lines.append('')
+    lines.append('} // namespace gui')
+    lines.append('} // namespace eez')
+    lines.append('')
+    lines.append('#endif')
+
+    if args.check:
+        try:
+            with open(os.path.join(ROOT, OUTPUT), encoding='utf-8') as f:
+                up_to_date = f.read() == '\n'.join(lines) + '\n'
+        except IOError:
+            up_to_date = False
+        if not up_to_date:
+            sys.stderr.write('%s is out of date, run: python3 tools/gen_data_operations.py\n' % OUTPUT)
+            return 1
+        return 0
+
+    with open(os.path.join(ROOT, OUTPUT), 'w', newline='\r\n') as f:
+        f.write('\n'.join(lines) + '\n')
+
+    sys.stdout.write('%s: %d of %d data functions with known operations\n' % (OUTPUT, numRestricted, numTotal))
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,254 @@
+#!/usr/bin/env python3
+#
+# Reference client for the BB3 remote display (front panel streaming) server.
+# See src/eez/modules/mcu/remote_display.h for the protocol description.
+# Server is off by default, enable it with SYST:COMM:ENAB ON,RDIS.
+#
+# Usage:
+#   remote_display_client.py HOST [--port 5026]
+#       shows the display in a window, mouse is touch, mouse wheel and
+#       right click are encoder rotation and click (requires tkinter)
+#   remote_display_client.py HOST --frames N [--snapshot file.ppm]
+#       receives N frames (or waits up to --timeout seconds), prints
+#       bandwidth statistics and optionally saves the last frame
+#
+# Only the Python standard library is used, LZ4 block decoder is included.
+
+import argparse
+import socket
+import struct
+import sys
+import time
+
+DEFAULT_PORT = 5026
+
+
+def lz4_block_decompress(src, size):
+    dst = bytearray()
+    i = 0
+    n = len(src)
+    while i < n:
+        token = src[i]
+        i += 1
+
+        length = token >> 4
+        if length == 15:
+            while True:
+                b = src[i]
+                i += 1
+                length += b
+                if b != 255:
+                    break
+        dst += src[i:i + length]
+        i += length
+        if i >= n:
+            break
+
+        offset = src[i] | (src[i + 1] << 8)
+        i += 2
+
+        length = token & 15
+        if length == 15:
+            while True:
+                b = src[i]
+                i += 1
+                length += b
+                if b != 255:
+                    break
+        length += 4
+
+        start = len(dst) - offset
+        if offset >= length:
+            dst += dst[start:start + length]
+        else:
+            for k in range(length):
+                dst.append(dst[start + k])
+
+    if len(dst) != size:
+        raise ValueError("LZ4 block decompressed to %d bytes, expected %d" % (len(dst), size))
+    return bytes(dst)
+
+
+class RemoteDisplay:
+    def __init__(self, host, port):
+        self.sock = socket.create_connection((host, port))
+        self.sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        self.received = 0
+
+        hello = self.recv_exact(10)
+        tag, version, self.tile_size, _, self.width, self.height, self.cache_size = struct.unpack("<cBBBHHH", hello)
+        if tag != b"H" or version != 1:
+            raise RuntimeError("unsupported server (%r, version %d)" % (tag, version))
+
+        self.tiles_x = self.width // self.tile_size
+        self.tile_bytes = self.tile_size * self.tile_size * 2
+        self.cache = [None] * self.cache_size
+        # RGB565 little endian, whole frame
+        self.frame = bytearray(self.width * self.height * 2)
+        self.frame_number = 0
+        self.num_tiles = 0
+        self.num_cached_tiles = 0
+
+    def recv_exact(self, size):
+        data = bytearray()
+        while len(data) < size:
+            chunk = self.sock.recv(size - len(data))
+            if not chunk:
+                raise ConnectionError("server closed the connection")
+            data += chunk
+        self.received += size
+        return bytes(data)
+
+    def read_frame(self):
+        """Reads one frame update, returns list of changed tile indexes."""
+        tag, _, num_tiles, self.frame_number = struct.unpack("<cBHI", self.recv_exact(8))
+        if tag != b"F":
+            raise RuntimeError("unexpected message %r" % tag)
+
+        changed = []
+        for _ in range(num_tiles):
+            tile_index, tile_hash, length = struct.unpack("<HIH", self.recv_exact(8))
+            slot = tile_hash % self.cache_size
+            if length == 0:
+                pixels = self.cache[slot]
+                if pixels is None:
+                    raise RuntimeError("tile %d refers to empty cache slot %d" % (tile_index, slot))
+                self.num_cached_tiles += 1
+            else:
+                data = self.recv_exact(length)
+                if length == self.tile_bytes:
+                    pixels = data
+                else:
+                    pixels = lz4_block_decompress(data, self.tile_bytes)
+                self.cache[slot] = pixels
+                self.num_tiles += 1
+
+            self.put_tile(tile_index, pixels)
+            changed.append(tile_index)
+
+        return changed
+
+    def put_tile(self, tile_index, pixels):
+        x = (tile_index % self.tiles_x) * self.tile_size
+        y = (tile_index // self.tiles_x) * self.tile_size
+        row = self.tile_size * 2
+        for ty in range(self.tile_size):
+            offset = ((y + ty) * self.width + x) * 2
+            self.frame[offset:offset + row] = pixels[ty * row:(ty + 1) * row]
+
+    def rgb(self, x1=0, y1=0, x2=None, y2=None):
+        x2 = self.width if x2 is None else x2
+        y2 = self.height if y2 is None else y2
+        out = bytearray()
+        for y in range(y1, y2):
+            offset = (y * self.width + x1) * 2
+            for i in range(offset, offset + (x2 - x1) * 2, 2):
+                c = self.frame[i] | (self.frame[i + 1] << 8)
+                out += bytes(((c >> 8) & 0xF8, (c >> 3) & 0xFC, (c << 3) & 0xF8))
+        return bytes(out)
+
+    def touch(self, x, y, pressed):
+        self.sock.sendall(struct.pack("<cHHB", b"T", x, y, 1 if pressed else 0))
+
+    def encoder(self, counter, clicked=False):
+        self.sock.sendall(struct.pack("<cbB", b"E", counter, 1 if clicked else 0))
+
+    def refresh(self):
+        self.sock.sendall(b"R")
+
+    def save_ppm(self, path):
+        with open(path, "wb") as f:
+            f.write(b"P6\n%d %d\n255\n" % (self.width, self.height))
+            f.write(self.rgb())
+
+
+def run_stats(display, args):
+    display.sock.settimeout(args.timeout)
+    start = time.time()
+    frames = 0
+    try:
+        while frames < args.frames:
+            changed = display.read_frame()
+            frames += 1
+            print("frame %d: %d tiles" % (display.frame_number, len(changed)))
+    except socket.timeout:
+        pass
+    elapsed = time.time() - start
+
+    print("%d frames, %d tiles decoded, %d tiles from cache, %d bytes received in %.1f s" % (
+        frames, display.num_tiles, display.num_cached_tiles, display.received, elapsed))
+
+    if args.snapshot:
+        display.save_ppm(args.snapshot)
+
+
+def run_viewer(display, args):
+    import threading
+    import tkinter
+
+    root = tkinter.Tk()
+    root.title("BB3 remote display")
+    image = tkinter.PhotoImage(width=display.width, height=display.height)
+    label = tkinter.Label(root, image=image, borderwidth=0)
+    label.pack()
+
+    pending = set()
+    lock = threading.Lock()
+
+    def receiver():
+        try:
+            while True:
+                changed = display.read_frame()
+                with lock:
+                    pending.update(changed)
+        except (ConnectionError, OSError) as e:
+            print(e)
+
+    def update():
+        with lock:
+            changed = list(pending)
+            pending.clear()
+            for tile_index in changed:
+                x = (tile_index % display.tiles_x) * display.tile_size
+                y = (tile_index // display.tiles_x) * display.tile_size
+                rgb = display.rgb(x, y, x + display.tile_size, y + display.tile_size)
+                rows = []
+                for ty in range(display.tile_size):
+                    row = rgb[ty * display.tile_size * 3:(ty + 1) * display.tile_size * 3]
+                    rows.append("{" + " ".join("#%02x%02x%02x" % tuple(row[i:i + 3]) for i in range(0, len(row), 3)) + "}")
+                image.put(" ".join(rows), to=(x, y))
+        root.after(15, update)
+
+    label.bind("<ButtonPress-1>", lambda e: display.touch(e.x, e.y, True))
+    label.bind("<B1-Motion>", lambda e: display.touch(max(e.x, 0), max(e.y, 0), True))
+    label.bind("<ButtonRelease-1>", lambda e: display.touch(max(e.x, 0), max(e.y, 0), False))
+    label.bind("<MouseWheel>", lambda e: display.encoder(1 if e.delta > 0 else -1))
+    label.bind("<Button-4>", lambda e: display.encoder(1))
+    label.bind("<Button-5>", lambda e: display.encoder(-1))
+    label.bind("<Button-3>", lambda e: display.encoder(0, True))
+
+    threading.Thread(target=receiver, daemon=True).start()
+    update()
+    root.mainloop()
+
+
+def main():
+    parser = argparse.ArgumentParser(description="BB3 remote display client")
+    parser.add_argument("host")
+    parser.add_argument("--port", type=int, default=DEFAULT_PORT)
+    parser.add_argument("--frames", type=int, help="receive this many frames, print statistics and exit")
+    parser.add_argument("--timeout", type=float, default=5.0, help="with --frames, stop if no frame arrives for this long")
+    parser.add_argument("--snapshot", help="with --frames, save the last frame as PPM")
+    args = parser.parse_args()
+
+    display = RemoteDisplay(args.host, args.port)
+    print("connected: %dx%d, tile size %d, cache size %d" % (display.width, display.height, display.tile_size, display.cache_size))
+
+    if args.frames:
+        run_stats(display, args)
+    else:
+        run_viewer(display, args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,125 @@
+#!/usr/bin/env python3
+#
+# Reference client for the BB3 measurement stream server.
+# See src/eez/modules/psu/stream.h for the protocol description.
+#
+# Usage:
+#   stream_client.py HOST [--port 5027] [--channels 1,2] [--quantity both]
+#                    [--decimation N] [--duration S] [--csv file.csv]
+#       subscribes, prints sample rate per channel and quantity every second
+#       and optionally writes every received sample into CSV file
+#
+# Without --channels the subscription already set with SYSTem:COMMunicate:STReam
+# is used. Only the Python standard library is used.
+
+import argparse
+import socket
+import struct
+import sys
+import time
+
+DEFAULT_PORT = 5027
+
+QUANTITY_VOLTAGE = 1
+QUANTITY_CURRENT = 2
+
+QUANTITIES = {
+    "volt": QUANTITY_VOLTAGE,
+    "curr": QUANTITY_CURRENT,
+    "both": QUANTITY_VOLTAGE | QUANTITY_CURRENT,
+}
+
+
+class Stream:
+    def __init__(self, host, port):
+        self.sock = socket.create_connection((host, port))
+        self.sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        self.received = 0
+        self.dropped = 0
+
+        hello = self.recv_exact(8)
+        tag, version, self.num_channels, _, self.channels, self.quantities, self.decimation = struct.unpack("<cBBBBBH", hello)
+        if tag != b"H" or version != 2:
+            raise RuntimeError("unsupported server (%r, version %d)" % (tag, version))
+
+    def recv_exact(self, size):
+        data = bytearray()
+        while len(data) < size:
+            chunk = self.sock.recv(size - len(data))
+            if not chunk:
+                raise ConnectionError("server closed the connection")
+            data += chunk
+        self.received += size
+        return bytes(data)
+
+    def subscribe(self, channels, quantities, decimation):
+        self.sock.sendall(struct.pack("<cBBH", b"S", channels, quantities, decimation))
+
+    def read_samples(self):
+        """Reads one data message, returns list of (time, channel index, quantity, value)."""
+        tag, _, num_samples, dropped = struct.unpack("<cBHI", self.recv_exact(8))
+        if tag != b"D":
+            raise RuntimeError("unexpected message %r" % tag)
+        self.dropped += dropped
+
+        data = self.recv_exact(num_samples * 14)
+        return [struct.unpack_from("<QBBf", data, i * 14) for i in range(num_samples)]
+
+
+def main():
+    parser = argparse.ArgumentParser(description="BB3 measurement stream client")
+    parser.add_argument("host")
+    parser.add_argument("--port", type=int, default=DEFAULT_PORT)
+    parser.add_argument("--channels", help="comma separated list of channels, e.g. 1,2")
+    parser.add_argument("--quantity", choices=sorted(QUANTITIES), default="both")
+    parser.add_argument("--decimation", type=int, default=1, help="send mean of every N samples")
+    parser.add_argument("--duration", type=float, help="stop after this many seconds")
+    parser.add_argument("--csv", help="write samples into this file")
+    args = parser.parse_args()
+
+    stream = Stream(args.host, args.port)
+    print("connected: %d channels, subscription channels 0x%02x, quantities %d, decimation %d" % (
+        stream.num_channels, stream.channels, stream.quantities, stream.decimation))
+
+    if args.channels:
+        channels = 0
+        for channel in args.channels.split(","):
+            channels |= 1 << (int(channel) - 1)
+        stream.subscribe(channels, QUANTITIES[args.quantity], args.decimation)
+
+    csv = open(args.csv, "w") if args.csv else None
+    if csv:
+        csv.write("time,channel,quantity,value\n")
+
+    start = time.time()
+    last_report = start
+    counts = {}
+    total = 0
+    try:
+        while args.duration is None or time.time() - start < args.duration:
+            for t, channel_index, quantity, value in stream.read_samples():
+                key = (channel_index + 1, "U" if quantity == QUANTITY_VOLTAGE else "I")
+                counts[key] = counts.get(key, 0) + 1
+                total += 1
+                if csv:
+                    csv.write("%d,%d,%s,%g\n" % (t, key[0], key[1], value))
+
+            now = time.time()
+            if now - last_report >= 1.0:
+                print("  ".join("CH%d %s: %.0f/s" % (key[0], key[1], counts[key] / (now - last_report)) for key in sorted(counts)) +
+                    "  dropped: %d" % stream.dropped)
+                counts = {}
+                last_report = now
+    except KeyboardInterrupt:
+        pass
+    except (ConnectionError, OSError) as e:
+        print(e)
+    finally:
+        if csv:
+            csv.close()
+
+    print("%d samples, %d dropped, %d bytes received in %.1f s" % (total, stream.dropped, stream.received, time.time() - start))
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,244 @@
+#!/usr/bin/env python3
+#
+# Checks ramp, list, trigger delay and protection delay timing across the
+# point where the 32-bit microsecond counter wraps around (2^32 us, about
+# 4295 s after the boot, see micros64() in src/eez/system.h).
+#
+# Each case starts the simulator with --start-time, so the wrap comes a few
+# seconds after the boot. It sets the case up over SCPI (TCP port 5025)
+# and waits until the wrap is case.lead seconds away. Then it starts the
+# case and checks the output voltage or the protection state against the
+# time reported by SIMUlator:TIME?:
+#
+#     python3 tools/timebase_wrap_test.py path/to/modular-psu-firmware
+#
+# Simulator must have ethernet enabled (it is by default). Exits with non-zero
+# status if any check fails. Only the Python standard library is used.
+
+import argparse
+import os
+import socket
+import subprocess
+import sys
+import time
+
+WRAP_TIME = 2 ** 32 / 1000000.0 # in seconds
+
+SCPI_PORT = 5025
+
+# the simulator is started this many seconds before the wrap, it must boot
+# and set up the case in that time
+BOOT_MARGIN = 10.0
+
+# max. allowed difference between expected and actual time of a change,
+# covers ADC sampling, PSU tick and SCPI round trip
+TIME_TOLERANCE = 0.15
+VOLTAGE_TOLERANCE = 0.05
+
+POLL_PERIOD = 0.05
+
+
+class Simulator:
+    def __init__(self, exe, start_time):
+        self.start_time = start_time
+        self.process = subprocess.Popen([exe, '--start-time', '%.6f' % start_time],
+                                        cwd=os.path.dirname(os.path.abspath(exe)),
+                                        stdin=subprocess.PIPE, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+
+        deadline = time.time() + BOOT_MARGIN
+        while True:
+            try:
+                self.sock = socket.create_connection(('127.0.0.1', SCPI_PORT), timeout=5)
+                break
+            except OSError:
+                if time.time() > deadline or self.process.poll() is not None:
+                    self.close()
+                    raise RuntimeError('can not connect to the simulator')
+                time.sleep(0.2)
+        self.file = self.sock.makefile('rb')
+
+    def close(self):
+        if hasattr(self, 'sock'):
+            self.sock.close()
+        self.process.kill()
+        self.process.wait()
+
+    def send(self, command):
+        self.sock.sendall(command.encode() + b'\n')
+
+    def query(self, command):
+        self.send(command)
+        while True:
+            line = self.file.readline()
+            if not line:
+                raise RuntimeError('simulator closed the connection')
+            line = line.decode().strip()
+            # skip notifications like "**Reset" and "**ERROR ..."
+            if not line.startswith('**'):
+                return line
+
+    def setup(self, commands):
+        for command in commands:
+            # wait for each command, input sent during *RST is lost
+            self.query(command + ';*OPC?')
+        error = self.query('SYST:ERR?')
+        if not error.startswith('0,'):
+            raise RuntimeError('setup failed: %s' % error)
+
+    # time since the wrap point, negative before it
+    def parse_time(self, response):
+        return self.start_time + float(response.split(',')[1]) - WRAP_TIME
+
+    # sends command (could be empty) and returns its result (None if it is
+    # not a query) and the time after it was executed, relative to the wrap
+    def timed(self, command):
+        response = self.query(command + ';:SIMU:TIME?' if command else 'SIMU:TIME?')
+        if ';' in response:
+            result, t = response.split(';')
+            return result, self.parse_time(t)
+        return None, self.parse_time(response)
+
+    def wait_until(self, t):
+        _, now = self.timed(None)
+        if now > t:
+            raise RuntimeError('simulator is late %.3f s, increase BOOT_MARGIN' % (now - t))
+        time.sleep(t - now)
+
+
+class Case:
+    name = None
+    # how many seconds before the wrap start() is called
+    lead = None
+    setup = []
+    start = None
+    # how many seconds after start() values are checked
+    duration = None
+    query = 'MEAS:VOLT?'
+
+    # range of valid values at time t after start
+    def expected(self, t):
+        raise NotImplementedError()
+
+
+def step(t, t_step, before, after):
+    return before if t < t_step else after
+
+
+class TriggerDelayCase(Case):
+    name = 'trigger delay'
+    lead = 0.5
+    setup = ['VOLT:MODE STEP', 'CURR:MODE STEP', 'VOLT 0', 'CURR 1', 'VOLT:TRIG 10', 'CURR:TRIG 1',
+             'OUTP 1', 'TRIG:SOUR BUS', 'TRIG:DEL 1', 'INIT']
+    start = '*TRG'
+    duration = 2.0
+
+    def expected(self, t):
+        return step(t, 1.0, 0.0, 10.0)
+
+
+class RampCase(Case):
+    name = 'ramp'
+    lead = 1.0
+    setup = ['VOLT:MODE STEP', 'CURR:MODE STEP', 'VOLT 0', 'CURR 1', 'VOLT:TRIG 10', 'CURR:TRIG 1',
+             'VOLT:RAMP:DUR 2', 'OUTP 1', 'TRIG:SOUR BUS', 'TRIG:DEL 0', 'INIT']
+    start = '*TRG'
+    duration = 3.0
+
+    def expected(self, t):
+        return min(max(5.0 * t, 0.0), 10.0)
+
+
+class ListCase(Case):
+    name = 'list'
+    lead = 1.25
+    setup = ['LIST:VOLT 1,2,3,4,5', 'LIST:CURR 1', 'LIST:DWEL 0.5', 'LIST:COUN 1',
+             'VOLT:MODE LIST', 'CURR:MODE LIST', 'VOLT 0', 'CURR 1', 'OUTP 1', 'TRIG:SOUR BUS', 'TRIG:DEL 0', 'INIT']
+    start = '*TRG'
+    duration = 2.4
+
+    def expected(self, t):
+        return 1.0 + min(max(int(t / 0.5), 0), 4)
+
+
+class ProtectionDelayCase(Case):
+    name = 'protection delay'
+    lead = 0.5
+    # 10 V on 5 Ohm is limited to 0.5 A, OCP trips 1 s after CC is entered
+    setup = ['VOLT 10', 'CURR 0.5', 'CURR:PROT:DEL 1', 'CURR:PROT:STAT ON',
+             'SIMU:LOAD 5', 'SIMU:LOAD:STAT OFF', 'OUTP 1']
+    start = 'SIMU:LOAD:STAT ON'
+    duration = 2.0
+    query = 'CURR:PROT:TRIP?'
+
+    def expected(self, t):
+        return step(t, 1.0, 0.0, 1.0)
+
+
+CASES = [TriggerDelayCase(), RampCase(), ListCase(), ProtectionDelayCase()]
+
+
+def run_case(exe, case):
+    simulator = Simulator(exe, WRAP_TIME - BOOT_MARGIN)
+    try:
+        simulator.setup(['*RST', '*CLS'] + case.setup)
+        simulator.wait_until(-case.lead)
+
+        _, start_time = simulator.timed(case.start)
+        if start_time >= 0:
+            raise RuntimeError('started %.3f s after the wrap' % start_time)
+
+        errors = []
+        num_samples = 0
+        while True:
+            value, t = simulator.timed(case.query)
+            t -= start_time
+            if t > case.duration:
+                break
+
+            # the value could be sampled up to TIME_TOLERANCE before or after t
+            a = case.expected(t - TIME_TOLERANCE)
+            b = case.expected(t + TIME_TOLERANCE)
+            low = min(a, b) - VOLTAGE_TOLERANCE
+            high = max(a, b) + VOLTAGE_TOLERANCE
+
+            num_samples += 1
+            if not low <= float(value) <= high:
+                errors.append('at %.3f s (%+.3f s from the wrap) %s is %s, expected %g..%g' %
+                              (t, t + start_time, case.query, value, low, high))
+
+            time.sleep(POLL_PERIOD)
+
+        error = simulator.query('SYST:ERR?')
+        if not error.startswith('0,'):
+            errors.append('SCPI error: %s' % error)
+
+        return errors, num_samples
+    finally:
+        simulator.close()
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('simulator', help='path to the simulator executable')
+    args = parser.parse_args()
+
+    failed = 0
+    for case in CASES:
+        try:
+            errors, num_samples = run_case(args.simulator, case)
+        except (RuntimeError, OSError, ValueError) as e:
+            errors, num_samples = [str(e)], 0
+
+        if errors:
+            failed += 1
+            sys.stdout.write('FAIL %s\n' % case.name)
+            for error in errors:
+                sys.stdout.write('    %s\n' % error)
+        else:
+            sys.stdout.write('OK   %s (%d samples)\n' % (case.name, num_samples))
+
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
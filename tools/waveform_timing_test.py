@@ -0,0 +1,140 @@
+#!/usr/bin/env python3
+#
+# Checks FUNCtion (waveform) output timing against the virtual ADC of the
+# simulator. Each case starts the simulator, sets the waveform up over SCPI
+# (TCP port 5025), triggers it and then samples MEAS:VOLT? together with
+# SIMUlator:TIME?. Every sample must match the waveform at some point of the
+# last ADC_LAG seconds before it was taken:
+#
+#     python3 tools/waveform_timing_test.py path/to/modular-psu-firmware
+#
+# Waveform is written to the DAC by the waveform thread every
+# CONF_WAVEFORM_UPDATE_PERIOD_US (1 ms in the simulator), so the output is
+# late only for the ADC conversion and averaging. Exits with non-zero status
+# if any check fails. Only the Python standard library is used.
+
+import argparse
+import math
+import sys
+import time
+
+from timebase_wrap_test import Simulator
+
+# max. time from the DAC update until it is visible in MEAS:VOLT?
+ADC_LAG = 0.015
+VOLTAGE_TOLERANCE = 0.05
+
+# expected value is evaluated at this step inside the ADC_LAG window
+TIME_STEP = 0.0005
+
+POLL_PERIOD = 0.02
+
+
+class Case:
+    name = None
+    setup = []
+    # how many seconds after *TRG values are checked
+    duration = None
+
+    # expected output voltage t seconds after the waveform is started
+    def expected(self, t):
+        raise NotImplementedError()
+
+
+def waveform_setup(shape, frequency, amplitude, offset, phase, count):
+    return ['FUNC:SHAP %s' % shape, 'FUNC:FREQ %g' % frequency, 'FUNC:AMPL %g' % amplitude,
+            'FUNC:OFFS %g' % offset, 'FUNC:PHAS %g' % phase, 'FUNC:COUN %d' % count,
+            'VOLT:MODE FUNC', 'CURR:MODE FUNC', 'VOLT 0', 'CURR 1', 'CURR:TRIG 1',
+            'OUTP 1', 'TRIG:SOUR BUS', 'TRIG:DEL 0', 'INIT']
+
+
+class TriangleCase(Case):
+    name = 'triangle 1 Hz'
+    # 0 V -> 10 V -> 0 V, two periods, stays at 0 V after the last one
+    setup = waveform_setup('TRI', 1, 5, 5, 0, 2)
+    duration = 2.5
+
+    def expected(self, t):
+        if t < 0 or t >= 2:
+            return 0.0
+        x = t % 1.0
+        return 20.0 * x if x < 0.5 else 20.0 - 20.0 * x
+
+
+class SineCase(Case):
+    name = 'sine 20 Hz'
+    # 50 ms period sampled every 20 ms, i.e. at a different phase every time,
+    # starts and, after 40 periods, stays at 10 V
+    setup = waveform_setup('SIN', 20, 5, 5, 90, 40)
+    duration = 2.5
+
+    def expected(self, t):
+        if t < 0:
+            return 0.0
+        if t >= 2:
+            return 10.0
+        return 5.0 + 5.0 * math.cos(2.0 * math.pi * 20.0 * t)
+
+
+CASES = [TriangleCase(), SineCase()]
+
+
+def run_case(exe, case):
+    simulator = Simulator(exe, 0.0)
+    try:
+        simulator.setup(['*RST', '*CLS'] + case.setup)
+
+        _, start_time = simulator.timed('*TRG')
+
+        errors = []
+        num_samples = 0
+        while True:
+            value, t = simulator.timed('MEAS:VOLT?')
+            t -= start_time
+            if t > case.duration:
+                break
+
+            values = [case.expected(t - i * TIME_STEP) for i in range(int(round(ADC_LAG / TIME_STEP)) + 1)]
+            low = min(values) - VOLTAGE_TOLERANCE
+            high = max(values) + VOLTAGE_TOLERANCE
+
+            num_samples += 1
+            if not low <= float(value) <= high:
+                errors.append('at %.3f s MEAS:VOLT? is %s, expected %.3f..%.3f' % (t, value, low, high))
+
+            time.sleep(POLL_PERIOD)
+
+        error = simulator.query('SYST:ERR?')
+        if not error.startswith('0,'):
+            errors.append('SCPI error: %s' % error)
+
+        return errors, num_samples
+    finally:
+        simulator.close()
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('simulator', help='path to the simulator executable')
+    args = parser.parse_args()
+
+    failed = 0
+    for case in CASES:
+        try:
+            errors, num_samples = run_case(args.simulator, case)
+        except (RuntimeError, OSError, ValueError) as e:
+            errors, num_samples = [str(e)], 0
+
+        if errors:
+            failed += 1
+            sys.stdout.write('FAIL %s\n' % case.name)
+            for error in errors:
+                sys.stdout.write('    %s\n' % error)
+        else:
+            sys.stdout.write('OK   %s (%d samples)\n' % (case.name, num_samples))
+
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())